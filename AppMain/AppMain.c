@@ -2,8 +2,10 @@
  * @file uart_dma_example.c
  * @brief Example of DMA operation with UART1 for K1921VG015 MCU.
  * 
- * This example implements receiving 16 bytes over UART1 via DMA into the UBUFF array.
- * After receiving, the contents of UBUFF are sent back via UART1 using DMA.
+ * This example implements receiving 16 bytes over UART1 into a pool buffer.
+ * After receiving, the buffer is sent back via UART1 using DMA straight
+ * from the buffer (see Lib/buf).
+ * UART1 is served by the common UART driver (see Lib/uart).
  * The code and description are based on an example from NIIET with added FreeRTOS port.
  * 
  * UART1 settings:
@@ -30,6 +32,17 @@
 #include <stdio.h>
 #include <system_k1921vg015.h>
 #include "logger.h"
+#include "uart.h"
+#include "hrtimer.h"
+#include "prof.h"
+#include "trace.h"
+#include "telem.h"
+#include "init.h"
+#include "clk.h"
+#include "buf.h"
+#include "fwup.h"
+#include "lzs.h"
+#include "dma_mem.h"
 
 #include "FreeRTOS.h"
 #include "task.h"
@@ -54,18 +67,44 @@
 
 #define UBUFF_SIZE 16
 
-/** @brief Buffer for storing data received from UART1 */
-uint8_t UBUFF[UBUFF_SIZE];
+#define PROF_DUMP_PERIOD_MS 10000
 
-/** @brief DMA control data structure aligned on 1024-byte boundary */
-DMA_CtrlData_TypeDef DMA_CONFIGDATA __attribute__((aligned(1024)));
+#define TRACE_BAUD 921600
+#define TRACE_DRAIN_MS 10
+
+#define TELEM_BAUD 921600
+#define TELEM_PERIOD_MS 10
+#define TELEM_BATCH 10
+
+#define LZS_BAUD 921600
+#define LZS_IDLE_MS 10
+#define LZS_PRIO 2
+#define LZS_TELEM_PRIO 3
+
+#define FWUP_BAUD 921600
+#define FWUP_WRITE_PRIO 3
+#define FWUP_SERVE_PRIO 2
+
+/** Slot this image is linked for, 1 in the slot B build */
+#ifndef FWUP_SLOT
+#define FWUP_SLOT FWUP_SLOT_A
+#endif
+
+/** Channel of the memory to memory copies, no peripheral request on it */
+#define DMA_MEM_CH 1
+
+#define INIT_TASK_PRIO 1
+
+#define CLK_GOV_PERIOD_MS 100
+#define CLK_GOV_UP_PCT 70
+#define CLK_GOV_DOWN_PCT 20
+#define CLK_GOV_PRIO 3
 
 
 /** Function prototypes */
-void TMR32_IRQHandler(void);
-void DMA_CH_9_IRQHandler(void);
-void DMA_CH_12_IRQHandler(void);
+void LedShift(hrtimer_t *t, void *arg);
 void MainThr(void *arg);
+void EchoThr(void *arg);
 
 
 /**
@@ -83,153 +122,139 @@ void BSP_led_init()
 
 
 /**
- * @brief Initialize 32-bit timer with given period.
- * @param period Timer period in clock ticks
+ * @brief Initialize UART1 peripheral.
+ *
+ * Sets baud rate to 115200, GPIO pins A.2 and A.3 are routed by the driver,
+ * TX path is fed by DMA channel 9.
  *
- * Configures TMR32 in count-up mode to specified period with interrupt on match.
+ * @return 0 on success, driver error code otherwise.
  */
-void TMR32_init(uint32_t period)
+int UART1_init()
 {
-    RCU->CGCFGAPB_bit.TMR32EN = 1;      /**< Enable TMR32 clock */
-    RCU->RSTDISAPB_bit.TMR32EN = 1;     /**< Release TMR32 reset */
-
-    TMR32->CAPCOM[0].VAL = period - 1;  /**< Set timer period */
-    TMR32->CTRL_bit.MODE = 1;           /**< Count up mode */
-
-    TMR32->IM = 2;                      /**< Enable interrupt on CAPCOM[0] match */
-
-    /* Configure interrupt handler and priority in PLIC */
-    PLIC_SetIrqHandler(Plic_Mach_Target, IsrVect_IRQ_TMR32, TMR32_IRQHandler);
-    PLIC_SetPriority(IsrVect_IRQ_TMR32, 0x1);
-    PLIC_IntEnable(Plic_Mach_Target, IsrVect_IRQ_TMR32);
+    const uart_config_t cfg = {
+        .baud = UART1_BAUD,
+        .tx_buf_size = 128,
+        .rx_buf_size = 128,
+        .use_dma = 1,
+        .irq_prio = 1,
+    };
+
+    int ret = uart_init(UART_PORT1, &cfg);
+    if (ret != 0)
+        FERROR("UART1 init failed");
+    return ret;
 }
 
 
 /**
- * @brief Initialize DMA channels for UART1 transmit and receive.
+ * @brief Staged peripheral init, see Lib/init.
  *
- * Sets up DMA channel 9 for UART1 TX and channel 12 for UART1 RX
- * with 16-byte transfers to/from buffer UBUFF.
+ * Clock and LEDs come first, then the log port and UART1 before the
+ * scheduler starts. The banner is not needed to become operational
+ * and is printed by the low priority init task.
  */
-void DMA_UART1_init()
+static int clock_init(void)
 {
-    DMA->BASEPTR = (uint32_t)(&DMA_CONFIGDATA);  /**< Set base pointer for DMA control data */
-
-    // Configure DMA channel 9 (TX)
-    DMA_CONFIGDATA.PRM_DATA.CH[9].SRC_DATA_END_PTR = (uint32_t)&(UBUFF[UBUFF_SIZE - 1]);
-    DMA_CONFIGDATA.PRM_DATA.CH[9].CHANNEL_CFG_bit.SRC_SIZE = DMA_CHANNEL_CFG_SRC_SIZE_Byte;
-    DMA_CONFIGDATA.PRM_DATA.CH[9].CHANNEL_CFG_bit.SRC_INC = DMA_CHANNEL_CFG_SRC_INC_Byte;
-    DMA_CONFIGDATA.PRM_DATA.CH[9].DST_DATA_END_PTR = (uint32_t)(&UART1->DR);
-    DMA_CONFIGDATA.PRM_DATA.CH[9].CHANNEL_CFG_bit.DST_SIZE = DMA_CHANNEL_CFG_DST_SIZE_Byte;
-    DMA_CONFIGDATA.PRM_DATA.CH[9].CHANNEL_CFG_bit.DST_INC = DMA_CHANNEL_CFG_DST_INC_None;
-    DMA_CONFIGDATA.PRM_DATA.CH[9].CHANNEL_CFG_bit.R_POWER = 0x0;
-    DMA_CONFIGDATA.PRM_DATA.CH[9].CHANNEL_CFG_bit.N_MINUS_1 = UBUFF_SIZE - 1;
-    DMA_CONFIGDATA.PRM_DATA.CH[9].CHANNEL_CFG_bit.CYCLE_CTRL = DMA_CHANNEL_CFG_CYCLE_CTRL_Basic;
-
-    // Configure DMA channel 12 (RX)
-    DMA_CONFIGDATA.PRM_DATA.CH[12].SRC_DATA_END_PTR = (uint32_t)(&UART1->DR);
-    DMA_CONFIGDATA.PRM_DATA.CH[12].CHANNEL_CFG_bit.SRC_SIZE = DMA_CHANNEL_CFG_SRC_SIZE_Byte;
-    DMA_CONFIGDATA.PRM_DATA.CH[12].CHANNEL_CFG_bit.SRC_INC = DMA_CHANNEL_CFG_SRC_INC_None;
-    DMA_CONFIGDATA.PRM_DATA.CH[12].DST_DATA_END_PTR = (uint32_t)(&UBUFF[UBUFF_SIZE - 1]);
-    DMA_CONFIGDATA.PRM_DATA.CH[12].CHANNEL_CFG_bit.DST_SIZE = DMA_CHANNEL_CFG_DST_SIZE_Byte;
-    DMA_CONFIGDATA.PRM_DATA.CH[12].CHANNEL_CFG_bit.DST_INC = DMA_CHANNEL_CFG_DST_INC_Byte;
-    DMA_CONFIGDATA.PRM_DATA.CH[12].CHANNEL_CFG_bit.R_POWER = 0x0;
-    DMA_CONFIGDATA.PRM_DATA.CH[12].CHANNEL_CFG_bit.N_MINUS_1 = UBUFF_SIZE - 1;
-    DMA_CONFIGDATA.PRM_DATA.CH[12].CHANNEL_CFG_bit.CYCLE_CTRL = DMA_CHANNEL_CFG_CYCLE_CTRL_Basic;
-
-    DMA->ENSET_bit.CH9 = 1;       /**< Enable DMA channel 9 */
-    DMA->ENSET_bit.CH12 = 1;      /**< Enable DMA channel 12 */
-    DMA->CFG_bit.MASTEREN = 1;    /**< Enable DMA controller */
-
-    // Configure DMA interrupts in PLIC
-    PLIC_SetIrqHandler(Plic_Mach_Target, IsrVect_IRQ_DMA3, DMA_CH_9_IRQHandler);
-    PLIC_SetPriority(IsrVect_IRQ_DMA3, 0x1);
-    PLIC_IntEnable(Plic_Mach_Target, IsrVect_IRQ_DMA3);
-
-    PLIC_SetIrqHandler(Plic_Mach_Target, IsrVect_IRQ_DMA4, DMA_CH_12_IRQHandler);
-    PLIC_SetPriority(IsrVect_IRQ_DMA4, 0x1);
-    PLIC_IntEnable(Plic_Mach_Target, IsrVect_IRQ_DMA4);
-
-    UART1->DMACR_bit.RXDMAE = 1; /**< Enable UART1 RX DMA requests */
+    SystemInit();
+    SystemCoreClockUpdate();
+    return 0;
 }
+INIT_EARLY(clock_init, 10);
 
-
-/**
- * @brief Initialize UART1 peripheral.
- *
- * Sets baud rate to 115200, configures GPIO pins A.2 and A.3 for UART,
- * enables UART1 transmitter and receiver.
- */
-void UART1_init()
+static int led_init(void)
 {
-    uint32_t baud_icoef = HSECLK_VAL / (16 * UART1_BAUD);
-    uint32_t baud_fcoef =
-        ((HSECLK_VAL / (16.0f * RETARGET_UART_BAUD) - baud_icoef) * 64 + 0.5f);
+    BSP_led_init();
+    return 0;
+}
+INIT_EARLY(led_init, 20);
 
-    RCU->CGCFGAHB_bit.GPIOAEN = 1;      /**< Enable GPIOA clock */
-    RCU->RSTDISAHB_bit.GPIOAEN = 1;     /**< Release GPIOA reset */
-    RCU->CGCFGAPB_bit.UART1EN = 1;      /**< Enable UART1 clock */
-    RCU->RSTDISAPB_bit.UART1EN = 1;     /**< Release UART1 reset */
-
-    GPIOA->ALTFUNCNUM_bit.PIN2 = 1;     /**< Set alternate function for PA2 (RX) */
-    GPIOA->ALTFUNCNUM_bit.PIN3 = 1;     /**< Set alternate function for PA3 (TX) */
-    GPIOA->ALTFUNCSET = GPIO_ALTFUNCSET_PIN2_Msk | GPIO_ALTFUNCSET_PIN3_Msk;
-
-    RCU->UARTCLKCFG[1].UARTCLKCFG_bit.CLKSEL = RCU_UARTCLKCFG_CLKSEL_HSE;
-    RCU->UARTCLKCFG[1].UARTCLKCFG_bit.DIVEN = 0;
-    RCU->UARTCLKCFG[1].UARTCLKCFG_bit.RSTDIS = 1;
-    RCU->UARTCLKCFG[1].UARTCLKCFG_bit.CLKEN = 1;
-
-    UART1->IBRD = baud_icoef;           /**< Integer baud rate divisor */
-    UART1->FBRD = baud_fcoef;           /**< Fractional baud rate divisor */
-    UART1->LCRH = UART_LCRH_FEN_Msk | (3 << UART_LCRH_WLEN_Pos); /**< Enable FIFOs, 8-bit data */
-    UART1->IFLS = 0;                    /**< Interrupt FIFO level select */
-    UART1->CR = UART_CR_TXE_Msk | UART_CR_RXE_Msk | UART_CR_UARTEN_Msk; /**< Enable TX, RX, UART */
+static int log_init(void)
+{
+    retarget_init();
+    return 0;
 }
+INIT_PRE_SCHED(log_init, 10);
 
+#if !TRACE_ENABLE && !TELEM_ENABLE && !FWUP_ENABLE && !LZS_ENABLE
+INIT_PRE_SCHED(UART1_init, 20);
+#endif
 
-/**
- * @brief Initialize peripherals and system.
- *
- * Calls LED init, system setup, UART and DMA init,
- * and outputs system info via logging.
- */
-void periph_init()
+/** Bulk copies and fills off the CPU, see dma_memcpy() */
+static int dma_mem_setup(void)
+{
+    return dma_mem_init(DMA_MEM_CH);
+}
+INIT_PRE_SCHED(dma_mem_setup, 30);
+
+static int banner(void)
 {
-    BSP_led_init();
-    SystemInit();
-    SystemCoreClockUpdate();
-    BSP_led_init();
-    retarget_init();
-    UART1_init();
-    DMA_UART1_init();
     FINFO("K1921VG015 SYSCLK = %d MHz", (int)(SystemCoreClock / 1E6));
     FINFO("UID[0] = 0x%X  UID[1] = 0x%X  UID[2] = 0x%X  UID[3] = 0x%X",
           (unsigned int)PMUSYS->UID[0], (unsigned int)PMUSYS->UID[1],
           (unsigned int)PMUSYS->UID[2], (unsigned int)PMUSYS->UID[3]);
     FINFO("Start UART1(TX - A.3,  RX - A.2) DMA\r\n");
+    return 0;
 }
+INIT_POST_SCHED(banner, 10);
 
 
 /** Global variable to track LED shift pattern */
 volatile uint32_t led_shift;
 
+/** LED steps taken, counted in the timer callback */
+volatile uint32_t led_steps;
+
+/** LED shift timer, served by the TMR32 timer wheel */
+static hrtimer_t led_timer;
+
+
+#if TELEM_ENABLE
+static int32_t heap_free(void)
+{
+    return (int32_t)xPortGetFreeHeapSize();
+}
+
+/** Telemetry channels: every period, heap every 10th */
+TELEM_COUNTER(led_steps, 1);
+TELEM_GAUGE(led_shift, 1);
+TELEM_GAUGE_FN(heap_free, 10);
+#endif
+
+
+#if FWUP_ENABLE
+/** Internal flash holding both slots, a file in the host simulation */
+static flash_dev_t fwup_flash;
+static const fwup_layout_t fwup_layout = FWUP_LAYOUT_DEFAULT;
+
+static int fwup_flash_init(void)
+{
+#if SIM_HOST
+    return flash_file_init(&fwup_flash, "fwup_flash.bin", 1024 * 1024, 4096, 4096);
+#else
+    flash_int_init(&fwup_flash);
+    return 0;
+#endif
+}
+#endif
+
 
 /**
  * @brief Application entry point.
  *
- * Disables interrupts, initializes FreeRTOS, peripherals,
- * creates main task, enables interrupts, and starts scheduler.
+ * Disables interrupts, initializes FreeRTOS, runs the early and
+ * pre-scheduler init levels, creates tasks, enables interrupts,
+ * and starts scheduler.
  *
  * @return Integer status (never returns under normal operation).
  */
 int main(void)
 {
     InterruptDisable();
+    init_mark("main");
     freertos_risc_v_provider_init();
 
-    periph_init();
-    memset(UBUFF, 0, UBUFF_SIZE); /**< Clear UBUFF buffer */
+    init_run(INIT_LEVEL_EARLY);
+    init_run(INIT_LEVEL_PRE_SCHED);
     led_shift = LED0_MSK;
 
     BaseType_t ret = xTaskCreate(MainThr, "MainTask", 256, NULL, 5, NULL);
@@ -238,6 +263,59 @@ int main(void)
             ; /**< Error: task creation failed, infinitely wait */
     }
 
+#if TRACE_ENABLE
+    /** UART1 (the only port with TX DMA) carries the trace stream instead of the echo */
+    if (trace_start(UART_PORT1, TRACE_BAUD, TRACE_DRAIN_MS, 2) != 0) {
+        while (1)
+            ; /**< Error: trace start failed, infinitely wait */
+    }
+#elif LZS_ENABLE
+    /** Log and telemetry compressed into one stream, decode with Tools/lzs_cat.py */
+    if (lzs_start(UART_PORT1, LZS_BAUD, LZS_IDLE_MS, LZS_PRIO) != 0) {
+        while (1)
+            ; /**< Error: stream start failed, infinitely wait */
+    }
+    retarget_redirect(lzs_putc);
+#if TELEM_ENABLE
+    if (telem_start_sink(lzs_write_buf, TELEM_PERIOD_MS, TELEM_BATCH, LZS_TELEM_PRIO) != 0) {
+        while (1)
+            ; /**< Error: telemetry start failed, infinitely wait */
+    }
+#endif
+#elif TELEM_ENABLE
+    /** Same port for the telemetry frames, decode with Tools/telem2csv.py */
+    if (telem_start(UART_PORT1, TELEM_BAUD, TELEM_PERIOD_MS, TELEM_BATCH, 2) != 0) {
+        while (1)
+            ; /**< Error: telemetry start failed, infinitely wait */
+    }
+#elif FWUP_ENABLE
+    /** Same port for the image upload, see Tools/fwup.py */
+    if (fwup_flash_init() != 0 ||
+        fwup_init(&fwup_flash, &fwup_layout, FWUP_SLOT, FWUP_WRITE_PRIO) != FWUP_OK ||
+        fwup_serve(UART_PORT1, FWUP_BAUD, FWUP_SERVE_PRIO) != 0) {
+        while (1)
+            ; /**< Error: update service start failed, infinitely wait */
+    }
+#else
+    ret = xTaskCreate(EchoThr, "EchoTask", 256, NULL, 4, NULL);
+    if (ret != pdPASS) {
+        while (1)
+            ; /**< Error: task creation failed, infinitely wait */
+    }
+#endif
+
+    /** Probe table dump, compiled out unless built with PROF_ENABLE */
+    if (prof_task_start(PROF_DUMP_PERIOD_MS, 1) != 0) {
+        while (1)
+            ; /**< Error: task creation failed, infinitely wait */
+    }
+
+    /** Deferred init and the boot-time report, below every application task */
+    if (init_task_start(INIT_TASK_PRIO) != 0) {
+        while (1)
+            ; /**< Error: task creation failed, infinitely wait */
+    }
+
     InterruptEnable();
     vTaskStartScheduler();
 
@@ -252,14 +330,34 @@ int main(void)
 /**
  * @brief Main task executed by FreeRTOS.
  *
- * Initializes timer and outputs example log messages,
- * then delays in a loop.
+ * Starts the LED timer, marks the boot operational (confirming the slot
+ * with FWUP_ENABLE), starts the clock governor, outputs example log
+ * messages, then delays in a loop.
  *
  * @param arg Unused argument pointer.
  */
 void MainThr(__attribute__((unused)) void *arg)
 {
-    TMR32_init(SystemCoreClock >> 4);
+    hrtimer_init(1);
+    hrtimer_setup(&led_timer, LedShift, NULL, 0);
+    hrtimer_start(&led_timer, hrtimer_freq() >> 4, hrtimer_freq() >> 4);
+    init_mark("operational");
+
+#if FWUP_ENABLE
+    /** Got this far: keep this image, a trial boot is over */
+    if (fwup_confirm(&fwup_flash, &fwup_layout, FWUP_SLOT) != FWUP_OK)
+        FERROR("firmware confirm failed");
+#endif
+
+    /** HSE while idle, back to PLL under load */
+    const clk_governor_config_t gov = {
+        .period_ms = CLK_GOV_PERIOD_MS,
+        .up_pct = CLK_GOV_UP_PCT,
+        .down_pct = CLK_GOV_DOWN_PCT,
+        .prio = CLK_GOV_PRIO,
+    };
+    if (clk_governor_start(&gov) != 0)
+        FERROR("clock governor start failed");
 
     FWARNING("\texample::\t%f", 0.123);
     FERROR("\t\texample::\t%f", 0.123);
@@ -272,56 +370,46 @@ void MainThr(__attribute__((unused)) void *arg)
 
 
 /**
- * @brief Timer32 interrupt handler.
+ * @brief LED timer callback (TMR32 interrupt context).
  *
  * Toggles LEDs by shifting the pattern, loops back to first LED.
- * Clears interrupt flag to acknowledge the timer interrupt.
  */
-void TMR32_IRQHandler()
+void LedShift(__attribute__((unused)) hrtimer_t *t, __attribute__((unused)) void *arg)
 {
     GPIOA->DATAOUTTGL = led_shift;
     led_shift = led_shift << 1;
     if (led_shift > LED7_MSK)
         led_shift = LED0_MSK;
-
-    TMR32->IC = 3; /**< Clear timer interrupt flag */
+    led_steps++;
 }
 
 
 /**
- * @brief DMA channel 9 interrupt handler (TX channel).
+ * @brief UART1 echo task.
  *
- * Handles DMA transfer completion for UART1 TX.
- * Disables TX DMA requests, clears buffer, and reinitializes DMA.
- */
-void DMA_CH_9_IRQHandler()
-{
-    if (DMA->IRQSTAT_bit.CH9) {
-        DMA->IRQSTATCLR = DMA_IRQSTATCLR_CH9_Msk; /**< Clear DMA channel 9 interrupt */
-        UART1->DMACR_bit.TXDMAE = 0;               /**< Disable TX DMA */
-        memset(UBUFF, 0, UBUFF_SIZE);               /**< Clear UBUFF buffer */
-        DMA_UART1_init();                           /**< Reinitialize DMA */
-    }
-}
-
-
-/**
- * @brief DMA channel 12 interrupt handler (RX channel).
+ * Waits for UBUFF_SIZE bytes on UART1, outputs them to the log
+ * and sends them back via UART1. The data stays in one pool buffer:
+ * the log and the DMA each hold a reference, no copies.
  *
- * Handles DMA transfer completion for UART1 RX.
- * Disables RX DMA requests, outputs received data via printf,
- * then enables TX DMA requests for echo.
+ * @param arg Unused argument pointer.
  */
-void DMA_CH_12_IRQHandler()
+void EchoThr(__attribute__((unused)) void *arg)
 {
-    uint16_t i;
+    buf_t *b;
+
+    while (1) {
+        b = buf_alloc(UBUFF_SIZE);
+        if (b == NULL) {
+            vTaskDelay(1);
+            continue;
+        }
+        if (uart_read_buf(UART_PORT1, b, UBUFF_SIZE, UART_WAIT_FOREVER) != UBUFF_SIZE) {
+            buf_free(b);
+            continue;
+        }
 
-    if (DMA->IRQSTAT_bit.CH12) {
-        DMA->IRQSTATCLR = DMA_IRQSTATCLR_CH12_Msk; /**< Clear DMA channel 12 interrupt */
-        UART1->DMACR_bit.RXDMAE = 0;               /**< Disable RX DMA */
         FINFO("\nUART1 Echo: ");
-        for (i = 0; i < UBUFF_SIZE; i++)
-            __io_putchar(UBUFF[i]);                /**< Output received data */
-        UART1->DMACR_bit.TXDMAE = 1;               /**< Enable TX DMA to echo data */
+        retarget_write_buf(buf_ref(b));            /**< Output received data */
+        uart_write_buf(UART_PORT1, b, UART_WAIT_FOREVER);
     }
 }
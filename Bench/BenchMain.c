@@ -0,0 +1,93 @@
+/**
+ * @file BenchMain.c
+ * @brief Kernel primitive benchmark firmware for K1921VG015.
+ *
+ * Times the library kernels first ("bench,<lib>,<metric>,<value>"
+ * lines: dma_mem, lzs, dsp), then measures context switches, queues,
+ * notifications, semaphores, mutex priority inheritance and stream
+ * buffers with mcycle and prints a machine readable table on the log
+ * UART (UART0, 115200): one "bench,rtos,<metric>,<value>" line per
+ * figure, then "bench,rtos,done,1". Rerun after every kernel update.
+ *
+ * @copyright 2025 AO "NIIET"
+ */
+
+/** Includes ------------------------------------------------------------------ */
+#include <K1921VG015.h>
+#include <system_k1921vg015.h>
+#include <stdio.h>
+#include "logger.h"
+#include "rtos_bench.h"
+#include "dma_mem.h"
+#include "lzs.h"
+#include "dsp.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "freeRTOS_RiscV_provider.h"
+
+
+/** Defines ------------------------------------------------------------------- */
+/** Bench task priority; helpers run one above and two below it */
+#define BENCH_PRIO (configMAX_PRIORITIES - 3)
+/** Channel of dma_mem_bench(), RTOS_BENCH_DMA_CH is the kernel bench's */
+#define BENCH_DMA_MEM_CH 1
+#define BENCH_LIB_STACK 512
+
+
+/**
+ * @brief Library benchmarks, then the kernel one.
+ *
+ * Runs alone, so nothing else competes for the core or the bus.
+ *
+ * @param arg Unused argument pointer.
+ */
+static void BenchLibThr(__attribute__((unused)) void *arg)
+{
+    if (dma_mem_init(BENCH_DMA_MEM_CH) != DMA_MEM_OK || dma_mem_bench() < 0)
+        printf("bench,dma,error,1\r\n");
+    if (lzs_bench() != 0)
+        printf("bench,lzs,error,1\r\n");
+#ifndef SIM_HOST
+    /** mcycle counts only mean something on the core */
+    dsp_bench();
+#endif
+
+    if (rtos_bench_start(BENCH_PRIO) != 0)
+        printf("bench,rtos,error,1\r\n");
+    vTaskDelete(NULL);
+}
+
+
+/**
+ * @brief Benchmark entry point.
+ *
+ * Brings up the clock and the log UART, starts the bench task
+ * and the scheduler.
+ *
+ * @return Integer status (never returns under normal operation).
+ */
+int main(void)
+{
+    InterruptDisable();
+    freertos_risc_v_provider_init();
+
+    SystemInit();
+    SystemCoreClockUpdate();
+    retarget_init();
+
+    if (xTaskCreate(BenchLibThr, "BenchLib", BENCH_LIB_STACK, NULL,
+                    BENCH_PRIO, NULL) != pdPASS) {
+        while (1)
+            ; /**< Error: bench start failed, infinitely wait */
+    }
+
+    InterruptEnable();
+    vTaskStartScheduler();
+
+    while (1) {
+        ; /**< Infinite loop after scheduler start (should never be reached) */
+    }
+
+    return 0;
+}
@@ -0,0 +1,550 @@
+#include <stdio.h>
+#include "rtos_bench.h"
+#include "dma.h"
+#include "ring.h"
+#include "riscv-csr.h"
+#include "system_k1921vg015.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "stream_buffer.h"
+
+#define RTOS_BENCH_STACK 512
+#define RTOS_BENCH_HELPER_STACK 256
+#define RTOS_BENCH_QUEUE_LEN 4
+#define RTOS_BENCH_SB_SIZE 1024
+/** @brief Bytes moved per stream buffer throughput run */
+#define RTOS_BENCH_SB_BYTES (64 * 1024)
+#define RTOS_BENCH_SB_CHUNK_MAX 256
+
+typedef struct {
+	uint32_t min;
+	uint32_t max;
+	uint32_t n;
+	uint64_t sum;
+} bench_stat_t;
+
+typedef enum {
+	BENCH_ISR_QUEUE = 0,
+	BENCH_ISR_NOTIFY,
+	BENCH_ISR_RING,
+	BENCH_ISR_RING_MPSC,
+} bench_isr_t;
+
+/* Tasks of bench_ctx_switch() that use the FPU */
+#define BENCH_FPU_MAIN 0x01
+#define BENCH_FPU_HELPER 0x02
+
+static struct {
+	TaskHandle_t main;
+	TaskHandle_t helper;
+	QueueHandle_t q;
+	SemaphoreHandle_t sem;
+	SemaphoreHandle_t mtx;
+	StreamBufferHandle_t sb;
+	ring_spsc_t ring;
+	ring_mpsc_t mpsc;
+	void *ring_slots[RTOS_BENCH_QUEUE_LEN];
+	ring_cell_t mpsc_cells[RTOS_BENCH_QUEUE_LEN];
+	bench_stat_t a;
+	bench_stat_t b;
+	bench_stat_t c;
+	volatile uint32_t t0;
+	volatile uint32_t t1;
+	volatile uint32_t done;
+	volatile uint32_t sb_chunk;
+	volatile uint32_t isr_send;
+	volatile UBaseType_t inherited;
+	volatile float f;
+	volatile uint8_t fpu;
+	volatile uint8_t isr_mode;
+	uint8_t prio;
+	uint32_t dma_src;
+	uint32_t dma_dst;
+} rb;
+
+static inline uint32_t bench_now(void)
+{
+	return csr_read_mcycle();
+}
+
+static void stat_reset(bench_stat_t *s)
+{
+	s->min = UINT32_MAX;
+	s->max = 0;
+	s->n = 0;
+	s->sum = 0;
+}
+
+static void stat_add(bench_stat_t *s, uint32_t v)
+{
+	if (v < s->min)
+		s->min = v;
+	if (v > s->max)
+		s->max = v;
+	s->sum += v;
+	s->n++;
+}
+
+static void bench_print(const char *name, uint32_t v)
+{
+	printf("bench,rtos,%s,%lu\r\n", name, (unsigned long)v);
+}
+
+static void stat_print(const char *name, const bench_stat_t *s)
+{
+	printf("bench,rtos,%s_min,%lu\r\n", name, (unsigned long)s->min);
+	printf("bench,rtos,%s_avg,%lu\r\n", name,
+	       (unsigned long)(s->n ? s->sum / s->n : 0));
+	printf("bench,rtos,%s_max,%lu\r\n", name, (unsigned long)s->max);
+}
+
+static void bench_helper_start(TaskFunction_t fn, UBaseType_t prio)
+{
+	stat_reset(&rb.a);
+	stat_reset(&rb.b);
+	stat_reset(&rb.c);
+	rb.done = 0;
+	if (xTaskCreate(fn, "bench_h", RTOS_BENCH_HELPER_STACK, NULL, prio,
+			&rb.helper) != pdPASS) {
+		while (1)
+			; /**< Error: task creation failed, infinitely wait */
+	}
+}
+
+static void bench_helper_stop(void)
+{
+	vTaskDelete(rb.helper);
+	rb.helper = NULL;
+}
+
+/* Calls without a context switch ------------------------------------------- */
+
+static void bench_ops(void)
+{
+	uint32_t t0, t1, v = 0;
+	bench_stat_t s1, s2;
+
+	stat_reset(&rb.a);
+	for (uint32_t i = 0; i < RTOS_BENCH_ITER; i++) {
+		t0 = bench_now();
+		t1 = bench_now();
+		stat_add(&rb.a, t1 - t0);
+	}
+	stat_print("mcycle_read", &rb.a);
+
+	/* No other ready task at this priority: returns at once */
+	stat_reset(&rb.a);
+	for (uint32_t i = 0; i < RTOS_BENCH_ITER; i++) {
+		t0 = bench_now();
+		taskYIELD();
+		stat_add(&rb.a, bench_now() - t0);
+	}
+	stat_print("yield_noswitch", &rb.a);
+
+	stat_reset(&s1);
+	stat_reset(&s2);
+	for (uint32_t i = 0; i < RTOS_BENCH_ITER; i++) {
+		t0 = bench_now();
+		xQueueSend(rb.q, &v, 0);
+		t1 = bench_now();
+		xQueueReceive(rb.q, &v, 0);
+		stat_add(&s1, t1 - t0);
+		stat_add(&s2, bench_now() - t1);
+	}
+	stat_print("queue_send", &s1);
+	stat_print("queue_recv", &s2);
+
+	stat_reset(&s1);
+	stat_reset(&s2);
+	for (uint32_t i = 0; i < RTOS_BENCH_ITER; i++) {
+		t0 = bench_now();
+		xSemaphoreGive(rb.sem);
+		t1 = bench_now();
+		xSemaphoreTake(rb.sem, 0);
+		stat_add(&s1, t1 - t0);
+		stat_add(&s2, bench_now() - t1);
+	}
+	stat_print("sem_give", &s1);
+	stat_print("sem_take", &s2);
+
+	stat_reset(&s1);
+	stat_reset(&s2);
+	for (uint32_t i = 0; i < RTOS_BENCH_ITER; i++) {
+		t0 = bench_now();
+		xSemaphoreTake(rb.mtx, 0);
+		t1 = bench_now();
+		xSemaphoreGive(rb.mtx);
+		stat_add(&s1, t1 - t0);
+		stat_add(&s2, bench_now() - t1);
+	}
+	stat_print("mutex_take", &s1);
+	stat_print("mutex_give", &s2);
+
+	stat_reset(&s1);
+	stat_reset(&s2);
+	for (uint32_t i = 0; i < RTOS_BENCH_ITER; i++) {
+		t0 = bench_now();
+		xTaskNotifyGive(rb.main);
+		t1 = bench_now();
+		ulTaskNotifyTake(pdTRUE, 0);
+		stat_add(&s1, t1 - t0);
+		stat_add(&s2, bench_now() - t1);
+	}
+	stat_print("notify_give", &s1);
+	stat_print("notify_take", &s2);
+
+	stat_reset(&s1);
+	stat_reset(&s2);
+	for (uint32_t i = 0; i < RTOS_BENCH_ITER; i++) {
+		void *item;
+
+		t0 = bench_now();
+		ring_spsc_push(&rb.ring, &v, NULL);
+		t1 = bench_now();
+		ring_spsc_pop(&rb.ring, &item);
+		stat_add(&s1, t1 - t0);
+		stat_add(&s2, bench_now() - t1);
+	}
+	stat_print("ring_push", &s1);
+	stat_print("ring_pop", &s2);
+
+	stat_reset(&s1);
+	stat_reset(&s2);
+	for (uint32_t i = 0; i < RTOS_BENCH_ITER; i++) {
+		void *item;
+
+		t0 = bench_now();
+		ring_mpsc_push(&rb.mpsc, &v, NULL);
+		t1 = bench_now();
+		ring_mpsc_pop(&rb.mpsc, &item);
+		stat_add(&s1, t1 - t0);
+		stat_add(&s2, bench_now() - t1);
+	}
+	stat_print("mpsc_push", &s1);
+	stat_print("mpsc_pop", &s2);
+}
+
+/* Context switch ----------------------------------------------------------- */
+
+static void helper_yield(__attribute__((unused)) void *arg)
+{
+	while (1) {
+		if (rb.fpu & BENCH_FPU_HELPER)
+			rb.f *= 1.0001f;
+		rb.t0 = bench_now();
+		taskYIELD();
+	}
+}
+
+/**
+ * @brief Two tasks of equal priority yielding to each other.
+ * @param fpu Tasks touching the FPU: their registers are switched too
+ *
+ * The FPU context is switched lazily, so the bench task must not
+ * touch the FPU before the cases that leave it out: once dirty its
+ * registers are saved on every switch away.
+ */
+static void bench_ctx_switch(uint8_t fpu, const char *name)
+{
+	rb.fpu = fpu;
+	bench_helper_start(helper_yield, rb.prio);
+	taskYIELD();
+	for (uint32_t i = 0; i < RTOS_BENCH_ITER; i++) {
+		if (fpu & BENCH_FPU_MAIN)
+			rb.f *= 1.0001f;
+		taskYIELD();
+		stat_add(&rb.a, bench_now() - rb.t0);
+	}
+	bench_helper_stop();
+	stat_print(name, &rb.a);
+}
+
+/* Task to task wake-up ----------------------------------------------------- */
+
+static void helper_notify(__attribute__((unused)) void *arg)
+{
+	while (1) {
+		ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+		stat_add(&rb.a, bench_now() - rb.t0);
+	}
+}
+
+static void helper_queue(__attribute__((unused)) void *arg)
+{
+	uint32_t t;
+
+	while (1) {
+		xQueueReceive(rb.q, &t, portMAX_DELAY);
+		stat_add(&rb.a, bench_now() - t);
+	}
+}
+
+static void helper_sem(__attribute__((unused)) void *arg)
+{
+	while (1) {
+		xSemaphoreTake(rb.sem, portMAX_DELAY);
+		stat_add(&rb.a, bench_now() - rb.t0);
+	}
+}
+
+/** @brief Signal a blocked higher priority task, time until it runs */
+static void bench_wake(void)
+{
+	uint32_t t;
+
+	bench_helper_start(helper_notify, rb.prio + 1);
+	for (uint32_t i = 0; i < RTOS_BENCH_ITER; i++) {
+		rb.t0 = bench_now();
+		xTaskNotifyGive(rb.helper);
+	}
+	bench_helper_stop();
+	stat_print("notify_wake", &rb.a);
+
+	bench_helper_start(helper_queue, rb.prio + 1);
+	for (uint32_t i = 0; i < RTOS_BENCH_ITER; i++) {
+		t = bench_now();
+		xQueueSend(rb.q, &t, portMAX_DELAY);
+	}
+	bench_helper_stop();
+	stat_print("queue_wake", &rb.a);
+
+	bench_helper_start(helper_sem, rb.prio + 1);
+	for (uint32_t i = 0; i < RTOS_BENCH_ITER; i++) {
+		rb.t0 = bench_now();
+		xSemaphoreGive(rb.sem);
+	}
+	bench_helper_stop();
+	stat_print("sem_wake", &rb.a);
+}
+
+/* Interrupt to task -------------------------------------------------------- */
+
+static void bench_dma_done(__attribute__((unused)) uint32_t ch,
+			   __attribute__((unused)) void *arg)
+{
+	BaseType_t woken = pdFALSE;
+	uint32_t t = bench_now();
+
+	switch (rb.isr_mode) {
+	case BENCH_ISR_QUEUE:
+		xQueueSendFromISR(rb.q, &t, &woken);
+		break;
+	case BENCH_ISR_NOTIFY:
+		rb.t1 = t;
+		vTaskNotifyGiveFromISR(rb.helper, &woken);
+		break;
+	case BENCH_ISR_RING:
+		ring_spsc_push(&rb.ring, (void *)(uintptr_t)t, &woken);
+		break;
+	default:
+		ring_mpsc_push(&rb.mpsc, (void *)(uintptr_t)t, &woken);
+		break;
+	}
+	/* Handler side cost of the handoff, read by the helper later */
+	rb.isr_send = bench_now() - t;
+	portYIELD_FROM_ISR(woken);
+}
+
+static void helper_isr(__attribute__((unused)) void *arg)
+{
+	uint32_t t;
+	void *item;
+
+	while (1) {
+		switch (rb.isr_mode) {
+		case BENCH_ISR_QUEUE:
+			xQueueReceive(rb.q, &t, portMAX_DELAY);
+			break;
+		case BENCH_ISR_NOTIFY:
+			ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+			t = rb.t1;
+			break;
+		case BENCH_ISR_RING:
+			ring_spsc_receive(&rb.ring, &item, portMAX_DELAY);
+			t = (uint32_t)(uintptr_t)item;
+			break;
+		default:
+			ring_mpsc_receive(&rb.mpsc, &item, portMAX_DELAY);
+			t = (uint32_t)(uintptr_t)item;
+			break;
+		}
+		stat_add(&rb.c, rb.isr_send);
+		stat_add(&rb.a, t - rb.t0);
+		stat_add(&rb.b, bench_now() - t);
+		rb.done++;
+	}
+}
+
+/**
+ * @brief Software triggered DMA completion interrupt wakes a task.
+ *
+ * a: request to handler entry (interrupt latency and dispatch),
+ * b: handler entry to the woken task running,
+ * c: the handoff call in the handler.
+ */
+static void bench_isr(bench_isr_t mode, const char *name)
+{
+	char metric[32];
+
+	rb.isr_mode = mode;
+	bench_helper_start(helper_isr, rb.prio + 1);
+	dma_init();
+	dma_set_handler(RTOS_BENCH_DMA_CH, bench_dma_done, NULL);
+
+	for (uint32_t i = 0; i < RTOS_BENCH_ITER; i++) {
+		dma_ch_setup(RTOS_BENCH_DMA_CH, &rb.dma_src, &rb.dma_dst, 1,
+			     DMA_XFER_WORD | DMA_XFER_AUTOREQ);
+		dma_ch_enable(RTOS_BENCH_DMA_CH);
+		rb.t0 = bench_now();
+		dma_ch_request(RTOS_BENCH_DMA_CH);
+		while (rb.done != i + 1)
+			;
+	}
+
+	dma_set_handler(RTOS_BENCH_DMA_CH, NULL, NULL);
+	bench_helper_stop();
+	/* The helper was deleted while waiting, drop its handle */
+	rb.ring.waiter = NULL;
+	rb.mpsc.waiter = NULL;
+	if (mode == BENCH_ISR_QUEUE)
+		stat_print("isr_entry", &rb.a);
+	snprintf(metric, sizeof(metric), "isr_%s_send", name);
+	stat_print(metric, &rb.c);
+	snprintf(metric, sizeof(metric), "isr_%s_wake", name);
+	stat_print(metric, &rb.b);
+}
+
+/* Mutex contention --------------------------------------------------------- */
+
+static void helper_mutex(__attribute__((unused)) void *arg)
+{
+	while (1) {
+		ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+		xSemaphoreTake(rb.mtx, portMAX_DELAY);
+		/* The bench task preempts here and blocks on the mutex */
+		xTaskNotifyGive(rb.main);
+		rb.inherited = uxTaskPriorityGet(NULL);
+		rb.t1 = bench_now();
+		xSemaphoreGive(rb.mtx);
+	}
+}
+
+/**
+ * @brief High priority task blocks on a mutex held by a low one.
+ *
+ * mutex_block: take call to the holder running with the inherited
+ * priority; mutex_handoff: give call to the waiter owning it.
+ */
+static void bench_mutex(void)
+{
+	uint32_t t0;
+
+	bench_helper_start(helper_mutex, rb.prio - 2);
+	for (uint32_t i = 0; i < RTOS_BENCH_ITER; i++) {
+		xTaskNotifyGive(rb.helper);
+		ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+		t0 = bench_now();
+		xSemaphoreTake(rb.mtx, portMAX_DELAY);
+		stat_add(&rb.a, rb.t1 - t0);
+		stat_add(&rb.b, bench_now() - rb.t1);
+		xSemaphoreGive(rb.mtx);
+	}
+	bench_helper_stop();
+	stat_print("mutex_block", &rb.a);
+	stat_print("mutex_handoff", &rb.b);
+	bench_print("mutex_inherit_ok", rb.inherited == rb.prio);
+}
+
+/* Stream buffer throughput ------------------------------------------------- */
+
+static void helper_sb(__attribute__((unused)) void *arg)
+{
+	static uint8_t chunk[RTOS_BENCH_SB_CHUNK_MAX];
+
+	while (1) {
+		uint32_t left = RTOS_BENCH_SB_BYTES;
+
+		ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+		while (left) {
+			uint32_t n = left < rb.sb_chunk ? left : rb.sb_chunk;
+
+			xStreamBufferSend(rb.sb, chunk, n, portMAX_DELAY);
+			left -= n;
+		}
+	}
+}
+
+/** @brief Lower priority producer, consumer woken on every chunk */
+static void bench_sb(void)
+{
+	static const uint16_t chunks[] = { 1, 16, 64, RTOS_BENCH_SB_CHUNK_MAX };
+	static uint8_t buf[RTOS_BENCH_SB_CHUNK_MAX];
+	char name[24];
+
+	bench_helper_start(helper_sb, rb.prio - 1);
+	for (uint32_t c = 0; c < sizeof(chunks) / sizeof(chunks[0]); c++) {
+		uint32_t got = 0, t0, cycles;
+
+		xStreamBufferReset(rb.sb);
+		rb.sb_chunk = chunks[c];
+		t0 = bench_now();
+		xTaskNotifyGive(rb.helper);
+		while (got < RTOS_BENCH_SB_BYTES)
+			got += xStreamBufferReceive(rb.sb, buf, sizeof(buf),
+						    portMAX_DELAY);
+		cycles = bench_now() - t0;
+
+		snprintf(name, sizeof(name), "sbuf_%u_Bps",
+			 (unsigned int)chunks[c]);
+		bench_print(name, (uint32_t)((uint64_t)RTOS_BENCH_SB_BYTES *
+					     SystemCoreClock / cycles));
+	}
+	bench_helper_stop();
+}
+
+static void rtos_bench_task(__attribute__((unused)) void *arg)
+{
+	printf("bench,rtos,kernel,%s\r\n", tskKERNEL_VERSION_NUMBER);
+	bench_print("cpu_hz", SystemCoreClock);
+	bench_print("port_optimised_task_selection",
+		    configUSE_PORT_OPTIMISED_TASK_SELECTION);
+	bench_print("fpu", configENABLE_FPU);
+
+	bench_ops();
+	bench_ctx_switch(0, "ctx_switch");
+	bench_ctx_switch(BENCH_FPU_HELPER, "ctx_switch_fpu_one");
+	bench_ctx_switch(BENCH_FPU_MAIN | BENCH_FPU_HELPER, "ctx_switch_fpu");
+	bench_wake();
+	bench_isr(BENCH_ISR_QUEUE, "queue");
+	bench_isr(BENCH_ISR_NOTIFY, "notify");
+	bench_isr(BENCH_ISR_RING, "ring");
+	bench_isr(BENCH_ISR_RING_MPSC, "mpsc");
+	bench_mutex();
+	bench_sb();
+
+	bench_print("done", 1);
+	vTaskDelete(NULL);
+}
+
+int rtos_bench_start(uint8_t prio)
+{
+	if (prio < 2 || prio + 1 >= configMAX_PRIORITIES)
+		return -1;
+
+	rb.prio = prio;
+	rb.q = xQueueCreate(RTOS_BENCH_QUEUE_LEN, sizeof(uint32_t));
+	rb.sem = xSemaphoreCreateBinary();
+	rb.mtx = xSemaphoreCreateMutex();
+	rb.sb = xStreamBufferCreate(RTOS_BENCH_SB_SIZE, 1);
+	ring_spsc_init(&rb.ring, rb.ring_slots, RTOS_BENCH_QUEUE_LEN);
+	ring_mpsc_init(&rb.mpsc, rb.mpsc_cells, RTOS_BENCH_QUEUE_LEN);
+	if (!rb.q || !rb.sem || !rb.mtx || !rb.sb)
+		return -1;
+
+	if (xTaskCreate(rtos_bench_task, "bench", RTOS_BENCH_STACK, NULL, prio,
+			&rb.main) != pdPASS)
+		return -1;
+	return 0;
+}
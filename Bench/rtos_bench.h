@@ -0,0 +1,37 @@
+#ifndef __rtos_bench_h__
+#define __rtos_bench_h__
+
+#include <stdint.h>
+
+/*! CPP guard */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Samples per measurement */
+#define RTOS_BENCH_ITER 1000
+
+/** @brief DMA channel used as a software triggered interrupt source */
+#ifndef RTOS_BENCH_DMA_CH
+#define RTOS_BENCH_DMA_CH 0
+#endif
+
+/**
+ * @brief Measure the kernel primitives and print the results.
+ * @param prio Priority of the bench task; helpers run at prio - 2..prio + 1
+ * @return 0 if the bench task was created
+ *
+ * Every figure is a count of mcycle ticks, printed as
+ * "bench,rtos,<metric>_{min,avg,max},<cycles>"; stream buffer
+ * throughput as "bench,rtos,sbuf_<chunk>_Bps,<bytes per second>".
+ * Interrupt handoff is compared across queue, notification and the
+ * Lib/ring SPSC/MPSC rings as isr_<kind>_send and isr_<kind>_wake.
+ * The run ends with "bench,rtos,done,1".
+ */
+int rtos_bench_start(uint8_t prio);
+
+#ifdef __cplusplus
+}
+#endif /* End of CPP guard */
+
+#endif //__rtos_bench_h__
@@ -0,0 +1,46 @@
+/**
+ * @file BootMain.c
+ * @brief Boot image of the A/B firmware update for K1921VG015.
+ *
+ * Sits in the first 16 KiB of the internal flash, picks the
+ * application slot from the boot record log (see Lib/fwup) and
+ * jumps to its start. Runs on the reset clock with interrupts off
+ * and no kernel; the application's startup sets everything up again.
+ *
+ * @copyright 2025 AO "NIIET"
+ */
+
+/** Includes ------------------------------------------------------------------ */
+#include <K1921VG015.h>
+#include "flash_dev.h"
+#include "fwup_boot.h"
+
+
+/**
+ * @brief Boot entry point.
+ *
+ * Marks a freshly written slot as on trial or falls back from one
+ * that never confirmed, then starts the chosen slot.
+ *
+ * @return Never returns.
+ */
+int main(void)
+{
+    static const fwup_layout_t lay = FWUP_LAYOUT_DEFAULT;
+    flash_dev_t dev;
+    fwup_slot_t slot;
+    void (*entry)(void);
+
+    flash_int_init(&dev);
+    slot = fwup_boot_select(&dev, &lay);
+
+    /** _start is the first word of every slot image */
+    entry = (void (*)(void))(uintptr_t)(dev.mmap + lay.slot[slot]);
+    entry();
+
+    while (1) {
+        ; /**< Infinite loop (should never be reached) */
+    }
+
+    return 0;
+}
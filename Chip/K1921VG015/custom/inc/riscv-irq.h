@@ -0,0 +1,48 @@
+#ifndef __custom_riscv_irq_h__
+#define __custom_riscv_irq_h__
+
+/*
+ * SDK interrupt header plus the mstatus.MIE save/restore pair the
+ * libraries lock with. The host simulation has no vector table and
+ * only takes the pair, on top of its riscv-csr.h stand-in.
+ */
+
+#ifndef SIM_HOST
+#include_next <riscv-irq.h>
+#endif
+#include <stdint.h>
+#include "riscv-csr.h"
+
+/*! CPP guard */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Mask machine interrupts.
+ * @return Previous mstatus.MIE, for irq_restore()
+ *
+ * Nests: only the outermost irq_restore() unmasks. Lasts a few
+ * instructions and must not call FreeRTOS, whose critical section
+ * exit would unmask early.
+ */
+static inline uint32_t irq_save(void)
+{
+	uint32_t mie = csr_read_mstatus() & MSTATUS_MIE_BIT_MASK;
+
+	csr_clr_bits_mstatus(MSTATUS_MIE_BIT_MASK);
+	return mie;
+}
+
+/** @brief Unmask machine interrupts if irq_save() found them enabled */
+static inline void irq_restore(uint32_t mie)
+{
+	if (mie)
+		csr_set_bits_mstatus(MSTATUS_MIE_BIT_MASK);
+}
+
+#ifdef __cplusplus
+}
+#endif /* End of CPP guard */
+
+#endif //__custom_riscv_irq_h__
@@ -0,0 +1,60 @@
+#ifndef __host_K1921VG015_h__
+#define __host_K1921VG015_h__
+
+/*
+ * Device header of the SDK with the peripheral instances moved to
+ * host memory. Plain blocks keep what drivers write; TMR32, DMA
+ * and QSPI go through their models, which apply the previous access's
+ * writes and advance time on every access.
+ */
+
+#include_next <K1921VG015.h>
+#include "sim.h"
+
+/*! CPP guard */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern RCU_TypeDef sim_rcu;
+extern PMUSYS_TypeDef sim_pmusys;
+extern GPIO_TypeDef sim_gpio[3];
+extern UART_TypeDef sim_uart[5];
+
+TMR32_TypeDef *sim_tmr32(void);
+DMA_TypeDef *sim_dma(void);
+QSPI_TypeDef *sim_qspi(void);
+
+#undef RCU
+#undef PMUSYS
+#undef GPIOA
+#undef GPIOB
+#undef GPIOC
+#undef UART0
+#undef UART1
+#undef UART2
+#undef UART3
+#undef UART4
+#undef TMR32
+#undef DMA
+#undef QSPI
+
+#define RCU (&sim_rcu)
+#define PMUSYS (&sim_pmusys)
+#define GPIOA (&sim_gpio[0])
+#define GPIOB (&sim_gpio[1])
+#define GPIOC (&sim_gpio[2])
+#define UART0 (&sim_uart[0])
+#define UART1 (&sim_uart[1])
+#define UART2 (&sim_uart[2])
+#define UART3 (&sim_uart[3])
+#define UART4 (&sim_uart[4])
+#define TMR32 (sim_tmr32())
+#define DMA (sim_dma())
+#define QSPI (sim_qspi())
+
+#ifdef __cplusplus
+}
+#endif /* End of CPP guard */
+
+#endif //__host_K1921VG015_h__
@@ -0,0 +1,28 @@
+#ifndef __mtimer_h__
+#define __mtimer_h__
+
+/*
+ * Host stand-in: the POSIX port keeps its own tick, mtime is a
+ * variable advanced by the simulation core.
+ */
+
+#include <stdint.h>
+
+/*! CPP guard */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MTIME_FREQ_HZ 1000000UL
+
+extern volatile uint64_t sim_mtime;
+extern volatile uint64_t sim_mtimecmp;
+
+#define RISCV_MTIME_ADDR ((uintptr_t)&sim_mtime)
+#define RISCV_MTIMECMP_ADDR ((uintptr_t)&sim_mtimecmp)
+
+#ifdef __cplusplus
+}
+#endif /* End of CPP guard */
+
+#endif //__mtimer_h__
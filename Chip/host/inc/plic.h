@@ -0,0 +1,28 @@
+#ifndef __plic_h__
+#define __plic_h__
+
+/* Host PLIC model, same calls as the SDK driver */
+
+#include <stdint.h>
+#include "K1921VG015.h"
+
+/*! CPP guard */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+	Plic_Mach_Target = 0,
+} Plic_TargetTypeDef;
+
+void PLIC_SetIrqHandler(Plic_TargetTypeDef target, IsrVect_TypeDef irq,
+			void (*handler)(void));
+void PLIC_SetPriority(IsrVect_TypeDef irq, uint32_t prio);
+void PLIC_IntEnable(Plic_TargetTypeDef target, IsrVect_TypeDef irq);
+void PLIC_IntDisable(Plic_TargetTypeDef target, IsrVect_TypeDef irq);
+
+#ifdef __cplusplus
+}
+#endif /* End of CPP guard */
+
+#endif //__plic_h__
@@ -0,0 +1,67 @@
+#ifndef __riscv_csr_h__
+#define __riscv_csr_h__
+
+/*
+ * Host stand-in for the SDK CSR accessors: mstatus.MIE maps to the
+ * kernel critical section, mcycle/minstret to the host clock.
+ */
+
+#include <stdint.h>
+#include "sim.h"
+
+/*! CPP guard */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MSTATUS_MIE_BIT_MASK 0x8UL
+
+static inline uint32_t csr_read_mstatus(void)
+{
+	return sim_mstatus;
+}
+
+static inline void csr_clr_bits_mstatus(uint32_t mask)
+{
+	if (mask & sim_mstatus & MSTATUS_MIE_BIT_MASK)
+		sim_mie_clear();
+}
+
+static inline void csr_set_bits_mstatus(uint32_t mask)
+{
+	if ((mask & MSTATUS_MIE_BIT_MASK) &&
+	    !(sim_mstatus & MSTATUS_MIE_BIT_MASK))
+		sim_mie_set();
+}
+
+static inline uint32_t csr_read_mcycle(void)
+{
+	return (uint32_t)sim_cycles();
+}
+
+static inline uint32_t csr_read_mcycleh(void)
+{
+	return (uint32_t)(sim_cycles() >> 32);
+}
+
+/** @brief No instruction counter on the host: one per cycle */
+static inline uint32_t csr_read_minstret(void)
+{
+	return csr_read_mcycle();
+}
+
+static inline uint32_t csr_read_minstreth(void)
+{
+	return csr_read_mcycleh();
+}
+
+static inline uint32_t csr_read_mcause(void)
+{
+	return sim_mcause;
+}
+
+#ifdef __cplusplus
+}
+#endif /* End of CPP guard */
+
+#endif //__riscv_csr_h__
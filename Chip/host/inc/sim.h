@@ -0,0 +1,80 @@
+#ifndef __sim_h__
+#define __sim_h__
+
+#include <stdint.h>
+
+/*! CPP guard */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Host simulation core.
+ *
+ * Peripheral models run from the "sim" task, the highest priority
+ * task of the system, once per tick or when an interrupt is raised
+ * from a task. Interrupt handlers installed with PLIC_SetIrqHandler()
+ * run in the same task with the simulated MIE cleared, so FromISR
+ * APIs and portYIELD_FROM_ISR() behave as on the target. Timing is
+ * functional: model latency is up to one tick.
+ */
+
+/** @brief Core clock of the simulation, mcycle and TMR32 rate */
+#define SIM_CPU_HZ 50000000UL
+/** @brief Interrupt sources of the PLIC model */
+#define SIM_IRQ_COUNT 64
+
+/** @brief Peripheral model step, runs in interrupt context */
+typedef void (*sim_model_t)(void);
+
+/** @brief Core cycles since start (host monotonic clock) */
+uint64_t sim_cycles(void);
+
+/** @brief Mark an interrupt source pending; any context */
+void sim_irq_raise(uint32_t irq);
+
+/** @brief Run the models soon, e.g. after a register write; any context */
+void sim_wake(void);
+
+/** @brief Register a model step; any task context */
+void sim_model_add(sim_model_t step);
+
+/** @brief Inside a simulated interrupt handler */
+int sim_in_isr(void);
+
+/** @brief Simulated mstatus, only MIE is modelled */
+extern volatile uint32_t sim_mstatus;
+/** @brief Interrupt source being handled, reported as mcause */
+extern volatile uint32_t sim_mcause;
+
+/** @brief Clear/set MIE: enter/leave a kernel critical section */
+void sim_mie_clear(void);
+void sim_mie_set(void);
+
+/**
+ * @brief Drive a TMR32 capture input with a pulse train.
+ * @param capcom CAPCOM channel
+ * @param dma_ch DMA channel its request is wired to
+ * @param period Pulse period in core cycles
+ * @param high High time in core cycles
+ * @param count Edges to generate, both polarities counted
+ *
+ * The input is low until the first rising edge, one period from now.
+ */
+void sim_tmr32_pulses(uint32_t capcom, uint32_t dma_ch, uint32_t period,
+		      uint32_t high, uint32_t count);
+
+/** @brief configASSERT() of the host build */
+void sim_assert_failed(const char *file, int line);
+
+/** @brief Interrupt enable/disable macros of the SDK */
+#undef InterruptEnable
+#undef InterruptDisable
+#define InterruptEnable() sim_mie_set()
+#define InterruptDisable() sim_mie_clear()
+
+#ifdef __cplusplus
+}
+#endif /* End of CPP guard */
+
+#endif //__sim_h__
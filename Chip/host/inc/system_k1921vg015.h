@@ -0,0 +1,21 @@
+#ifndef __host_system_k1921vg015_h__
+#define __host_system_k1921vg015_h__
+
+/*
+ * SDK system header; SystemInit() and the clock variables are
+ * provided by the simulation core. Interrupt enable macros of the
+ * SDK are replaced by the simulated MIE.
+ */
+
+/* sim.h may already be in: let the SDK define its versions first */
+#undef InterruptEnable
+#undef InterruptDisable
+#include_next <system_k1921vg015.h>
+#include "sim.h"
+
+#undef InterruptEnable
+#undef InterruptDisable
+#define InterruptEnable() sim_mie_set()
+#define InterruptDisable() sim_mie_clear()
+
+#endif //__host_system_k1921vg015_h__
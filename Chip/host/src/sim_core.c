@@ -0,0 +1,195 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "K1921VG015.h"
+#include "system_k1921vg015.h"
+#include "plic.h"
+#include "mtimer.h"
+#include "riscv-csr.h"
+
+/* Older kernels have no interrupt trace hooks */
+#ifndef traceISR_ENTER
+#define traceISR_ENTER()
+#endif
+#ifndef traceISR_EXIT
+#define traceISR_EXIT()
+#endif
+
+#define SIM_MODELS_MAX 16
+/** @brief Handlers run per pass at most, stops interrupt storms */
+#define SIM_DISPATCH_MAX 64
+
+uint32_t SystemCoreClock = SIM_CPU_HZ;
+
+volatile uint32_t sim_mstatus = MSTATUS_MIE_BIT_MASK;
+volatile uint32_t sim_mcause;
+volatile uint64_t sim_mtime;
+volatile uint64_t sim_mtimecmp;
+
+static struct {
+	void (*handler[SIM_IRQ_COUNT])(void);
+	uint8_t prio[SIM_IRQ_COUNT];
+	uint64_t enabled;
+	uint64_t pending; /**< set from any thread, atomics only */
+} sim_plic;
+
+static sim_model_t sim_models[SIM_MODELS_MAX];
+static uint32_t sim_nmodels;
+static TaskHandle_t sim_task_handle;
+static volatile uint8_t sim_isr;
+static struct timespec sim_t0;
+
+__attribute__((constructor)) static void sim_clock_init(void)
+{
+	clock_gettime(CLOCK_MONOTONIC, &sim_t0);
+}
+
+uint64_t sim_cycles(void)
+{
+	struct timespec t;
+	uint64_t ns;
+
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	ns = (uint64_t)(t.tv_sec - sim_t0.tv_sec) * 1000000000ULL +
+	     (uint64_t)t.tv_nsec - (uint64_t)sim_t0.tv_nsec;
+	return ns * (SIM_CPU_HZ / 1000000) / 1000;
+}
+
+int sim_in_isr(void)
+{
+	return sim_isr;
+}
+
+void sim_mie_clear(void)
+{
+	portENTER_CRITICAL();
+	sim_mstatus &= ~MSTATUS_MIE_BIT_MASK;
+}
+
+void sim_mie_set(void)
+{
+	sim_mstatus |= MSTATUS_MIE_BIT_MASK;
+	portEXIT_CRITICAL();
+}
+
+void sim_assert_failed(const char *file, int line)
+{
+	fprintf(stderr, "assert: %s:%d\n", file, line);
+	abort();
+}
+
+void sim_irq_raise(uint32_t irq)
+{
+	if (irq >= SIM_IRQ_COUNT)
+		return;
+	__atomic_fetch_or(&sim_plic.pending, 1ULL << irq, __ATOMIC_SEQ_CST);
+	sim_wake();
+}
+
+void sim_wake(void)
+{
+	/* Run the models now unless in a handler or a masked section */
+	if (sim_task_handle && !sim_isr &&
+	    (sim_mstatus & MSTATUS_MIE_BIT_MASK) &&
+	    xTaskGetSchedulerState() == taskSCHEDULER_RUNNING)
+		xTaskNotifyGive(sim_task_handle);
+}
+
+void PLIC_SetIrqHandler(__attribute__((unused)) Plic_TargetTypeDef target,
+			IsrVect_TypeDef irq, void (*handler)(void))
+{
+	if ((uint32_t)irq < SIM_IRQ_COUNT)
+		sim_plic.handler[irq] = handler;
+}
+
+void PLIC_SetPriority(IsrVect_TypeDef irq, uint32_t prio)
+{
+	if ((uint32_t)irq < SIM_IRQ_COUNT)
+		sim_plic.prio[irq] = prio;
+}
+
+void PLIC_IntEnable(__attribute__((unused)) Plic_TargetTypeDef target,
+		    IsrVect_TypeDef irq)
+{
+	if ((uint32_t)irq < SIM_IRQ_COUNT)
+		sim_plic.enabled |= 1ULL << irq;
+}
+
+void PLIC_IntDisable(__attribute__((unused)) Plic_TargetTypeDef target,
+		     IsrVect_TypeDef irq)
+{
+	if ((uint32_t)irq < SIM_IRQ_COUNT)
+		sim_plic.enabled &= ~(1ULL << irq);
+}
+
+/** @brief Run pending enabled handlers, highest priority first */
+static void sim_dispatch(void)
+{
+	for (uint32_t n = 0; n < SIM_DISPATCH_MAX; n++) {
+		uint64_t act = __atomic_load_n(&sim_plic.pending,
+					       __ATOMIC_SEQ_CST) &
+			       sim_plic.enabled;
+		uint32_t best = SIM_IRQ_COUNT;
+
+		if (!act)
+			return;
+		for (uint32_t i = 0; i < SIM_IRQ_COUNT; i++)
+			if ((act & (1ULL << i)) && sim_plic.handler[i] &&
+			    (best == SIM_IRQ_COUNT ||
+			     sim_plic.prio[i] > sim_plic.prio[best]))
+				best = i;
+		if (best == SIM_IRQ_COUNT)
+			return;
+
+		__atomic_fetch_and(&sim_plic.pending, ~(1ULL << best),
+				   __ATOMIC_SEQ_CST);
+		sim_mcause = best;
+		traceISR_ENTER();
+		sim_plic.handler[best]();
+		traceISR_EXIT();
+	}
+}
+
+static void sim_task(__attribute__((unused)) void *arg)
+{
+	while (1) {
+		ulTaskNotifyTake(pdTRUE, 1);
+
+		sim_mie_clear();
+		sim_isr = 1;
+		sim_mtime = sim_cycles() / (SIM_CPU_HZ / MTIME_FREQ_HZ);
+		for (uint32_t i = 0; i < sim_nmodels; i++)
+			sim_models[i]();
+		sim_dispatch();
+		sim_isr = 0;
+		sim_mie_set();
+	}
+}
+
+static void sim_start(void)
+{
+	if (sim_task_handle)
+		return;
+	if (xTaskCreate(sim_task, "sim", configMINIMAL_STACK_SIZE * 4, NULL,
+			configMAX_PRIORITIES - 1, &sim_task_handle) != pdPASS)
+		sim_assert_failed(__FILE__, __LINE__);
+}
+
+void sim_model_add(sim_model_t step)
+{
+	sim_start();
+	if (sim_nmodels < SIM_MODELS_MAX)
+		sim_models[sim_nmodels++] = step;
+}
+
+void SystemInit(void)
+{
+	sim_start();
+}
+
+void SystemCoreClockUpdate(void)
+{
+	SystemCoreClock = SIM_CPU_HZ;
+}
@@ -0,0 +1,495 @@
+#include <string.h>
+#include "K1921VG015.h"
+#include "plic.h"
+
+/** @brief TMR32 interrupt bits: overflow, then one per CAPCOM */
+#define SIM_TMR32_OVF (1UL << 0)
+#define SIM_TMR32_CAPCOM_NUM 4
+
+/** @brief DMA channels and channels per interrupt line */
+#define SIM_DMA_CH_PER_IRQ 3
+#define SIM_DMA_IRQ_NUM 8
+
+RCU_TypeDef sim_rcu;
+PMUSYS_TypeDef sim_pmusys;
+GPIO_TypeDef sim_gpio[3];
+UART_TypeDef sim_uart[5];
+
+__attribute__((constructor)) static void sim_periph_init(void)
+{
+	/* "SIM" and a fixed serial number */
+	sim_pmusys.UID[0] = 0x53494D00;
+	sim_pmusys.UID[1] = 0x00000001;
+	sim_pmusys.UID[2] = 0x00000002;
+	sim_pmusys.UID[3] = 0x00000003;
+}
+
+static void sim_dma_hw_request(uint32_t ch);
+
+/*
+ * TMR32: free running counter on the core clock. Compare channels
+ * (CAPCOM CTRL left at 0) flag a match when the counter passed
+ * their value since the previous access. Host code runs slower
+ * than the target, so a compare value written up to one tick in
+ * the past still matches instead of waiting for the wrap.
+ *
+ * Capture channels (CAPMODE set) latch the exact time of every edge
+ * of sim_tmr32_pulses() up to now and raise their DMA request when
+ * it is unmasked in DMAIM. CAPEVT: 0 rising, 1 falling, 2 both.
+ */
+#define SIM_TMR32_LATE (SIM_CPU_HZ / 1000)
+
+static TMR32_TypeDef tmr_regs;
+static struct {
+	uint64_t last;
+	uint32_t ris;
+	uint32_t val[SIM_TMR32_CAPCOM_NUM];
+	uint8_t added;
+} tmr;
+
+/** @brief Pulse trains on the capture inputs */
+static struct {
+	uint64_t next; /**< time of the next edge */
+	uint32_t period;
+	uint32_t high;
+	uint32_t left; /**< edges still to come */
+	uint32_t dma_ch;
+	uint8_t level; /**< input before the next edge */
+} tmr_cap[SIM_TMR32_CAPCOM_NUM];
+
+void sim_tmr32_pulses(uint32_t capcom, uint32_t dma_ch, uint32_t period,
+		      uint32_t high, uint32_t count)
+{
+	tmr_cap[capcom].period = period;
+	tmr_cap[capcom].high = high;
+	tmr_cap[capcom].dma_ch = dma_ch;
+	tmr_cap[capcom].level = 0;
+	tmr_cap[capcom].next = sim_cycles() + period;
+	tmr_cap[capcom].left = count;
+}
+
+static void sim_tmr32_edge(uint32_t ch)
+{
+	uint32_t evt = tmr_regs.CAPCOM[ch].CTRL_bit.CAPEVT;
+	uint64_t at = tmr_cap[ch].next;
+	uint8_t rise = !tmr_cap[ch].level;
+
+	tmr_cap[ch].level = rise;
+	tmr_cap[ch].next += rise ? tmr_cap[ch].high :
+				   tmr_cap[ch].period - tmr_cap[ch].high;
+	tmr_cap[ch].left--;
+	if (!tmr_regs.CAPCOM[ch].CTRL_bit.CAPMODE || (evt == 0 && !rise) ||
+	    (evt == 1 && rise))
+		return;
+
+	tmr_regs.CAPCOM[ch].VAL = (uint32_t)at;
+	tmr.val[ch] = (uint32_t)at;
+	tmr.ris |= 1UL << (1 + ch);
+	if (tmr_regs.DMAIM & (1UL << (1 + ch)))
+		sim_dma_hw_request(tmr_cap[ch].dma_ch);
+}
+
+static void sim_tmr32_step(void)
+{
+	(void)sim_tmr32();
+}
+
+TMR32_TypeDef *sim_tmr32(void)
+{
+	uint64_t now = sim_cycles();
+	uint64_t span = now - tmr.last;
+	uint32_t from = (uint32_t)tmr.last;
+
+	if (!tmr.added) {
+		tmr.added = 1;
+		sim_model_add(sim_tmr32_step);
+	}
+
+	/* Interrupt clear written since the previous access */
+	if (tmr_regs.IC) {
+		tmr.ris &= ~tmr_regs.IC;
+		tmr_regs.IC = 0;
+	}
+
+	if (tmr_regs.CTRL_bit.MODE) {
+		if ((now >> 32) != (tmr.last >> 32))
+			tmr.ris |= SIM_TMR32_OVF;
+		for (uint32_t ch = 0; ch < SIM_TMR32_CAPCOM_NUM; ch++) {
+			uint32_t val;
+
+			while (tmr_cap[ch].left && tmr_cap[ch].next <= now)
+				sim_tmr32_edge(ch);
+			val = tmr_regs.CAPCOM[ch].VAL;
+			int late = val != tmr.val[ch] &&
+				   (uint32_t)now - val < SIM_TMR32_LATE;
+
+			tmr.val[ch] = val;
+			if (tmr_regs.CAPCOM[ch].CTRL == 0 &&
+			    (late || span > UINT32_MAX ||
+			     val - from - 1 < span))
+				tmr.ris |= 1UL << (1 + ch);
+		}
+	}
+	tmr.last = now;
+
+	tmr_regs.COUNT = (uint32_t)now;
+	tmr_regs.RIS = tmr.ris;
+	tmr_regs.MIS = tmr.ris & tmr_regs.IM;
+	if (tmr_regs.MIS)
+		sim_irq_raise(IsrVect_IRQ_TMR32);
+	return &tmr_regs;
+}
+
+/*
+ * DMA: set/clear registers are applied on the next access, a
+ * software request runs the whole cycle of the channel's current
+ * control structure, ping-pong switches to the other structure. A
+ * peripheral request moves 2^R_POWER transfers right away.
+ */
+static DMA_TypeDef dma_regs;
+static struct {
+	uint32_t en;
+	uint32_t alt;
+	uint32_t req;
+	uint32_t irq;
+	uint32_t enset; /**< mirrored ENSET/PRIALTSET, a change is a write */
+	uint32_t altset;
+	uint8_t added;
+} dma;
+
+static const IsrVect_TypeDef sim_dma_irq[SIM_DMA_IRQ_NUM] = {
+	IsrVect_IRQ_DMA0, IsrVect_IRQ_DMA1, IsrVect_IRQ_DMA2,
+	IsrVect_IRQ_DMA3, IsrVect_IRQ_DMA4, IsrVect_IRQ_DMA5,
+	IsrVect_IRQ_DMA6, IsrVect_IRQ_DMA7,
+};
+
+/** @brief Address step of an increment code (None is the same for both) */
+static uint32_t sim_dma_inc(uint32_t inc)
+{
+	return inc == DMA_CHANNEL_CFG_SRC_INC_None ? 0 : 1UL << inc;
+}
+
+static void sim_dma_cycle(uint32_t ch, uint32_t burst)
+{
+	DMA_CtrlData_TypeDef *ctl =
+		(DMA_CtrlData_TypeDef *)(uintptr_t)dma_regs.BASEPTR;
+	uint32_t bit = 1UL << ch;
+	int alt = (dma.alt & bit) != 0;
+	DMA_Channel_TypeDef *d = alt ? &ctl->ALT_DATA.CH[ch] :
+				       &ctl->PRM_DATA.CH[ch];
+	uint32_t cc = d->CHANNEL_CFG_bit.CYCLE_CTRL;
+	uint32_t n = d->CHANNEL_CFG_bit.N_MINUS_1 + 1;
+	uint32_t size = 1UL << d->CHANNEL_CFG_bit.SRC_SIZE;
+	uint32_t sinc = sim_dma_inc(d->CHANNEL_CFG_bit.SRC_INC);
+	uint32_t dinc = sim_dma_inc(d->CHANNEL_CFG_bit.DST_INC);
+	uint8_t *src = (uint8_t *)(uintptr_t)(d->SRC_DATA_END_PTR -
+					      (n - 1) * sinc);
+	uint8_t *dst = (uint8_t *)(uintptr_t)(d->DST_DATA_END_PTR -
+					      (n - 1) * dinc);
+	uint32_t k = n < burst ? n : burst;
+
+	if (cc == DMA_CHANNEL_CFG_CYCLE_CTRL_Stop) {
+		dma.en &= ~bit;
+		return;
+	}
+
+	for (uint32_t i = 0; i < k; i++) {
+		memcpy(dst, src, size);
+		src += sinc;
+		dst += dinc;
+	}
+	if (k < n) {
+		d->CHANNEL_CFG_bit.N_MINUS_1 = n - k - 1;
+		return;
+	}
+	d->CHANNEL_CFG_bit.N_MINUS_1 = 0;
+	d->CHANNEL_CFG_bit.CYCLE_CTRL = DMA_CHANNEL_CFG_CYCLE_CTRL_Stop;
+
+	if (cc == DMA_CHANNEL_CFG_CYCLE_CTRL_PingPong) {
+		DMA_Channel_TypeDef *o = alt ? &ctl->PRM_DATA.CH[ch] :
+					       &ctl->ALT_DATA.CH[ch];
+
+		dma.alt ^= bit;
+		if (o->CHANNEL_CFG_bit.CYCLE_CTRL ==
+		    DMA_CHANNEL_CFG_CYCLE_CTRL_Stop)
+			dma.en &= ~bit;
+	} else {
+		dma.en &= ~bit;
+	}
+
+	dma.irq |= bit;
+	sim_irq_raise(sim_dma_irq[ch / SIM_DMA_CH_PER_IRQ]);
+}
+
+static void sim_dma_step(void)
+{
+	uint32_t run;
+
+	(void)sim_dma();
+	run = dma.en & dma.req;
+	dma.req &= ~run;
+	while (run) {
+		uint32_t ch = __builtin_ctz(run);
+
+		run &= run - 1;
+		sim_dma_cycle(ch, UINT32_MAX);
+	}
+	(void)sim_dma();
+}
+
+static void sim_dma_hw_request(uint32_t ch)
+{
+	DMA_CtrlData_TypeDef *ctl;
+	DMA_Channel_TypeDef *d;
+
+	(void)sim_dma();
+	if (!(dma.en & (1UL << ch)))
+		return;
+	ctl = (DMA_CtrlData_TypeDef *)(uintptr_t)dma_regs.BASEPTR;
+	d = (dma.alt & (1UL << ch)) ? &ctl->ALT_DATA.CH[ch] :
+				      &ctl->PRM_DATA.CH[ch];
+	sim_dma_cycle(ch, 1UL << d->CHANNEL_CFG_bit.R_POWER);
+	(void)sim_dma();
+}
+
+DMA_TypeDef *sim_dma(void)
+{
+	if (!dma.added) {
+		dma.added = 1;
+		sim_model_add(sim_dma_step);
+	}
+
+	if (dma_regs.ENSET != dma.enset)
+		dma.en |= dma_regs.ENSET;
+	dma.en &= ~dma_regs.ENCLR;
+	if (dma_regs.PRIALTSET != dma.altset)
+		dma.alt |= dma_regs.PRIALTSET;
+	dma.alt &= ~dma_regs.PRIALTCLR;
+	dma.req |= dma_regs.SWREQ;
+	dma.irq &= ~dma_regs.IRQSTATCLR;
+	if (dma_regs.SWREQ)
+		sim_wake();
+
+	dma_regs.ENCLR = 0;
+	dma_regs.PRIALTCLR = 0;
+	dma_regs.SWREQ = 0;
+	dma_regs.IRQSTATCLR = 0;
+	dma.enset = dma.en;
+	dma.altset = dma.alt;
+	dma_regs.ENSET = dma.en;
+	dma_regs.PRIALTSET = dma.alt;
+	dma_regs.IRQSTAT = dma.irq;
+	return &dma_regs;
+}
+
+/** @brief Transfer size in bytes of an enabled channel, 0 if it is off */
+static uint32_t sim_dma_size(uint32_t ch)
+{
+	DMA_CtrlData_TypeDef *ctl;
+	DMA_Channel_TypeDef *d;
+
+	(void)sim_dma();
+	if (!(dma.en & (1UL << ch)))
+		return 0;
+	ctl = (DMA_CtrlData_TypeDef *)(uintptr_t)dma_regs.BASEPTR;
+	d = (dma.alt & (1UL << ch)) ? &ctl->ALT_DATA.CH[ch] :
+				      &ctl->PRM_DATA.CH[ch];
+	return 1UL << d->CHANNEL_CFG_bit.SRC_SIZE;
+}
+
+/*
+ * QSPI with a 4 MiB serial NOR (W25Q32 command set) behind it.
+ *
+ * Writing IR starts a frame, AR is taken on the access after it.
+ * Accesses cannot tell a register from another, so a CPU data
+ * phase assumes the driver's loop: a status poll, then DR, per
+ * byte. That only holds up to the FIFO depth; longer data phases
+ * wait for RXDMAE/TXDMAE and go through the DMA request lines, one
+ * transfer per request, from the model step too. Erase and program
+ * finish at once; WIP reads set once.
+ */
+#define SIM_QSPI_DMA_TX 22
+#define SIM_QSPI_DMA_RX 23
+#define SIM_QSPI_FIFO 16
+#define SIM_QSPI_IDLE 0xFFFFFFFFUL
+#define SIM_NOR_SIZE (4UL << 20)
+
+static QSPI_TypeDef qspi_regs;
+static struct {
+	uint8_t mem[SIM_NOR_SIZE];
+	uint32_t addr;
+	uint32_t len;
+	uint32_t pos; /**< data bytes moved */
+	uint8_t cmd;
+	uint8_t phase; /**< 0 idle, 1 waiting for AR, 2 data */
+	uint8_t cpu; /**< CPU data: 1 DR is next, 2 DR was written */
+	uint8_t wel;
+	uint8_t wip;
+	uint8_t sr2;
+	uint8_t added;
+} qspi;
+
+static const uint8_t sim_nor_id[3] = { 0xEF, 0x40, 0x16 };
+
+/** @brief Byte i of the response to a read frame */
+static uint8_t sim_nor_out(uint32_t i)
+{
+	switch (qspi.cmd) {
+	case 0x9F:
+		return i < sizeof(sim_nor_id) ? sim_nor_id[i] : 0;
+	case 0x05:
+		return qspi.wip | qspi.wel << 1;
+	case 0x35:
+		return qspi.sr2;
+	case 0xEB:
+		return qspi.mem[(qspi.addr + i) % SIM_NOR_SIZE];
+	default:
+		return 0xFF;
+	}
+}
+
+/** @brief Byte i of a write frame */
+static void sim_nor_in(uint32_t i, uint8_t b)
+{
+	if (qspi.cmd == 0x32 && qspi.wel) {
+		/* Page program wraps within the page */
+		uint32_t a = (qspi.addr & ~0xFFUL) | ((qspi.addr + i) & 0xFF);
+
+		qspi.mem[a % SIM_NOR_SIZE] &= b;
+	} else if (qspi.cmd == 0x31 && qspi.wel && i == 0) {
+		qspi.sr2 = b;
+	}
+}
+
+static void sim_nor_start(void)
+{
+	uint32_t size = qspi.cmd == 0x20 ? 0x1000 : 0x10000;
+
+	if (qspi.cmd == 0x06) {
+		qspi.wel = 1;
+	} else if ((qspi.cmd == 0x20 || qspi.cmd == 0xD8) && qspi.wel) {
+		memset(&qspi.mem[(qspi.addr & ~(size - 1)) % SIM_NOR_SIZE],
+		       0xFF, size);
+		qspi.wel = 0;
+		qspi.wip = 1;
+	}
+}
+
+static void sim_nor_end(void)
+{
+	if (qspi.cmd == 0x05) {
+		qspi.wip = 0;
+	} else if ((qspi.cmd == 0x32 || qspi.cmd == 0x31) && qspi.wel) {
+		qspi.wel = 0;
+		qspi.wip = 1;
+	}
+}
+
+/** @brief Serve the DMA requests of a data phase */
+static void sim_qspi_dma(void)
+{
+	int rx = qspi_regs.DMACR_bit.RXDMAE;
+	uint32_t ch = rx ? SIM_QSPI_DMA_RX : SIM_QSPI_DMA_TX;
+	uint32_t size;
+
+	while (qspi.pos < qspi.len && (size = sim_dma_size(ch)) != 0) {
+		uint32_t w = 0;
+
+		if (rx) {
+			for (uint32_t i = 0; i < size; i++)
+				w |= (uint32_t)sim_nor_out(qspi.pos + i)
+				     << (8 * i);
+			qspi_regs.DR = w;
+			sim_dma_hw_request(ch);
+		} else {
+			sim_dma_hw_request(ch);
+			w = qspi_regs.DR;
+			for (uint32_t i = 0; i < size; i++)
+				sim_nor_in(qspi.pos + i, (uint8_t)(w >> 8 * i));
+		}
+		qspi.pos += size;
+	}
+}
+
+/** @brief One CPU access during the data phase */
+static void sim_qspi_cpu(void)
+{
+	int rx = qspi_regs.FCFG_bit.FMODE;
+
+	if (qspi.cpu == 1) {
+		/* This access is the DR read or write */
+		if (rx) {
+			qspi.pos++;
+			qspi.cpu = 0;
+		} else {
+			qspi.cpu = 2;
+		}
+		return;
+	}
+	if (qspi.cpu == 2) {
+		sim_nor_in(qspi.pos++, (uint8_t)qspi_regs.DR);
+		qspi.cpu = 0;
+	}
+	if (qspi.pos < qspi.len) {
+		if (rx) {
+			qspi_regs.DR = sim_nor_out(qspi.pos);
+			qspi_regs.SR_bit.RXNE = 1;
+		} else {
+			qspi_regs.SR_bit.TXNF = 1;
+		}
+		qspi.cpu = 1;
+	}
+}
+
+static void sim_qspi_update(int access)
+{
+	if (qspi.phase == 0 && qspi_regs.IR != SIM_QSPI_IDLE) {
+		qspi.cmd = (uint8_t)qspi_regs.IR;
+		qspi_regs.IR = SIM_QSPI_IDLE;
+		qspi_regs.AR = SIM_QSPI_IDLE;
+		qspi.len = qspi_regs.FCFG_bit.DMODE ? qspi_regs.DLR + 1 : 0;
+		qspi.pos = 0;
+		qspi.cpu = 0;
+		qspi.addr = 0;
+		qspi.phase = qspi_regs.FCFG_bit.ADMODE ? 1 : 2;
+		if (qspi.phase == 2)
+			sim_nor_start();
+	} else if (qspi.phase == 1 && qspi_regs.AR != SIM_QSPI_IDLE) {
+		qspi.addr = qspi_regs.AR;
+		qspi.phase = 2;
+		sim_nor_start();
+	}
+
+	if (qspi.phase == 2) {
+		if (qspi_regs.DMACR_bit.RXDMAE || qspi_regs.DMACR_bit.TXDMAE)
+			sim_qspi_dma();
+		else if (access && qspi.len <= SIM_QSPI_FIFO)
+			sim_qspi_cpu();
+		if (qspi.pos >= qspi.len && qspi.cpu == 0) {
+			sim_nor_end();
+			qspi.phase = 0;
+		}
+	}
+	qspi_regs.SR_bit.BUSY = qspi.phase != 0;
+	if (qspi.phase != 2 || qspi.cpu == 0) {
+		qspi_regs.SR_bit.RXNE = 0;
+		qspi_regs.SR_bit.TXNF = 0;
+	}
+}
+
+static void sim_qspi_step(void)
+{
+	sim_qspi_update(0);
+}
+
+QSPI_TypeDef *sim_qspi(void)
+{
+	if (!qspi.added) {
+		qspi.added = 1;
+		qspi_regs.IR = SIM_QSPI_IDLE;
+		memset(qspi.mem, 0xFF, sizeof(qspi.mem));
+		sim_model_add(sim_qspi_step);
+	}
+	sim_qspi_update(1);
+	return &qspi_regs;
+}
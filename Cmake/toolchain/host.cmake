@@ -0,0 +1,22 @@
+# Host (Linux) simulation build: FreeRTOS POSIX port and the
+# peripheral models of Chip/host instead of the K1921VG015 HAL.
+# CMAKE_SYSTEM_NAME is left to CMake so the build is not a cross
+# build; modules test CMAKE_CROSSCOMPILING for target-only parts.
+# 32-bit code keeps pointers and register layouts as on the target
+# (needs gcc-multilib).
+
+find_program(CMAKE_C_COMPILER gcc)
+find_program(CMAKE_ASM_COMPILER gcc)
+find_program(CMAKE_CXX_COMPILER g++)
+
+add_compile_options(
+    -m32
+    -ffunction-sections
+    -fdata-sections
+    -Wall
+)
+
+add_link_options(
+    -m32
+    -Wl,--gc-sections
+)
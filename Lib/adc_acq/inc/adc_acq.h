@@ -0,0 +1,114 @@
+#ifndef __adc_acq_h__
+#define __adc_acq_h__
+
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "clk.h"
+#include "ring.h"
+
+/*! CPP guard */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Max channels scanned by one acquisition */
+#define ADC_ACQ_CH_MAX 8
+/** @brief Max sample buffers of one acquisition */
+#define ADC_ACQ_BUF_MAX 8
+
+typedef enum {
+	ADC_ACQ_SAR = 0, /**< SAR sequencer scans on timer trigger */
+	ADC_ACQ_SD, /**< sigma-delta channels in continuous mode */
+} adc_acq_conv_t;
+
+/** @brief Per-channel configuration */
+typedef struct {
+	uint8_t input; /**< converter input number */
+	uint8_t gain; /**< SD only: PGA setting, 0 = x1 */
+	uint8_t diff; /**< SD only: differential input */
+} adc_acq_chan_t;
+
+/**
+ * @brief Acquisition configuration.
+ *
+ * Samples are interleaved by scan: data[scan * nchannels + ch].
+ * buf holds nbufs blocks of block_scans * nchannels samples; a
+ * block must fit one DMA cycle (DMA_XFER_MAX samples).
+ */
+typedef struct {
+	adc_acq_conv_t conv;
+	uint8_t seq; /**< SAR sequencer number */
+	uint8_t nchannels;
+	adc_acq_chan_t channels[ADC_ACQ_CH_MAX];
+	uint32_t scan_rate; /**< scans per second */
+	uint16_t block_scans;
+	uint8_t nbufs; /**< 3..ADC_ACQ_BUF_MAX */
+	uint8_t dma_ch;
+	uint16_t *buf;
+} adc_acq_config_t;
+
+/** @brief Full block handed to the processing task */
+typedef struct {
+	uint64_t timestamp; /**< mtime of the first scan */
+	uint32_t seq_no; /**< block counter, gaps mean dropped blocks */
+	uint16_t scans;
+	uint8_t nchannels;
+	uint8_t idx; /**< buffer index, pass back to adc_acq_release() */
+	const uint16_t *data;
+} adc_block_t;
+
+typedef struct {
+	uint32_t blocks;
+	uint32_t overruns; /**< blocks dropped: no free buffer for DMA */
+	uint32_t hw_overruns; /**< converter FIFO overflow events */
+} adc_acq_stats_t;
+
+/**
+ * @brief Acquisition instance, treat as opaque.
+ *
+ * Full blocks reach the task through an SPSC ring of pointers into
+ * blk[]: the DMA handler never masks interrupts to hand one over.
+ */
+typedef struct {
+	adc_acq_config_t cfg;
+	ring_spsc_t ready;
+	void *ready_slots[ADC_ACQ_BUF_MAX];
+	adc_block_t blk[ADC_ACQ_BUF_MAX];
+	volatile uint32_t free_msk;
+	uint8_t cur[2]; /**< buffer loaded in primary/alternate structure */
+	uint8_t alt_next;
+	uint32_t seq_no;
+	uint64_t block_ticks; /**< block duration in mtime ticks */
+	adc_acq_stats_t stats;
+	clk_notifier_t clk;
+} adc_acq_t;
+
+/**
+ * @brief Configure converter, trigger timer and DMA; start sampling.
+ *
+ * Scan rate and SAR clock come from the core clock: a running
+ * acquisition vetoes clk_set_op() until adc_acq_stop().
+ * @return 0 on success, -1 on bad configuration
+ */
+int adc_acq_start(adc_acq_t *acq, const adc_acq_config_t *cfg);
+
+/** @brief Stop trigger and DMA */
+void adc_acq_stop(adc_acq_t *acq);
+
+/**
+ * @brief Wait for the next full block.
+ * @return pdTRUE if a block was received
+ */
+BaseType_t adc_acq_get(adc_acq_t *acq, adc_block_t *blk, TickType_t timeout);
+
+/** @brief Return a processed block's buffer to the acquisition */
+void adc_acq_release(adc_acq_t *acq, const adc_block_t *blk);
+
+/** @brief Copy statistics */
+void adc_acq_get_stats(adc_acq_t *acq, adc_acq_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif /* End of CPP guard */
+
+#endif //__adc_acq_h__
@@ -0,0 +1,244 @@
+#include <string.h>
+#include "adc_acq.h"
+#include "dma.h"
+#include "mtimer.h"
+#include "task.h"
+
+/** @brief SAR converter clock, SD modulator clock */
+#define ADC_SAR_CLK_HZ 25000000
+#define ADC_SD_MOD_HZ 4000000
+/** @brief SD decimation ratio limits */
+#define ADC_SD_OSR_MIN 32
+#define ADC_SD_OSR_MAX 1024
+
+/** @brief Event multiplexer code of the TMR0 period event */
+#define ADC_EMUX_TMR0 0x3
+
+static uint64_t adc_mtime(void)
+{
+	volatile uint32_t *mtime = (volatile uint32_t *)RISCV_MTIME_ADDR;
+	uint32_t hi, lo;
+
+	do {
+		hi = mtime[1];
+		lo = mtime[0];
+	} while (hi != mtime[1]);
+	return ((uint64_t)hi << 32) | lo;
+}
+
+static volatile const void *adc_src_reg(const adc_acq_config_t *cfg)
+{
+	if (cfg->conv == ADC_ACQ_SAR)
+		return &ADCSAR->SEQ[cfg->seq].SFIFO;
+	return &ADCSD->FIFO;
+}
+
+static uint32_t adc_block_len(const adc_acq_config_t *cfg)
+{
+	return (uint32_t)cfg->block_scans * cfg->nchannels;
+}
+
+static uint16_t *adc_buf(const adc_acq_t *acq, uint32_t idx)
+{
+	return acq->cfg.buf + idx * adc_block_len(&acq->cfg);
+}
+
+static void adc_dma_load(adc_acq_t *acq, int alt, uint32_t idx)
+{
+	dma_ch_setup(acq->cfg.dma_ch, adc_src_reg(&acq->cfg),
+		     adc_buf(acq, idx), adc_block_len(&acq->cfg),
+		     DMA_XFER_HALFWORD | DMA_XFER_DST_INC | DMA_XFER_PINGPONG |
+			     (alt ? DMA_XFER_ALT : 0));
+	acq->cur[alt] = idx;
+}
+
+/**
+ * @brief Ping-pong half completed.
+ *
+ * Reloads the finished structure with the next free buffer while
+ * the controller fills the other one, then hands the full block
+ * over. Without a free buffer the full one is reused and the block
+ * is dropped; seq_no still advances so the consumer sees the gap.
+ */
+static void adc_dma_done(__attribute__((unused)) uint32_t ch, void *arg)
+{
+	adc_acq_t *acq = arg;
+	BaseType_t woken = pdFALSE;
+	int alt = acq->alt_next;
+	uint32_t idx = acq->cur[alt];
+	adc_block_t *blk = &acq->blk[idx];
+
+	acq->alt_next ^= 1;
+	if (acq->cfg.conv == ADC_ACQ_SAR && ADCSAR->SEQ[acq->cfg.seq].SOVF) {
+		ADCSAR->SEQ[acq->cfg.seq].SOVF = 1;
+		acq->stats.hw_overruns++;
+	}
+	blk->timestamp = adc_mtime() - acq->block_ticks;
+	blk->seq_no = acq->seq_no++;
+
+	if (acq->free_msk == 0) {
+		acq->stats.overruns++;
+		adc_dma_load(acq, alt, idx);
+		return;
+	}
+
+	uint32_t next = __builtin_ctz(acq->free_msk);
+
+	acq->free_msk &= ~(1UL << next);
+	adc_dma_load(acq, alt, next);
+
+	blk->scans = acq->cfg.block_scans;
+	blk->nchannels = acq->cfg.nchannels;
+	blk->idx = idx;
+	blk->data = adc_buf(acq, idx);
+	acq->stats.blocks++;
+	/* At most nbufs - 2 blocks are out, the ring cannot fill */
+	ring_spsc_push(&acq->ready, blk, &woken);
+	portYIELD_FROM_ISR(woken);
+}
+
+static void adc_sar_init(const adc_acq_config_t *cfg)
+{
+	ADCSAR_SEQ_TypeDef *seq = &ADCSAR->SEQ[cfg->seq];
+	uint32_t div = SystemCoreClock / ADC_SAR_CLK_HZ;
+
+	RCU->CGCFGAPB_bit.ADCSAREN = 1;
+	RCU->RSTDISAPB_bit.ADCSAREN = 1;
+	RCU->ADCSARCLKCFG_bit.DIVN = div ? div - 1 : 0;
+	RCU->ADCSARCLKCFG_bit.DIVEN = div > 1;
+	RCU->ADCSARCLKCFG_bit.CLKEN = 1;
+	RCU->ADCSARCLKCFG_bit.RSTDIS = 1;
+
+	ADCSAR->ACTL_bit.ADCEN = 1;
+	while (!ADCSAR->ACTL_bit.ADCRDY) {
+	};
+
+	seq->SRQSEL[0] = 0;
+	seq->SRQSEL[1] = 0;
+	for (uint32_t i = 0; i < cfg->nchannels; i++)
+		seq->SRQSEL[i / 4] |= (uint32_t)cfg->channels[i].input
+				      << ((i % 4) * 8);
+	seq->SRQCTL_bit.RQMAX = cfg->nchannels - 1;
+	/* One DMA request per conversion, restart scan on every event */
+	seq->SCCTL_bit.DMAEN = 1;
+	seq->SCCTL_bit.RCNT = 0;
+	ADCSAR->EMUX &= ~(0xFUL << (cfg->seq * 4));
+	ADCSAR->EMUX |= (uint32_t)ADC_EMUX_TMR0 << (cfg->seq * 4);
+	ADCSAR->SEQEN |= 1UL << cfg->seq;
+}
+
+static void adc_sar_trigger_start(uint32_t scan_rate)
+{
+	RCU->CGCFGAPB_bit.TMR0EN = 1;
+	RCU->RSTDISAPB_bit.TMR0EN = 1;
+	TMR0->LOAD = SystemCoreClock / scan_rate - 1;
+	TMR0->VALUE = TMR0->LOAD;
+	TMR0->CTRL_bit.ON = 1;
+}
+
+static void adc_sd_init(const adc_acq_config_t *cfg)
+{
+	uint32_t osr = ADC_SD_MOD_HZ / cfg->scan_rate;
+	uint32_t ena = 0;
+
+	if (osr < ADC_SD_OSR_MIN)
+		osr = ADC_SD_OSR_MIN;
+	if (osr > ADC_SD_OSR_MAX)
+		osr = ADC_SD_OSR_MAX;
+
+	RCU->CGCFGAPB_bit.ADCSDEN = 1;
+	RCU->RSTDISAPB_bit.ADCSDEN = 1;
+
+	ADCSD->CTRL_bit.PON = 1;
+	ADCSD->CTRL_bit.OSR = osr - 1;
+	for (uint32_t i = 0; i < cfg->nchannels; i++) {
+		uint32_t in = cfg->channels[i].input;
+
+		ADCSD->CHCTL[in].CHCTL_bit.AMPL = cfg->channels[i].gain;
+		ADCSD->CHCTL[in].CHCTL_bit.DIFF = cfg->channels[i].diff;
+		ena |= 1UL << in;
+	}
+	ADCSD->CTRL_bit.DMAEN = 1;
+	ADCSD->ENB = ena;
+	ADCSD->CTRL_bit.START = 1;
+}
+
+static int adc_clk_cb(clk_event_t ev, __attribute__((unused)) uint32_t old_hz,
+		      __attribute__((unused)) uint32_t new_hz,
+		      __attribute__((unused)) void *arg)
+{
+	return ev == CLK_PRE_CHANGE ? -1 : 0;
+}
+
+int adc_acq_start(adc_acq_t *acq, const adc_acq_config_t *cfg)
+{
+	uint32_t len = adc_block_len(cfg);
+	uint64_t scans;
+
+	if (cfg->nchannels == 0 || cfg->nchannels > ADC_ACQ_CH_MAX ||
+	    cfg->nbufs < 3 || cfg->nbufs > ADC_ACQ_BUF_MAX || len == 0 ||
+	    len > DMA_XFER_MAX || cfg->scan_rate == 0 || cfg->buf == NULL ||
+	    cfg->dma_ch >= DMA_CH_COUNT)
+		return -1;
+
+	memset(acq, 0, sizeof(*acq));
+	acq->cfg = *cfg;
+	ring_spsc_init(&acq->ready, acq->ready_slots, ADC_ACQ_BUF_MAX);
+
+	scans = (uint64_t)cfg->block_scans * MTIME_FREQ_HZ;
+	acq->block_ticks = scans / cfg->scan_rate;
+	acq->free_msk = ((1UL << cfg->nbufs) - 1) & ~3UL;
+
+	clk_notifier_register(&acq->clk, adc_clk_cb, acq);
+	dma_init();
+	dma_set_handler(cfg->dma_ch, adc_dma_done, acq);
+	dma_ch_use_primary(cfg->dma_ch);
+	adc_dma_load(acq, 0, 0);
+	adc_dma_load(acq, 1, 1);
+	dma_ch_enable(cfg->dma_ch);
+
+	if (cfg->conv == ADC_ACQ_SAR) {
+		adc_sar_init(cfg);
+		adc_sar_trigger_start(cfg->scan_rate);
+	} else {
+		adc_sd_init(cfg);
+	}
+	return 0;
+}
+
+void adc_acq_stop(adc_acq_t *acq)
+{
+	if (acq->cfg.conv == ADC_ACQ_SAR) {
+		TMR0->CTRL_bit.ON = 0;
+		ADCSAR->SEQEN &= ~(1UL << acq->cfg.seq);
+	} else {
+		ADCSD->CTRL_bit.START = 0;
+	}
+	dma_ch_disable(acq->cfg.dma_ch);
+	dma_set_handler(acq->cfg.dma_ch, NULL, NULL);
+	clk_notifier_unregister(&acq->clk);
+}
+
+BaseType_t adc_acq_get(adc_acq_t *acq, adc_block_t *blk, TickType_t timeout)
+{
+	void *full;
+
+	if (ring_spsc_receive(&acq->ready, &full, timeout) != RING_OK)
+		return pdFALSE;
+	*blk = *(const adc_block_t *)full;
+	return pdTRUE;
+}
+
+void adc_acq_release(adc_acq_t *acq, const adc_block_t *blk)
+{
+	taskENTER_CRITICAL();
+	acq->free_msk |= 1UL << blk->idx;
+	taskEXIT_CRITICAL();
+}
+
+void adc_acq_get_stats(adc_acq_t *acq, adc_acq_stats_t *stats)
+{
+	taskENTER_CRITICAL();
+	*stats = acq->stats;
+	taskEXIT_CRITICAL();
+}
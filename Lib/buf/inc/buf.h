@@ -0,0 +1,129 @@
+#ifndef __buf_h__
+#define __buf_h__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*! CPP guard */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Size classes, X(data size, count), ascending sizes.
+ *
+ * Data size is the room behind the headroom; sizes must keep
+ * buffers 4 byte aligned for DMA. Override from the build to resize
+ * the pool.
+ */
+#ifndef BUF_CLASSES
+#define BUF_CLASSES(X) \
+	X(64, 32)      \
+	X(256, 16)     \
+	X(1024, 4)
+#endif
+
+/** @brief Room in front of the data of a fresh buffer for headers */
+#ifndef BUF_HEADROOM
+#define BUF_HEADROOM 16
+#endif
+
+#define BUF_X_ONE(sz, n) +1
+enum { BUF_CLASS_COUNT = 0 BUF_CLASSES(BUF_X_ONE) };
+
+/**
+ * @brief Buffer descriptor, one segment of a chain.
+ *
+ * Every segment holds one reference on the next one, so a chain is
+ * shared by taking a reference on its head and released with a
+ * single buf_free().
+ */
+typedef struct buf {
+	struct buf *next;
+	uint8_t *data; /**< first valid byte */
+	uint8_t *head; /**< start of the storage, private */
+	uint16_t len; /**< valid bytes in this segment */
+	uint8_t ref;
+	uint8_t cls; /**< size class, private */
+} buf_t;
+
+typedef struct {
+	uint16_t size;
+	uint16_t count;
+	uint16_t used;
+	uint16_t peak; /**< most buffers in use at once */
+	uint32_t allocs;
+	uint32_t fails; /**< allocations refused, class exhausted */
+} buf_class_stats_t;
+
+typedef struct {
+	buf_class_stats_t cls[BUF_CLASS_COUNT];
+	uint32_t oversize; /**< requests larger than the largest class */
+} buf_stats_t;
+
+/**
+ * @brief Take a buffer of the smallest class with size bytes of room.
+ *
+ * Any context, interrupts included. The buffer comes empty with
+ * BUF_HEADROOM in front and one reference; the contents are not
+ * cleared. Falls through to the next class when one is exhausted.
+ * @return Buffer or NULL when the pool is exhausted
+ */
+buf_t *buf_alloc(size_t size);
+
+/** @brief Take another reference, returns b */
+buf_t *buf_ref(buf_t *b);
+
+/**
+ * @brief Drop a reference on a chain.
+ *
+ * Segments whose count reaches zero go back to the pool, walking
+ * the chain until one is still referenced. Any context, b may be
+ * NULL.
+ */
+void buf_free(buf_t *b);
+
+/** @brief Append tail to the chain, taking over the caller's reference */
+void buf_chain(buf_t *b, buf_t *tail);
+
+/** @brief Bytes of the whole chain */
+size_t buf_total_len(const buf_t *b);
+
+/** @brief Storage size of the segment's class */
+size_t buf_size(const buf_t *b);
+
+static inline size_t buf_headroom(const buf_t *b)
+{
+	return (size_t)(b->data - b->head);
+}
+
+static inline size_t buf_tailroom(const buf_t *b)
+{
+	return buf_size(b) - buf_headroom(b) - b->len;
+}
+
+/**
+ * @brief Prepend n bytes from the headroom.
+ * @return New start of data, NULL if the headroom is too small
+ */
+uint8_t *buf_push(buf_t *b, size_t n);
+
+/**
+ * @brief Strip n bytes from the front of the data.
+ * @return New start of data, NULL if fewer than n bytes are valid
+ */
+uint8_t *buf_pull(buf_t *b, size_t n);
+
+/**
+ * @brief Extend the data by n bytes at the end.
+ * @return Start of the added area, NULL if the tailroom is too small
+ */
+uint8_t *buf_put(buf_t *b, size_t n);
+
+void buf_get_stats(buf_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif /* End of CPP guard */
+
+#endif //__buf_h__
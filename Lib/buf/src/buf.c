@@ -0,0 +1,189 @@
+#include <stddef.h>
+#include "buf.h"
+#include "riscv-irq.h"
+
+/**
+ * @brief One size class.
+ *
+ * Descriptors past fresh were never handed out, so a zeroed pool is
+ * ready without an init call and any context may allocate first.
+ */
+typedef struct {
+	buf_t *desc;
+	uint8_t *mem;
+	uint16_t size; /**< storage per buffer, headroom included */
+	uint16_t count;
+	buf_t *free;
+	uint16_t fresh;
+	uint16_t used;
+	uint16_t peak;
+	uint32_t allocs;
+	uint32_t fails;
+} buf_pool_t;
+
+#define BUF_X_STORAGE(sz, n)                              \
+	static buf_t buf_desc_##sz[n];                    \
+	static uint8_t buf_mem_##sz[n][BUF_HEADROOM + sz] \
+		__attribute__((aligned(4)));
+BUF_CLASSES(BUF_X_STORAGE)
+
+#define BUF_X_POOL(sz, n)                                    \
+	{ .desc = buf_desc_##sz, .mem = &buf_mem_##sz[0][0], \
+	  .size = BUF_HEADROOM + sz, .count = n },
+
+static buf_pool_t buf_pools[BUF_CLASS_COUNT] = { BUF_CLASSES(BUF_X_POOL) };
+static uint32_t buf_oversize;
+
+/*
+ * The core has no atomics (rv32imfc): the free lists are guarded by
+ * masking interrupts (irq_save()) for a few instructions instead,
+ * which is just as safe from tasks and ISRs on a single hart.
+ */
+
+/** @brief Pop a descriptor of the class, masked */
+static buf_t *buf_take(buf_pool_t *p, uint8_t cls)
+{
+	buf_t *b = p->free;
+
+	if (b) {
+		p->free = b->next;
+	} else if (p->fresh < p->count) {
+		b = &p->desc[p->fresh];
+		b->head = p->mem + (size_t)p->fresh * p->size;
+		b->cls = cls;
+		p->fresh++;
+	} else {
+		return NULL;
+	}
+	if (++p->used > p->peak)
+		p->peak = p->used;
+	p->allocs++;
+	return b;
+}
+
+buf_t *buf_alloc(size_t size)
+{
+	buf_t *b = NULL;
+	uint32_t mie = irq_save();
+	uint8_t cls;
+
+	for (cls = 0; cls < BUF_CLASS_COUNT; cls++) {
+		buf_pool_t *p = &buf_pools[cls];
+
+		if (size > (size_t)(p->size - BUF_HEADROOM))
+			continue;
+		b = buf_take(p, cls);
+		if (b)
+			break;
+		p->fails++;
+	}
+	if (b == NULL &&
+	    size > (size_t)(buf_pools[BUF_CLASS_COUNT - 1].size - BUF_HEADROOM))
+		buf_oversize++;
+	irq_restore(mie);
+
+	if (b) {
+		b->next = NULL;
+		b->data = b->head + BUF_HEADROOM;
+		b->len = 0;
+		b->ref = 1;
+	}
+	return b;
+}
+
+buf_t *buf_ref(buf_t *b)
+{
+	uint32_t mie = irq_save();
+
+	b->ref++;
+	irq_restore(mie);
+	return b;
+}
+
+void buf_free(buf_t *b)
+{
+	while (b) {
+		uint32_t mie = irq_save();
+		buf_t *next = b->next;
+
+		if (--b->ref) {
+			irq_restore(mie);
+			return;
+		}
+		buf_pool_t *p = &buf_pools[b->cls];
+
+		b->next = p->free;
+		p->free = b;
+		p->used--;
+		irq_restore(mie);
+		b = next;
+	}
+}
+
+void buf_chain(buf_t *b, buf_t *tail)
+{
+	while (b->next)
+		b = b->next;
+	b->next = tail;
+}
+
+size_t buf_total_len(const buf_t *b)
+{
+	size_t len = 0;
+
+	for (; b; b = b->next)
+		len += b->len;
+	return len;
+}
+
+size_t buf_size(const buf_t *b)
+{
+	return buf_pools[b->cls].size;
+}
+
+uint8_t *buf_push(buf_t *b, size_t n)
+{
+	if (n > buf_headroom(b))
+		return NULL;
+	b->data -= n;
+	b->len += n;
+	return b->data;
+}
+
+uint8_t *buf_pull(buf_t *b, size_t n)
+{
+	if (n > b->len)
+		return NULL;
+	b->data += n;
+	b->len -= n;
+	return b->data;
+}
+
+uint8_t *buf_put(buf_t *b, size_t n)
+{
+	uint8_t *tail = b->data + b->len;
+
+	if (n > buf_tailroom(b))
+		return NULL;
+	b->len += n;
+	return tail;
+}
+
+void buf_get_stats(buf_stats_t *stats)
+{
+	uint32_t mie = irq_save();
+
+	for (uint8_t cls = 0; cls < BUF_CLASS_COUNT; cls++) {
+		const buf_pool_t *p = &buf_pools[cls];
+		buf_class_stats_t *s = &stats->cls[cls];
+
+		s->size = p->size - BUF_HEADROOM;
+		s->count = p->count;
+		s->used = p->used;
+		s->peak = p->peak;
+		s->allocs = p->allocs;
+		s->fails = p->fails;
+	}
+	stats->oversize = buf_oversize;
+	irq_restore(mie);
+}
@@ -0,0 +1,115 @@
+#ifndef __clk_h__
+#define __clk_h__
+
+#include <stdint.h>
+
+/*! CPP guard */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CLK_OK 0
+#define CLK_ERR_PARAM -1
+#define CLK_ERR_BUSY -2 /**< a driver vetoed the change */
+#define CLK_ERR_MTIME -3 /**< mtime follows the core clock on this part */
+
+/** @brief Operating points, PLL is the configuration SystemInit() set */
+typedef enum {
+	CLK_OP_HSE, /**< external crystal, PLL bypassed but kept locked */
+	CLK_OP_PLL,
+	CLK_OP_COUNT
+} clk_op_t;
+
+/**
+ * @brief Notifier events, in the order a change sends them.
+ *
+ * PRE_CHANGE runs in the caller's task and may block or veto by
+ * returning non-zero; ABORT_CHANGE then goes to those that already
+ * accepted. CHANGE runs right after the switch with interrupts
+ * masked: re-time the hardware and return, nothing else.
+ * POST_CHANGE runs in the caller's task again.
+ */
+typedef enum {
+	CLK_PRE_CHANGE,
+	CLK_CHANGE,
+	CLK_POST_CHANGE,
+	CLK_ABORT_CHANGE,
+} clk_event_t;
+
+typedef int (*clk_notifier_cb_t)(clk_event_t ev, uint32_t old_hz,
+				 uint32_t new_hz, void *arg);
+
+/** @brief Notifier block, owned by the driver, fields are private */
+typedef struct clk_notifier {
+	struct clk_notifier *next;
+	clk_notifier_cb_t cb;
+	void *arg;
+} clk_notifier_t;
+
+typedef struct {
+	uint32_t switches;
+	uint32_t vetoes;
+	uint32_t boosts; /**< switches up forced by clk_boost_get() */
+	uint32_t switch_us_max; /**< longest switch, notifiers included */
+	uint64_t op_us[CLK_OP_COUNT]; /**< time spent at each point */
+} clk_stats_t;
+
+/** @brief Load governor settings, load in percent of the last period */
+typedef struct {
+	uint32_t period_ms;
+	uint8_t up_pct; /**< go to PLL at this load or above */
+	uint8_t down_pct; /**< go to HSE at this load or below */
+	uint8_t prio;
+} clk_governor_config_t;
+
+/**
+ * @brief Add a notifier, called in registration order.
+ *
+ * Registering an already registered block is a no-op.
+ */
+void clk_notifier_register(clk_notifier_t *n, clk_notifier_cb_t cb,
+			   void *arg);
+
+void clk_notifier_unregister(clk_notifier_t *n);
+
+/**
+ * @brief Switch the system clock, notifying the drivers.
+ *
+ * Task context only, changes are serialized. The first switch away
+ * from the boot clock checks mtime against mcycle; if mtime moved
+ * with the core clock the switch is undone (notifiers see
+ * ABORT_CHANGE) and every later one refused.
+ * @return CLK_OK, CLK_ERR_BUSY if vetoed, CLK_ERR_MTIME, CLK_ERR_PARAM
+ */
+int clk_set_op(clk_op_t op);
+
+clk_op_t clk_get_op(void);
+
+/** @brief mtime rate, the same at every operating point */
+uint32_t clk_mtime_hz(void);
+
+/**
+ * @brief Hold the full speed point for a burst.
+ *
+ * Switches to PLL at once and keeps the governor from going down
+ * until the matching clk_boost_put(). Calls nest.
+ * @return clk_set_op() result
+ */
+int clk_boost_get(void);
+void clk_boost_put(void);
+
+/**
+ * @brief Start the load governor task.
+ *
+ * Load comes from the idle task run time of the kernel statistics.
+ * @return 0 on success, -1 if the task could not be created
+ */
+int clk_governor_start(const clk_governor_config_t *cfg);
+
+void clk_get_stats(clk_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif /* End of CPP guard */
+
+#endif //__clk_h__
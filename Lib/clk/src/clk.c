@@ -0,0 +1,331 @@
+#include <stddef.h>
+#include "clk.h"
+#include "init.h"
+#include "K1921VG015.h"
+#include "system_k1921vg015.h"
+#include "mtimer.h"
+#include "riscv-csr.h"
+#include "riscv-irq.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+#ifndef HSECLK_VAL
+#define HSECLK_VAL 16000000
+#endif
+
+/** @brief mtime ticks timed against mcycle to see what clocks mtime */
+#define CLK_MTIME_PROBE 16
+
+enum { CLK_MTIME_UNKNOWN, CLK_MTIME_FIXED, CLK_MTIME_SCALED };
+
+static const uint32_t clk_sel[CLK_OP_COUNT] = {
+	[CLK_OP_HSE] = RCU_SYSCLKCFG_SYSSEL_HSE,
+	[CLK_OP_PLL] = RCU_SYSCLKCFG_SYSSEL_PLL0,
+};
+
+static init_once_t clk_once = INIT_ONCE_INIT;
+static SemaphoreHandle_t clk_mutex;
+static clk_notifier_t *clk_list;
+static clk_op_t clk_cur;
+static uint32_t clk_hz[CLK_OP_COUNT];
+static uint32_t clk_boot_hz;
+static uint8_t clk_mtime_mode;
+static uint64_t clk_since;
+static volatile uint32_t clk_boosts;
+static clk_stats_t clk_st;
+static clk_governor_config_t clk_gov;
+
+static int clk_setup(void)
+{
+	clk_mutex = xSemaphoreCreateMutex();
+	if (clk_mutex == NULL)
+		return -1;
+
+	/* Only the boot configuration is known to be valid for the PLL */
+	clk_boot_hz = SystemCoreClock;
+	clk_cur = RCU->SYSCLKCFG_bit.SYSSEL == RCU_SYSCLKCFG_SYSSEL_HSE ?
+			  CLK_OP_HSE :
+			  CLK_OP_PLL;
+	clk_hz[CLK_OP_HSE] = HSECLK_VAL;
+	clk_hz[CLK_OP_PLL] = clk_cur == CLK_OP_PLL ? clk_boot_hz : 0;
+	clk_since = init_now();
+	return 0;
+}
+
+/** @brief Close the time slice of the current point, masked */
+static void clk_account(void)
+{
+	uint64_t now = init_now();
+
+	clk_st.op_us[clk_cur] += (now - clk_since) * 1000000 / MTIME_FREQ_HZ;
+	clk_since = now;
+}
+
+static void clk_hw_select(clk_op_t op)
+{
+	RCU->SYSCLKCFG_bit.SYSSEL = clk_sel[op];
+#ifndef SIM_HOST
+	while (RCU->SYSCLKSTAT_bit.SYSSTAT != clk_sel[op]) {
+	};
+#endif
+}
+
+#ifndef SIM_HOST
+/**
+ * @brief mtime rate right after a switch, from mcycle.
+ *
+ * Whether mtime runs off the core clock depends on the timer clock
+ * source left by the SDK, so the first switch measures it and
+ * snaps to the closer of the two cases.
+ */
+static uint8_t clk_mtime_probe(uint32_t core_hz)
+{
+	volatile uint32_t *mtime = (volatile uint32_t *)RISCV_MTIME_ADDR;
+	uint32_t t0 = *mtime, c0, hz, scaled;
+
+	while (*mtime == t0) {
+	};
+	c0 = csr_read_mcycle();
+	t0 = *mtime;
+	while (*mtime - t0 < CLK_MTIME_PROBE) {
+	};
+	hz = (uint64_t)core_hz * CLK_MTIME_PROBE / (csr_read_mcycle() - c0);
+	scaled = (uint64_t)MTIME_FREQ_HZ * core_hz / clk_boot_hz;
+
+	if ((hz > scaled ? hz - scaled : scaled - hz) <
+	    (hz > MTIME_FREQ_HZ ? hz - MTIME_FREQ_HZ : MTIME_FREQ_HZ - hz))
+		return CLK_MTIME_SCALED;
+	return CLK_MTIME_FIXED;
+}
+#endif
+
+/**
+ * @brief Whether mtime followed a switch to new_hz, masked.
+ *
+ * The kernel tick, init_now(), the I2C watchdog, ADC timestamps and
+ * the run time statistics all count mtime at MTIME_FREQ_HZ, and the
+ * port keeps its tick increment in flash. A clock that moves mtime
+ * is therefore not used at all.
+ */
+static int clk_mtime_scaled(uint32_t new_hz)
+{
+#ifndef SIM_HOST
+	if (clk_mtime_mode == CLK_MTIME_UNKNOWN && new_hz != clk_boot_hz)
+		clk_mtime_mode = clk_mtime_probe(new_hz);
+	return clk_mtime_mode == CLK_MTIME_SCALED;
+#else
+	/* The simulated mtime does not follow the core clock */
+	(void)new_hz;
+	return 0;
+#endif
+}
+
+void clk_notifier_register(clk_notifier_t *n, clk_notifier_cb_t cb,
+			   void *arg)
+{
+	uint32_t mie = irq_save();
+	clk_notifier_t **pp = &clk_list;
+
+	while (*pp && *pp != n)
+		pp = &(*pp)->next;
+	if (*pp == NULL) {
+		n->next = NULL;
+		n->cb = cb;
+		n->arg = arg;
+		*pp = n;
+	}
+	irq_restore(mie);
+}
+
+void clk_notifier_unregister(clk_notifier_t *n)
+{
+	uint32_t mie = irq_save();
+	clk_notifier_t **pp = &clk_list;
+
+	while (*pp && *pp != n)
+		pp = &(*pp)->next;
+	/* n->next stays valid for a change walking the list right now */
+	if (*pp)
+		*pp = n->next;
+	irq_restore(mie);
+}
+
+static void clk_notify(clk_notifier_t *from, clk_notifier_t *to,
+		       clk_event_t ev, uint32_t old_hz, uint32_t new_hz)
+{
+	for (clk_notifier_t *n = from; n != to; n = n->next)
+		n->cb(ev, old_hz, new_hz, n->arg);
+}
+
+int clk_set_op(clk_op_t op)
+{
+	uint32_t old_hz, new_hz, mie;
+	uint64_t t0;
+	clk_notifier_t *n;
+	int ret = CLK_OK;
+
+	if (op >= CLK_OP_COUNT || INIT_ONCE(&clk_once, clk_setup) != 0 ||
+	    clk_hz[op] == 0)
+		return CLK_ERR_PARAM;
+
+	xSemaphoreTake(clk_mutex, portMAX_DELAY);
+	if (op == clk_cur)
+		goto out;
+	if (clk_mtime_mode == CLK_MTIME_SCALED) {
+		ret = CLK_ERR_MTIME;
+		goto out;
+	}
+
+	t0 = init_now();
+	old_hz = SystemCoreClock;
+	new_hz = clk_hz[op];
+	for (n = clk_list; n; n = n->next)
+		if (n->cb(CLK_PRE_CHANGE, old_hz, new_hz, n->arg) != 0)
+			break;
+	if (n) {
+		clk_notify(clk_list, n, CLK_ABORT_CHANGE, old_hz, new_hz);
+		clk_st.vetoes++;
+		ret = CLK_ERR_BUSY;
+		goto out;
+	}
+
+	mie = irq_save();
+	clk_account();
+	clk_hw_select(op);
+	SystemCoreClockUpdate();
+	new_hz = SystemCoreClock;
+	if (clk_mtime_scaled(new_hz)) {
+		/* Back before anything ran at the new clock */
+		clk_hw_select(clk_cur);
+		SystemCoreClockUpdate();
+		irq_restore(mie);
+		clk_notify(clk_list, NULL, CLK_ABORT_CHANGE, old_hz, new_hz);
+		ret = CLK_ERR_MTIME;
+		goto out;
+	}
+	clk_cur = op;
+	clk_notify(clk_list, NULL, CLK_CHANGE, old_hz, new_hz);
+	irq_restore(mie);
+
+	clk_notify(clk_list, NULL, CLK_POST_CHANGE, old_hz, new_hz);
+
+	t0 = (init_now() - t0) * 1000000 / MTIME_FREQ_HZ;
+	clk_st.switches++;
+	if (t0 > clk_st.switch_us_max)
+		clk_st.switch_us_max = (uint32_t)t0;
+out:
+	xSemaphoreGive(clk_mutex);
+	return ret;
+}
+
+clk_op_t clk_get_op(void)
+{
+	if (INIT_ONCE(&clk_once, clk_setup) != 0)
+		return CLK_OP_PLL;
+	return clk_cur;
+}
+
+uint32_t clk_mtime_hz(void)
+{
+	return MTIME_FREQ_HZ;
+}
+
+int clk_boost_get(void)
+{
+	uint32_t mie = irq_save();
+	int ret;
+
+	clk_boosts++;
+	irq_restore(mie);
+
+	if (clk_get_op() == CLK_OP_PLL)
+		return CLK_OK;
+	ret = clk_set_op(CLK_OP_PLL);
+	if (ret == CLK_OK)
+		clk_st.boosts++;
+	return ret;
+}
+
+void clk_boost_put(void)
+{
+	uint32_t mie = irq_save();
+
+	if (clk_boosts)
+		clk_boosts--;
+	irq_restore(mie);
+}
+
+/**
+ * @brief Load governor.
+ *
+ * Load is the share of the period not spent in the idle task. It is
+ * measured at the current clock, so up_pct applies to HSE and
+ * down_pct to PLL: keep the gap wider than the clock ratio would
+ * move the load, or the governor oscillates.
+ */
+static void clk_governor(__attribute__((unused)) void *arg)
+{
+	TickType_t last = xTaskGetTickCount();
+	uint32_t idle0 = (uint32_t)ulTaskGetIdleRunTimeCounter();
+	uint32_t t0 = (uint32_t)portGET_RUN_TIME_COUNTER_VALUE();
+
+	while (1) {
+		uint32_t idle, t, load;
+		clk_op_t want;
+
+		vTaskDelayUntil(&last, pdMS_TO_TICKS(clk_gov.period_ms));
+		idle = (uint32_t)ulTaskGetIdleRunTimeCounter();
+		t = (uint32_t)portGET_RUN_TIME_COUNTER_VALUE();
+		if (t == t0)
+			continue;
+		load = 100 - (uint32_t)((uint64_t)(idle - idle0) * 100 /
+					(t - t0));
+		idle0 = idle;
+		t0 = t;
+
+		want = clk_cur;
+		if (clk_boosts || load >= clk_gov.up_pct)
+			want = CLK_OP_PLL;
+		else if (load <= clk_gov.down_pct)
+			want = CLK_OP_HSE;
+		if (want == clk_cur)
+			continue;
+		switch (clk_set_op(want)) {
+		case CLK_OK:
+			/* The switch itself is not load */
+			idle0 = (uint32_t)ulTaskGetIdleRunTimeCounter();
+			t0 = (uint32_t)portGET_RUN_TIME_COUNTER_VALUE();
+			break;
+		case CLK_ERR_MTIME:
+			/* Nothing left to govern */
+			vTaskDelete(NULL);
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+int clk_governor_start(const clk_governor_config_t *cfg)
+{
+	if (cfg == NULL || cfg->period_ms == 0 ||
+	    cfg->down_pct >= cfg->up_pct ||
+	    INIT_ONCE(&clk_once, clk_setup) != 0)
+		return -1;
+	clk_gov = *cfg;
+	if (xTaskCreate(clk_governor, "clk", 256, NULL, cfg->prio, NULL) !=
+	    pdPASS)
+		return -1;
+	return 0;
+}
+
+void clk_get_stats(clk_stats_t *stats)
+{
+	uint32_t mie = irq_save();
+
+	if (clk_mutex)
+		clk_account();
+	*stats = clk_st;
+	irq_restore(mie);
+}
@@ -0,0 +1,119 @@
+#ifndef __dma_h__
+#define __dma_h__
+
+#include <stdint.h>
+#include "K1921VG015.h"
+
+/*! CPP guard */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Number of channels of the DMA controller */
+#define DMA_CH_COUNT 24
+/** @brief Number of channels sharing one DMA interrupt line */
+#define DMA_CH_PER_IRQ 3
+/** @brief Number of DMA interrupt lines in the PLIC */
+#define DMA_IRQ_COUNT (DMA_CH_COUNT / DMA_CH_PER_IRQ)
+/** @brief Marker for "no DMA channel assigned" */
+#define DMA_CH_NONE 0xFF
+
+/** @brief Transfer unit width */
+#define DMA_XFER_BYTE (0 << 0)
+#define DMA_XFER_HALFWORD (1 << 0)
+#define DMA_XFER_WORD (2 << 0)
+#define DMA_XFER_WIDTH_Msk (3 << 0)
+/** @brief Increment source/destination address by the transfer width */
+#define DMA_XFER_SRC_INC (1 << 2)
+#define DMA_XFER_DST_INC (1 << 3)
+/** @brief Load the alternate control structure instead of the primary one */
+#define DMA_XFER_ALT (1 << 4)
+/** @brief Ping-pong cycle (primary and alternate structures take turns) */
+#define DMA_XFER_PINGPONG (1 << 5)
+/** @brief Auto-request cycle, whole transfer on one request (mem-to-mem) */
+#define DMA_XFER_AUTOREQ (1 << 6)
+
+/** @brief Maximum number of transfers of one DMA cycle */
+#define DMA_XFER_MAX 1024
+
+/**
+ * @brief Channel completion callback.
+ *
+ * Called from the DMA interrupt with the channel number
+ * and the argument given to dma_set_handler().
+ */
+typedef void (*dma_handler_t)(uint32_t ch, void *arg);
+
+/**
+ * @brief Initialize the DMA controller.
+ *
+ * Sets the control data base pointer, enables the controller
+ * and routes every DMA interrupt line to the common dispatcher.
+ * Safe to call more than once.
+ */
+void dma_init(void);
+
+/**
+ * @brief Install completion handler of a channel.
+ * @param ch Channel number
+ * @param handler Callback, NULL to disable the channel interrupt
+ * @param arg Callback argument
+ */
+void dma_set_handler(uint32_t ch, dma_handler_t handler, void *arg);
+
+/**
+ * @brief Load a control structure of a channel.
+ * @param ch Channel number
+ * @param src Source start address
+ * @param dst Destination start address
+ * @param count Number of transfers, 1..DMA_XFER_MAX
+ * @param flags DMA_XFER_* combination
+ *
+ * Only fills the control structure, the channel is started
+ * with dma_ch_enable().
+ */
+void dma_ch_setup(uint32_t ch, const volatile void *src, volatile void *dst,
+		  uint32_t count, uint32_t flags);
+
+/**
+ * @brief Number of transfers left in the primary or alternate structure.
+ * @param ch Channel number
+ * @param alt Non zero to query the alternate structure
+ */
+uint32_t dma_ch_remaining(uint32_t ch, int alt);
+
+/** @brief Enable channel (start waiting for requests) */
+static inline void dma_ch_enable(uint32_t ch)
+{
+	DMA->ENSET = 1UL << ch;
+}
+
+/** @brief Disable channel */
+static inline void dma_ch_disable(uint32_t ch)
+{
+	DMA->ENCLR = 1UL << ch;
+}
+
+/** @brief Channel is enabled (cycle not finished yet) */
+static inline int dma_ch_busy(uint32_t ch)
+{
+	return (DMA->ENSET & (1UL << ch)) != 0;
+}
+
+/** @brief Issue a software request on the channel */
+static inline void dma_ch_request(uint32_t ch)
+{
+	DMA->SWREQ = 1UL << ch;
+}
+
+/** @brief Select primary control structure for the next cycle */
+static inline void dma_ch_use_primary(uint32_t ch)
+{
+	DMA->PRIALTCLR = 1UL << ch;
+}
+
+#ifdef __cplusplus
+}
+#endif /* End of CPP guard */
+
+#endif //__dma_h__
@@ -0,0 +1,150 @@
+#ifndef __dma_mem_h__
+#define __dma_mem_h__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*! CPP guard */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DMA_MEM_OK 0
+#define DMA_MEM_ERR_PARAM -1
+/** @brief Status of a queued or running request */
+#define DMA_MEM_PENDING 1
+
+/** @brief Notification index dma_mem_wait() blocks on, 0 stays free */
+#define DMA_MEM_NOTIFY_INDEX 2
+
+/**
+ * @brief Requests up to this many bytes are done by the CPU.
+ *
+ * Below it the channel setup and the completion interrupt cost more
+ * than the copy; dma_mem_bench() measures where that is. 64 is a
+ * guess, not measured on a board yet: run the Bench firmware and
+ * take its bench,dma,cpu_max.
+ */
+#ifndef DMA_MEM_CPU_MAX
+#define DMA_MEM_CPU_MAX 64
+#endif
+
+/**
+ * @brief Upper bound of the CPU threshold.
+ *
+ * A CPU request queued behind DMA ones is copied by dma_mem_irq()
+ * with interrupts masked, this bounds that time.
+ */
+#ifndef DMA_MEM_CPU_LIMIT
+#define DMA_MEM_CPU_LIMIT 256
+#endif
+
+#if DMA_MEM_CPU_MAX > DMA_MEM_CPU_LIMIT
+#error "DMA_MEM_CPU_MAX above DMA_MEM_CPU_LIMIT"
+#endif
+
+typedef struct dma_mem_xfer dma_mem_xfer_t;
+
+/**
+ * @brief Completion callback, called from the DMA interrupt.
+ *
+ * Not called for requests the CPU finished before returning.
+ */
+typedef void (*dma_mem_done_t)(dma_mem_xfer_t *x, void *arg);
+
+/**
+ * @brief One copy or fill request.
+ *
+ * The structure and both buffers belong to the driver from
+ * dma_memcpy()/dma_memset() until status leaves DMA_MEM_PENDING.
+ */
+struct dma_mem_xfer {
+	/* Driver owned */
+	dma_mem_xfer_t *next;
+	uint8_t *dst;
+	const uint8_t *src; /**< &fill for dma_memset() */
+	uint32_t count; /**< DMA transfers left */
+	uint32_t fill; /**< dma_memset() value in every byte */
+	uint32_t tail; /**< bytes copied by the CPU after the DMA part */
+	uint8_t head; /**< and before it */
+	uint8_t width; /**< DMA_XFER_BYTE/HALFWORD/WORD */
+	uint8_t inc; /**< DMA_XFER_SRC_INC for copies */
+	dma_mem_done_t done;
+	void *arg;
+	TaskHandle_t owner;
+	volatile int status;
+};
+
+typedef struct {
+	uint32_t dma_xfers;
+	uint32_t dma_bytes;
+	uint32_t cpu_xfers; /**< at or below the threshold */
+	uint32_t cpu_bytes;
+	uint32_t queue_hwm; /**< max requests waiting at once */
+} dma_mem_stats_t;
+
+/**
+ * @brief Take a channel for memory to memory transfers.
+ * @param ch Channel, not routed to a peripheral in use
+ * @return DMA_MEM_OK, DMA_MEM_ERR_PARAM for a bad channel
+ *
+ * Calls dma_init(). Must be called before the scheduler starts or
+ * from a single task.
+ */
+int dma_mem_init(uint32_t ch);
+
+/**
+ * @brief Copy len bytes, without waiting for the copy.
+ * @param done Completion callback, NULL for none
+ * @return DMA_MEM_PENDING if queued, DMA_MEM_OK if already copied
+ *         by the CPU, DMA_MEM_ERR_PARAM
+ *
+ * Any context. Requests run one after another in submission order,
+ * so a copy may read what an earlier one writes. The widest transfer
+ * both addresses allow is used, a few unaligned bytes at the ends
+ * are copied by the CPU. Buffers must not overlap.
+ */
+int dma_memcpy(dma_mem_xfer_t *x, void *dst, const void *src, size_t len,
+	       dma_mem_done_t done, void *arg);
+
+/** @brief Fill len bytes with c, same rules as dma_memcpy() */
+int dma_memset(dma_mem_xfer_t *x, void *dst, int c, size_t len,
+	       dma_mem_done_t done, void *arg);
+
+/**
+ * @brief Wait for a request.
+ * @return Request status, DMA_MEM_PENDING if still running
+ *
+ * Uses the calling task's notification DMA_MEM_NOTIFY_INDEX, tasks
+ * only, one request at a time.
+ */
+int dma_mem_wait(dma_mem_xfer_t *x, TickType_t timeout);
+
+/**
+ * @brief Change the CPU threshold, DMA_MEM_CPU_MAX at init.
+ * @return Threshold set, bytes clamped to DMA_MEM_CPU_LIMIT
+ */
+uint32_t dma_mem_set_cpu_max(uint32_t bytes);
+
+void dma_mem_get_stats(dma_mem_stats_t *stats);
+
+/**
+ * @brief Compare DMA with CPU memcpy() at several sizes.
+ * @return Largest measured size the CPU copies faster, clamped to
+ *         DMA_MEM_CPU_LIMIT, which becomes the threshold; -1 on a
+ *         wrong copy
+ *
+ * Output lines are "bench,dma,memcpy_<bytes>_{cpu,dma,submit},
+ * <cycles>": memcpy() time, DMA time from submit to completion
+ * and CPU time of the submit alone, then "bench,dma,cpu_max,<bytes>".
+ * Needs dma_mem_init() and a task context; the channel must be idle.
+ */
+int dma_mem_bench(void);
+
+#ifdef __cplusplus
+}
+#endif /* End of CPP guard */
+
+#endif //__dma_mem_h__
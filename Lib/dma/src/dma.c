@@ -0,0 +1,124 @@
+#include "dma.h"
+#include "plic.h"
+#include "prof.h"
+
+/** @brief DMA control data structure aligned on 1024-byte boundary */
+DMA_CtrlData_TypeDef DMA_CONFIGDATA __attribute__((aligned(1024)));
+
+static struct {
+	dma_handler_t handler;
+	void *arg;
+} dma_handlers[DMA_CH_COUNT];
+
+/** @brief Channels with an installed completion handler */
+static volatile uint32_t dma_handler_msk;
+static uint8_t dma_ready;
+
+static const IsrVect_TypeDef dma_irq_vect[DMA_IRQ_COUNT] = {
+	IsrVect_IRQ_DMA0, IsrVect_IRQ_DMA1, IsrVect_IRQ_DMA2,
+	IsrVect_IRQ_DMA3, IsrVect_IRQ_DMA4, IsrVect_IRQ_DMA5,
+	IsrVect_IRQ_DMA6, IsrVect_IRQ_DMA7,
+};
+
+static void dma_irq_dispatch(void);
+
+void dma_init(void)
+{
+	if (dma_ready)
+		return;
+
+	DMA->BASEPTR = (uint32_t)(&DMA_CONFIGDATA);
+	DMA->CFG_bit.MASTEREN = 1;
+
+	for (uint32_t i = 0; i < DMA_IRQ_COUNT; i++) {
+		PLIC_SetIrqHandler(Plic_Mach_Target, dma_irq_vect[i],
+				   dma_irq_dispatch);
+		PLIC_SetPriority(dma_irq_vect[i], 0x1);
+	}
+	dma_ready = 1;
+}
+
+void dma_set_handler(uint32_t ch, dma_handler_t handler, void *arg)
+{
+	uint32_t line = ch / DMA_CH_PER_IRQ;
+
+	dma_handlers[ch].handler = handler;
+	dma_handlers[ch].arg = arg;
+
+	if (handler) {
+		dma_handler_msk |= 1UL << ch;
+		PLIC_IntEnable(Plic_Mach_Target, dma_irq_vect[line]);
+	} else {
+		dma_handler_msk &= ~(1UL << ch);
+	}
+}
+
+void dma_ch_setup(uint32_t ch, const volatile void *src, volatile void *dst,
+		  uint32_t count, uint32_t flags)
+{
+	uint32_t width = flags & DMA_XFER_WIDTH_Msk;
+	uint32_t last = (count - 1) << width;
+	uint32_t src_end = (uint32_t)src;
+	uint32_t dst_end = (uint32_t)dst;
+	uint32_t cycle = DMA_CHANNEL_CFG_CYCLE_CTRL_Basic;
+	DMA_Channel_TypeDef *desc = (flags & DMA_XFER_ALT) ?
+					    &DMA_CONFIGDATA.ALT_DATA.CH[ch] :
+					    &DMA_CONFIGDATA.PRM_DATA.CH[ch];
+
+	if (flags & DMA_XFER_SRC_INC)
+		src_end += last;
+	if (flags & DMA_XFER_DST_INC)
+		dst_end += last;
+	if (flags & DMA_XFER_PINGPONG)
+		cycle = DMA_CHANNEL_CFG_CYCLE_CTRL_PingPong;
+	else if (flags & DMA_XFER_AUTOREQ)
+		cycle = DMA_CHANNEL_CFG_CYCLE_CTRL_AutoReq;
+
+	desc->SRC_DATA_END_PTR = src_end;
+	desc->DST_DATA_END_PTR = dst_end;
+	desc->CHANNEL_CFG = 0;
+	desc->CHANNEL_CFG_bit.SRC_SIZE = width;
+	desc->CHANNEL_CFG_bit.DST_SIZE = width;
+	desc->CHANNEL_CFG_bit.SRC_INC = (flags & DMA_XFER_SRC_INC) ?
+						width :
+						DMA_CHANNEL_CFG_SRC_INC_None;
+	desc->CHANNEL_CFG_bit.DST_INC = (flags & DMA_XFER_DST_INC) ?
+						width :
+						DMA_CHANNEL_CFG_DST_INC_None;
+	/* Arbitrate after every transfer for peripherals, after 1024 for memory */
+	desc->CHANNEL_CFG_bit.R_POWER = (flags & DMA_XFER_AUTOREQ) ? 10 : 0;
+	desc->CHANNEL_CFG_bit.N_MINUS_1 = count - 1;
+	desc->CHANNEL_CFG_bit.CYCLE_CTRL = cycle;
+}
+
+uint32_t dma_ch_remaining(uint32_t ch, int alt)
+{
+	DMA_Channel_TypeDef *desc = alt ? &DMA_CONFIGDATA.ALT_DATA.CH[ch] :
+					  &DMA_CONFIGDATA.PRM_DATA.CH[ch];
+
+	/* Stopped cycle reports N_MINUS_1 = 0 with CYCLE_CTRL cleared */
+	if (desc->CHANNEL_CFG_bit.CYCLE_CTRL ==
+	    DMA_CHANNEL_CFG_CYCLE_CTRL_Stop)
+		return 0;
+	return desc->CHANNEL_CFG_bit.N_MINUS_1 + 1;
+}
+
+/**
+ * @brief Common handler of all DMA interrupt lines.
+ *
+ * Every line shares the same status register, so each pending
+ * channel with a handler is serviced whatever line fired.
+ */
+static void dma_irq_dispatch(void)
+{
+	uint32_t pend = DMA->IRQSTAT & dma_handler_msk;
+	PROF_SCOPE(dma_isr);
+
+	while (pend) {
+		uint32_t ch = __builtin_ctz(pend);
+
+		pend &= pend - 1;
+		DMA->IRQSTATCLR = 1UL << ch;
+		dma_handlers[ch].handler(ch, dma_handlers[ch].arg);
+	}
+}
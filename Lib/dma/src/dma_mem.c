@@ -0,0 +1,258 @@
+#include <string.h>
+#include "dma.h"
+#include "dma_mem.h"
+#include "riscv-irq.h"
+
+static uint32_t dma_mem_ch = DMA_CH_NONE;
+static uint32_t dma_mem_cpu_max = DMA_MEM_CPU_MAX;
+
+/* Request queue, the head is the running one */
+static dma_mem_xfer_t *dma_mem_cur;
+static dma_mem_xfer_t *dma_mem_last;
+static uint32_t dma_mem_waiting;
+static uint8_t dma_mem_armed; /**< channel runs a cycle of dma_mem_cur */
+
+static dma_mem_stats_t dma_mem_st;
+
+static void dma_mem_cpu(dma_mem_xfer_t *x, uint32_t n)
+{
+	if (x->inc) {
+		memcpy(x->dst, x->src, n);
+		x->src += n;
+	} else {
+		memset(x->dst, (int)(x->fill & 0xFF), n);
+	}
+	x->dst += n;
+}
+
+/**
+ * @brief Split a request into CPU head, DMA transfers and CPU tail.
+ * @param align Address bits that must be zero for a width, dst ^ src
+ *              for copies
+ *
+ * The head brings dst (and with it src) to the widest width the
+ * alignment allows, the tail is what is left of a unit.
+ */
+static void dma_mem_split(dma_mem_xfer_t *x, uint32_t len, uint32_t align)
+{
+	uint32_t w = (align & 3) == 0 ? DMA_XFER_WORD :
+		     (align & 1) == 0 ? DMA_XFER_HALFWORD :
+					DMA_XFER_BYTE;
+	uint32_t head = -(uint32_t)(uintptr_t)x->dst & ((1UL << w) - 1);
+
+	if (head > len)
+		head = len;
+	x->width = (uint8_t)w;
+	x->head = (uint8_t)head;
+	x->count = (len - head) >> w;
+	x->tail = len - head - (x->count << w);
+}
+
+/** @brief Next DMA cycle of the running request */
+static void dma_mem_arm(dma_mem_xfer_t *x)
+{
+	uint32_t n = x->count < DMA_XFER_MAX ? x->count : DMA_XFER_MAX;
+
+	dma_ch_use_primary(dma_mem_ch);
+	dma_ch_setup(dma_mem_ch, x->src, x->dst, n,
+		     x->width | x->inc | DMA_XFER_DST_INC | DMA_XFER_AUTOREQ);
+	dma_mem_armed = 1;
+	dma_ch_enable(dma_mem_ch);
+	dma_ch_request(dma_mem_ch);
+}
+
+static void dma_mem_finish(dma_mem_xfer_t *x, BaseType_t *woken)
+{
+	TaskHandle_t owner = x->owner;
+	dma_mem_done_t done = x->done;
+	void *arg = x->arg;
+
+	/* The callback may submit the request again */
+	x->status = DMA_MEM_OK;
+	if (done)
+		done(x, arg);
+	if (owner)
+		vTaskNotifyGiveIndexedFromISR(owner, DMA_MEM_NOTIFY_INDEX,
+					      woken);
+}
+
+/**
+ * @brief Start the queue head, finishing CPU only requests on the way.
+ *
+ * Called with interrupts masked. A callback that submits a request
+ * arms the channel itself, the loop then stops.
+ */
+static void dma_mem_run(BaseType_t *woken)
+{
+	dma_mem_xfer_t *x;
+
+	while (!dma_mem_armed && (x = dma_mem_cur) != NULL) {
+		if (x->head) {
+			dma_mem_cpu(x, x->head);
+			x->head = 0;
+		}
+		if (x->count) {
+			dma_mem_arm(x);
+			return;
+		}
+		dma_mem_cpu(x, x->tail);
+		dma_mem_cur = x->next;
+		if (dma_mem_cur == NULL)
+			dma_mem_last = NULL;
+		dma_mem_waiting--;
+		dma_mem_finish(x, woken);
+	}
+}
+
+static void dma_mem_irq(__attribute__((unused)) uint32_t ch,
+			__attribute__((unused)) void *arg)
+{
+	uint32_t mie = irq_save();
+	dma_mem_xfer_t *x = dma_mem_cur;
+	BaseType_t woken = pdFALSE;
+	uint32_t n;
+
+	/* Stray completion, nothing of ours on the channel */
+	if (!dma_mem_armed || x == NULL) {
+		irq_restore(mie);
+		return;
+	}
+	n = x->count < DMA_XFER_MAX ? x->count : DMA_XFER_MAX;
+	dma_mem_armed = 0;
+	x->dst += n << x->width;
+	if (x->inc)
+		x->src += n << x->width;
+	x->count -= n;
+	dma_mem_run(&woken);
+	irq_restore(mie);
+	portYIELD_FROM_ISR(woken);
+}
+
+static int dma_mem_submit(dma_mem_xfer_t *x, uint32_t len, uint32_t align,
+			  dma_mem_done_t done, void *arg)
+{
+	uint32_t mie;
+
+	dma_mem_split(x, len, align);
+	x->done = done;
+	x->arg = arg;
+	x->owner = NULL;
+	x->next = NULL;
+
+	mie = irq_save();
+	if (len <= dma_mem_cpu_max || x->count == 0) {
+		dma_mem_st.cpu_xfers++;
+		dma_mem_st.cpu_bytes += len;
+		/* Small ones with nothing queued ahead go now */
+		if (dma_mem_cur == NULL) {
+			irq_restore(mie);
+			dma_mem_cpu(x, len);
+			x->status = DMA_MEM_OK;
+			return DMA_MEM_OK;
+		}
+		x->head = 0;
+		x->count = 0;
+		x->tail = len;
+	} else {
+		dma_mem_st.dma_xfers++;
+		dma_mem_st.dma_bytes += len;
+	}
+
+	x->status = DMA_MEM_PENDING;
+	if (dma_mem_last)
+		dma_mem_last->next = x;
+	else
+		dma_mem_cur = x;
+	dma_mem_last = x;
+	if (++dma_mem_waiting > dma_mem_st.queue_hwm)
+		dma_mem_st.queue_hwm = dma_mem_waiting;
+	dma_mem_run(NULL);
+	irq_restore(mie);
+	return DMA_MEM_PENDING;
+}
+
+int dma_memcpy(dma_mem_xfer_t *x, void *dst, const void *src, size_t len,
+	       dma_mem_done_t done, void *arg)
+{
+	if (x == NULL || dst == NULL || src == NULL ||
+	    dma_mem_ch == DMA_CH_NONE)
+		return DMA_MEM_ERR_PARAM;
+	x->dst = dst;
+	x->src = src;
+	x->inc = DMA_XFER_SRC_INC;
+	/* Both addresses move together: only their difference counts */
+	return dma_mem_submit(x, (uint32_t)len,
+			      (uint32_t)((uintptr_t)dst ^ (uintptr_t)src), done,
+			      arg);
+}
+
+int dma_memset(dma_mem_xfer_t *x, void *dst, int c, size_t len,
+	       dma_mem_done_t done, void *arg)
+{
+	if (x == NULL || dst == NULL || dma_mem_ch == DMA_CH_NONE)
+		return DMA_MEM_ERR_PARAM;
+	x->dst = dst;
+	x->fill = (uint8_t)c * 0x01010101UL;
+	x->src = (const uint8_t *)&x->fill;
+	x->inc = 0;
+	return dma_mem_submit(x, (uint32_t)len, 0, done, arg);
+}
+
+/** @brief Drop wake-ups no wait is going to take, outside the lock */
+static void dma_mem_notify_clear(void)
+{
+	(void)xTaskNotifyStateClearIndexed(NULL, DMA_MEM_NOTIFY_INDEX);
+	(void)ulTaskNotifyValueClearIndexed(NULL, DMA_MEM_NOTIFY_INDEX,
+					    UINT32_MAX);
+}
+
+int dma_mem_wait(dma_mem_xfer_t *x, TickType_t timeout)
+{
+	uint32_t mie;
+	TimeOut_t to;
+
+	dma_mem_notify_clear();
+	mie = irq_save();
+	if (x->status == DMA_MEM_PENDING)
+		x->owner = xTaskGetCurrentTaskHandle();
+	irq_restore(mie);
+
+	vTaskSetTimeOutState(&to);
+	while (x->status == DMA_MEM_PENDING) {
+		if (xTaskCheckForTimeOut(&to, &timeout) == pdTRUE)
+			break;
+		(void)ulTaskNotifyTakeIndexed(DMA_MEM_NOTIFY_INDEX, pdTRUE,
+					      timeout);
+	}
+
+	/* A late completion must not wake the next wait */
+	mie = irq_save();
+	x->owner = NULL;
+	irq_restore(mie);
+	dma_mem_notify_clear();
+	return x->status;
+}
+
+uint32_t dma_mem_set_cpu_max(uint32_t bytes)
+{
+	dma_mem_cpu_max = bytes < DMA_MEM_CPU_LIMIT ? bytes : DMA_MEM_CPU_LIMIT;
+	return dma_mem_cpu_max;
+}
+
+void dma_mem_get_stats(dma_mem_stats_t *stats)
+{
+	uint32_t mie = irq_save();
+
+	*stats = dma_mem_st;
+	irq_restore(mie);
+}
+
+int dma_mem_init(uint32_t ch)
+{
+	if (ch >= DMA_CH_COUNT)
+		return DMA_MEM_ERR_PARAM;
+	dma_init();
+	dma_mem_ch = ch;
+	dma_set_handler(ch, dma_mem_irq, NULL);
+	return DMA_MEM_OK;
+}
@@ -0,0 +1,69 @@
+#include <stdio.h>
+#include <string.h>
+#include "dma_mem.h"
+#include "riscv-csr.h"
+
+#define DMA_MEM_BENCH_MAX 8192
+#define DMA_MEM_BENCH_REPS 8
+
+static uint32_t bench_src[DMA_MEM_BENCH_MAX / 4];
+static uint32_t bench_dst[DMA_MEM_BENCH_MAX / 4];
+
+static const uint32_t bench_sizes[] = {
+	16, 32, 64, 128, 256, 512, 1024, 4096, DMA_MEM_BENCH_MAX,
+};
+
+static void dma_mem_bench_print(uint32_t n, const char *what, uint32_t v)
+{
+	printf("bench,dma,memcpy_%lu_%s,%lu\r\n", (unsigned long)n, what,
+	       (unsigned long)v);
+}
+
+int dma_mem_bench(void)
+{
+	uint32_t cpu_max = 0;
+	dma_mem_xfer_t x;
+
+	for (uint32_t i = 0; i < DMA_MEM_BENCH_MAX / 4; i++)
+		bench_src[i] = i * 0x9E3779B9u;
+	/* Every size through the channel */
+	dma_mem_set_cpu_max(0);
+
+	for (uint32_t s = 0; s < sizeof(bench_sizes) / sizeof(bench_sizes[0]);
+	     s++) {
+		uint32_t n = bench_sizes[s], cpu = 0, dma = 0, sub = 0, c0;
+
+		for (uint32_t r = 0; r < DMA_MEM_BENCH_REPS; r++) {
+			c0 = csr_read_mcycle();
+			memcpy(bench_dst, bench_src, n);
+			cpu += csr_read_mcycle() - c0;
+
+			memset(bench_dst, 0, n);
+			c0 = csr_read_mcycle();
+			if (dma_memcpy(&x, bench_dst, bench_src, n, NULL,
+				       NULL) != DMA_MEM_PENDING) {
+				dma_mem_set_cpu_max(DMA_MEM_CPU_MAX);
+				return -1;
+			}
+			sub += csr_read_mcycle() - c0;
+			while (x.status == DMA_MEM_PENDING)
+				;
+			dma += csr_read_mcycle() - c0;
+			if (memcmp(bench_dst, bench_src, n) != 0) {
+				dma_mem_set_cpu_max(DMA_MEM_CPU_MAX);
+				return -1;
+			}
+		}
+		cpu /= DMA_MEM_BENCH_REPS;
+		dma /= DMA_MEM_BENCH_REPS;
+		sub /= DMA_MEM_BENCH_REPS;
+		dma_mem_bench_print(n, "cpu", cpu);
+		dma_mem_bench_print(n, "dma", dma);
+		dma_mem_bench_print(n, "submit", sub);
+		if (cpu <= dma)
+			cpu_max = n;
+	}
+
+	printf("bench,dma,cpu_max,%lu\r\n", (unsigned long)cpu_max);
+	return (int)dma_mem_set_cpu_max(cpu_max);
+}
@@ -0,0 +1,217 @@
+#ifndef __dsp_h__
+#define __dsp_h__
+
+#include <stdint.h>
+
+/*! CPP guard */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Largest real FFT length; twiddle tables in flash are sized
+ * for it (see Tools/dsp_twiddle_gen.py).
+ */
+#define DSP_FFT_MAX 1024
+
+/**
+ * @brief Placement of the hot loops.
+ *
+ * On target the kernels run from RAM (.RamFunc) to avoid flash wait
+ * states; on the host build this expands to nothing.
+ */
+#if defined(__riscv) && !defined(DSP_NO_RAMFUNC)
+#define DSP_RAMFUNC __attribute__((section(".RamFunc"), noinline))
+#else
+#define DSP_RAMFUNC
+#endif
+
+typedef int16_t q15_t;
+typedef int32_t q31_t;
+
+/** @brief Saturate to Q15/Q31 (min/max map onto Zbb instructions) */
+static inline q15_t dsp_sat_q15(int32_t v)
+{
+	v = v < INT16_MIN ? INT16_MIN : v;
+	return (q15_t)(v > INT16_MAX ? INT16_MAX : v);
+}
+
+static inline q31_t dsp_sat_q31(int64_t v)
+{
+	v = v < INT32_MIN ? INT32_MIN : v;
+	return (q31_t)(v > INT32_MAX ? INT32_MAX : v);
+}
+
+/* FIR ---------------------------------------------------------------------- */
+
+/**
+ * @brief FIR filter instances.
+ *
+ * coeffs are in natural order b[0..ntaps). state holds
+ * ntaps - 1 + max block size samples. decim is the decimation
+ * factor (1 = plain FIR); block sizes must be multiples of it.
+ */
+typedef struct {
+	const float *coeffs;
+	float *state;
+	uint16_t ntaps;
+	uint16_t decim;
+} dsp_fir_f32_t;
+
+typedef struct {
+	const q15_t *coeffs;
+	q15_t *state;
+	uint16_t ntaps;
+	uint16_t decim;
+} dsp_fir_q15_t;
+
+typedef struct {
+	const q31_t *coeffs;
+	q31_t *state;
+	uint16_t ntaps;
+	uint16_t decim;
+} dsp_fir_q31_t;
+
+void dsp_fir_init_f32(dsp_fir_f32_t *f, const float *coeffs, float *state,
+		      uint16_t ntaps, uint16_t decim);
+void dsp_fir_init_q15(dsp_fir_q15_t *f, const q15_t *coeffs, q15_t *state,
+		      uint16_t ntaps, uint16_t decim);
+void dsp_fir_init_q31(dsp_fir_q31_t *f, const q31_t *coeffs, q31_t *state,
+		      uint16_t ntaps, uint16_t decim);
+
+/** @brief Filter n input samples into n / decim output samples */
+void dsp_fir_f32(dsp_fir_f32_t *f, const float *in, float *out, uint32_t n);
+void dsp_fir_q15(dsp_fir_q15_t *f, const q15_t *in, q15_t *out, uint32_t n);
+void dsp_fir_q31(dsp_fir_q31_t *f, const q31_t *in, q31_t *out, uint32_t n);
+
+/* Biquad IIR cascade ------------------------------------------------------- */
+
+/**
+ * @brief Cascade of second order sections.
+ *
+ * Per stage coefficients {b0, b1, b2, a1, a2} of
+ * H(z) = (b0 + b1 z^-1 + b2 z^-2) / (1 + a1 z^-1 + a2 z^-2).
+ * Float runs transposed direct form II (2 state words per stage),
+ * fixed point runs direct form I (4 state words per stage) with
+ * coefficients scaled down by 2^shift (at most 15 for Q15, 31 for
+ * Q31; init clamps larger values).
+ */
+typedef struct {
+	const float *coeffs;
+	float *state;
+	uint8_t stages;
+} dsp_biquad_f32_t;
+
+typedef struct {
+	const q15_t *coeffs;
+	q15_t *state;
+	uint8_t stages;
+	uint8_t shift;
+} dsp_biquad_q15_t;
+
+typedef struct {
+	const q31_t *coeffs;
+	q31_t *state;
+	uint8_t stages;
+	uint8_t shift;
+} dsp_biquad_q31_t;
+
+void dsp_biquad_init_f32(dsp_biquad_f32_t *f, const float *coeffs,
+			 float *state, uint8_t stages);
+void dsp_biquad_init_q15(dsp_biquad_q15_t *f, const q15_t *coeffs,
+			 q15_t *state, uint8_t stages, uint8_t shift);
+void dsp_biquad_init_q31(dsp_biquad_q31_t *f, const q31_t *coeffs,
+			 q31_t *state, uint8_t stages, uint8_t shift);
+
+void dsp_biquad_f32(dsp_biquad_f32_t *f, const float *in, float *out,
+		    uint32_t n);
+void dsp_biquad_q15(dsp_biquad_q15_t *f, const q15_t *in, q15_t *out,
+		    uint32_t n);
+void dsp_biquad_q31(dsp_biquad_q31_t *f, const q31_t *in, q31_t *out,
+		    uint32_t n);
+
+/* FFT ---------------------------------------------------------------------- */
+
+/**
+ * @brief Complex FFT in place, n = power of two up to DSP_FFT_MAX / 2.
+ *
+ * Radix-2^2 decimation in frequency (radix-4 butterflies, one
+ * radix-2 stage for odd log2(n)) followed by bit reversal.
+ * Data is interleaved re/im.
+ * @return 0, -1 on unsupported length
+ */
+int dsp_cfft_f32(float *buf, uint32_t n);
+
+/**
+ * @brief Complex FFT in place, Q15, scaled by 1/n to avoid overflow.
+ * @return 0, -1 on unsupported length
+ */
+int dsp_cfft_q15(q15_t *buf, uint32_t n);
+
+/**
+ * @brief Complex FFT in place, Q31, scaled by 1/n to avoid overflow.
+ *
+ * Inputs of magnitude up to 1 cannot saturate.
+ * @return 0, -1 on unsupported length
+ */
+int dsp_cfft_q31(q31_t *buf, uint32_t n);
+
+/**
+ * @brief Real FFT of n points (power of two, 4..DSP_FFT_MAX).
+ * @param buf n real samples in, packed spectrum out:
+ *            buf[0] = X[0], buf[1] = X[n/2] (both real),
+ *            buf[2k], buf[2k+1] = Re/Im X[k] for 0 < k < n/2
+ * @return 0, -1 on unsupported length
+ */
+int dsp_rfft_f32(float *buf, uint32_t n);
+
+/**
+ * @brief Real FFT, Q31, same packing as dsp_rfft_f32(), scaled by 1/n.
+ * @return 0, -1 on unsupported length
+ */
+int dsp_rfft_q31(q31_t *buf, uint32_t n);
+
+/** @brief Squared magnitude of a packed real spectrum, n/2 + 1 bins */
+void dsp_rfft_power_f32(const float *spec, float *power, uint32_t n);
+
+/* Windows ------------------------------------------------------------------ */
+
+typedef enum {
+	DSP_WIN_HANN = 0,
+	DSP_WIN_HAMMING,
+	DSP_WIN_BLACKMAN,
+} dsp_window_t;
+
+/** @brief Fill n periodic window coefficients */
+void dsp_window_f32(float *w, uint32_t n, dsp_window_t type);
+void dsp_window_q15(q15_t *w, uint32_t n, dsp_window_t type);
+
+/** @brief out[i] = in[i] * w[i], in place allowed */
+void dsp_mul_f32(const float *in, const float *w, float *out, uint32_t n);
+void dsp_mul_q15(const q15_t *in, const q15_t *w, q15_t *out, uint32_t n);
+
+/* Statistics --------------------------------------------------------------- */
+
+float dsp_rms_f32(const float *in, uint32_t n);
+q15_t dsp_rms_q15(const q15_t *in, uint32_t n);
+q31_t dsp_rms_q31(const q31_t *in, uint32_t n);
+
+/** @brief Largest absolute value and its index */
+float dsp_peak_f32(const float *in, uint32_t n, uint32_t *idx);
+q15_t dsp_peak_q15(const q15_t *in, uint32_t n, uint32_t *idx);
+q31_t dsp_peak_q31(const q31_t *in, uint32_t n, uint32_t *idx);
+
+/* Benchmark ---------------------------------------------------------------- */
+
+/**
+ * @brief Run every kernel on synthetic data and print cycle counts.
+ *
+ * Output lines are "bench,dsp,<kernel>,<cycles>". Target only.
+ */
+void dsp_bench(void);
+
+#ifdef __cplusplus
+}
+#endif /* End of CPP guard */
+
+#endif //__dsp_h__
@@ -0,0 +1,133 @@
+#include <string.h>
+#include "dsp.h"
+
+void dsp_biquad_init_f32(dsp_biquad_f32_t *f, const float *coeffs,
+			 float *state, uint8_t stages)
+{
+	f->coeffs = coeffs;
+	f->state = state;
+	f->stages = stages;
+	memset(state, 0, 2 * stages * sizeof(float));
+}
+
+void dsp_biquad_init_q15(dsp_biquad_q15_t *f, const q15_t *coeffs,
+			 q15_t *state, uint8_t stages, uint8_t shift)
+{
+	f->coeffs = coeffs;
+	f->state = state;
+	f->stages = stages;
+	/* Products are Q30, at most 15 bits of shift are left to undo */
+	f->shift = shift > 15 ? 15 : shift;
+	memset(state, 0, 4 * stages * sizeof(q15_t));
+}
+
+void dsp_biquad_init_q31(dsp_biquad_q31_t *f, const q31_t *coeffs,
+			 q31_t *state, uint8_t stages, uint8_t shift)
+{
+	f->coeffs = coeffs;
+	f->state = state;
+	f->stages = stages;
+	f->shift = shift > 31 ? 31 : shift;
+	memset(state, 0, 4 * stages * sizeof(q31_t));
+}
+
+/*
+ * Stages run one after another over the whole block (out of stage k is
+ * in of stage k + 1), so coefficients and state stay in registers for
+ * the inner loop.
+ */
+
+DSP_RAMFUNC void dsp_biquad_f32(dsp_biquad_f32_t *f, const float *in,
+				float *out, uint32_t n)
+{
+	const float *c = f->coeffs;
+	float *st = f->state;
+	const float *src = in;
+
+	for (uint32_t s = 0; s < f->stages; s++, c += 5, st += 2) {
+		const float b0 = c[0], b1 = c[1], b2 = c[2];
+		const float a1 = c[3], a2 = c[4];
+		float s1 = st[0], s2 = st[1];
+
+		for (uint32_t i = 0; i < n; i++) {
+			float x = src[i];
+			float y = b0 * x + s1;
+
+			s1 = b1 * x - a1 * y + s2;
+			s2 = b2 * x - a2 * y;
+			out[i] = y;
+		}
+		st[0] = s1;
+		st[1] = s2;
+		src = out;
+	}
+}
+
+DSP_RAMFUNC void dsp_biquad_q15(dsp_biquad_q15_t *f, const q15_t *in,
+				q15_t *out, uint32_t n)
+{
+	const q15_t *c = f->coeffs;
+	q15_t *st = f->state;
+	const q15_t *src = in;
+	const uint32_t sh = 15 - f->shift;
+	const int64_t rnd = sh ? (int64_t)1 << (sh - 1) : 0;
+
+	for (uint32_t s = 0; s < f->stages; s++, c += 5, st += 4) {
+		const int32_t b0 = c[0], b1 = c[1], b2 = c[2];
+		const int32_t a1 = c[3], a2 = c[4];
+		int32_t x1 = st[0], x2 = st[1], y1 = st[2], y2 = st[3];
+
+		for (uint32_t i = 0; i < n; i++) {
+			int32_t x = src[i];
+			int64_t acc = (int64_t)b0 * x + (int64_t)b1 * x1 +
+				      (int64_t)b2 * x2 - (int64_t)a1 * y1 -
+				      (int64_t)a2 * y2;
+			int32_t y = dsp_sat_q15(
+				dsp_sat_q31((acc + rnd) >> sh));
+
+			x2 = x1;
+			x1 = x;
+			y2 = y1;
+			y1 = y;
+			out[i] = (q15_t)y;
+		}
+		st[0] = (q15_t)x1;
+		st[1] = (q15_t)x2;
+		st[2] = (q15_t)y1;
+		st[3] = (q15_t)y2;
+		src = out;
+	}
+}
+
+DSP_RAMFUNC void dsp_biquad_q31(dsp_biquad_q31_t *f, const q31_t *in,
+				q31_t *out, uint32_t n)
+{
+	const q31_t *c = f->coeffs;
+	q31_t *st = f->state;
+	const q31_t *src = in;
+	const uint32_t sh = 31 - f->shift;
+
+	for (uint32_t s = 0; s < f->stages; s++, c += 5, st += 4) {
+		const int64_t b0 = c[0], b1 = c[1], b2 = c[2];
+		const int64_t a1 = c[3], a2 = c[4];
+		q31_t x1 = st[0], x2 = st[1], y1 = st[2], y2 = st[3];
+
+		for (uint32_t i = 0; i < n; i++) {
+			q31_t x = src[i];
+			int64_t acc = b0 * x + b1 * x1 + b2 * x2 - a1 * y1 -
+				      a2 * y2;
+			q31_t y = dsp_sat_q31(acc >> sh);
+
+			x2 = x1;
+			x1 = x;
+			y2 = y1;
+			y1 = y;
+			out[i] = y;
+		}
+		st[0] = x1;
+		st[1] = x2;
+		st[2] = y1;
+		st[3] = y2;
+		src = out;
+	}
+}
@@ -0,0 +1,126 @@
+#include <stdio.h>
+#include "dsp.h"
+#include "riscv-csr.h"
+
+#define DSP_BENCH_N 256
+#define DSP_BENCH_TAPS 32
+#define DSP_BENCH_STAGES 4
+
+static float bench_f32[DSP_FFT_MAX];
+static float bench_out_f32[DSP_BENCH_N];
+static float bench_state_f32[DSP_BENCH_TAPS - 1 + DSP_BENCH_N];
+static float bench_taps_f32[DSP_BENCH_TAPS];
+static q15_t bench_q15[2 * DSP_BENCH_N];
+static q15_t bench_out_q15[DSP_BENCH_N];
+static q15_t bench_state_q15[DSP_BENCH_TAPS - 1 + DSP_BENCH_N];
+static q15_t bench_taps_q15[DSP_BENCH_TAPS];
+static q31_t bench_q31[DSP_FFT_MAX];
+static q31_t bench_out_q31[DSP_BENCH_N];
+static q31_t bench_state_q31[DSP_BENCH_TAPS - 1 + DSP_BENCH_N];
+static q31_t bench_taps_q31[DSP_BENCH_TAPS];
+
+static const float bench_sos_f32[5 * DSP_BENCH_STAGES] = {
+	0.2f, 0.4f, 0.2f, -0.5f, 0.3f, 0.2f, 0.4f, 0.2f, -0.5f, 0.3f,
+	0.2f, 0.4f, 0.2f, -0.5f, 0.3f, 0.2f, 0.4f, 0.2f, -0.5f, 0.3f,
+};
+/* Same sections in Q14 (shift 1) */
+static const q15_t bench_sos_q15[5 * DSP_BENCH_STAGES] = {
+	3277, 6554, 3277, -8192, 4915, 3277, 6554, 3277, -8192, 4915,
+	3277, 6554, 3277, -8192, 4915, 3277, 6554, 3277, -8192, 4915,
+};
+/* And in Q30 */
+static const q31_t bench_sos_q31[5 * DSP_BENCH_STAGES] = {
+	214748365, 429496730, 214748365, -536870912, 322122547,
+	214748365, 429496730, 214748365, -536870912, 322122547,
+	214748365, 429496730, 214748365, -536870912, 322122547,
+	214748365, 429496730, 214748365, -536870912, 322122547,
+};
+static float bench_bq_state_f32[2 * DSP_BENCH_STAGES];
+static q15_t bench_bq_state_q15[4 * DSP_BENCH_STAGES];
+static q31_t bench_bq_state_q31[4 * DSP_BENCH_STAGES];
+
+static void dsp_bench_fill(void)
+{
+	uint32_t seed = 1;
+
+	for (uint32_t i = 0; i < DSP_FFT_MAX; i++) {
+		seed = seed * 1103515245 + 12345;
+		bench_f32[i] = (float)(int16_t)(seed >> 16) / 32768.0f;
+	}
+	for (uint32_t i = 0; i < 2 * DSP_BENCH_N; i++)
+		bench_q15[i] = (q15_t)(bench_f32[i] * 16384.0f);
+	for (uint32_t i = 0; i < DSP_FFT_MAX; i++)
+		bench_q31[i] = (q31_t)(bench_f32[i] * 1073741824.0f);
+	for (uint32_t i = 0; i < DSP_BENCH_TAPS; i++) {
+		bench_taps_f32[i] = 1.0f / DSP_BENCH_TAPS;
+		bench_taps_q15[i] = 32768 / DSP_BENCH_TAPS;
+		bench_taps_q31[i] = (q31_t)(0x80000000UL / DSP_BENCH_TAPS);
+	}
+}
+
+static void dsp_bench_print(const char *name, uint32_t cycles)
+{
+	printf("bench,dsp,%s,%lu\r\n", name, (unsigned long)cycles);
+}
+
+#define DSP_BENCH_RUN(name, call)                              \
+	do {                                                   \
+		uint32_t t0 = csr_read_mcycle();               \
+		call;                                          \
+		dsp_bench_print(name, csr_read_mcycle() - t0); \
+	} while (0)
+
+void dsp_bench(void)
+{
+	dsp_fir_f32_t fir_f32;
+	dsp_fir_q15_t fir_q15;
+	dsp_fir_q31_t fir_q31;
+	dsp_biquad_f32_t bq_f32;
+	dsp_biquad_q15_t bq_q15;
+	dsp_biquad_q31_t bq_q31;
+	uint32_t idx;
+
+	dsp_bench_fill();
+	dsp_fir_init_f32(&fir_f32, bench_taps_f32, bench_state_f32,
+			 DSP_BENCH_TAPS, 1);
+	dsp_fir_init_q15(&fir_q15, bench_taps_q15, bench_state_q15,
+			 DSP_BENCH_TAPS, 1);
+	dsp_fir_init_q31(&fir_q31, bench_taps_q31, bench_state_q31,
+			 DSP_BENCH_TAPS, 1);
+	dsp_biquad_init_f32(&bq_f32, bench_sos_f32, bench_bq_state_f32,
+			    DSP_BENCH_STAGES);
+	dsp_biquad_init_q15(&bq_q15, bench_sos_q15, bench_bq_state_q15,
+			    DSP_BENCH_STAGES, 1);
+	dsp_biquad_init_q31(&bq_q31, bench_sos_q31, bench_bq_state_q31,
+			    DSP_BENCH_STAGES, 1);
+
+	DSP_BENCH_RUN("fir_f32_32x256",
+		      dsp_fir_f32(&fir_f32, bench_f32, bench_out_f32,
+				  DSP_BENCH_N));
+	DSP_BENCH_RUN("fir_q15_32x256",
+		      dsp_fir_q15(&fir_q15, bench_q15, bench_out_q15,
+				  DSP_BENCH_N));
+	DSP_BENCH_RUN("fir_q31_32x256",
+		      dsp_fir_q31(&fir_q31, bench_q31, bench_out_q31,
+				  DSP_BENCH_N));
+	DSP_BENCH_RUN("biquad_f32_4x256",
+		      dsp_biquad_f32(&bq_f32, bench_f32, bench_out_f32,
+				     DSP_BENCH_N));
+	DSP_BENCH_RUN("biquad_q15_4x256",
+		      dsp_biquad_q15(&bq_q15, bench_q15, bench_out_q15,
+				     DSP_BENCH_N));
+	DSP_BENCH_RUN("biquad_q31_4x256",
+		      dsp_biquad_q31(&bq_q31, bench_q31, bench_out_q31,
+				     DSP_BENCH_N));
+	DSP_BENCH_RUN("window_f32_256",
+		      dsp_mul_f32(bench_f32, bench_out_f32, bench_out_f32,
+				  DSP_BENCH_N));
+	DSP_BENCH_RUN("rms_f32_256", (void)dsp_rms_f32(bench_f32, DSP_BENCH_N));
+	DSP_BENCH_RUN("peak_q15_256",
+		      (void)dsp_peak_q15(bench_q15, DSP_BENCH_N, &idx));
+	DSP_BENCH_RUN("cfft_q15_256", dsp_cfft_q15(bench_q15, DSP_BENCH_N));
+	DSP_BENCH_RUN("cfft_q31_256", dsp_cfft_q31(bench_q31, DSP_BENCH_N));
+	DSP_BENCH_RUN("cfft_f32_256", dsp_cfft_f32(bench_f32, DSP_BENCH_N));
+	DSP_BENCH_RUN("rfft_q31_1024", dsp_rfft_q31(bench_q31, DSP_FFT_MAX));
+	DSP_BENCH_RUN("rfft_f32_1024", dsp_rfft_f32(bench_f32, DSP_FFT_MAX));
+}
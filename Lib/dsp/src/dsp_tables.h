@@ -0,0 +1,11 @@
+#ifndef __dsp_tables_h__
+#define __dsp_tables_h__
+
+#include "dsp.h"
+
+/** @brief exp(-2*pi*i*k/DSP_FFT_MAX), interleaved re/im, in flash */
+extern const float dsp_twiddle_f32[2 * DSP_FFT_MAX];
+extern const int16_t dsp_twiddle_q15[2 * DSP_FFT_MAX];
+extern const int32_t dsp_twiddle_q31[2 * DSP_FFT_MAX];
+
+#endif //__dsp_tables_h__
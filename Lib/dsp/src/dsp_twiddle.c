@@ -0,0 +1,3088 @@
+/* Generated by Tools/dsp_twiddle_gen.py, do not edit */
+#include "dsp_tables.h"
+
+#if DSP_FFT_MAX != 1024
+#error "regenerate twiddle tables for DSP_FFT_MAX"
+#endif
+
+/* exp(-2*pi*i*k/DSP_FFT_MAX), interleaved re/im */
+const float dsp_twiddle_f32[2 * DSP_FFT_MAX] = {
+	1.000000000e+00f, -0.000000000e+00f,
+	9.999811753e-01f, -6.135884649e-03f,
+	9.999247018e-01f, -1.227153829e-02f,
+	9.998305818e-01f, -1.840672991e-02f,
+	9.996988187e-01f, -2.454122852e-02f,
+	9.995294175e-01f, -3.067480318e-02f,
+	9.993223846e-01f, -3.680722294e-02f,
+	9.990777278e-01f, -4.293825693e-02f,
+	9.987954562e-01f, -4.906767433e-02f,
+	9.984755806e-01f, -5.519524435e-02f,
+	9.981181129e-01f, -6.132073630e-02f,
+	9.977230666e-01f, -6.744391956e-02f,
+	9.972904567e-01f, -7.356456360e-02f,
+	9.968202993e-01f, -7.968243797e-02f,
+	9.963126122e-01f, -8.579731234e-02f,
+	9.957674145e-01f, -9.190895650e-02f,
+	9.951847267e-01f, -9.801714033e-02f,
+	9.945645707e-01f, -1.041216339e-01f,
+	9.939069700e-01f, -1.102222073e-01f,
+	9.932119492e-01f, -1.163186309e-01f,
+	9.924795346e-01f, -1.224106752e-01f,
+	9.917097537e-01f, -1.284981108e-01f,
+	9.909026354e-01f, -1.345807085e-01f,
+	9.900582103e-01f, -1.406582393e-01f,
+	9.891765100e-01f, -1.467304745e-01f,
+	9.882575677e-01f, -1.527971853e-01f,
+	9.873014182e-01f, -1.588581433e-01f,
+	9.863080972e-01f, -1.649131205e-01f,
+	9.852776424e-01f, -1.709618888e-01f,
+	9.842100924e-01f, -1.770042204e-01f,
+	9.831054874e-01f, -1.830398880e-01f,
+	9.819638691e-01f, -1.890686641e-01f,
+	9.807852804e-01f, -1.950903220e-01f,
+	9.795697657e-01f, -2.011046348e-01f,
+	9.783173707e-01f, -2.071113762e-01f,
+	9.770281427e-01f, -2.131103199e-01f,
+	9.757021300e-01f, -2.191012402e-01f,
+	9.743393828e-01f, -2.250839114e-01f,
+	9.729399522e-01f, -2.310581083e-01f,
+	9.715038910e-01f, -2.370236060e-01f,
+	9.700312532e-01f, -2.429801799e-01f,
+	9.685220943e-01f, -2.489276057e-01f,
+	9.669764710e-01f, -2.548656596e-01f,
+	9.653944417e-01f, -2.607941179e-01f,
+	9.637760658e-01f, -2.667127575e-01f,
+	9.621214043e-01f, -2.726213554e-01f,
+	9.604305194e-01f, -2.785196894e-01f,
+	9.587034749e-01f, -2.844075372e-01f,
+	9.569403357e-01f, -2.902846773e-01f,
+	9.551411683e-01f, -2.961508882e-01f,
+	9.533060404e-01f, -3.020059493e-01f,
+	9.514350210e-01f, -3.078496400e-01f,
+	9.495281806e-01f, -3.136817404e-01f,
+	9.475855910e-01f, -3.195020308e-01f,
+	9.456073254e-01f, -3.253102922e-01f,
+	9.435934582e-01f, -3.311063058e-01f,
+	9.415440652e-01f, -3.368898534e-01f,
+	9.394592236e-01f, -3.426607173e-01f,
+	9.373390119e-01f, -3.484186802e-01f,
+	9.351835099e-01f, -3.541635254e-01f,
+	9.329927988e-01f, -3.598950365e-01f,
+	9.307669611e-01f, -3.656129978e-01f,
+	9.285060805e-01f, -3.713171940e-01f,
+	9.262102421e-01f, -3.770074102e-01f,
+	9.238795325e-01f, -3.826834324e-01f,
+	9.215140393e-01f, -3.883450467e-01f,
+	9.191138517e-01f, -3.939920401e-01f,
+	9.166790599e-01f, -3.996241998e-01f,
+	9.142097557e-01f, -4.052413140e-01f,
+	9.117060320e-01f, -4.108431711e-01f,
+	9.091679831e-01f, -4.164295601e-01f,
+	9.065957045e-01f, -4.220002708e-01f,
+	9.039892931e-01f, -4.275550934e-01f,
+	9.013488470e-01f, -4.330938189e-01f,
+	8.986744657e-01f, -4.386162385e-01f,
+	8.959662498e-01f, -4.441221446e-01f,
+	8.932243012e-01f, -4.496113297e-01f,
+	8.904487232e-01f, -4.550835871e-01f,
+	8.876396204e-01f, -4.605387110e-01f,
+	8.847970984e-01f, -4.659764958e-01f,
+	8.819212643e-01f, -4.713967368e-01f,
+	8.790122264e-01f, -4.767992301e-01f,
+	8.760700942e-01f, -4.821837721e-01f,
+	8.730949784e-01f, -4.875501601e-01f,
+	8.700869911e-01f, -4.928981922e-01f,
+	8.670462455e-01f, -4.982276670e-01f,
+	8.639728561e-01f, -5.035383837e-01f,
+	8.608669386e-01f, -5.088301425e-01f,
+	8.577286100e-01f, -5.141027442e-01f,
+	8.545579884e-01f, -5.193559902e-01f,
+	8.513551931e-01f, -5.245896827e-01f,
+	8.481203448e-01f, -5.298036247e-01f,
+	8.448535652e-01f, -5.349976199e-01f,
+	8.415549774e-01f, -5.401714727e-01f,
+	8.382247056e-01f, -5.453249884e-01f,
+	8.348628750e-01f, -5.504579729e-01f,
+	8.314696123e-01f, -5.555702330e-01f,
+	8.280450453e-01f, -5.606615762e-01f,
+	8.245893028e-01f, -5.657318108e-01f,
+	8.211025150e-01f, -5.707807459e-01f,
+	8.175848132e-01f, -5.758081914e-01f,
+	8.140363297e-01f, -5.808139581e-01f,
+	8.104571983e-01f, -5.857978575e-01f,
+	8.068475535e-01f, -5.907597019e-01f,
+	8.032075315e-01f, -5.956993045e-01f,
+	7.995372691e-01f, -6.006164794e-01f,
+	7.958369046e-01f, -6.055110414e-01f,
+	7.921065773e-01f, -6.103828063e-01f,
+	7.883464276e-01f, -6.152315906e-01f,
+	7.845565972e-01f, -6.200572118e-01f,
+	7.807372286e-01f, -6.248594881e-01f,
+	7.768884657e-01f, -6.296382389e-01f,
+	7.730104534e-01f, -6.343932842e-01f,
+	7.691033376e-01f, -6.391244449e-01f,
+	7.651672656e-01f, -6.438315429e-01f,
+	7.612023855e-01f, -6.485144010e-01f,
+	7.572088465e-01f, -6.531728430e-01f,
+	7.531867990e-01f, -6.578066933e-01f,
+	7.491363945e-01f, -6.624157776e-01f,
+	7.450577854e-01f, -6.669999223e-01f,
+	7.409511254e-01f, -6.715589548e-01f,
+	7.368165689e-01f, -6.760927036e-01f,
+	7.326542717e-01f, -6.806009978e-01f,
+	7.284643904e-01f, -6.850836678e-01f,
+	7.242470830e-01f, -6.895405447e-01f,
+	7.200025080e-01f, -6.939714609e-01f,
+	7.157308253e-01f, -6.983762494e-01f,
+	7.114321957e-01f, -7.027547445e-01f,
+	7.071067812e-01f, -7.071067812e-01f,
+	7.027547445e-01f, -7.114321957e-01f,
+	6.983762494e-01f, -7.157308253e-01f,
+	6.939714609e-01f, -7.200025080e-01f,
+	6.895405447e-01f, -7.242470830e-01f,
+	6.850836678e-01f, -7.284643904e-01f,
+	6.806009978e-01f, -7.326542717e-01f,
+	6.760927036e-01f, -7.368165689e-01f,
+	6.715589548e-01f, -7.409511254e-01f,
+	6.669999223e-01f, -7.450577854e-01f,
+	6.624157776e-01f, -7.491363945e-01f,
+	6.578066933e-01f, -7.531867990e-01f,
+	6.531728430e-01f, -7.572088465e-01f,
+	6.485144010e-01f, -7.612023855e-01f,
+	6.438315429e-01f, -7.651672656e-01f,
+	6.391244449e-01f, -7.691033376e-01f,
+	6.343932842e-01f, -7.730104534e-01f,
+	6.296382389e-01f, -7.768884657e-01f,
+	6.248594881e-01f, -7.807372286e-01f,
+	6.200572118e-01f, -7.845565972e-01f,
+	6.152315906e-01f, -7.883464276e-01f,
+	6.103828063e-01f, -7.921065773e-01f,
+	6.055110414e-01f, -7.958369046e-01f,
+	6.006164794e-01f, -7.995372691e-01f,
+	5.956993045e-01f, -8.032075315e-01f,
+	5.907597019e-01f, -8.068475535e-01f,
+	5.857978575e-01f, -8.104571983e-01f,
+	5.808139581e-01f, -8.140363297e-01f,
+	5.758081914e-01f, -8.175848132e-01f,
+	5.707807459e-01f, -8.211025150e-01f,
+	5.657318108e-01f, -8.245893028e-01f,
+	5.606615762e-01f, -8.280450453e-01f,
+	5.555702330e-01f, -8.314696123e-01f,
+	5.504579729e-01f, -8.348628750e-01f,
+	5.453249884e-01f, -8.382247056e-01f,
+	5.401714727e-01f, -8.415549774e-01f,
+	5.349976199e-01f, -8.448535652e-01f,
+	5.298036247e-01f, -8.481203448e-01f,
+	5.245896827e-01f, -8.513551931e-01f,
+	5.193559902e-01f, -8.545579884e-01f,
+	5.141027442e-01f, -8.577286100e-01f,
+	5.088301425e-01f, -8.608669386e-01f,
+	5.035383837e-01f, -8.639728561e-01f,
+	4.982276670e-01f, -8.670462455e-01f,
+	4.928981922e-01f, -8.700869911e-01f,
+	4.875501601e-01f, -8.730949784e-01f,
+	4.821837721e-01f, -8.760700942e-01f,
+	4.767992301e-01f, -8.790122264e-01f,
+	4.713967368e-01f, -8.819212643e-01f,
+	4.659764958e-01f, -8.847970984e-01f,
+	4.605387110e-01f, -8.876396204e-01f,
+	4.550835871e-01f, -8.904487232e-01f,
+	4.496113297e-01f, -8.932243012e-01f,
+	4.441221446e-01f, -8.959662498e-01f,
+	4.386162385e-01f, -8.986744657e-01f,
+	4.330938189e-01f, -9.013488470e-01f,
+	4.275550934e-01f, -9.039892931e-01f,
+	4.220002708e-01f, -9.065957045e-01f,
+	4.164295601e-01f, -9.091679831e-01f,
+	4.108431711e-01f, -9.117060320e-01f,
+	4.052413140e-01f, -9.142097557e-01f,
+	3.996241998e-01f, -9.166790599e-01f,
+	3.939920401e-01f, -9.191138517e-01f,
+	3.883450467e-01f, -9.215140393e-01f,
+	3.826834324e-01f, -9.238795325e-01f,
+	3.770074102e-01f, -9.262102421e-01f,
+	3.713171940e-01f, -9.285060805e-01f,
+	3.656129978e-01f, -9.307669611e-01f,
+	3.598950365e-01f, -9.329927988e-01f,
+	3.541635254e-01f, -9.351835099e-01f,
+	3.484186802e-01f, -9.373390119e-01f,
+	3.426607173e-01f, -9.394592236e-01f,
+	3.368898534e-01f, -9.415440652e-01f,
+	3.311063058e-01f, -9.435934582e-01f,
+	3.253102922e-01f, -9.456073254e-01f,
+	3.195020308e-01f, -9.475855910e-01f,
+	3.136817404e-01f, -9.495281806e-01f,
+	3.078496400e-01f, -9.514350210e-01f,
+	3.020059493e-01f, -9.533060404e-01f,
+	2.961508882e-01f, -9.551411683e-01f,
+	2.902846773e-01f, -9.569403357e-01f,
+	2.844075372e-01f, -9.587034749e-01f,
+	2.785196894e-01f, -9.604305194e-01f,
+	2.726213554e-01f, -9.621214043e-01f,
+	2.667127575e-01f, -9.637760658e-01f,
+	2.607941179e-01f, -9.653944417e-01f,
+	2.548656596e-01f, -9.669764710e-01f,
+	2.489276057e-01f, -9.685220943e-01f,
+	2.429801799e-01f, -9.700312532e-01f,
+	2.370236060e-01f, -9.715038910e-01f,
+	2.310581083e-01f, -9.729399522e-01f,
+	2.250839114e-01f, -9.743393828e-01f,
+	2.191012402e-01f, -9.757021300e-01f,
+	2.131103199e-01f, -9.770281427e-01f,
+	2.071113762e-01f, -9.783173707e-01f,
+	2.011046348e-01f, -9.795697657e-01f,
+	1.950903220e-01f, -9.807852804e-01f,
+	1.890686641e-01f, -9.819638691e-01f,
+	1.830398880e-01f, -9.831054874e-01f,
+	1.770042204e-01f, -9.842100924e-01f,
+	1.709618888e-01f, -9.852776424e-01f,
+	1.649131205e-01f, -9.863080972e-01f,
+	1.588581433e-01f, -9.873014182e-01f,
+	1.527971853e-01f, -9.882575677e-01f,
+	1.467304745e-01f, -9.891765100e-01f,
+	1.406582393e-01f, -9.900582103e-01f,
+	1.345807085e-01f, -9.909026354e-01f,
+	1.284981108e-01f, -9.917097537e-01f,
+	1.224106752e-01f, -9.924795346e-01f,
+	1.163186309e-01f, -9.932119492e-01f,
+	1.102222073e-01f, -9.939069700e-01f,
+	1.041216339e-01f, -9.945645707e-01f,
+	9.801714033e-02f, -9.951847267e-01f,
+	9.190895650e-02f, -9.957674145e-01f,
+	8.579731234e-02f, -9.963126122e-01f,
+	7.968243797e-02f, -9.968202993e-01f,
+	7.356456360e-02f, -9.972904567e-01f,
+	6.744391956e-02f, -9.977230666e-01f,
+	6.132073630e-02f, -9.981181129e-01f,
+	5.519524435e-02f, -9.984755806e-01f,
+	4.906767433e-02f, -9.987954562e-01f,
+	4.293825693e-02f, -9.990777278e-01f,
+	3.680722294e-02f, -9.993223846e-01f,
+	3.067480318e-02f, -9.995294175e-01f,
+	2.454122852e-02f, -9.996988187e-01f,
+	1.840672991e-02f, -9.998305818e-01f,
+	1.227153829e-02f, -9.999247018e-01f,
+	6.135884649e-03f, -9.999811753e-01f,
+	6.123233996e-17f, -1.000000000e+00f,
+	-6.135884649e-03f, -9.999811753e-01f,
+	-1.227153829e-02f, -9.999247018e-01f,
+	-1.840672991e-02f, -9.998305818e-01f,
+	-2.454122852e-02f, -9.996988187e-01f,
+	-3.067480318e-02f, -9.995294175e-01f,
+	-3.680722294e-02f, -9.993223846e-01f,
+	-4.293825693e-02f, -9.990777278e-01f,
+	-4.906767433e-02f, -9.987954562e-01f,
+	-5.519524435e-02f, -9.984755806e-01f,
+	-6.132073630e-02f, -9.981181129e-01f,
+	-6.744391956e-02f, -9.977230666e-01f,
+	-7.356456360e-02f, -9.972904567e-01f,
+	-7.968243797e-02f, -9.968202993e-01f,
+	-8.579731234e-02f, -9.963126122e-01f,
+	-9.190895650e-02f, -9.957674145e-01f,
+	-9.801714033e-02f, -9.951847267e-01f,
+	-1.041216339e-01f, -9.945645707e-01f,
+	-1.102222073e-01f, -9.939069700e-01f,
+	-1.163186309e-01f, -9.932119492e-01f,
+	-1.224106752e-01f, -9.924795346e-01f,
+	-1.284981108e-01f, -9.917097537e-01f,
+	-1.345807085e-01f, -9.909026354e-01f,
+	-1.406582393e-01f, -9.900582103e-01f,
+	-1.467304745e-01f, -9.891765100e-01f,
+	-1.527971853e-01f, -9.882575677e-01f,
+	-1.588581433e-01f, -9.873014182e-01f,
+	-1.649131205e-01f, -9.863080972e-01f,
+	-1.709618888e-01f, -9.852776424e-01f,
+	-1.770042204e-01f, -9.842100924e-01f,
+	-1.830398880e-01f, -9.831054874e-01f,
+	-1.890686641e-01f, -9.819638691e-01f,
+	-1.950903220e-01f, -9.807852804e-01f,
+	-2.011046348e-01f, -9.795697657e-01f,
+	-2.071113762e-01f, -9.783173707e-01f,
+	-2.131103199e-01f, -9.770281427e-01f,
+	-2.191012402e-01f, -9.757021300e-01f,
+	-2.250839114e-01f, -9.743393828e-01f,
+	-2.310581083e-01f, -9.729399522e-01f,
+	-2.370236060e-01f, -9.715038910e-01f,
+	-2.429801799e-01f, -9.700312532e-01f,
+	-2.489276057e-01f, -9.685220943e-01f,
+	-2.548656596e-01f, -9.669764710e-01f,
+	-2.607941179e-01f, -9.653944417e-01f,
+	-2.667127575e-01f, -9.637760658e-01f,
+	-2.726213554e-01f, -9.621214043e-01f,
+	-2.785196894e-01f, -9.604305194e-01f,
+	-2.844075372e-01f, -9.587034749e-01f,
+	-2.902846773e-01f, -9.569403357e-01f,
+	-2.961508882e-01f, -9.551411683e-01f,
+	-3.020059493e-01f, -9.533060404e-01f,
+	-3.078496400e-01f, -9.514350210e-01f,
+	-3.136817404e-01f, -9.495281806e-01f,
+	-3.195020308e-01f, -9.475855910e-01f,
+	-3.253102922e-01f, -9.456073254e-01f,
+	-3.311063058e-01f, -9.435934582e-01f,
+	-3.368898534e-01f, -9.415440652e-01f,
+	-3.426607173e-01f, -9.394592236e-01f,
+	-3.484186802e-01f, -9.373390119e-01f,
+	-3.541635254e-01f, -9.351835099e-01f,
+	-3.598950365e-01f, -9.329927988e-01f,
+	-3.656129978e-01f, -9.307669611e-01f,
+	-3.713171940e-01f, -9.285060805e-01f,
+	-3.770074102e-01f, -9.262102421e-01f,
+	-3.826834324e-01f, -9.238795325e-01f,
+	-3.883450467e-01f, -9.215140393e-01f,
+	-3.939920401e-01f, -9.191138517e-01f,
+	-3.996241998e-01f, -9.166790599e-01f,
+	-4.052413140e-01f, -9.142097557e-01f,
+	-4.108431711e-01f, -9.117060320e-01f,
+	-4.164295601e-01f, -9.091679831e-01f,
+	-4.220002708e-01f, -9.065957045e-01f,
+	-4.275550934e-01f, -9.039892931e-01f,
+	-4.330938189e-01f, -9.013488470e-01f,
+	-4.386162385e-01f, -8.986744657e-01f,
+	-4.441221446e-01f, -8.959662498e-01f,
+	-4.496113297e-01f, -8.932243012e-01f,
+	-4.550835871e-01f, -8.904487232e-01f,
+	-4.605387110e-01f, -8.876396204e-01f,
+	-4.659764958e-01f, -8.847970984e-01f,
+	-4.713967368e-01f, -8.819212643e-01f,
+	-4.767992301e-01f, -8.790122264e-01f,
+	-4.821837721e-01f, -8.760700942e-01f,
+	-4.875501601e-01f, -8.730949784e-01f,
+	-4.928981922e-01f, -8.700869911e-01f,
+	-4.982276670e-01f, -8.670462455e-01f,
+	-5.035383837e-01f, -8.639728561e-01f,
+	-5.088301425e-01f, -8.608669386e-01f,
+	-5.141027442e-01f, -8.577286100e-01f,
+	-5.193559902e-01f, -8.545579884e-01f,
+	-5.245896827e-01f, -8.513551931e-01f,
+	-5.298036247e-01f, -8.481203448e-01f,
+	-5.349976199e-01f, -8.448535652e-01f,
+	-5.401714727e-01f, -8.415549774e-01f,
+	-5.453249884e-01f, -8.382247056e-01f,
+	-5.504579729e-01f, -8.348628750e-01f,
+	-5.555702330e-01f, -8.314696123e-01f,
+	-5.606615762e-01f, -8.280450453e-01f,
+	-5.657318108e-01f, -8.245893028e-01f,
+	-5.707807459e-01f, -8.211025150e-01f,
+	-5.758081914e-01f, -8.175848132e-01f,
+	-5.808139581e-01f, -8.140363297e-01f,
+	-5.857978575e-01f, -8.104571983e-01f,
+	-5.907597019e-01f, -8.068475535e-01f,
+	-5.956993045e-01f, -8.032075315e-01f,
+	-6.006164794e-01f, -7.995372691e-01f,
+	-6.055110414e-01f, -7.958369046e-01f,
+	-6.103828063e-01f, -7.921065773e-01f,
+	-6.152315906e-01f, -7.883464276e-01f,
+	-6.200572118e-01f, -7.845565972e-01f,
+	-6.248594881e-01f, -7.807372286e-01f,
+	-6.296382389e-01f, -7.768884657e-01f,
+	-6.343932842e-01f, -7.730104534e-01f,
+	-6.391244449e-01f, -7.691033376e-01f,
+	-6.438315429e-01f, -7.651672656e-01f,
+	-6.485144010e-01f, -7.612023855e-01f,
+	-6.531728430e-01f, -7.572088465e-01f,
+	-6.578066933e-01f, -7.531867990e-01f,
+	-6.624157776e-01f, -7.491363945e-01f,
+	-6.669999223e-01f, -7.450577854e-01f,
+	-6.715589548e-01f, -7.409511254e-01f,
+	-6.760927036e-01f, -7.368165689e-01f,
+	-6.806009978e-01f, -7.326542717e-01f,
+	-6.850836678e-01f, -7.284643904e-01f,
+	-6.895405447e-01f, -7.242470830e-01f,
+	-6.939714609e-01f, -7.200025080e-01f,
+	-6.983762494e-01f, -7.157308253e-01f,
+	-7.027547445e-01f, -7.114321957e-01f,
+	-7.071067812e-01f, -7.071067812e-01f,
+	-7.114321957e-01f, -7.027547445e-01f,
+	-7.157308253e-01f, -6.983762494e-01f,
+	-7.200025080e-01f, -6.939714609e-01f,
+	-7.242470830e-01f, -6.895405447e-01f,
+	-7.284643904e-01f, -6.850836678e-01f,
+	-7.326542717e-01f, -6.806009978e-01f,
+	-7.368165689e-01f, -6.760927036e-01f,
+	-7.409511254e-01f, -6.715589548e-01f,
+	-7.450577854e-01f, -6.669999223e-01f,
+	-7.491363945e-01f, -6.624157776e-01f,
+	-7.531867990e-01f, -6.578066933e-01f,
+	-7.572088465e-01f, -6.531728430e-01f,
+	-7.612023855e-01f, -6.485144010e-01f,
+	-7.651672656e-01f, -6.438315429e-01f,
+	-7.691033376e-01f, -6.391244449e-01f,
+	-7.730104534e-01f, -6.343932842e-01f,
+	-7.768884657e-01f, -6.296382389e-01f,
+	-7.807372286e-01f, -6.248594881e-01f,
+	-7.845565972e-01f, -6.200572118e-01f,
+	-7.883464276e-01f, -6.152315906e-01f,
+	-7.921065773e-01f, -6.103828063e-01f,
+	-7.958369046e-01f, -6.055110414e-01f,
+	-7.995372691e-01f, -6.006164794e-01f,
+	-8.032075315e-01f, -5.956993045e-01f,
+	-8.068475535e-01f, -5.907597019e-01f,
+	-8.104571983e-01f, -5.857978575e-01f,
+	-8.140363297e-01f, -5.808139581e-01f,
+	-8.175848132e-01f, -5.758081914e-01f,
+	-8.211025150e-01f, -5.707807459e-01f,
+	-8.245893028e-01f, -5.657318108e-01f,
+	-8.280450453e-01f, -5.606615762e-01f,
+	-8.314696123e-01f, -5.555702330e-01f,
+	-8.348628750e-01f, -5.504579729e-01f,
+	-8.382247056e-01f, -5.453249884e-01f,
+	-8.415549774e-01f, -5.401714727e-01f,
+	-8.448535652e-01f, -5.349976199e-01f,
+	-8.481203448e-01f, -5.298036247e-01f,
+	-8.513551931e-01f, -5.245896827e-01f,
+	-8.545579884e-01f, -5.193559902e-01f,
+	-8.577286100e-01f, -5.141027442e-01f,
+	-8.608669386e-01f, -5.088301425e-01f,
+	-8.639728561e-01f, -5.035383837e-01f,
+	-8.670462455e-01f, -4.982276670e-01f,
+	-8.700869911e-01f, -4.928981922e-01f,
+	-8.730949784e-01f, -4.875501601e-01f,
+	-8.760700942e-01f, -4.821837721e-01f,
+	-8.790122264e-01f, -4.767992301e-01f,
+	-8.819212643e-01f, -4.713967368e-01f,
+	-8.847970984e-01f, -4.659764958e-01f,
+	-8.876396204e-01f, -4.605387110e-01f,
+	-8.904487232e-01f, -4.550835871e-01f,
+	-8.932243012e-01f, -4.496113297e-01f,
+	-8.959662498e-01f, -4.441221446e-01f,
+	-8.986744657e-01f, -4.386162385e-01f,
+	-9.013488470e-01f, -4.330938189e-01f,
+	-9.039892931e-01f, -4.275550934e-01f,
+	-9.065957045e-01f, -4.220002708e-01f,
+	-9.091679831e-01f, -4.164295601e-01f,
+	-9.117060320e-01f, -4.108431711e-01f,
+	-9.142097557e-01f, -4.052413140e-01f,
+	-9.166790599e-01f, -3.996241998e-01f,
+	-9.191138517e-01f, -3.939920401e-01f,
+	-9.215140393e-01f, -3.883450467e-01f,
+	-9.238795325e-01f, -3.826834324e-01f,
+	-9.262102421e-01f, -3.770074102e-01f,
+	-9.285060805e-01f, -3.713171940e-01f,
+	-9.307669611e-01f, -3.656129978e-01f,
+	-9.329927988e-01f, -3.598950365e-01f,
+	-9.351835099e-01f, -3.541635254e-01f,
+	-9.373390119e-01f, -3.484186802e-01f,
+	-9.394592236e-01f, -3.426607173e-01f,
+	-9.415440652e-01f, -3.368898534e-01f,
+	-9.435934582e-01f, -3.311063058e-01f,
+	-9.456073254e-01f, -3.253102922e-01f,
+	-9.475855910e-01f, -3.195020308e-01f,
+	-9.495281806e-01f, -3.136817404e-01f,
+	-9.514350210e-01f, -3.078496400e-01f,
+	-9.533060404e-01f, -3.020059493e-01f,
+	-9.551411683e-01f, -2.961508882e-01f,
+	-9.569403357e-01f, -2.902846773e-01f,
+	-9.587034749e-01f, -2.844075372e-01f,
+	-9.604305194e-01f, -2.785196894e-01f,
+	-9.621214043e-01f, -2.726213554e-01f,
+	-9.637760658e-01f, -2.667127575e-01f,
+	-9.653944417e-01f, -2.607941179e-01f,
+	-9.669764710e-01f, -2.548656596e-01f,
+	-9.685220943e-01f, -2.489276057e-01f,
+	-9.700312532e-01f, -2.429801799e-01f,
+	-9.715038910e-01f, -2.370236060e-01f,
+	-9.729399522e-01f, -2.310581083e-01f,
+	-9.743393828e-01f, -2.250839114e-01f,
+	-9.757021300e-01f, -2.191012402e-01f,
+	-9.770281427e-01f, -2.131103199e-01f,
+	-9.783173707e-01f, -2.071113762e-01f,
+	-9.795697657e-01f, -2.011046348e-01f,
+	-9.807852804e-01f, -1.950903220e-01f,
+	-9.819638691e-01f, -1.890686641e-01f,
+	-9.831054874e-01f, -1.830398880e-01f,
+	-9.842100924e-01f, -1.770042204e-01f,
+	-9.852776424e-01f, -1.709618888e-01f,
+	-9.863080972e-01f, -1.649131205e-01f,
+	-9.873014182e-01f, -1.588581433e-01f,
+	-9.882575677e-01f, -1.527971853e-01f,
+	-9.891765100e-01f, -1.467304745e-01f,
+	-9.900582103e-01f, -1.406582393e-01f,
+	-9.909026354e-01f, -1.345807085e-01f,
+	-9.917097537e-01f, -1.284981108e-01f,
+	-9.924795346e-01f, -1.224106752e-01f,
+	-9.932119492e-01f, -1.163186309e-01f,
+	-9.939069700e-01f, -1.102222073e-01f,
+	-9.945645707e-01f, -1.041216339e-01f,
+	-9.951847267e-01f, -9.801714033e-02f,
+	-9.957674145e-01f, -9.190895650e-02f,
+	-9.963126122e-01f, -8.579731234e-02f,
+	-9.968202993e-01f, -7.968243797e-02f,
+	-9.972904567e-01f, -7.356456360e-02f,
+	-9.977230666e-01f, -6.744391956e-02f,
+	-9.981181129e-01f, -6.132073630e-02f,
+	-9.984755806e-01f, -5.519524435e-02f,
+	-9.987954562e-01f, -4.906767433e-02f,
+	-9.990777278e-01f, -4.293825693e-02f,
+	-9.993223846e-01f, -3.680722294e-02f,
+	-9.995294175e-01f, -3.067480318e-02f,
+	-9.996988187e-01f, -2.454122852e-02f,
+	-9.998305818e-01f, -1.840672991e-02f,
+	-9.999247018e-01f, -1.227153829e-02f,
+	-9.999811753e-01f, -6.135884649e-03f,
+	-1.000000000e+00f, -1.224646799e-16f,
+	-9.999811753e-01f, 6.135884649e-03f,
+	-9.999247018e-01f, 1.227153829e-02f,
+	-9.998305818e-01f, 1.840672991e-02f,
+	-9.996988187e-01f, 2.454122852e-02f,
+	-9.995294175e-01f, 3.067480318e-02f,
+	-9.993223846e-01f, 3.680722294e-02f,
+	-9.990777278e-01f, 4.293825693e-02f,
+	-9.987954562e-01f, 4.906767433e-02f,
+	-9.984755806e-01f, 5.519524435e-02f,
+	-9.981181129e-01f, 6.132073630e-02f,
+	-9.977230666e-01f, 6.744391956e-02f,
+	-9.972904567e-01f, 7.356456360e-02f,
+	-9.968202993e-01f, 7.968243797e-02f,
+	-9.963126122e-01f, 8.579731234e-02f,
+	-9.957674145e-01f, 9.190895650e-02f,
+	-9.951847267e-01f, 9.801714033e-02f,
+	-9.945645707e-01f, 1.041216339e-01f,
+	-9.939069700e-01f, 1.102222073e-01f,
+	-9.932119492e-01f, 1.163186309e-01f,
+	-9.924795346e-01f, 1.224106752e-01f,
+	-9.917097537e-01f, 1.284981108e-01f,
+	-9.909026354e-01f, 1.345807085e-01f,
+	-9.900582103e-01f, 1.406582393e-01f,
+	-9.891765100e-01f, 1.467304745e-01f,
+	-9.882575677e-01f, 1.527971853e-01f,
+	-9.873014182e-01f, 1.588581433e-01f,
+	-9.863080972e-01f, 1.649131205e-01f,
+	-9.852776424e-01f, 1.709618888e-01f,
+	-9.842100924e-01f, 1.770042204e-01f,
+	-9.831054874e-01f, 1.830398880e-01f,
+	-9.819638691e-01f, 1.890686641e-01f,
+	-9.807852804e-01f, 1.950903220e-01f,
+	-9.795697657e-01f, 2.011046348e-01f,
+	-9.783173707e-01f, 2.071113762e-01f,
+	-9.770281427e-01f, 2.131103199e-01f,
+	-9.757021300e-01f, 2.191012402e-01f,
+	-9.743393828e-01f, 2.250839114e-01f,
+	-9.729399522e-01f, 2.310581083e-01f,
+	-9.715038910e-01f, 2.370236060e-01f,
+	-9.700312532e-01f, 2.429801799e-01f,
+	-9.685220943e-01f, 2.489276057e-01f,
+	-9.669764710e-01f, 2.548656596e-01f,
+	-9.653944417e-01f, 2.607941179e-01f,
+	-9.637760658e-01f, 2.667127575e-01f,
+	-9.621214043e-01f, 2.726213554e-01f,
+	-9.604305194e-01f, 2.785196894e-01f,
+	-9.587034749e-01f, 2.844075372e-01f,
+	-9.569403357e-01f, 2.902846773e-01f,
+	-9.551411683e-01f, 2.961508882e-01f,
+	-9.533060404e-01f, 3.020059493e-01f,
+	-9.514350210e-01f, 3.078496400e-01f,
+	-9.495281806e-01f, 3.136817404e-01f,
+	-9.475855910e-01f, 3.195020308e-01f,
+	-9.456073254e-01f, 3.253102922e-01f,
+	-9.435934582e-01f, 3.311063058e-01f,
+	-9.415440652e-01f, 3.368898534e-01f,
+	-9.394592236e-01f, 3.426607173e-01f,
+	-9.373390119e-01f, 3.484186802e-01f,
+	-9.351835099e-01f, 3.541635254e-01f,
+	-9.329927988e-01f, 3.598950365e-01f,
+	-9.307669611e-01f, 3.656129978e-01f,
+	-9.285060805e-01f, 3.713171940e-01f,
+	-9.262102421e-01f, 3.770074102e-01f,
+	-9.238795325e-01f, 3.826834324e-01f,
+	-9.215140393e-01f, 3.883450467e-01f,
+	-9.191138517e-01f, 3.939920401e-01f,
+	-9.166790599e-01f, 3.996241998e-01f,
+	-9.142097557e-01f, 4.052413140e-01f,
+	-9.117060320e-01f, 4.108431711e-01f,
+	-9.091679831e-01f, 4.164295601e-01f,
+	-9.065957045e-01f, 4.220002708e-01f,
+	-9.039892931e-01f, 4.275550934e-01f,
+	-9.013488470e-01f, 4.330938189e-01f,
+	-8.986744657e-01f, 4.386162385e-01f,
+	-8.959662498e-01f, 4.441221446e-01f,
+	-8.932243012e-01f, 4.496113297e-01f,
+	-8.904487232e-01f, 4.550835871e-01f,
+	-8.876396204e-01f, 4.605387110e-01f,
+	-8.847970984e-01f, 4.659764958e-01f,
+	-8.819212643e-01f, 4.713967368e-01f,
+	-8.790122264e-01f, 4.767992301e-01f,
+	-8.760700942e-01f, 4.821837721e-01f,
+	-8.730949784e-01f, 4.875501601e-01f,
+	-8.700869911e-01f, 4.928981922e-01f,
+	-8.670462455e-01f, 4.982276670e-01f,
+	-8.639728561e-01f, 5.035383837e-01f,
+	-8.608669386e-01f, 5.088301425e-01f,
+	-8.577286100e-01f, 5.141027442e-01f,
+	-8.545579884e-01f, 5.193559902e-01f,
+	-8.513551931e-01f, 5.245896827e-01f,
+	-8.481203448e-01f, 5.298036247e-01f,
+	-8.448535652e-01f, 5.349976199e-01f,
+	-8.415549774e-01f, 5.401714727e-01f,
+	-8.382247056e-01f, 5.453249884e-01f,
+	-8.348628750e-01f, 5.504579729e-01f,
+	-8.314696123e-01f, 5.555702330e-01f,
+	-8.280450453e-01f, 5.606615762e-01f,
+	-8.245893028e-01f, 5.657318108e-01f,
+	-8.211025150e-01f, 5.707807459e-01f,
+	-8.175848132e-01f, 5.758081914e-01f,
+	-8.140363297e-01f, 5.808139581e-01f,
+	-8.104571983e-01f, 5.857978575e-01f,
+	-8.068475535e-01f, 5.907597019e-01f,
+	-8.032075315e-01f, 5.956993045e-01f,
+	-7.995372691e-01f, 6.006164794e-01f,
+	-7.958369046e-01f, 6.055110414e-01f,
+	-7.921065773e-01f, 6.103828063e-01f,
+	-7.883464276e-01f, 6.152315906e-01f,
+	-7.845565972e-01f, 6.200572118e-01f,
+	-7.807372286e-01f, 6.248594881e-01f,
+	-7.768884657e-01f, 6.296382389e-01f,
+	-7.730104534e-01f, 6.343932842e-01f,
+	-7.691033376e-01f, 6.391244449e-01f,
+	-7.651672656e-01f, 6.438315429e-01f,
+	-7.612023855e-01f, 6.485144010e-01f,
+	-7.572088465e-01f, 6.531728430e-01f,
+	-7.531867990e-01f, 6.578066933e-01f,
+	-7.491363945e-01f, 6.624157776e-01f,
+	-7.450577854e-01f, 6.669999223e-01f,
+	-7.409511254e-01f, 6.715589548e-01f,
+	-7.368165689e-01f, 6.760927036e-01f,
+	-7.326542717e-01f, 6.806009978e-01f,
+	-7.284643904e-01f, 6.850836678e-01f,
+	-7.242470830e-01f, 6.895405447e-01f,
+	-7.200025080e-01f, 6.939714609e-01f,
+	-7.157308253e-01f, 6.983762494e-01f,
+	-7.114321957e-01f, 7.027547445e-01f,
+	-7.071067812e-01f, 7.071067812e-01f,
+	-7.027547445e-01f, 7.114321957e-01f,
+	-6.983762494e-01f, 7.157308253e-01f,
+	-6.939714609e-01f, 7.200025080e-01f,
+	-6.895405447e-01f, 7.242470830e-01f,
+	-6.850836678e-01f, 7.284643904e-01f,
+	-6.806009978e-01f, 7.326542717e-01f,
+	-6.760927036e-01f, 7.368165689e-01f,
+	-6.715589548e-01f, 7.409511254e-01f,
+	-6.669999223e-01f, 7.450577854e-01f,
+	-6.624157776e-01f, 7.491363945e-01f,
+	-6.578066933e-01f, 7.531867990e-01f,
+	-6.531728430e-01f, 7.572088465e-01f,
+	-6.485144010e-01f, 7.612023855e-01f,
+	-6.438315429e-01f, 7.651672656e-01f,
+	-6.391244449e-01f, 7.691033376e-01f,
+	-6.343932842e-01f, 7.730104534e-01f,
+	-6.296382389e-01f, 7.768884657e-01f,
+	-6.248594881e-01f, 7.807372286e-01f,
+	-6.200572118e-01f, 7.845565972e-01f,
+	-6.152315906e-01f, 7.883464276e-01f,
+	-6.103828063e-01f, 7.921065773e-01f,
+	-6.055110414e-01f, 7.958369046e-01f,
+	-6.006164794e-01f, 7.995372691e-01f,
+	-5.956993045e-01f, 8.032075315e-01f,
+	-5.907597019e-01f, 8.068475535e-01f,
+	-5.857978575e-01f, 8.104571983e-01f,
+	-5.808139581e-01f, 8.140363297e-01f,
+	-5.758081914e-01f, 8.175848132e-01f,
+	-5.707807459e-01f, 8.211025150e-01f,
+	-5.657318108e-01f, 8.245893028e-01f,
+	-5.606615762e-01f, 8.280450453e-01f,
+	-5.555702330e-01f, 8.314696123e-01f,
+	-5.504579729e-01f, 8.348628750e-01f,
+	-5.453249884e-01f, 8.382247056e-01f,
+	-5.401714727e-01f, 8.415549774e-01f,
+	-5.349976199e-01f, 8.448535652e-01f,
+	-5.298036247e-01f, 8.481203448e-01f,
+	-5.245896827e-01f, 8.513551931e-01f,
+	-5.193559902e-01f, 8.545579884e-01f,
+	-5.141027442e-01f, 8.577286100e-01f,
+	-5.088301425e-01f, 8.608669386e-01f,
+	-5.035383837e-01f, 8.639728561e-01f,
+	-4.982276670e-01f, 8.670462455e-01f,
+	-4.928981922e-01f, 8.700869911e-01f,
+	-4.875501601e-01f, 8.730949784e-01f,
+	-4.821837721e-01f, 8.760700942e-01f,
+	-4.767992301e-01f, 8.790122264e-01f,
+	-4.713967368e-01f, 8.819212643e-01f,
+	-4.659764958e-01f, 8.847970984e-01f,
+	-4.605387110e-01f, 8.876396204e-01f,
+	-4.550835871e-01f, 8.904487232e-01f,
+	-4.496113297e-01f, 8.932243012e-01f,
+	-4.441221446e-01f, 8.959662498e-01f,
+	-4.386162385e-01f, 8.986744657e-01f,
+	-4.330938189e-01f, 9.013488470e-01f,
+	-4.275550934e-01f, 9.039892931e-01f,
+	-4.220002708e-01f, 9.065957045e-01f,
+	-4.164295601e-01f, 9.091679831e-01f,
+	-4.108431711e-01f, 9.117060320e-01f,
+	-4.052413140e-01f, 9.142097557e-01f,
+	-3.996241998e-01f, 9.166790599e-01f,
+	-3.939920401e-01f, 9.191138517e-01f,
+	-3.883450467e-01f, 9.215140393e-01f,
+	-3.826834324e-01f, 9.238795325e-01f,
+	-3.770074102e-01f, 9.262102421e-01f,
+	-3.713171940e-01f, 9.285060805e-01f,
+	-3.656129978e-01f, 9.307669611e-01f,
+	-3.598950365e-01f, 9.329927988e-01f,
+	-3.541635254e-01f, 9.351835099e-01f,
+	-3.484186802e-01f, 9.373390119e-01f,
+	-3.426607173e-01f, 9.394592236e-01f,
+	-3.368898534e-01f, 9.415440652e-01f,
+	-3.311063058e-01f, 9.435934582e-01f,
+	-3.253102922e-01f, 9.456073254e-01f,
+	-3.195020308e-01f, 9.475855910e-01f,
+	-3.136817404e-01f, 9.495281806e-01f,
+	-3.078496400e-01f, 9.514350210e-01f,
+	-3.020059493e-01f, 9.533060404e-01f,
+	-2.961508882e-01f, 9.551411683e-01f,
+	-2.902846773e-01f, 9.569403357e-01f,
+	-2.844075372e-01f, 9.587034749e-01f,
+	-2.785196894e-01f, 9.604305194e-01f,
+	-2.726213554e-01f, 9.621214043e-01f,
+	-2.667127575e-01f, 9.637760658e-01f,
+	-2.607941179e-01f, 9.653944417e-01f,
+	-2.548656596e-01f, 9.669764710e-01f,
+	-2.489276057e-01f, 9.685220943e-01f,
+	-2.429801799e-01f, 9.700312532e-01f,
+	-2.370236060e-01f, 9.715038910e-01f,
+	-2.310581083e-01f, 9.729399522e-01f,
+	-2.250839114e-01f, 9.743393828e-01f,
+	-2.191012402e-01f, 9.757021300e-01f,
+	-2.131103199e-01f, 9.770281427e-01f,
+	-2.071113762e-01f, 9.783173707e-01f,
+	-2.011046348e-01f, 9.795697657e-01f,
+	-1.950903220e-01f, 9.807852804e-01f,
+	-1.890686641e-01f, 9.819638691e-01f,
+	-1.830398880e-01f, 9.831054874e-01f,
+	-1.770042204e-01f, 9.842100924e-01f,
+	-1.709618888e-01f, 9.852776424e-01f,
+	-1.649131205e-01f, 9.863080972e-01f,
+	-1.588581433e-01f, 9.873014182e-01f,
+	-1.527971853e-01f, 9.882575677e-01f,
+	-1.467304745e-01f, 9.891765100e-01f,
+	-1.406582393e-01f, 9.900582103e-01f,
+	-1.345807085e-01f, 9.909026354e-01f,
+	-1.284981108e-01f, 9.917097537e-01f,
+	-1.224106752e-01f, 9.924795346e-01f,
+	-1.163186309e-01f, 9.932119492e-01f,
+	-1.102222073e-01f, 9.939069700e-01f,
+	-1.041216339e-01f, 9.945645707e-01f,
+	-9.801714033e-02f, 9.951847267e-01f,
+	-9.190895650e-02f, 9.957674145e-01f,
+	-8.579731234e-02f, 9.963126122e-01f,
+	-7.968243797e-02f, 9.968202993e-01f,
+	-7.356456360e-02f, 9.972904567e-01f,
+	-6.744391956e-02f, 9.977230666e-01f,
+	-6.132073630e-02f, 9.981181129e-01f,
+	-5.519524435e-02f, 9.984755806e-01f,
+	-4.906767433e-02f, 9.987954562e-01f,
+	-4.293825693e-02f, 9.990777278e-01f,
+	-3.680722294e-02f, 9.993223846e-01f,
+	-3.067480318e-02f, 9.995294175e-01f,
+	-2.454122852e-02f, 9.996988187e-01f,
+	-1.840672991e-02f, 9.998305818e-01f,
+	-1.227153829e-02f, 9.999247018e-01f,
+	-6.135884649e-03f, 9.999811753e-01f,
+	-1.836970199e-16f, 1.000000000e+00f,
+	6.135884649e-03f, 9.999811753e-01f,
+	1.227153829e-02f, 9.999247018e-01f,
+	1.840672991e-02f, 9.998305818e-01f,
+	2.454122852e-02f, 9.996988187e-01f,
+	3.067480318e-02f, 9.995294175e-01f,
+	3.680722294e-02f, 9.993223846e-01f,
+	4.293825693e-02f, 9.990777278e-01f,
+	4.906767433e-02f, 9.987954562e-01f,
+	5.519524435e-02f, 9.984755806e-01f,
+	6.132073630e-02f, 9.981181129e-01f,
+	6.744391956e-02f, 9.977230666e-01f,
+	7.356456360e-02f, 9.972904567e-01f,
+	7.968243797e-02f, 9.968202993e-01f,
+	8.579731234e-02f, 9.963126122e-01f,
+	9.190895650e-02f, 9.957674145e-01f,
+	9.801714033e-02f, 9.951847267e-01f,
+	1.041216339e-01f, 9.945645707e-01f,
+	1.102222073e-01f, 9.939069700e-01f,
+	1.163186309e-01f, 9.932119492e-01f,
+	1.224106752e-01f, 9.924795346e-01f,
+	1.284981108e-01f, 9.917097537e-01f,
+	1.345807085e-01f, 9.909026354e-01f,
+	1.406582393e-01f, 9.900582103e-01f,
+	1.467304745e-01f, 9.891765100e-01f,
+	1.527971853e-01f, 9.882575677e-01f,
+	1.588581433e-01f, 9.873014182e-01f,
+	1.649131205e-01f, 9.863080972e-01f,
+	1.709618888e-01f, 9.852776424e-01f,
+	1.770042204e-01f, 9.842100924e-01f,
+	1.830398880e-01f, 9.831054874e-01f,
+	1.890686641e-01f, 9.819638691e-01f,
+	1.950903220e-01f, 9.807852804e-01f,
+	2.011046348e-01f, 9.795697657e-01f,
+	2.071113762e-01f, 9.783173707e-01f,
+	2.131103199e-01f, 9.770281427e-01f,
+	2.191012402e-01f, 9.757021300e-01f,
+	2.250839114e-01f, 9.743393828e-01f,
+	2.310581083e-01f, 9.729399522e-01f,
+	2.370236060e-01f, 9.715038910e-01f,
+	2.429801799e-01f, 9.700312532e-01f,
+	2.489276057e-01f, 9.685220943e-01f,
+	2.548656596e-01f, 9.669764710e-01f,
+	2.607941179e-01f, 9.653944417e-01f,
+	2.667127575e-01f, 9.637760658e-01f,
+	2.726213554e-01f, 9.621214043e-01f,
+	2.785196894e-01f, 9.604305194e-01f,
+	2.844075372e-01f, 9.587034749e-01f,
+	2.902846773e-01f, 9.569403357e-01f,
+	2.961508882e-01f, 9.551411683e-01f,
+	3.020059493e-01f, 9.533060404e-01f,
+	3.078496400e-01f, 9.514350210e-01f,
+	3.136817404e-01f, 9.495281806e-01f,
+	3.195020308e-01f, 9.475855910e-01f,
+	3.253102922e-01f, 9.456073254e-01f,
+	3.311063058e-01f, 9.435934582e-01f,
+	3.368898534e-01f, 9.415440652e-01f,
+	3.426607173e-01f, 9.394592236e-01f,
+	3.484186802e-01f, 9.373390119e-01f,
+	3.541635254e-01f, 9.351835099e-01f,
+	3.598950365e-01f, 9.329927988e-01f,
+	3.656129978e-01f, 9.307669611e-01f,
+	3.713171940e-01f, 9.285060805e-01f,
+	3.770074102e-01f, 9.262102421e-01f,
+	3.826834324e-01f, 9.238795325e-01f,
+	3.883450467e-01f, 9.215140393e-01f,
+	3.939920401e-01f, 9.191138517e-01f,
+	3.996241998e-01f, 9.166790599e-01f,
+	4.052413140e-01f, 9.142097557e-01f,
+	4.108431711e-01f, 9.117060320e-01f,
+	4.164295601e-01f, 9.091679831e-01f,
+	4.220002708e-01f, 9.065957045e-01f,
+	4.275550934e-01f, 9.039892931e-01f,
+	4.330938189e-01f, 9.013488470e-01f,
+	4.386162385e-01f, 8.986744657e-01f,
+	4.441221446e-01f, 8.959662498e-01f,
+	4.496113297e-01f, 8.932243012e-01f,
+	4.550835871e-01f, 8.904487232e-01f,
+	4.605387110e-01f, 8.876396204e-01f,
+	4.659764958e-01f, 8.847970984e-01f,
+	4.713967368e-01f, 8.819212643e-01f,
+	4.767992301e-01f, 8.790122264e-01f,
+	4.821837721e-01f, 8.760700942e-01f,
+	4.875501601e-01f, 8.730949784e-01f,
+	4.928981922e-01f, 8.700869911e-01f,
+	4.982276670e-01f, 8.670462455e-01f,
+	5.035383837e-01f, 8.639728561e-01f,
+	5.088301425e-01f, 8.608669386e-01f,
+	5.141027442e-01f, 8.577286100e-01f,
+	5.193559902e-01f, 8.545579884e-01f,
+	5.245896827e-01f, 8.513551931e-01f,
+	5.298036247e-01f, 8.481203448e-01f,
+	5.349976199e-01f, 8.448535652e-01f,
+	5.401714727e-01f, 8.415549774e-01f,
+	5.453249884e-01f, 8.382247056e-01f,
+	5.504579729e-01f, 8.348628750e-01f,
+	5.555702330e-01f, 8.314696123e-01f,
+	5.606615762e-01f, 8.280450453e-01f,
+	5.657318108e-01f, 8.245893028e-01f,
+	5.707807459e-01f, 8.211025150e-01f,
+	5.758081914e-01f, 8.175848132e-01f,
+	5.808139581e-01f, 8.140363297e-01f,
+	5.857978575e-01f, 8.104571983e-01f,
+	5.907597019e-01f, 8.068475535e-01f,
+	5.956993045e-01f, 8.032075315e-01f,
+	6.006164794e-01f, 7.995372691e-01f,
+	6.055110414e-01f, 7.958369046e-01f,
+	6.103828063e-01f, 7.921065773e-01f,
+	6.152315906e-01f, 7.883464276e-01f,
+	6.200572118e-01f, 7.845565972e-01f,
+	6.248594881e-01f, 7.807372286e-01f,
+	6.296382389e-01f, 7.768884657e-01f,
+	6.343932842e-01f, 7.730104534e-01f,
+	6.391244449e-01f, 7.691033376e-01f,
+	6.438315429e-01f, 7.651672656e-01f,
+	6.485144010e-01f, 7.612023855e-01f,
+	6.531728430e-01f, 7.572088465e-01f,
+	6.578066933e-01f, 7.531867990e-01f,
+	6.624157776e-01f, 7.491363945e-01f,
+	6.669999223e-01f, 7.450577854e-01f,
+	6.715589548e-01f, 7.409511254e-01f,
+	6.760927036e-01f, 7.368165689e-01f,
+	6.806009978e-01f, 7.326542717e-01f,
+	6.850836678e-01f, 7.284643904e-01f,
+	6.895405447e-01f, 7.242470830e-01f,
+	6.939714609e-01f, 7.200025080e-01f,
+	6.983762494e-01f, 7.157308253e-01f,
+	7.027547445e-01f, 7.114321957e-01f,
+	7.071067812e-01f, 7.071067812e-01f,
+	7.114321957e-01f, 7.027547445e-01f,
+	7.157308253e-01f, 6.983762494e-01f,
+	7.200025080e-01f, 6.939714609e-01f,
+	7.242470830e-01f, 6.895405447e-01f,
+	7.284643904e-01f, 6.850836678e-01f,
+	7.326542717e-01f, 6.806009978e-01f,
+	7.368165689e-01f, 6.760927036e-01f,
+	7.409511254e-01f, 6.715589548e-01f,
+	7.450577854e-01f, 6.669999223e-01f,
+	7.491363945e-01f, 6.624157776e-01f,
+	7.531867990e-01f, 6.578066933e-01f,
+	7.572088465e-01f, 6.531728430e-01f,
+	7.612023855e-01f, 6.485144010e-01f,
+	7.651672656e-01f, 6.438315429e-01f,
+	7.691033376e-01f, 6.391244449e-01f,
+	7.730104534e-01f, 6.343932842e-01f,
+	7.768884657e-01f, 6.296382389e-01f,
+	7.807372286e-01f, 6.248594881e-01f,
+	7.845565972e-01f, 6.200572118e-01f,
+	7.883464276e-01f, 6.152315906e-01f,
+	7.921065773e-01f, 6.103828063e-01f,
+	7.958369046e-01f, 6.055110414e-01f,
+	7.995372691e-01f, 6.006164794e-01f,
+	8.032075315e-01f, 5.956993045e-01f,
+	8.068475535e-01f, 5.907597019e-01f,
+	8.104571983e-01f, 5.857978575e-01f,
+	8.140363297e-01f, 5.808139581e-01f,
+	8.175848132e-01f, 5.758081914e-01f,
+	8.211025150e-01f, 5.707807459e-01f,
+	8.245893028e-01f, 5.657318108e-01f,
+	8.280450453e-01f, 5.606615762e-01f,
+	8.314696123e-01f, 5.555702330e-01f,
+	8.348628750e-01f, 5.504579729e-01f,
+	8.382247056e-01f, 5.453249884e-01f,
+	8.415549774e-01f, 5.401714727e-01f,
+	8.448535652e-01f, 5.349976199e-01f,
+	8.481203448e-01f, 5.298036247e-01f,
+	8.513551931e-01f, 5.245896827e-01f,
+	8.545579884e-01f, 5.193559902e-01f,
+	8.577286100e-01f, 5.141027442e-01f,
+	8.608669386e-01f, 5.088301425e-01f,
+	8.639728561e-01f, 5.035383837e-01f,
+	8.670462455e-01f, 4.982276670e-01f,
+	8.700869911e-01f, 4.928981922e-01f,
+	8.730949784e-01f, 4.875501601e-01f,
+	8.760700942e-01f, 4.821837721e-01f,
+	8.790122264e-01f, 4.767992301e-01f,
+	8.819212643e-01f, 4.713967368e-01f,
+	8.847970984e-01f, 4.659764958e-01f,
+	8.876396204e-01f, 4.605387110e-01f,
+	8.904487232e-01f, 4.550835871e-01f,
+	8.932243012e-01f, 4.496113297e-01f,
+	8.959662498e-01f, 4.441221446e-01f,
+	8.986744657e-01f, 4.386162385e-01f,
+	9.013488470e-01f, 4.330938189e-01f,
+	9.039892931e-01f, 4.275550934e-01f,
+	9.065957045e-01f, 4.220002708e-01f,
+	9.091679831e-01f, 4.164295601e-01f,
+	9.117060320e-01f, 4.108431711e-01f,
+	9.142097557e-01f, 4.052413140e-01f,
+	9.166790599e-01f, 3.996241998e-01f,
+	9.191138517e-01f, 3.939920401e-01f,
+	9.215140393e-01f, 3.883450467e-01f,
+	9.238795325e-01f, 3.826834324e-01f,
+	9.262102421e-01f, 3.770074102e-01f,
+	9.285060805e-01f, 3.713171940e-01f,
+	9.307669611e-01f, 3.656129978e-01f,
+	9.329927988e-01f, 3.598950365e-01f,
+	9.351835099e-01f, 3.541635254e-01f,
+	9.373390119e-01f, 3.484186802e-01f,
+	9.394592236e-01f, 3.426607173e-01f,
+	9.415440652e-01f, 3.368898534e-01f,
+	9.435934582e-01f, 3.311063058e-01f,
+	9.456073254e-01f, 3.253102922e-01f,
+	9.475855910e-01f, 3.195020308e-01f,
+	9.495281806e-01f, 3.136817404e-01f,
+	9.514350210e-01f, 3.078496400e-01f,
+	9.533060404e-01f, 3.020059493e-01f,
+	9.551411683e-01f, 2.961508882e-01f,
+	9.569403357e-01f, 2.902846773e-01f,
+	9.587034749e-01f, 2.844075372e-01f,
+	9.604305194e-01f, 2.785196894e-01f,
+	9.621214043e-01f, 2.726213554e-01f,
+	9.637760658e-01f, 2.667127575e-01f,
+	9.653944417e-01f, 2.607941179e-01f,
+	9.669764710e-01f, 2.548656596e-01f,
+	9.685220943e-01f, 2.489276057e-01f,
+	9.700312532e-01f, 2.429801799e-01f,
+	9.715038910e-01f, 2.370236060e-01f,
+	9.729399522e-01f, 2.310581083e-01f,
+	9.743393828e-01f, 2.250839114e-01f,
+	9.757021300e-01f, 2.191012402e-01f,
+	9.770281427e-01f, 2.131103199e-01f,
+	9.783173707e-01f, 2.071113762e-01f,
+	9.795697657e-01f, 2.011046348e-01f,
+	9.807852804e-01f, 1.950903220e-01f,
+	9.819638691e-01f, 1.890686641e-01f,
+	9.831054874e-01f, 1.830398880e-01f,
+	9.842100924e-01f, 1.770042204e-01f,
+	9.852776424e-01f, 1.709618888e-01f,
+	9.863080972e-01f, 1.649131205e-01f,
+	9.873014182e-01f, 1.588581433e-01f,
+	9.882575677e-01f, 1.527971853e-01f,
+	9.891765100e-01f, 1.467304745e-01f,
+	9.900582103e-01f, 1.406582393e-01f,
+	9.909026354e-01f, 1.345807085e-01f,
+	9.917097537e-01f, 1.284981108e-01f,
+	9.924795346e-01f, 1.224106752e-01f,
+	9.932119492e-01f, 1.163186309e-01f,
+	9.939069700e-01f, 1.102222073e-01f,
+	9.945645707e-01f, 1.041216339e-01f,
+	9.951847267e-01f, 9.801714033e-02f,
+	9.957674145e-01f, 9.190895650e-02f,
+	9.963126122e-01f, 8.579731234e-02f,
+	9.968202993e-01f, 7.968243797e-02f,
+	9.972904567e-01f, 7.356456360e-02f,
+	9.977230666e-01f, 6.744391956e-02f,
+	9.981181129e-01f, 6.132073630e-02f,
+	9.984755806e-01f, 5.519524435e-02f,
+	9.987954562e-01f, 4.906767433e-02f,
+	9.990777278e-01f, 4.293825693e-02f,
+	9.993223846e-01f, 3.680722294e-02f,
+	9.995294175e-01f, 3.067480318e-02f,
+	9.996988187e-01f, 2.454122852e-02f,
+	9.998305818e-01f, 1.840672991e-02f,
+	9.999247018e-01f, 1.227153829e-02f,
+	9.999811753e-01f, 6.135884649e-03f,
+};
+
+const int16_t dsp_twiddle_q15[2 * DSP_FFT_MAX] = {
+	32767, 0,
+	32767, -201,
+	32766, -402,
+	32762, -603,
+	32758, -804,
+	32753, -1005,
+	32746, -1206,
+	32738, -1407,
+	32729, -1608,
+	32718, -1809,
+	32706, -2009,
+	32693, -2210,
+	32679, -2411,
+	32664, -2611,
+	32647, -2811,
+	32629, -3012,
+	32610, -3212,
+	32590, -3412,
+	32568, -3612,
+	32546, -3812,
+	32522, -4011,
+	32496, -4211,
+	32470, -4410,
+	32442, -4609,
+	32413, -4808,
+	32383, -5007,
+	32352, -5205,
+	32319, -5404,
+	32286, -5602,
+	32251, -5800,
+	32214, -5998,
+	32177, -6195,
+	32138, -6393,
+	32099, -6590,
+	32058, -6787,
+	32015, -6983,
+	31972, -7180,
+	31927, -7376,
+	31881, -7571,
+	31834, -7767,
+	31786, -7962,
+	31737, -8157,
+	31686, -8351,
+	31634, -8546,
+	31581, -8740,
+	31527, -8933,
+	31471, -9127,
+	31415, -9319,
+	31357, -9512,
+	31298, -9704,
+	31238, -9896,
+	31177, -10088,
+	31114, -10279,
+	31050, -10469,
+	30986, -10660,
+	30920, -10850,
+	30853, -11039,
+	30784, -11228,
+	30715, -11417,
+	30644, -11605,
+	30572, -11793,
+	30499, -11980,
+	30425, -12167,
+	30350, -12354,
+	30274, -12540,
+	30196, -12725,
+	30118, -12910,
+	30038, -13095,
+	29957, -13279,
+	29875, -13463,
+	29792, -13646,
+	29707, -13828,
+	29622, -14010,
+	29535, -14192,
+	29448, -14373,
+	29359, -14553,
+	29269, -14733,
+	29178, -14912,
+	29086, -15091,
+	28993, -15269,
+	28899, -15447,
+	28803, -15624,
+	28707, -15800,
+	28610, -15976,
+	28511, -16151,
+	28411, -16326,
+	28311, -16500,
+	28209, -16673,
+	28106, -16846,
+	28002, -17018,
+	27897, -17190,
+	27791, -17361,
+	27684, -17531,
+	27576, -17700,
+	27467, -17869,
+	27357, -18037,
+	27246, -18205,
+	27133, -18372,
+	27020, -18538,
+	26906, -18703,
+	26791, -18868,
+	26674, -19032,
+	26557, -19195,
+	26439, -19358,
+	26320, -19520,
+	26199, -19681,
+	26078, -19841,
+	25956, -20001,
+	25833, -20160,
+	25708, -20318,
+	25583, -20475,
+	25457, -20632,
+	25330, -20788,
+	25202, -20943,
+	25073, -21097,
+	24943, -21251,
+	24812, -21403,
+	24680, -21555,
+	24548, -21706,
+	24414, -21856,
+	24279, -22006,
+	24144, -22154,
+	24008, -22302,
+	23870, -22449,
+	23732, -22595,
+	23593, -22740,
+	23453, -22884,
+	23312, -23028,
+	23170, -23170,
+	23028, -23312,
+	22884, -23453,
+	22740, -23593,
+	22595, -23732,
+	22449, -23870,
+	22302, -24008,
+	22154, -24144,
+	22006, -24279,
+	21856, -24414,
+	21706, -24548,
+	21555, -24680,
+	21403, -24812,
+	21251, -24943,
+	21097, -25073,
+	20943, -25202,
+	20788, -25330,
+	20632, -25457,
+	20475, -25583,
+	20318, -25708,
+	20160, -25833,
+	20001, -25956,
+	19841, -26078,
+	19681, -26199,
+	19520, -26320,
+	19358, -26439,
+	19195, -26557,
+	19032, -26674,
+	18868, -26791,
+	18703, -26906,
+	18538, -27020,
+	18372, -27133,
+	18205, -27246,
+	18037, -27357,
+	17869, -27467,
+	17700, -27576,
+	17531, -27684,
+	17361, -27791,
+	17190, -27897,
+	17018, -28002,
+	16846, -28106,
+	16673, -28209,
+	16500, -28311,
+	16326, -28411,
+	16151, -28511,
+	15976, -28610,
+	15800, -28707,
+	15624, -28803,
+	15447, -28899,
+	15269, -28993,
+	15091, -29086,
+	14912, -29178,
+	14733, -29269,
+	14553, -29359,
+	14373, -29448,
+	14192, -29535,
+	14010, -29622,
+	13828, -29707,
+	13646, -29792,
+	13463, -29875,
+	13279, -29957,
+	13095, -30038,
+	12910, -30118,
+	12725, -30196,
+	12540, -30274,
+	12354, -30350,
+	12167, -30425,
+	11980, -30499,
+	11793, -30572,
+	11605, -30644,
+	11417, -30715,
+	11228, -30784,
+	11039, -30853,
+	10850, -30920,
+	10660, -30986,
+	10469, -31050,
+	10279, -31114,
+	10088, -31177,
+	9896, -31238,
+	9704, -31298,
+	9512, -31357,
+	9319, -31415,
+	9127, -31471,
+	8933, -31527,
+	8740, -31581,
+	8546, -31634,
+	8351, -31686,
+	8157, -31737,
+	7962, -31786,
+	7767, -31834,
+	7571, -31881,
+	7376, -31927,
+	7180, -31972,
+	6983, -32015,
+	6787, -32058,
+	6590, -32099,
+	6393, -32138,
+	6195, -32177,
+	5998, -32214,
+	5800, -32251,
+	5602, -32286,
+	5404, -32319,
+	5205, -32352,
+	5007, -32383,
+	4808, -32413,
+	4609, -32442,
+	4410, -32470,
+	4211, -32496,
+	4011, -32522,
+	3812, -32546,
+	3612, -32568,
+	3412, -32590,
+	3212, -32610,
+	3012, -32629,
+	2811, -32647,
+	2611, -32664,
+	2411, -32679,
+	2210, -32693,
+	2009, -32706,
+	1809, -32718,
+	1608, -32729,
+	1407, -32738,
+	1206, -32746,
+	1005, -32753,
+	804, -32758,
+	603, -32762,
+	402, -32766,
+	201, -32767,
+	0, -32768,
+	-201, -32767,
+	-402, -32766,
+	-603, -32762,
+	-804, -32758,
+	-1005, -32753,
+	-1206, -32746,
+	-1407, -32738,
+	-1608, -32729,
+	-1809, -32718,
+	-2009, -32706,
+	-2210, -32693,
+	-2411, -32679,
+	-2611, -32664,
+	-2811, -32647,
+	-3012, -32629,
+	-3212, -32610,
+	-3412, -32590,
+	-3612, -32568,
+	-3812, -32546,
+	-4011, -32522,
+	-4211, -32496,
+	-4410, -32470,
+	-4609, -32442,
+	-4808, -32413,
+	-5007, -32383,
+	-5205, -32352,
+	-5404, -32319,
+	-5602, -32286,
+	-5800, -32251,
+	-5998, -32214,
+	-6195, -32177,
+	-6393, -32138,
+	-6590, -32099,
+	-6787, -32058,
+	-6983, -32015,
+	-7180, -31972,
+	-7376, -31927,
+	-7571, -31881,
+	-7767, -31834,
+	-7962, -31786,
+	-8157, -31737,
+	-8351, -31686,
+	-8546, -31634,
+	-8740, -31581,
+	-8933, -31527,
+	-9127, -31471,
+	-9319, -31415,
+	-9512, -31357,
+	-9704, -31298,
+	-9896, -31238,
+	-10088, -31177,
+	-10279, -31114,
+	-10469, -31050,
+	-10660, -30986,
+	-10850, -30920,
+	-11039, -30853,
+	-11228, -30784,
+	-11417, -30715,
+	-11605, -30644,
+	-11793, -30572,
+	-11980, -30499,
+	-12167, -30425,
+	-12354, -30350,
+	-12540, -30274,
+	-12725, -30196,
+	-12910, -30118,
+	-13095, -30038,
+	-13279, -29957,
+	-13463, -29875,
+	-13646, -29792,
+	-13828, -29707,
+	-14010, -29622,
+	-14192, -29535,
+	-14373, -29448,
+	-14553, -29359,
+	-14733, -29269,
+	-14912, -29178,
+	-15091, -29086,
+	-15269, -28993,
+	-15447, -28899,
+	-15624, -28803,
+	-15800, -28707,
+	-15976, -28610,
+	-16151, -28511,
+	-16326, -28411,
+	-16500, -28311,
+	-16673, -28209,
+	-16846, -28106,
+	-17018, -28002,
+	-17190, -27897,
+	-17361, -27791,
+	-17531, -27684,
+	-17700, -27576,
+	-17869, -27467,
+	-18037, -27357,
+	-18205, -27246,
+	-18372, -27133,
+	-18538, -27020,
+	-18703, -26906,
+	-18868, -26791,
+	-19032, -26674,
+	-19195, -26557,
+	-19358, -26439,
+	-19520, -26320,
+	-19681, -26199,
+	-19841, -26078,
+	-20001, -25956,
+	-20160, -25833,
+	-20318, -25708,
+	-20475, -25583,
+	-20632, -25457,
+	-20788, -25330,
+	-20943, -25202,
+	-21097, -25073,
+	-21251, -24943,
+	-21403, -24812,
+	-21555, -24680,
+	-21706, -24548,
+	-21856, -24414,
+	-22006, -24279,
+	-22154, -24144,
+	-22302, -24008,
+	-22449, -23870,
+	-22595, -23732,
+	-22740, -23593,
+	-22884, -23453,
+	-23028, -23312,
+	-23170, -23170,
+	-23312, -23028,
+	-23453, -22884,
+	-23593, -22740,
+	-23732, -22595,
+	-23870, -22449,
+	-24008, -22302,
+	-24144, -22154,
+	-24279, -22006,
+	-24414, -21856,
+	-24548, -21706,
+	-24680, -21555,
+	-24812, -21403,
+	-24943, -21251,
+	-25073, -21097,
+	-25202, -20943,
+	-25330, -20788,
+	-25457, -20632,
+	-25583, -20475,
+	-25708, -20318,
+	-25833, -20160,
+	-25956, -20001,
+	-26078, -19841,
+	-26199, -19681,
+	-26320, -19520,
+	-26439, -19358,
+	-26557, -19195,
+	-26674, -19032,
+	-26791, -18868,
+	-26906, -18703,
+	-27020, -18538,
+	-27133, -18372,
+	-27246, -18205,
+	-27357, -18037,
+	-27467, -17869,
+	-27576, -17700,
+	-27684, -17531,
+	-27791, -17361,
+	-27897, -17190,
+	-28002, -17018,
+	-28106, -16846,
+	-28209, -16673,
+	-28311, -16500,
+	-28411, -16326,
+	-28511, -16151,
+	-28610, -15976,
+	-28707, -15800,
+	-28803, -15624,
+	-28899, -15447,
+	-28993, -15269,
+	-29086, -15091,
+	-29178, -14912,
+	-29269, -14733,
+	-29359, -14553,
+	-29448, -14373,
+	-29535, -14192,
+	-29622, -14010,
+	-29707, -13828,
+	-29792, -13646,
+	-29875, -13463,
+	-29957, -13279,
+	-30038, -13095,
+	-30118, -12910,
+	-30196, -12725,
+	-30274, -12540,
+	-30350, -12354,
+	-30425, -12167,
+	-30499, -11980,
+	-30572, -11793,
+	-30644, -11605,
+	-30715, -11417,
+	-30784, -11228,
+	-30853, -11039,
+	-30920, -10850,
+	-30986, -10660,
+	-31050, -10469,
+	-31114, -10279,
+	-31177, -10088,
+	-31238, -9896,
+	-31298, -9704,
+	-31357, -9512,
+	-31415, -9319,
+	-31471, -9127,
+	-31527, -8933,
+	-31581, -8740,
+	-31634, -8546,
+	-31686, -8351,
+	-31737, -8157,
+	-31786, -7962,
+	-31834, -7767,
+	-31881, -7571,
+	-31927, -7376,
+	-31972, -7180,
+	-32015, -6983,
+	-32058, -6787,
+	-32099, -6590,
+	-32138, -6393,
+	-32177, -6195,
+	-32214, -5998,
+	-32251, -5800,
+	-32286, -5602,
+	-32319, -5404,
+	-32352, -5205,
+	-32383, -5007,
+	-32413, -4808,
+	-32442, -4609,
+	-32470, -4410,
+	-32496, -4211,
+	-32522, -4011,
+	-32546, -3812,
+	-32568, -3612,
+	-32590, -3412,
+	-32610, -3212,
+	-32629, -3012,
+	-32647, -2811,
+	-32664, -2611,
+	-32679, -2411,
+	-32693, -2210,
+	-32706, -2009,
+	-32718, -1809,
+	-32729, -1608,
+	-32738, -1407,
+	-32746, -1206,
+	-32753, -1005,
+	-32758, -804,
+	-32762, -603,
+	-32766, -402,
+	-32767, -201,
+	-32768, 0,
+	-32767, 201,
+	-32766, 402,
+	-32762, 603,
+	-32758, 804,
+	-32753, 1005,
+	-32746, 1206,
+	-32738, 1407,
+	-32729, 1608,
+	-32718, 1809,
+	-32706, 2009,
+	-32693, 2210,
+	-32679, 2411,
+	-32664, 2611,
+	-32647, 2811,
+	-32629, 3012,
+	-32610, 3212,
+	-32590, 3412,
+	-32568, 3612,
+	-32546, 3812,
+	-32522, 4011,
+	-32496, 4211,
+	-32470, 4410,
+	-32442, 4609,
+	-32413, 4808,
+	-32383, 5007,
+	-32352, 5205,
+	-32319, 5404,
+	-32286, 5602,
+	-32251, 5800,
+	-32214, 5998,
+	-32177, 6195,
+	-32138, 6393,
+	-32099, 6590,
+	-32058, 6787,
+	-32015, 6983,
+	-31972, 7180,
+	-31927, 7376,
+	-31881, 7571,
+	-31834, 7767,
+	-31786, 7962,
+	-31737, 8157,
+	-31686, 8351,
+	-31634, 8546,
+	-31581, 8740,
+	-31527, 8933,
+	-31471, 9127,
+	-31415, 9319,
+	-31357, 9512,
+	-31298, 9704,
+	-31238, 9896,
+	-31177, 10088,
+	-31114, 10279,
+	-31050, 10469,
+	-30986, 10660,
+	-30920, 10850,
+	-30853, 11039,
+	-30784, 11228,
+	-30715, 11417,
+	-30644, 11605,
+	-30572, 11793,
+	-30499, 11980,
+	-30425, 12167,
+	-30350, 12354,
+	-30274, 12540,
+	-30196, 12725,
+	-30118, 12910,
+	-30038, 13095,
+	-29957, 13279,
+	-29875, 13463,
+	-29792, 13646,
+	-29707, 13828,
+	-29622, 14010,
+	-29535, 14192,
+	-29448, 14373,
+	-29359, 14553,
+	-29269, 14733,
+	-29178, 14912,
+	-29086, 15091,
+	-28993, 15269,
+	-28899, 15447,
+	-28803, 15624,
+	-28707, 15800,
+	-28610, 15976,
+	-28511, 16151,
+	-28411, 16326,
+	-28311, 16500,
+	-28209, 16673,
+	-28106, 16846,
+	-28002, 17018,
+	-27897, 17190,
+	-27791, 17361,
+	-27684, 17531,
+	-27576, 17700,
+	-27467, 17869,
+	-27357, 18037,
+	-27246, 18205,
+	-27133, 18372,
+	-27020, 18538,
+	-26906, 18703,
+	-26791, 18868,
+	-26674, 19032,
+	-26557, 19195,
+	-26439, 19358,
+	-26320, 19520,
+	-26199, 19681,
+	-26078, 19841,
+	-25956, 20001,
+	-25833, 20160,
+	-25708, 20318,
+	-25583, 20475,
+	-25457, 20632,
+	-25330, 20788,
+	-25202, 20943,
+	-25073, 21097,
+	-24943, 21251,
+	-24812, 21403,
+	-24680, 21555,
+	-24548, 21706,
+	-24414, 21856,
+	-24279, 22006,
+	-24144, 22154,
+	-24008, 22302,
+	-23870, 22449,
+	-23732, 22595,
+	-23593, 22740,
+	-23453, 22884,
+	-23312, 23028,
+	-23170, 23170,
+	-23028, 23312,
+	-22884, 23453,
+	-22740, 23593,
+	-22595, 23732,
+	-22449, 23870,
+	-22302, 24008,
+	-22154, 24144,
+	-22006, 24279,
+	-21856, 24414,
+	-21706, 24548,
+	-21555, 24680,
+	-21403, 24812,
+	-21251, 24943,
+	-21097, 25073,
+	-20943, 25202,
+	-20788, 25330,
+	-20632, 25457,
+	-20475, 25583,
+	-20318, 25708,
+	-20160, 25833,
+	-20001, 25956,
+	-19841, 26078,
+	-19681, 26199,
+	-19520, 26320,
+	-19358, 26439,
+	-19195, 26557,
+	-19032, 26674,
+	-18868, 26791,
+	-18703, 26906,
+	-18538, 27020,
+	-18372, 27133,
+	-18205, 27246,
+	-18037, 27357,
+	-17869, 27467,
+	-17700, 27576,
+	-17531, 27684,
+	-17361, 27791,
+	-17190, 27897,
+	-17018, 28002,
+	-16846, 28106,
+	-16673, 28209,
+	-16500, 28311,
+	-16326, 28411,
+	-16151, 28511,
+	-15976, 28610,
+	-15800, 28707,
+	-15624, 28803,
+	-15447, 28899,
+	-15269, 28993,
+	-15091, 29086,
+	-14912, 29178,
+	-14733, 29269,
+	-14553, 29359,
+	-14373, 29448,
+	-14192, 29535,
+	-14010, 29622,
+	-13828, 29707,
+	-13646, 29792,
+	-13463, 29875,
+	-13279, 29957,
+	-13095, 30038,
+	-12910, 30118,
+	-12725, 30196,
+	-12540, 30274,
+	-12354, 30350,
+	-12167, 30425,
+	-11980, 30499,
+	-11793, 30572,
+	-11605, 30644,
+	-11417, 30715,
+	-11228, 30784,
+	-11039, 30853,
+	-10850, 30920,
+	-10660, 30986,
+	-10469, 31050,
+	-10279, 31114,
+	-10088, 31177,
+	-9896, 31238,
+	-9704, 31298,
+	-9512, 31357,
+	-9319, 31415,
+	-9127, 31471,
+	-8933, 31527,
+	-8740, 31581,
+	-8546, 31634,
+	-8351, 31686,
+	-8157, 31737,
+	-7962, 31786,
+	-7767, 31834,
+	-7571, 31881,
+	-7376, 31927,
+	-7180, 31972,
+	-6983, 32015,
+	-6787, 32058,
+	-6590, 32099,
+	-6393, 32138,
+	-6195, 32177,
+	-5998, 32214,
+	-5800, 32251,
+	-5602, 32286,
+	-5404, 32319,
+	-5205, 32352,
+	-5007, 32383,
+	-4808, 32413,
+	-4609, 32442,
+	-4410, 32470,
+	-4211, 32496,
+	-4011, 32522,
+	-3812, 32546,
+	-3612, 32568,
+	-3412, 32590,
+	-3212, 32610,
+	-3012, 32629,
+	-2811, 32647,
+	-2611, 32664,
+	-2411, 32679,
+	-2210, 32693,
+	-2009, 32706,
+	-1809, 32718,
+	-1608, 32729,
+	-1407, 32738,
+	-1206, 32746,
+	-1005, 32753,
+	-804, 32758,
+	-603, 32762,
+	-402, 32766,
+	-201, 32767,
+	0, 32767,
+	201, 32767,
+	402, 32766,
+	603, 32762,
+	804, 32758,
+	1005, 32753,
+	1206, 32746,
+	1407, 32738,
+	1608, 32729,
+	1809, 32718,
+	2009, 32706,
+	2210, 32693,
+	2411, 32679,
+	2611, 32664,
+	2811, 32647,
+	3012, 32629,
+	3212, 32610,
+	3412, 32590,
+	3612, 32568,
+	3812, 32546,
+	4011, 32522,
+	4211, 32496,
+	4410, 32470,
+	4609, 32442,
+	4808, 32413,
+	5007, 32383,
+	5205, 32352,
+	5404, 32319,
+	5602, 32286,
+	5800, 32251,
+	5998, 32214,
+	6195, 32177,
+	6393, 32138,
+	6590, 32099,
+	6787, 32058,
+	6983, 32015,
+	7180, 31972,
+	7376, 31927,
+	7571, 31881,
+	7767, 31834,
+	7962, 31786,
+	8157, 31737,
+	8351, 31686,
+	8546, 31634,
+	8740, 31581,
+	8933, 31527,
+	9127, 31471,
+	9319, 31415,
+	9512, 31357,
+	9704, 31298,
+	9896, 31238,
+	10088, 31177,
+	10279, 31114,
+	10469, 31050,
+	10660, 30986,
+	10850, 30920,
+	11039, 30853,
+	11228, 30784,
+	11417, 30715,
+	11605, 30644,
+	11793, 30572,
+	11980, 30499,
+	12167, 30425,
+	12354, 30350,
+	12540, 30274,
+	12725, 30196,
+	12910, 30118,
+	13095, 30038,
+	13279, 29957,
+	13463, 29875,
+	13646, 29792,
+	13828, 29707,
+	14010, 29622,
+	14192, 29535,
+	14373, 29448,
+	14553, 29359,
+	14733, 29269,
+	14912, 29178,
+	15091, 29086,
+	15269, 28993,
+	15447, 28899,
+	15624, 28803,
+	15800, 28707,
+	15976, 28610,
+	16151, 28511,
+	16326, 28411,
+	16500, 28311,
+	16673, 28209,
+	16846, 28106,
+	17018, 28002,
+	17190, 27897,
+	17361, 27791,
+	17531, 27684,
+	17700, 27576,
+	17869, 27467,
+	18037, 27357,
+	18205, 27246,
+	18372, 27133,
+	18538, 27020,
+	18703, 26906,
+	18868, 26791,
+	19032, 26674,
+	19195, 26557,
+	19358, 26439,
+	19520, 26320,
+	19681, 26199,
+	19841, 26078,
+	20001, 25956,
+	20160, 25833,
+	20318, 25708,
+	20475, 25583,
+	20632, 25457,
+	20788, 25330,
+	20943, 25202,
+	21097, 25073,
+	21251, 24943,
+	21403, 24812,
+	21555, 24680,
+	21706, 24548,
+	21856, 24414,
+	22006, 24279,
+	22154, 24144,
+	22302, 24008,
+	22449, 23870,
+	22595, 23732,
+	22740, 23593,
+	22884, 23453,
+	23028, 23312,
+	23170, 23170,
+	23312, 23028,
+	23453, 22884,
+	23593, 22740,
+	23732, 22595,
+	23870, 22449,
+	24008, 22302,
+	24144, 22154,
+	24279, 22006,
+	24414, 21856,
+	24548, 21706,
+	24680, 21555,
+	24812, 21403,
+	24943, 21251,
+	25073, 21097,
+	25202, 20943,
+	25330, 20788,
+	25457, 20632,
+	25583, 20475,
+	25708, 20318,
+	25833, 20160,
+	25956, 20001,
+	26078, 19841,
+	26199, 19681,
+	26320, 19520,
+	26439, 19358,
+	26557, 19195,
+	26674, 19032,
+	26791, 18868,
+	26906, 18703,
+	27020, 18538,
+	27133, 18372,
+	27246, 18205,
+	27357, 18037,
+	27467, 17869,
+	27576, 17700,
+	27684, 17531,
+	27791, 17361,
+	27897, 17190,
+	28002, 17018,
+	28106, 16846,
+	28209, 16673,
+	28311, 16500,
+	28411, 16326,
+	28511, 16151,
+	28610, 15976,
+	28707, 15800,
+	28803, 15624,
+	28899, 15447,
+	28993, 15269,
+	29086, 15091,
+	29178, 14912,
+	29269, 14733,
+	29359, 14553,
+	29448, 14373,
+	29535, 14192,
+	29622, 14010,
+	29707, 13828,
+	29792, 13646,
+	29875, 13463,
+	29957, 13279,
+	30038, 13095,
+	30118, 12910,
+	30196, 12725,
+	30274, 12540,
+	30350, 12354,
+	30425, 12167,
+	30499, 11980,
+	30572, 11793,
+	30644, 11605,
+	30715, 11417,
+	30784, 11228,
+	30853, 11039,
+	30920, 10850,
+	30986, 10660,
+	31050, 10469,
+	31114, 10279,
+	31177, 10088,
+	31238, 9896,
+	31298, 9704,
+	31357, 9512,
+	31415, 9319,
+	31471, 9127,
+	31527, 8933,
+	31581, 8740,
+	31634, 8546,
+	31686, 8351,
+	31737, 8157,
+	31786, 7962,
+	31834, 7767,
+	31881, 7571,
+	31927, 7376,
+	31972, 7180,
+	32015, 6983,
+	32058, 6787,
+	32099, 6590,
+	32138, 6393,
+	32177, 6195,
+	32214, 5998,
+	32251, 5800,
+	32286, 5602,
+	32319, 5404,
+	32352, 5205,
+	32383, 5007,
+	32413, 4808,
+	32442, 4609,
+	32470, 4410,
+	32496, 4211,
+	32522, 4011,
+	32546, 3812,
+	32568, 3612,
+	32590, 3412,
+	32610, 3212,
+	32629, 3012,
+	32647, 2811,
+	32664, 2611,
+	32679, 2411,
+	32693, 2210,
+	32706, 2009,
+	32718, 1809,
+	32729, 1608,
+	32738, 1407,
+	32746, 1206,
+	32753, 1005,
+	32758, 804,
+	32762, 603,
+	32766, 402,
+	32767, 201,
+};
+
+const int32_t dsp_twiddle_q31[2 * DSP_FFT_MAX] = {
+	2147483647, 0,
+	2147443222, -13176712,
+	2147321946, -26352928,
+	2147119825, -39528151,
+	2146836866, -52701887,
+	2146473080, -65873638,
+	2146028480, -79042909,
+	2145503083, -92209205,
+	2144896910, -105372028,
+	2144209982, -118530885,
+	2143442326, -131685278,
+	2142593971, -144834714,
+	2141664948, -157978697,
+	2140655293, -171116733,
+	2139565043, -184248325,
+	2138394240, -197372981,
+	2137142927, -210490206,
+	2135811153, -223599506,
+	2134398966, -236700388,
+	2132906420, -249792358,
+	2131333572, -262874923,
+	2129680480, -275947592,
+	2127947206, -289009871,
+	2126133817, -302061269,
+	2124240380, -315101295,
+	2122266967, -328129457,
+	2120213651, -341145265,
+	2118080511, -354148230,
+	2115867626, -367137861,
+	2113575080, -380113669,
+	2111202959, -393075166,
+	2108751352, -406021865,
+	2106220352, -418953276,
+	2103610054, -431868915,
+	2100920556, -444768294,
+	2098151960, -457650927,
+	2095304370, -470516330,
+	2092377892, -483364019,
+	2089372638, -496193509,
+	2086288720, -509004318,
+	2083126254, -521795963,
+	2079885360, -534567963,
+	2076566160, -547319836,
+	2073168777, -560051104,
+	2069693342, -572761285,
+	2066139983, -585449903,
+	2062508835, -598116479,
+	2058800036, -610760536,
+	2055013723, -623381598,
+	2051150040, -635979190,
+	2047209133, -648552838,
+	2043191150, -661102068,
+	2039096241, -673626408,
+	2034924562, -686125387,
+	2030676269, -698598533,
+	2026351522, -711045377,
+	2021950484, -723465451,
+	2017473321, -735858287,
+	2012920201, -748223418,
+	2008291295, -760560380,
+	2003586779, -772868706,
+	1998806829, -785147934,
+	1993951625, -797397602,
+	1989021350, -809617249,
+	1984016189, -821806413,
+	1978936331, -833964638,
+	1973781967, -846091463,
+	1968553292, -858186435,
+	1963250501, -870249095,
+	1957873796, -882278992,
+	1952423377, -894275671,
+	1946899451, -906238681,
+	1941302225, -918167572,
+	1935631910, -930061894,
+	1929888720, -941921200,
+	1924072871, -953745043,
+	1918184581, -965532978,
+	1912224073, -977284562,
+	1906191570, -988999351,
+	1900087301, -1000676905,
+	1893911494, -1012316784,
+	1887664383, -1023918550,
+	1881346202, -1035481766,
+	1874957189, -1047005996,
+	1868497586, -1058490808,
+	1861967634, -1069935768,
+	1855367581, -1081340445,
+	1848697674, -1092704411,
+	1841958164, -1104027237,
+	1835149306, -1115308496,
+	1828271356, -1126547765,
+	1821324572, -1137744621,
+	1814309216, -1148898640,
+	1807225553, -1160009405,
+	1800073849, -1171076495,
+	1792854372, -1182099496,
+	1785567396, -1193077991,
+	1778213194, -1204011567,
+	1770792044, -1214899813,
+	1763304224, -1225742318,
+	1755750017, -1236538675,
+	1748129707, -1247288478,
+	1740443581, -1257991320,
+	1732691928, -1268646800,
+	1724875040, -1279254516,
+	1716993211, -1289814068,
+	1709046739, -1300325060,
+	1701035922, -1310787095,
+	1692961062, -1321199781,
+	1684822463, -1331562723,
+	1676620432, -1341875533,
+	1668355276, -1352137822,
+	1660027308, -1362349204,
+	1651636841, -1372509294,
+	1643184191, -1382617710,
+	1634669676, -1392674072,
+	1626093616, -1402678000,
+	1617456335, -1412629117,
+	1608758157, -1422527051,
+	1599999411, -1432371426,
+	1591180426, -1442161874,
+	1582301533, -1451898025,
+	1573363068, -1461579514,
+	1564365367, -1471205974,
+	1555308768, -1480777044,
+	1546193612, -1490292364,
+	1537020244, -1499751576,
+	1527789007, -1509154322,
+	1518500250, -1518500250,
+	1509154322, -1527789007,
+	1499751576, -1537020244,
+	1490292364, -1546193612,
+	1480777044, -1555308768,
+	1471205974, -1564365367,
+	1461579514, -1573363068,
+	1451898025, -1582301533,
+	1442161874, -1591180426,
+	1432371426, -1599999411,
+	1422527051, -1608758157,
+	1412629117, -1617456335,
+	1402678000, -1626093616,
+	1392674072, -1634669676,
+	1382617710, -1643184191,
+	1372509294, -1651636841,
+	1362349204, -1660027308,
+	1352137822, -1668355276,
+	1341875533, -1676620432,
+	1331562723, -1684822463,
+	1321199781, -1692961062,
+	1310787095, -1701035922,
+	1300325060, -1709046739,
+	1289814068, -1716993211,
+	1279254516, -1724875040,
+	1268646800, -1732691928,
+	1257991320, -1740443581,
+	1247288478, -1748129707,
+	1236538675, -1755750017,
+	1225742318, -1763304224,
+	1214899813, -1770792044,
+	1204011567, -1778213194,
+	1193077991, -1785567396,
+	1182099496, -1792854372,
+	1171076495, -1800073849,
+	1160009405, -1807225553,
+	1148898640, -1814309216,
+	1137744621, -1821324572,
+	1126547765, -1828271356,
+	1115308496, -1835149306,
+	1104027237, -1841958164,
+	1092704411, -1848697674,
+	1081340445, -1855367581,
+	1069935768, -1861967634,
+	1058490808, -1868497586,
+	1047005996, -1874957189,
+	1035481766, -1881346202,
+	1023918550, -1887664383,
+	1012316784, -1893911494,
+	1000676905, -1900087301,
+	988999351, -1906191570,
+	977284562, -1912224073,
+	965532978, -1918184581,
+	953745043, -1924072871,
+	941921200, -1929888720,
+	930061894, -1935631910,
+	918167572, -1941302225,
+	906238681, -1946899451,
+	894275671, -1952423377,
+	882278992, -1957873796,
+	870249095, -1963250501,
+	858186435, -1968553292,
+	846091463, -1973781967,
+	833964638, -1978936331,
+	821806413, -1984016189,
+	809617249, -1989021350,
+	797397602, -1993951625,
+	785147934, -1998806829,
+	772868706, -2003586779,
+	760560380, -2008291295,
+	748223418, -2012920201,
+	735858287, -2017473321,
+	723465451, -2021950484,
+	711045377, -2026351522,
+	698598533, -2030676269,
+	686125387, -2034924562,
+	673626408, -2039096241,
+	661102068, -2043191150,
+	648552838, -2047209133,
+	635979190, -2051150040,
+	623381598, -2055013723,
+	610760536, -2058800036,
+	598116479, -2062508835,
+	585449903, -2066139983,
+	572761285, -2069693342,
+	560051104, -2073168777,
+	547319836, -2076566160,
+	534567963, -2079885360,
+	521795963, -2083126254,
+	509004318, -2086288720,
+	496193509, -2089372638,
+	483364019, -2092377892,
+	470516330, -2095304370,
+	457650927, -2098151960,
+	444768294, -2100920556,
+	431868915, -2103610054,
+	418953276, -2106220352,
+	406021865, -2108751352,
+	393075166, -2111202959,
+	380113669, -2113575080,
+	367137861, -2115867626,
+	354148230, -2118080511,
+	341145265, -2120213651,
+	328129457, -2122266967,
+	315101295, -2124240380,
+	302061269, -2126133817,
+	289009871, -2127947206,
+	275947592, -2129680480,
+	262874923, -2131333572,
+	249792358, -2132906420,
+	236700388, -2134398966,
+	223599506, -2135811153,
+	210490206, -2137142927,
+	197372981, -2138394240,
+	184248325, -2139565043,
+	171116733, -2140655293,
+	157978697, -2141664948,
+	144834714, -2142593971,
+	131685278, -2143442326,
+	118530885, -2144209982,
+	105372028, -2144896910,
+	92209205, -2145503083,
+	79042909, -2146028480,
+	65873638, -2146473080,
+	52701887, -2146836866,
+	39528151, -2147119825,
+	26352928, -2147321946,
+	13176712, -2147443222,
+	0, -2147483648,
+	-13176712, -2147443222,
+	-26352928, -2147321946,
+	-39528151, -2147119825,
+	-52701887, -2146836866,
+	-65873638, -2146473080,
+	-79042909, -2146028480,
+	-92209205, -2145503083,
+	-105372028, -2144896910,
+	-118530885, -2144209982,
+	-131685278, -2143442326,
+	-144834714, -2142593971,
+	-157978697, -2141664948,
+	-171116733, -2140655293,
+	-184248325, -2139565043,
+	-197372981, -2138394240,
+	-210490206, -2137142927,
+	-223599506, -2135811153,
+	-236700388, -2134398966,
+	-249792358, -2132906420,
+	-262874923, -2131333572,
+	-275947592, -2129680480,
+	-289009871, -2127947206,
+	-302061269, -2126133817,
+	-315101295, -2124240380,
+	-328129457, -2122266967,
+	-341145265, -2120213651,
+	-354148230, -2118080511,
+	-367137861, -2115867626,
+	-380113669, -2113575080,
+	-393075166, -2111202959,
+	-406021865, -2108751352,
+	-418953276, -2106220352,
+	-431868915, -2103610054,
+	-444768294, -2100920556,
+	-457650927, -2098151960,
+	-470516330, -2095304370,
+	-483364019, -2092377892,
+	-496193509, -2089372638,
+	-509004318, -2086288720,
+	-521795963, -2083126254,
+	-534567963, -2079885360,
+	-547319836, -2076566160,
+	-560051104, -2073168777,
+	-572761285, -2069693342,
+	-585449903, -2066139983,
+	-598116479, -2062508835,
+	-610760536, -2058800036,
+	-623381598, -2055013723,
+	-635979190, -2051150040,
+	-648552838, -2047209133,
+	-661102068, -2043191150,
+	-673626408, -2039096241,
+	-686125387, -2034924562,
+	-698598533, -2030676269,
+	-711045377, -2026351522,
+	-723465451, -2021950484,
+	-735858287, -2017473321,
+	-748223418, -2012920201,
+	-760560380, -2008291295,
+	-772868706, -2003586779,
+	-785147934, -1998806829,
+	-797397602, -1993951625,
+	-809617249, -1989021350,
+	-821806413, -1984016189,
+	-833964638, -1978936331,
+	-846091463, -1973781967,
+	-858186435, -1968553292,
+	-870249095, -1963250501,
+	-882278992, -1957873796,
+	-894275671, -1952423377,
+	-906238681, -1946899451,
+	-918167572, -1941302225,
+	-930061894, -1935631910,
+	-941921200, -1929888720,
+	-953745043, -1924072871,
+	-965532978, -1918184581,
+	-977284562, -1912224073,
+	-988999351, -1906191570,
+	-1000676905, -1900087301,
+	-1012316784, -1893911494,
+	-1023918550, -1887664383,
+	-1035481766, -1881346202,
+	-1047005996, -1874957189,
+	-1058490808, -1868497586,
+	-1069935768, -1861967634,
+	-1081340445, -1855367581,
+	-1092704411, -1848697674,
+	-1104027237, -1841958164,
+	-1115308496, -1835149306,
+	-1126547765, -1828271356,
+	-1137744621, -1821324572,
+	-1148898640, -1814309216,
+	-1160009405, -1807225553,
+	-1171076495, -1800073849,
+	-1182099496, -1792854372,
+	-1193077991, -1785567396,
+	-1204011567, -1778213194,
+	-1214899813, -1770792044,
+	-1225742318, -1763304224,
+	-1236538675, -1755750017,
+	-1247288478, -1748129707,
+	-1257991320, -1740443581,
+	-1268646800, -1732691928,
+	-1279254516, -1724875040,
+	-1289814068, -1716993211,
+	-1300325060, -1709046739,
+	-1310787095, -1701035922,
+	-1321199781, -1692961062,
+	-1331562723, -1684822463,
+	-1341875533, -1676620432,
+	-1352137822, -1668355276,
+	-1362349204, -1660027308,
+	-1372509294, -1651636841,
+	-1382617710, -1643184191,
+	-1392674072, -1634669676,
+	-1402678000, -1626093616,
+	-1412629117, -1617456335,
+	-1422527051, -1608758157,
+	-1432371426, -1599999411,
+	-1442161874, -1591180426,
+	-1451898025, -1582301533,
+	-1461579514, -1573363068,
+	-1471205974, -1564365367,
+	-1480777044, -1555308768,
+	-1490292364, -1546193612,
+	-1499751576, -1537020244,
+	-1509154322, -1527789007,
+	-1518500250, -1518500250,
+	-1527789007, -1509154322,
+	-1537020244, -1499751576,
+	-1546193612, -1490292364,
+	-1555308768, -1480777044,
+	-1564365367, -1471205974,
+	-1573363068, -1461579514,
+	-1582301533, -1451898025,
+	-1591180426, -1442161874,
+	-1599999411, -1432371426,
+	-1608758157, -1422527051,
+	-1617456335, -1412629117,
+	-1626093616, -1402678000,
+	-1634669676, -1392674072,
+	-1643184191, -1382617710,
+	-1651636841, -1372509294,
+	-1660027308, -1362349204,
+	-1668355276, -1352137822,
+	-1676620432, -1341875533,
+	-1684822463, -1331562723,
+	-1692961062, -1321199781,
+	-1701035922, -1310787095,
+	-1709046739, -1300325060,
+	-1716993211, -1289814068,
+	-1724875040, -1279254516,
+	-1732691928, -1268646800,
+	-1740443581, -1257991320,
+	-1748129707, -1247288478,
+	-1755750017, -1236538675,
+	-1763304224, -1225742318,
+	-1770792044, -1214899813,
+	-1778213194, -1204011567,
+	-1785567396, -1193077991,
+	-1792854372, -1182099496,
+	-1800073849, -1171076495,
+	-1807225553, -1160009405,
+	-1814309216, -1148898640,
+	-1821324572, -1137744621,
+	-1828271356, -1126547765,
+	-1835149306, -1115308496,
+	-1841958164, -1104027237,
+	-1848697674, -1092704411,
+	-1855367581, -1081340445,
+	-1861967634, -1069935768,
+	-1868497586, -1058490808,
+	-1874957189, -1047005996,
+	-1881346202, -1035481766,
+	-1887664383, -1023918550,
+	-1893911494, -1012316784,
+	-1900087301, -1000676905,
+	-1906191570, -988999351,
+	-1912224073, -977284562,
+	-1918184581, -965532978,
+	-1924072871, -953745043,
+	-1929888720, -941921200,
+	-1935631910, -930061894,
+	-1941302225, -918167572,
+	-1946899451, -906238681,
+	-1952423377, -894275671,
+	-1957873796, -882278992,
+	-1963250501, -870249095,
+	-1968553292, -858186435,
+	-1973781967, -846091463,
+	-1978936331, -833964638,
+	-1984016189, -821806413,
+	-1989021350, -809617249,
+	-1993951625, -797397602,
+	-1998806829, -785147934,
+	-2003586779, -772868706,
+	-2008291295, -760560380,
+	-2012920201, -748223418,
+	-2017473321, -735858287,
+	-2021950484, -723465451,
+	-2026351522, -711045377,
+	-2030676269, -698598533,
+	-2034924562, -686125387,
+	-2039096241, -673626408,
+	-2043191150, -661102068,
+	-2047209133, -648552838,
+	-2051150040, -635979190,
+	-2055013723, -623381598,
+	-2058800036, -610760536,
+	-2062508835, -598116479,
+	-2066139983, -585449903,
+	-2069693342, -572761285,
+	-2073168777, -560051104,
+	-2076566160, -547319836,
+	-2079885360, -534567963,
+	-2083126254, -521795963,
+	-2086288720, -509004318,
+	-2089372638, -496193509,
+	-2092377892, -483364019,
+	-2095304370, -470516330,
+	-2098151960, -457650927,
+	-2100920556, -444768294,
+	-2103610054, -431868915,
+	-2106220352, -418953276,
+	-2108751352, -406021865,
+	-2111202959, -393075166,
+	-2113575080, -380113669,
+	-2115867626, -367137861,
+	-2118080511, -354148230,
+	-2120213651, -341145265,
+	-2122266967, -328129457,
+	-2124240380, -315101295,
+	-2126133817, -302061269,
+	-2127947206, -289009871,
+	-2129680480, -275947592,
+	-2131333572, -262874923,
+	-2132906420, -249792358,
+	-2134398966, -236700388,
+	-2135811153, -223599506,
+	-2137142927, -210490206,
+	-2138394240, -197372981,
+	-2139565043, -184248325,
+	-2140655293, -171116733,
+	-2141664948, -157978697,
+	-2142593971, -144834714,
+	-2143442326, -131685278,
+	-2144209982, -118530885,
+	-2144896910, -105372028,
+	-2145503083, -92209205,
+	-2146028480, -79042909,
+	-2146473080, -65873638,
+	-2146836866, -52701887,
+	-2147119825, -39528151,
+	-2147321946, -26352928,
+	-2147443222, -13176712,
+	-2147483648, 0,
+	-2147443222, 13176712,
+	-2147321946, 26352928,
+	-2147119825, 39528151,
+	-2146836866, 52701887,
+	-2146473080, 65873638,
+	-2146028480, 79042909,
+	-2145503083, 92209205,
+	-2144896910, 105372028,
+	-2144209982, 118530885,
+	-2143442326, 131685278,
+	-2142593971, 144834714,
+	-2141664948, 157978697,
+	-2140655293, 171116733,
+	-2139565043, 184248325,
+	-2138394240, 197372981,
+	-2137142927, 210490206,
+	-2135811153, 223599506,
+	-2134398966, 236700388,
+	-2132906420, 249792358,
+	-2131333572, 262874923,
+	-2129680480, 275947592,
+	-2127947206, 289009871,
+	-2126133817, 302061269,
+	-2124240380, 315101295,
+	-2122266967, 328129457,
+	-2120213651, 341145265,
+	-2118080511, 354148230,
+	-2115867626, 367137861,
+	-2113575080, 380113669,
+	-2111202959, 393075166,
+	-2108751352, 406021865,
+	-2106220352, 418953276,
+	-2103610054, 431868915,
+	-2100920556, 444768294,
+	-2098151960, 457650927,
+	-2095304370, 470516330,
+	-2092377892, 483364019,
+	-2089372638, 496193509,
+	-2086288720, 509004318,
+	-2083126254, 521795963,
+	-2079885360, 534567963,
+	-2076566160, 547319836,
+	-2073168777, 560051104,
+	-2069693342, 572761285,
+	-2066139983, 585449903,
+	-2062508835, 598116479,
+	-2058800036, 610760536,
+	-2055013723, 623381598,
+	-2051150040, 635979190,
+	-2047209133, 648552838,
+	-2043191150, 661102068,
+	-2039096241, 673626408,
+	-2034924562, 686125387,
+	-2030676269, 698598533,
+	-2026351522, 711045377,
+	-2021950484, 723465451,
+	-2017473321, 735858287,
+	-2012920201, 748223418,
+	-2008291295, 760560380,
+	-2003586779, 772868706,
+	-1998806829, 785147934,
+	-1993951625, 797397602,
+	-1989021350, 809617249,
+	-1984016189, 821806413,
+	-1978936331, 833964638,
+	-1973781967, 846091463,
+	-1968553292, 858186435,
+	-1963250501, 870249095,
+	-1957873796, 882278992,
+	-1952423377, 894275671,
+	-1946899451, 906238681,
+	-1941302225, 918167572,
+	-1935631910, 930061894,
+	-1929888720, 941921200,
+	-1924072871, 953745043,
+	-1918184581, 965532978,
+	-1912224073, 977284562,
+	-1906191570, 988999351,
+	-1900087301, 1000676905,
+	-1893911494, 1012316784,
+	-1887664383, 1023918550,
+	-1881346202, 1035481766,
+	-1874957189, 1047005996,
+	-1868497586, 1058490808,
+	-1861967634, 1069935768,
+	-1855367581, 1081340445,
+	-1848697674, 1092704411,
+	-1841958164, 1104027237,
+	-1835149306, 1115308496,
+	-1828271356, 1126547765,
+	-1821324572, 1137744621,
+	-1814309216, 1148898640,
+	-1807225553, 1160009405,
+	-1800073849, 1171076495,
+	-1792854372, 1182099496,
+	-1785567396, 1193077991,
+	-1778213194, 1204011567,
+	-1770792044, 1214899813,
+	-1763304224, 1225742318,
+	-1755750017, 1236538675,
+	-1748129707, 1247288478,
+	-1740443581, 1257991320,
+	-1732691928, 1268646800,
+	-1724875040, 1279254516,
+	-1716993211, 1289814068,
+	-1709046739, 1300325060,
+	-1701035922, 1310787095,
+	-1692961062, 1321199781,
+	-1684822463, 1331562723,
+	-1676620432, 1341875533,
+	-1668355276, 1352137822,
+	-1660027308, 1362349204,
+	-1651636841, 1372509294,
+	-1643184191, 1382617710,
+	-1634669676, 1392674072,
+	-1626093616, 1402678000,
+	-1617456335, 1412629117,
+	-1608758157, 1422527051,
+	-1599999411, 1432371426,
+	-1591180426, 1442161874,
+	-1582301533, 1451898025,
+	-1573363068, 1461579514,
+	-1564365367, 1471205974,
+	-1555308768, 1480777044,
+	-1546193612, 1490292364,
+	-1537020244, 1499751576,
+	-1527789007, 1509154322,
+	-1518500250, 1518500250,
+	-1509154322, 1527789007,
+	-1499751576, 1537020244,
+	-1490292364, 1546193612,
+	-1480777044, 1555308768,
+	-1471205974, 1564365367,
+	-1461579514, 1573363068,
+	-1451898025, 1582301533,
+	-1442161874, 1591180426,
+	-1432371426, 1599999411,
+	-1422527051, 1608758157,
+	-1412629117, 1617456335,
+	-1402678000, 1626093616,
+	-1392674072, 1634669676,
+	-1382617710, 1643184191,
+	-1372509294, 1651636841,
+	-1362349204, 1660027308,
+	-1352137822, 1668355276,
+	-1341875533, 1676620432,
+	-1331562723, 1684822463,
+	-1321199781, 1692961062,
+	-1310787095, 1701035922,
+	-1300325060, 1709046739,
+	-1289814068, 1716993211,
+	-1279254516, 1724875040,
+	-1268646800, 1732691928,
+	-1257991320, 1740443581,
+	-1247288478, 1748129707,
+	-1236538675, 1755750017,
+	-1225742318, 1763304224,
+	-1214899813, 1770792044,
+	-1204011567, 1778213194,
+	-1193077991, 1785567396,
+	-1182099496, 1792854372,
+	-1171076495, 1800073849,
+	-1160009405, 1807225553,
+	-1148898640, 1814309216,
+	-1137744621, 1821324572,
+	-1126547765, 1828271356,
+	-1115308496, 1835149306,
+	-1104027237, 1841958164,
+	-1092704411, 1848697674,
+	-1081340445, 1855367581,
+	-1069935768, 1861967634,
+	-1058490808, 1868497586,
+	-1047005996, 1874957189,
+	-1035481766, 1881346202,
+	-1023918550, 1887664383,
+	-1012316784, 1893911494,
+	-1000676905, 1900087301,
+	-988999351, 1906191570,
+	-977284562, 1912224073,
+	-965532978, 1918184581,
+	-953745043, 1924072871,
+	-941921200, 1929888720,
+	-930061894, 1935631910,
+	-918167572, 1941302225,
+	-906238681, 1946899451,
+	-894275671, 1952423377,
+	-882278992, 1957873796,
+	-870249095, 1963250501,
+	-858186435, 1968553292,
+	-846091463, 1973781967,
+	-833964638, 1978936331,
+	-821806413, 1984016189,
+	-809617249, 1989021350,
+	-797397602, 1993951625,
+	-785147934, 1998806829,
+	-772868706, 2003586779,
+	-760560380, 2008291295,
+	-748223418, 2012920201,
+	-735858287, 2017473321,
+	-723465451, 2021950484,
+	-711045377, 2026351522,
+	-698598533, 2030676269,
+	-686125387, 2034924562,
+	-673626408, 2039096241,
+	-661102068, 2043191150,
+	-648552838, 2047209133,
+	-635979190, 2051150040,
+	-623381598, 2055013723,
+	-610760536, 2058800036,
+	-598116479, 2062508835,
+	-585449903, 2066139983,
+	-572761285, 2069693342,
+	-560051104, 2073168777,
+	-547319836, 2076566160,
+	-534567963, 2079885360,
+	-521795963, 2083126254,
+	-509004318, 2086288720,
+	-496193509, 2089372638,
+	-483364019, 2092377892,
+	-470516330, 2095304370,
+	-457650927, 2098151960,
+	-444768294, 2100920556,
+	-431868915, 2103610054,
+	-418953276, 2106220352,
+	-406021865, 2108751352,
+	-393075166, 2111202959,
+	-380113669, 2113575080,
+	-367137861, 2115867626,
+	-354148230, 2118080511,
+	-341145265, 2120213651,
+	-328129457, 2122266967,
+	-315101295, 2124240380,
+	-302061269, 2126133817,
+	-289009871, 2127947206,
+	-275947592, 2129680480,
+	-262874923, 2131333572,
+	-249792358, 2132906420,
+	-236700388, 2134398966,
+	-223599506, 2135811153,
+	-210490206, 2137142927,
+	-197372981, 2138394240,
+	-184248325, 2139565043,
+	-171116733, 2140655293,
+	-157978697, 2141664948,
+	-144834714, 2142593971,
+	-131685278, 2143442326,
+	-118530885, 2144209982,
+	-105372028, 2144896910,
+	-92209205, 2145503083,
+	-79042909, 2146028480,
+	-65873638, 2146473080,
+	-52701887, 2146836866,
+	-39528151, 2147119825,
+	-26352928, 2147321946,
+	-13176712, 2147443222,
+	0, 2147483647,
+	13176712, 2147443222,
+	26352928, 2147321946,
+	39528151, 2147119825,
+	52701887, 2146836866,
+	65873638, 2146473080,
+	79042909, 2146028480,
+	92209205, 2145503083,
+	105372028, 2144896910,
+	118530885, 2144209982,
+	131685278, 2143442326,
+	144834714, 2142593971,
+	157978697, 2141664948,
+	171116733, 2140655293,
+	184248325, 2139565043,
+	197372981, 2138394240,
+	210490206, 2137142927,
+	223599506, 2135811153,
+	236700388, 2134398966,
+	249792358, 2132906420,
+	262874923, 2131333572,
+	275947592, 2129680480,
+	289009871, 2127947206,
+	302061269, 2126133817,
+	315101295, 2124240380,
+	328129457, 2122266967,
+	341145265, 2120213651,
+	354148230, 2118080511,
+	367137861, 2115867626,
+	380113669, 2113575080,
+	393075166, 2111202959,
+	406021865, 2108751352,
+	418953276, 2106220352,
+	431868915, 2103610054,
+	444768294, 2100920556,
+	457650927, 2098151960,
+	470516330, 2095304370,
+	483364019, 2092377892,
+	496193509, 2089372638,
+	509004318, 2086288720,
+	521795963, 2083126254,
+	534567963, 2079885360,
+	547319836, 2076566160,
+	560051104, 2073168777,
+	572761285, 2069693342,
+	585449903, 2066139983,
+	598116479, 2062508835,
+	610760536, 2058800036,
+	623381598, 2055013723,
+	635979190, 2051150040,
+	648552838, 2047209133,
+	661102068, 2043191150,
+	673626408, 2039096241,
+	686125387, 2034924562,
+	698598533, 2030676269,
+	711045377, 2026351522,
+	723465451, 2021950484,
+	735858287, 2017473321,
+	748223418, 2012920201,
+	760560380, 2008291295,
+	772868706, 2003586779,
+	785147934, 1998806829,
+	797397602, 1993951625,
+	809617249, 1989021350,
+	821806413, 1984016189,
+	833964638, 1978936331,
+	846091463, 1973781967,
+	858186435, 1968553292,
+	870249095, 1963250501,
+	882278992, 1957873796,
+	894275671, 1952423377,
+	906238681, 1946899451,
+	918167572, 1941302225,
+	930061894, 1935631910,
+	941921200, 1929888720,
+	953745043, 1924072871,
+	965532978, 1918184581,
+	977284562, 1912224073,
+	988999351, 1906191570,
+	1000676905, 1900087301,
+	1012316784, 1893911494,
+	1023918550, 1887664383,
+	1035481766, 1881346202,
+	1047005996, 1874957189,
+	1058490808, 1868497586,
+	1069935768, 1861967634,
+	1081340445, 1855367581,
+	1092704411, 1848697674,
+	1104027237, 1841958164,
+	1115308496, 1835149306,
+	1126547765, 1828271356,
+	1137744621, 1821324572,
+	1148898640, 1814309216,
+	1160009405, 1807225553,
+	1171076495, 1800073849,
+	1182099496, 1792854372,
+	1193077991, 1785567396,
+	1204011567, 1778213194,
+	1214899813, 1770792044,
+	1225742318, 1763304224,
+	1236538675, 1755750017,
+	1247288478, 1748129707,
+	1257991320, 1740443581,
+	1268646800, 1732691928,
+	1279254516, 1724875040,
+	1289814068, 1716993211,
+	1300325060, 1709046739,
+	1310787095, 1701035922,
+	1321199781, 1692961062,
+	1331562723, 1684822463,
+	1341875533, 1676620432,
+	1352137822, 1668355276,
+	1362349204, 1660027308,
+	1372509294, 1651636841,
+	1382617710, 1643184191,
+	1392674072, 1634669676,
+	1402678000, 1626093616,
+	1412629117, 1617456335,
+	1422527051, 1608758157,
+	1432371426, 1599999411,
+	1442161874, 1591180426,
+	1451898025, 1582301533,
+	1461579514, 1573363068,
+	1471205974, 1564365367,
+	1480777044, 1555308768,
+	1490292364, 1546193612,
+	1499751576, 1537020244,
+	1509154322, 1527789007,
+	1518500250, 1518500250,
+	1527789007, 1509154322,
+	1537020244, 1499751576,
+	1546193612, 1490292364,
+	1555308768, 1480777044,
+	1564365367, 1471205974,
+	1573363068, 1461579514,
+	1582301533, 1451898025,
+	1591180426, 1442161874,
+	1599999411, 1432371426,
+	1608758157, 1422527051,
+	1617456335, 1412629117,
+	1626093616, 1402678000,
+	1634669676, 1392674072,
+	1643184191, 1382617710,
+	1651636841, 1372509294,
+	1660027308, 1362349204,
+	1668355276, 1352137822,
+	1676620432, 1341875533,
+	1684822463, 1331562723,
+	1692961062, 1321199781,
+	1701035922, 1310787095,
+	1709046739, 1300325060,
+	1716993211, 1289814068,
+	1724875040, 1279254516,
+	1732691928, 1268646800,
+	1740443581, 1257991320,
+	1748129707, 1247288478,
+	1755750017, 1236538675,
+	1763304224, 1225742318,
+	1770792044, 1214899813,
+	1778213194, 1204011567,
+	1785567396, 1193077991,
+	1792854372, 1182099496,
+	1800073849, 1171076495,
+	1807225553, 1160009405,
+	1814309216, 1148898640,
+	1821324572, 1137744621,
+	1828271356, 1126547765,
+	1835149306, 1115308496,
+	1841958164, 1104027237,
+	1848697674, 1092704411,
+	1855367581, 1081340445,
+	1861967634, 1069935768,
+	1868497586, 1058490808,
+	1874957189, 1047005996,
+	1881346202, 1035481766,
+	1887664383, 1023918550,
+	1893911494, 1012316784,
+	1900087301, 1000676905,
+	1906191570, 988999351,
+	1912224073, 977284562,
+	1918184581, 965532978,
+	1924072871, 953745043,
+	1929888720, 941921200,
+	1935631910, 930061894,
+	1941302225, 918167572,
+	1946899451, 906238681,
+	1952423377, 894275671,
+	1957873796, 882278992,
+	1963250501, 870249095,
+	1968553292, 858186435,
+	1973781967, 846091463,
+	1978936331, 833964638,
+	1984016189, 821806413,
+	1989021350, 809617249,
+	1993951625, 797397602,
+	1998806829, 785147934,
+	2003586779, 772868706,
+	2008291295, 760560380,
+	2012920201, 748223418,
+	2017473321, 735858287,
+	2021950484, 723465451,
+	2026351522, 711045377,
+	2030676269, 698598533,
+	2034924562, 686125387,
+	2039096241, 673626408,
+	2043191150, 661102068,
+	2047209133, 648552838,
+	2051150040, 635979190,
+	2055013723, 623381598,
+	2058800036, 610760536,
+	2062508835, 598116479,
+	2066139983, 585449903,
+	2069693342, 572761285,
+	2073168777, 560051104,
+	2076566160, 547319836,
+	2079885360, 534567963,
+	2083126254, 521795963,
+	2086288720, 509004318,
+	2089372638, 496193509,
+	2092377892, 483364019,
+	2095304370, 470516330,
+	2098151960, 457650927,
+	2100920556, 444768294,
+	2103610054, 431868915,
+	2106220352, 418953276,
+	2108751352, 406021865,
+	2111202959, 393075166,
+	2113575080, 380113669,
+	2115867626, 367137861,
+	2118080511, 354148230,
+	2120213651, 341145265,
+	2122266967, 328129457,
+	2124240380, 315101295,
+	2126133817, 302061269,
+	2127947206, 289009871,
+	2129680480, 275947592,
+	2131333572, 262874923,
+	2132906420, 249792358,
+	2134398966, 236700388,
+	2135811153, 223599506,
+	2137142927, 210490206,
+	2138394240, 197372981,
+	2139565043, 184248325,
+	2140655293, 171116733,
+	2141664948, 157978697,
+	2142593971, 144834714,
+	2143442326, 131685278,
+	2144209982, 118530885,
+	2144896910, 105372028,
+	2145503083, 92209205,
+	2146028480, 79042909,
+	2146473080, 65873638,
+	2146836866, 52701887,
+	2147119825, 39528151,
+	2147321946, 26352928,
+	2147443222, 13176712,
+};
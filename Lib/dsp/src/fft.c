@@ -0,0 +1,402 @@
+#include "dsp.h"
+#include "dsp_tables.h"
+
+/*
+ * Radix-2^2 decimation in frequency. Each radix-4 pass splits a block
+ * of L points into four L/4 blocks holding X[4k], X[4k+2], X[4k+1],
+ * X[4k+3]; storing the middle two swapped keeps the final permutation
+ * a plain bit reversal, as with radix-2. Twiddles come from the
+ * DSP_FFT_MAX table with a stride, the j loop is outermost so each
+ * twiddle triple is loaded once per pass.
+ */
+
+static int dsp_fft_len_ok(uint32_t n, uint32_t max)
+{
+	return n >= 2 && n <= max && (n & (n - 1)) == 0;
+}
+
+static void dsp_bitrev_f32(float *buf, uint32_t n)
+{
+	for (uint32_t i = 1, j = 0; i < n; i++) {
+		uint32_t bit = n >> 1;
+
+		for (; j & bit; bit >>= 1)
+			j ^= bit;
+		j |= bit;
+		if (i < j) {
+			float re = buf[2 * i], im = buf[2 * i + 1];
+
+			buf[2 * i] = buf[2 * j];
+			buf[2 * i + 1] = buf[2 * j + 1];
+			buf[2 * j] = re;
+			buf[2 * j + 1] = im;
+		}
+	}
+}
+
+static void dsp_bitrev_q15(q15_t *buf, uint32_t n)
+{
+	uint32_t *c = (uint32_t *)buf;
+
+	for (uint32_t i = 1, j = 0; i < n; i++) {
+		uint32_t bit = n >> 1;
+
+		for (; j & bit; bit >>= 1)
+			j ^= bit;
+		j |= bit;
+		if (i < j) {
+			uint32_t t = c[i];
+
+			c[i] = c[j];
+			c[j] = t;
+		}
+	}
+}
+
+static void dsp_bitrev_q31(q31_t *buf, uint32_t n)
+{
+	for (uint32_t i = 1, j = 0; i < n; i++) {
+		uint32_t bit = n >> 1;
+
+		for (; j & bit; bit >>= 1)
+			j ^= bit;
+		j |= bit;
+		if (i < j) {
+			q31_t re = buf[2 * i], im = buf[2 * i + 1];
+
+			buf[2 * i] = buf[2 * j];
+			buf[2 * i + 1] = buf[2 * j + 1];
+			buf[2 * j] = re;
+			buf[2 * j + 1] = im;
+		}
+	}
+}
+
+DSP_RAMFUNC int dsp_cfft_f32(float *buf, uint32_t n)
+{
+	const float *tw = dsp_twiddle_f32;
+	uint32_t len;
+
+	if (!dsp_fft_len_ok(n, DSP_FFT_MAX / 2))
+		return -1;
+
+	for (len = n; len >= 4; len >>= 2) {
+		const uint32_t q = len >> 2;
+		const uint32_t stride = DSP_FFT_MAX / len;
+
+		for (uint32_t j = 0; j < q; j++) {
+			const float w1r = tw[2 * j * stride];
+			const float w1i = tw[2 * j * stride + 1];
+			const float w2r = tw[4 * j * stride];
+			const float w2i = tw[4 * j * stride + 1];
+			const float w3r = tw[6 * j * stride];
+			const float w3i = tw[6 * j * stride + 1];
+
+			for (uint32_t b = j; b < n; b += len) {
+				float *x0 = buf + 2 * b;
+				float *x1 = x0 + 2 * q;
+				float *x2 = x1 + 2 * q;
+				float *x3 = x2 + 2 * q;
+				float s02r = x0[0] + x2[0];
+				float s02i = x0[1] + x2[1];
+				float d02r = x0[0] - x2[0];
+				float d02i = x0[1] - x2[1];
+				float s13r = x1[0] + x3[0];
+				float s13i = x1[1] + x3[1];
+				float d13r = x1[0] - x3[0];
+				float d13i = x1[1] - x3[1];
+				float tr, ti;
+
+				x0[0] = s02r + s13r;
+				x0[1] = s02i + s13i;
+				/* X[4k+2] */
+				tr = s02r - s13r;
+				ti = s02i - s13i;
+				x1[0] = tr * w2r - ti * w2i;
+				x1[1] = tr * w2i + ti * w2r;
+				/* X[4k+1]: d02 - i * d13 */
+				tr = d02r + d13i;
+				ti = d02i - d13r;
+				x2[0] = tr * w1r - ti * w1i;
+				x2[1] = tr * w1i + ti * w1r;
+				/* X[4k+3]: d02 + i * d13 */
+				tr = d02r - d13i;
+				ti = d02i + d13r;
+				x3[0] = tr * w3r - ti * w3i;
+				x3[1] = tr * w3i + ti * w3r;
+			}
+		}
+	}
+
+	if (len == 2) {
+		for (uint32_t b = 0; b < n; b += 2) {
+			float *x = buf + 2 * b;
+			float r = x[0] - x[2], i = x[1] - x[3];
+
+			x[0] += x[2];
+			x[1] += x[3];
+			x[2] = r;
+			x[3] = i;
+		}
+	}
+
+	dsp_bitrev_f32(buf, n);
+	return 0;
+}
+
+static inline q15_t dsp_cmul_re_q15(int32_t ar, int32_t ai, int32_t wr,
+				    int32_t wi)
+{
+	return dsp_sat_q15((ar * wr - ai * wi + (1 << 14)) >> 15);
+}
+
+static inline q15_t dsp_cmul_im_q15(int32_t ar, int32_t ai, int32_t wr,
+				    int32_t wi)
+{
+	return dsp_sat_q15((ar * wi + ai * wr + (1 << 14)) >> 15);
+}
+
+DSP_RAMFUNC int dsp_cfft_q15(q15_t *buf, uint32_t n)
+{
+	const int16_t *tw = dsp_twiddle_q15;
+	uint32_t len;
+
+	if (!dsp_fft_len_ok(n, DSP_FFT_MAX / 2))
+		return -1;
+
+	/* Every radix-4 pass scales by 1/4, the radix-2 pass by 1/2 */
+	for (len = n; len >= 4; len >>= 2) {
+		const uint32_t q = len >> 2;
+		const uint32_t stride = DSP_FFT_MAX / len;
+
+		for (uint32_t j = 0; j < q; j++) {
+			const int32_t w1r = tw[2 * j * stride];
+			const int32_t w1i = tw[2 * j * stride + 1];
+			const int32_t w2r = tw[4 * j * stride];
+			const int32_t w2i = tw[4 * j * stride + 1];
+			const int32_t w3r = tw[6 * j * stride];
+			const int32_t w3i = tw[6 * j * stride + 1];
+
+			for (uint32_t b = j; b < n; b += len) {
+				q15_t *x0 = buf + 2 * b;
+				q15_t *x1 = x0 + 2 * q;
+				q15_t *x2 = x1 + 2 * q;
+				q15_t *x3 = x2 + 2 * q;
+				int32_t s02r = x0[0] + x2[0];
+				int32_t s02i = x0[1] + x2[1];
+				int32_t d02r = x0[0] - x2[0];
+				int32_t d02i = x0[1] - x2[1];
+				int32_t s13r = x1[0] + x3[0];
+				int32_t s13i = x1[1] + x3[1];
+				int32_t d13r = x1[0] - x3[0];
+				int32_t d13i = x1[1] - x3[1];
+				int32_t tr, ti;
+
+				x0[0] = (q15_t)((s02r + s13r) >> 2);
+				x0[1] = (q15_t)((s02i + s13i) >> 2);
+				tr = (s02r - s13r) >> 2;
+				ti = (s02i - s13i) >> 2;
+				x1[0] = dsp_cmul_re_q15(tr, ti, w2r, w2i);
+				x1[1] = dsp_cmul_im_q15(tr, ti, w2r, w2i);
+				tr = (d02r + d13i) >> 2;
+				ti = (d02i - d13r) >> 2;
+				x2[0] = dsp_cmul_re_q15(tr, ti, w1r, w1i);
+				x2[1] = dsp_cmul_im_q15(tr, ti, w1r, w1i);
+				tr = (d02r - d13i) >> 2;
+				ti = (d02i + d13r) >> 2;
+				x3[0] = dsp_cmul_re_q15(tr, ti, w3r, w3i);
+				x3[1] = dsp_cmul_im_q15(tr, ti, w3r, w3i);
+			}
+		}
+	}
+
+	if (len == 2) {
+		for (uint32_t b = 0; b < n; b += 2) {
+			q15_t *x = buf + 2 * b;
+			int32_t r = x[0] - x[2], i = x[1] - x[3];
+
+			x[0] = (q15_t)((x[0] + x[2]) >> 1);
+			x[1] = (q15_t)((x[1] + x[3]) >> 1);
+			x[2] = (q15_t)(r >> 1);
+			x[3] = (q15_t)(i >> 1);
+		}
+	}
+
+	dsp_bitrev_q15(buf, n);
+	return 0;
+}
+
+static inline q31_t dsp_cmul_re_q31(int32_t ar, int32_t ai, int32_t wr,
+				    int32_t wi)
+{
+	return dsp_sat_q31(((int64_t)ar * wr - (int64_t)ai * wi + (1 << 30)) >>
+			   31);
+}
+
+static inline q31_t dsp_cmul_im_q31(int32_t ar, int32_t ai, int32_t wr,
+				    int32_t wi)
+{
+	return dsp_sat_q31(((int64_t)ar * wi + (int64_t)ai * wr + (1 << 30)) >>
+			   31);
+}
+
+DSP_RAMFUNC int dsp_cfft_q31(q31_t *buf, uint32_t n)
+{
+	const int32_t *tw = dsp_twiddle_q31;
+	uint32_t len;
+
+	if (!dsp_fft_len_ok(n, DSP_FFT_MAX / 2))
+		return -1;
+
+	/*
+	 * Inputs are scaled by 1/4 before the butterfly so the sums fit
+	 * in 32 bits; the radix-2 pass halves them the same way
+	 */
+	for (len = n; len >= 4; len >>= 2) {
+		const uint32_t q = len >> 2;
+		const uint32_t stride = DSP_FFT_MAX / len;
+
+		for (uint32_t j = 0; j < q; j++) {
+			const int32_t w1r = tw[2 * j * stride];
+			const int32_t w1i = tw[2 * j * stride + 1];
+			const int32_t w2r = tw[4 * j * stride];
+			const int32_t w2i = tw[4 * j * stride + 1];
+			const int32_t w3r = tw[6 * j * stride];
+			const int32_t w3i = tw[6 * j * stride + 1];
+
+			for (uint32_t b = j; b < n; b += len) {
+				q31_t *x0 = buf + 2 * b;
+				q31_t *x1 = x0 + 2 * q;
+				q31_t *x2 = x1 + 2 * q;
+				q31_t *x3 = x2 + 2 * q;
+				int32_t a0r = x0[0] >> 2, a0i = x0[1] >> 2;
+				int32_t a1r = x1[0] >> 2, a1i = x1[1] >> 2;
+				int32_t a2r = x2[0] >> 2, a2i = x2[1] >> 2;
+				int32_t a3r = x3[0] >> 2, a3i = x3[1] >> 2;
+				int32_t s02r = a0r + a2r, s02i = a0i + a2i;
+				int32_t d02r = a0r - a2r, d02i = a0i - a2i;
+				int32_t s13r = a1r + a3r, s13i = a1i + a3i;
+				int32_t d13r = a1r - a3r, d13i = a1i - a3i;
+				int32_t tr, ti;
+
+				x0[0] = s02r + s13r;
+				x0[1] = s02i + s13i;
+				tr = s02r - s13r;
+				ti = s02i - s13i;
+				x1[0] = dsp_cmul_re_q31(tr, ti, w2r, w2i);
+				x1[1] = dsp_cmul_im_q31(tr, ti, w2r, w2i);
+				tr = d02r + d13i;
+				ti = d02i - d13r;
+				x2[0] = dsp_cmul_re_q31(tr, ti, w1r, w1i);
+				x2[1] = dsp_cmul_im_q31(tr, ti, w1r, w1i);
+				tr = d02r - d13i;
+				ti = d02i + d13r;
+				x3[0] = dsp_cmul_re_q31(tr, ti, w3r, w3i);
+				x3[1] = dsp_cmul_im_q31(tr, ti, w3r, w3i);
+			}
+		}
+	}
+
+	if (len == 2) {
+		for (uint32_t b = 0; b < n; b += 2) {
+			q31_t *x = buf + 2 * b;
+			int32_t ar = x[0] >> 1, ai = x[1] >> 1;
+			int32_t br = x[2] >> 1, bi = x[3] >> 1;
+
+			x[0] = ar + br;
+			x[1] = ai + bi;
+			x[2] = ar - br;
+			x[3] = ai - bi;
+		}
+	}
+
+	dsp_bitrev_q31(buf, n);
+	return 0;
+}
+
+/*
+ * n real points are transformed as n/2 complex points z[m] =
+ * x[2m] + i x[2m+1], then split into the even/odd spectra:
+ * E = (Z[k] + Z*[M-k]) / 2, O = (Z[k] - Z*[M-k]) / 2i,
+ * X[k] = E + W^k O, X[M-k] = (E - W^k O)*.
+ */
+DSP_RAMFUNC int dsp_rfft_f32(float *buf, uint32_t n)
+{
+	const uint32_t m = n >> 1;
+	uint32_t stride;
+	float z0r, z0i;
+
+	if (n < 4 || !dsp_fft_len_ok(n, DSP_FFT_MAX))
+		return -1;
+	stride = DSP_FFT_MAX / n;
+
+	dsp_cfft_f32(buf, m);
+
+	for (uint32_t k = 1; k <= m / 2; k++) {
+		float *a = buf + 2 * k;
+		float *b = buf + 2 * (m - k);
+		float wr = dsp_twiddle_f32[2 * k * stride];
+		float wi = dsp_twiddle_f32[2 * k * stride + 1];
+		float er = 0.5f * (a[0] + b[0]), ei = 0.5f * (a[1] - b[1]);
+		float odr = 0.5f * (a[1] + b[1]), odi = -0.5f * (a[0] - b[0]);
+		float tr = odr * wr - odi * wi, ti = odr * wi + odi * wr;
+
+		a[0] = er + tr;
+		a[1] = ei + ti;
+		b[0] = er - tr;
+		b[1] = ti - ei;
+	}
+
+	z0r = buf[0];
+	z0i = buf[1];
+	buf[0] = z0r + z0i;
+	buf[1] = z0r - z0i;
+	return 0;
+}
+
+/* As dsp_rfft_f32(); E and O take 1/4 instead of 1/2 to reach 1/n */
+DSP_RAMFUNC int dsp_rfft_q31(q31_t *buf, uint32_t n)
+{
+	const uint32_t m = n >> 1;
+	uint32_t stride;
+	int64_t z0r, z0i;
+
+	if (n < 4 || !dsp_fft_len_ok(n, DSP_FFT_MAX))
+		return -1;
+	stride = DSP_FFT_MAX / n;
+
+	dsp_cfft_q31(buf, m);
+
+	for (uint32_t k = 1; k <= m / 2; k++) {
+		q31_t *a = buf + 2 * k;
+		q31_t *b = buf + 2 * (m - k);
+		int32_t wr = dsp_twiddle_q31[2 * k * stride];
+		int32_t wi = dsp_twiddle_q31[2 * k * stride + 1];
+		int64_t er = ((int64_t)a[0] + b[0]) >> 2;
+		int64_t ei = ((int64_t)a[1] - b[1]) >> 2;
+		int32_t odr = (int32_t)(((int64_t)a[1] + b[1]) >> 2);
+		int32_t odi = (int32_t)(((int64_t)b[0] - a[0]) >> 2);
+		int64_t tr = dsp_cmul_re_q31(odr, odi, wr, wi);
+		int64_t ti = dsp_cmul_im_q31(odr, odi, wr, wi);
+
+		a[0] = dsp_sat_q31(er + tr);
+		a[1] = dsp_sat_q31(ei + ti);
+		b[0] = dsp_sat_q31(er - tr);
+		b[1] = dsp_sat_q31(ti - ei);
+	}
+
+	z0r = buf[0];
+	z0i = buf[1];
+	buf[0] = (q31_t)((z0r + z0i) >> 1);
+	buf[1] = (q31_t)((z0r - z0i) >> 1);
+	return 0;
+}
+
+void dsp_rfft_power_f32(const float *spec, float *power, uint32_t n)
+{
+	power[0] = spec[0] * spec[0];
+	power[n / 2] = spec[1] * spec[1];
+	for (uint32_t k = 1; k < n / 2; k++)
+		power[k] = spec[2 * k] * spec[2 * k] +
+			   spec[2 * k + 1] * spec[2 * k + 1];
+}
@@ -0,0 +1,116 @@
+#include <string.h>
+#include "dsp.h"
+
+void dsp_fir_init_f32(dsp_fir_f32_t *f, const float *coeffs, float *state,
+		      uint16_t ntaps, uint16_t decim)
+{
+	f->coeffs = coeffs;
+	f->state = state;
+	f->ntaps = ntaps;
+	f->decim = decim ? decim : 1;
+	memset(state, 0, (ntaps - 1) * sizeof(float));
+}
+
+void dsp_fir_init_q15(dsp_fir_q15_t *f, const q15_t *coeffs, q15_t *state,
+		      uint16_t ntaps, uint16_t decim)
+{
+	f->coeffs = coeffs;
+	f->state = state;
+	f->ntaps = ntaps;
+	f->decim = decim ? decim : 1;
+	memset(state, 0, (ntaps - 1) * sizeof(q15_t));
+}
+
+void dsp_fir_init_q31(dsp_fir_q31_t *f, const q31_t *coeffs, q31_t *state,
+		      uint16_t ntaps, uint16_t decim)
+{
+	f->coeffs = coeffs;
+	f->state = state;
+	f->ntaps = ntaps;
+	f->decim = decim ? decim : 1;
+	memset(state, 0, (ntaps - 1) * sizeof(q31_t));
+}
+
+/*
+ * The history and the new block sit back to back in state, so every
+ * output is one straight dot product: y[i] = sum b[k] * s[i + N-1 - k].
+ * Decimation only computes the outputs that are kept.
+ */
+
+DSP_RAMFUNC void dsp_fir_f32(dsp_fir_f32_t *f, const float *in, float *out,
+			     uint32_t n)
+{
+	const uint32_t ntaps = f->ntaps;
+	const float *b = f->coeffs;
+	float *s = f->state;
+
+	memcpy(s + ntaps - 1, in, n * sizeof(float));
+
+	for (uint32_t i = 0; i < n; i += f->decim) {
+		const float *px = s + i + ntaps - 1;
+		float acc0 = 0.0f, acc1 = 0.0f, acc2 = 0.0f, acc3 = 0.0f;
+		uint32_t k = 0;
+
+		/* Four independent accumulators hide the FMA latency */
+		for (; k + 4 <= ntaps; k += 4) {
+			acc0 += b[k] * px[-(int32_t)k];
+			acc1 += b[k + 1] * px[-(int32_t)k - 1];
+			acc2 += b[k + 2] * px[-(int32_t)k - 2];
+			acc3 += b[k + 3] * px[-(int32_t)k - 3];
+		}
+		for (; k < ntaps; k++)
+			acc0 += b[k] * px[-(int32_t)k];
+		*out++ = (acc0 + acc1) + (acc2 + acc3);
+	}
+
+	memmove(s, s + n, (ntaps - 1) * sizeof(float));
+}
+
+DSP_RAMFUNC void dsp_fir_q15(dsp_fir_q15_t *f, const q15_t *in, q15_t *out,
+			     uint32_t n)
+{
+	const uint32_t ntaps = f->ntaps;
+	const q15_t *b = f->coeffs;
+	q15_t *s = f->state;
+
+	memcpy(s + ntaps - 1, in, n * sizeof(q15_t));
+
+	for (uint32_t i = 0; i < n; i += f->decim) {
+		const q15_t *px = s + i + ntaps - 1;
+		int64_t acc0 = 0, acc1 = 0;
+		uint32_t k = 0;
+
+		/* Q30 products into 64-bit sums: no overflow for any ntaps */
+		for (; k + 2 <= ntaps; k += 2) {
+			acc0 += (int32_t)b[k] * px[-(int32_t)k];
+			acc1 += (int32_t)b[k + 1] * px[-(int32_t)k - 1];
+		}
+		if (k < ntaps)
+			acc0 += (int32_t)b[k] * px[-(int32_t)k];
+		acc0 += acc1;
+		*out++ = dsp_sat_q15(dsp_sat_q31((acc0 + (1 << 14)) >> 15));
+	}
+
+	memmove(s, s + n, (ntaps - 1) * sizeof(q15_t));
+}
+
+DSP_RAMFUNC void dsp_fir_q31(dsp_fir_q31_t *f, const q31_t *in, q31_t *out,
+			     uint32_t n)
+{
+	const uint32_t ntaps = f->ntaps;
+	const q31_t *b = f->coeffs;
+	q31_t *s = f->state;
+
+	memcpy(s + ntaps - 1, in, n * sizeof(q31_t));
+
+	for (uint32_t i = 0; i < n; i += f->decim) {
+		const q31_t *px = s + i + ntaps - 1;
+		int64_t acc = 0;
+
+		for (uint32_t k = 0; k < ntaps; k++)
+			acc += (int64_t)b[k] * px[-(int32_t)k];
+		*out++ = dsp_sat_q31(acc >> 31);
+	}
+
+	memmove(s, s + n, (ntaps - 1) * sizeof(q31_t));
+}
@@ -0,0 +1,119 @@
+#include <math.h>
+#include "dsp.h"
+
+static uint32_t dsp_isqrt64(uint64_t v)
+{
+	uint64_t res = 0;
+	uint64_t bit = 1ULL << 62;
+
+	while (bit > v)
+		bit >>= 2;
+	while (bit) {
+		if (v >= res + bit) {
+			v -= res + bit;
+			res = (res >> 1) + bit;
+		} else {
+			res >>= 1;
+		}
+		bit >>= 2;
+	}
+	return (uint32_t)res;
+}
+
+DSP_RAMFUNC float dsp_rms_f32(const float *in, uint32_t n)
+{
+	float acc0 = 0.0f, acc1 = 0.0f;
+	uint32_t i = 0;
+
+	if (n == 0)
+		return 0.0f;
+	for (; i + 2 <= n; i += 2) {
+		acc0 += in[i] * in[i];
+		acc1 += in[i + 1] * in[i + 1];
+	}
+	if (i < n)
+		acc0 += in[i] * in[i];
+	return sqrtf((acc0 + acc1) / (float)n);
+}
+
+DSP_RAMFUNC q15_t dsp_rms_q15(const q15_t *in, uint32_t n)
+{
+	uint64_t acc = 0;
+	uint32_t r;
+
+	if (n == 0)
+		return 0;
+	/* Q30 sum, mean stays Q30, its root is Q15 */
+	for (uint32_t i = 0; i < n; i++)
+		acc += (uint32_t)((int32_t)in[i] * in[i]);
+	r = dsp_isqrt64(acc / n);
+	return (q15_t)(r > INT16_MAX ? INT16_MAX : r);
+}
+
+DSP_RAMFUNC q31_t dsp_rms_q31(const q31_t *in, uint32_t n)
+{
+	uint64_t acc = 0;
+	uint32_t r;
+
+	if (n == 0)
+		return 0;
+	/* Squares truncated to Q31 keep the sum in 64 bits for any n */
+	for (uint32_t i = 0; i < n; i++)
+		acc += (uint64_t)((int64_t)in[i] * in[i]) >> 31;
+	r = dsp_isqrt64((acc / n) << 31);
+	return (q31_t)(r > INT32_MAX ? INT32_MAX : r);
+}
+
+DSP_RAMFUNC float dsp_peak_f32(const float *in, uint32_t n, uint32_t *idx)
+{
+	float peak = 0.0f;
+	uint32_t at = 0;
+
+	for (uint32_t i = 0; i < n; i++) {
+		float v = fabsf(in[i]);
+
+		if (v > peak) {
+			peak = v;
+			at = i;
+		}
+	}
+	if (idx)
+		*idx = at;
+	return peak;
+}
+
+DSP_RAMFUNC q15_t dsp_peak_q15(const q15_t *in, uint32_t n, uint32_t *idx)
+{
+	int32_t peak = 0;
+	uint32_t at = 0;
+
+	for (uint32_t i = 0; i < n; i++) {
+		int32_t v = in[i] < 0 ? -(int32_t)in[i] : in[i];
+
+		if (v > peak) {
+			peak = v;
+			at = i;
+		}
+	}
+	if (idx)
+		*idx = at;
+	return dsp_sat_q15(peak);
+}
+
+DSP_RAMFUNC q31_t dsp_peak_q31(const q31_t *in, uint32_t n, uint32_t *idx)
+{
+	int64_t peak = 0;
+	uint32_t at = 0;
+
+	for (uint32_t i = 0; i < n; i++) {
+		int64_t v = in[i] < 0 ? -(int64_t)in[i] : in[i];
+
+		if (v > peak) {
+			peak = v;
+			at = i;
+		}
+	}
+	if (idx)
+		*idx = at;
+	return dsp_sat_q31(peak);
+}
@@ -0,0 +1,46 @@
+#include <math.h>
+#include "dsp.h"
+
+#define DSP_PI 3.14159265358979f
+
+static float dsp_window_at(uint32_t i, uint32_t n, dsp_window_t type)
+{
+	float x = 2.0f * DSP_PI * (float)i / (float)n;
+
+	switch (type) {
+	case DSP_WIN_HAMMING:
+		return 0.54f - 0.46f * cosf(x);
+	case DSP_WIN_BLACKMAN:
+		return 0.42f - 0.5f * cosf(x) + 0.08f * cosf(2.0f * x);
+	case DSP_WIN_HANN:
+	default:
+		return 0.5f - 0.5f * cosf(x);
+	}
+}
+
+void dsp_window_f32(float *w, uint32_t n, dsp_window_t type)
+{
+	for (uint32_t i = 0; i < n; i++)
+		w[i] = dsp_window_at(i, n, type);
+}
+
+void dsp_window_q15(q15_t *w, uint32_t n, dsp_window_t type)
+{
+	for (uint32_t i = 0; i < n; i++)
+		w[i] = dsp_sat_q15(
+			(int32_t)lrintf(dsp_window_at(i, n, type) * 32768.0f));
+}
+
+DSP_RAMFUNC void dsp_mul_f32(const float *in, const float *w, float *out,
+			     uint32_t n)
+{
+	for (uint32_t i = 0; i < n; i++)
+		out[i] = in[i] * w[i];
+}
+
+DSP_RAMFUNC void dsp_mul_q15(const q15_t *in, const q15_t *w, q15_t *out,
+			     uint32_t n)
+{
+	for (uint32_t i = 0; i < n; i++)
+		out[i] = dsp_sat_q15(((int32_t)in[i] * w[i] + (1 << 14)) >> 15);
+}
@@ -28,7 +28,8 @@
 #define configMTIMECMP_BASE_ADDRESS              RISCV_MTIMECMP_ADDR
 #define configISR_STACK_SIZE_WORDS               ( 512 )
 
-#define configENABLE_FPU                         1
+/* FPU context is switched lazily by custom/port, not by the port */
+#define configENABLE_FPU                         0
 #define configENABLE_MPU                         0
 
 #define configUSE_PREEMPTION                     1
@@ -40,14 +41,25 @@
 #define configTICK_RATE_HZ                       ((TickType_t)1000)
 #define configMAX_PRIORITIES                     ( 32 )
 #define configMINIMAL_STACK_SIZE                 ((uint16_t)128)
+#ifdef SIM_HOST
+/* Host simulation: room for the test runner and the models */
+#define configTOTAL_HEAP_SIZE                    ((size_t)256*1024)
+#else
 #define configTOTAL_HEAP_SIZE                    ((size_t)32*1024)
+#endif
 #define configMAX_TASK_NAME_LEN                  ( 16 )
 #define configUSE_TRACE_FACILITY                 1
+/* Idle time for the clock governor (Lib/clk), counted on mtime */
+#define configGENERATE_RUN_TIME_STATS            1
 #define configUSE_16_BIT_TICKS                   0
 #define configUSE_MUTEXES                        1
 #define configQUEUE_REGISTRY_SIZE                8
 #define configUSE_RECURSIVE_MUTEXES              1
 #define configUSE_COUNTING_SEMAPHORES            1
+/* Index 0 is the application's, index 1 wakes ring consumers (Lib/ring),
+   index 2 dma_mem_wait() (Lib/dma), index 3 i2c_wait() (Lib/i2c),
+   index 4 QSPI DMA data phases (Lib/qspi_flash) */
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES    5
 #define configUSE_PORT_OPTIMISED_TASK_SELECTION  1
 
 /* USER CODE BEGIN MESSAGE_BUFFER_LENGTH_TYPE */
@@ -84,12 +96,18 @@ to exclude the API function. */
 #define INCLUDE_uxTaskGetStackHighWaterMark  1
 #define INCLUDE_xTaskGetCurrentTaskHandle    1
 #define INCLUDE_eTaskGetState                1
+#define INCLUDE_xTaskGetIdleTaskHandle       1
 
 
 /* Normal assert() semantics without relying on the provision of an assert.h
 header file. */
 /* USER CODE BEGIN 1 */
+#ifdef SIM_HOST
+void sim_assert_failed(const char *file, int line);
+#define configASSERT( x ) if ((x) == 0) sim_assert_failed(__FILE__, __LINE__)
+#else
 #define configASSERT( x ) if ((x) == 0) {taskDISABLE_INTERRUPTS(); for( ;; );}
+#endif
 /* USER CODE END 1 */
 
 
@@ -101,6 +119,11 @@ uint32_t RTOS_AppGetRuntimeCounterValueFromISR(void);
 #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() RTOS_AppConfigureTimerForRuntimeStats()
 #define portGET_RUN_TIME_COUNTER_VALUE() RTOS_AppGetRuntimeCounterValueFromISR()
 #endif
+
+/* Kernel event recorder (Lib/trace), TRACE_ENABLE CMake option */
+#if defined(TRACE_ENABLE) && (TRACE_ENABLE == 1) && !defined(__ASSEMBLER__)
+#include "trace_hooks.h"
+#endif
 /* USER CODE END Defines */
 
 #endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,65 @@
+#include <unistd.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "freeRTOS_RiscV_provider.h"
+#include "mtimer.h"
+
+/**
+ * @brief Host simulation counterpart of the RISC-V provider.
+ *
+ * Traps do not exist on the host: the POSIX port switches threads
+ * itself and Chip/host dispatches the simulated interrupts.
+ */
+void freertos_risc_v_provider_init(void)
+{
+}
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+__attribute__((weak)) void
+vApplicationGetIdleTaskMemory(StaticTask_t **ppxIdleTaskTCBBuffer,
+			      StackType_t **ppxIdleTaskStackBuffer,
+			      uint32_t *pulIdleTaskStackSize)
+{
+	/* Idle task control block and stack */
+	static StaticTask_t Idle_TCB;
+	static StackType_t Idle_Stack[configMINIMAL_STACK_SIZE];
+
+	*ppxIdleTaskTCBBuffer = &Idle_TCB;
+	*ppxIdleTaskStackBuffer = &Idle_Stack[0];
+	*pulIdleTaskStackSize = (uint32_t)configMINIMAL_STACK_SIZE;
+}
+
+__attribute__((weak)) void
+vApplicationGetTimerTaskMemory(StaticTask_t **ppxTimerTaskTCBBuffer,
+			       StackType_t **ppxTimerTaskStackBuffer,
+			       uint32_t *pulTimerTaskStackSize)
+{
+	/* Timer task control block and stack */
+	static StaticTask_t Timer_TCB;
+	static StackType_t Timer_Stack[configTIMER_TASK_STACK_DEPTH];
+
+	*ppxTimerTaskTCBBuffer = &Timer_TCB;
+	*ppxTimerTaskStackBuffer = &Timer_Stack[0];
+	*pulTimerTaskStackSize = (uint32_t)configTIMER_TASK_STACK_DEPTH;
+}
+#endif
+
+#if (configGENERATE_RUN_TIME_STATS == 1)
+/** @brief Run time statistics clock: the simulated mtime */
+void RTOS_AppConfigureTimerForRuntimeStats(void)
+{
+}
+
+uint32_t RTOS_AppGetRuntimeCounterValueFromISR(void)
+{
+	return (uint32_t)sim_mtime;
+}
+#endif
+
+#if (configUSE_IDLE_HOOK == 1)
+__attribute__((weak)) void vApplicationIdleHook(void)
+{
+	/* Host counterpart of wfi: give the CPU back until the next tick */
+	usleep(1000000 / configTICK_RATE_HZ);
+}
+#endif
@@ -1,10 +1,19 @@
 #include "FreeRTOS.h"
 #include "freeRTOS_RiscV_provider.h"
 #include "plic.h"
+#include "riscv-csr.h"
 #include <system_k1921vg015.h>
 
 void freertos_risc_v_trap_handler();
 
+/* Older kernels have no interrupt trace hooks */
+#ifndef traceISR_ENTER
+#define traceISR_ENTER()
+#endif
+#ifndef traceISR_EXIT
+#define traceISR_EXIT()
+#endif
+
 /**
  * @brief Initialize the FreeRTOS RISC-V provider.
  *
@@ -39,7 +48,46 @@ void freertos_risc_v_application_exception_handler(void)
  */
 void freertos_risc_v_application_interrupt_handler(void)
 {
+	traceISR_ENTER();
 	trap_handler();
+	traceISR_EXIT();
+}
+
+/* Trap frame of the task last interrupted, see the chip extensions */
+void *freertos_risc_v_fpu_frame;
+
+#define FPU_MSTATUS_FS (3UL << 13) /* dirty when all set */
+
+/* ft0-ft7, fa0-fa7, ft8-ft11 */
+#define FPU_CALLER_SAVED(op)                                          \
+	op " f0, 0(%0)\n" op " f1, 4(%0)\n" op " f2, 8(%0)\n"          \
+	op " f3, 12(%0)\n" op " f4, 16(%0)\n" op " f5, 20(%0)\n"       \
+	op " f6, 24(%0)\n" op " f7, 28(%0)\n" op " f10, 32(%0)\n"      \
+	op " f11, 36(%0)\n" op " f12, 40(%0)\n" op " f13, 44(%0)\n"    \
+	op " f14, 48(%0)\n" op " f15, 52(%0)\n" op " f16, 56(%0)\n"    \
+	op " f17, 60(%0)\n" op " f28, 64(%0)\n" op " f29, 68(%0)\n"    \
+	op " f30, 72(%0)\n" op " f31, 76(%0)\n"
+
+void freertos_risc_v_fpu_isr_enter(freertos_fpu_ctx_t *ctx)
+{
+	ctx->mstatus = csr_read_mstatus();
+	/* Not dirty: the task has nothing in the FPU worth keeping */
+	if ((ctx->mstatus & FPU_MSTATUS_FS) != FPU_MSTATUS_FS)
+		return;
+	__asm volatile(FPU_CALLER_SAVED("fsw") : : "r"(ctx->f) : "memory");
+	__asm volatile("frcsr %0" : "=r"(ctx->fcsr));
+}
+
+void freertos_risc_v_fpu_isr_exit(const freertos_fpu_ctx_t *ctx)
+{
+	if ((ctx->mstatus & FPU_MSTATUS_FS) == FPU_MSTATUS_FS) {
+		__asm volatile(FPU_CALLER_SAVED("flw") : : "r"(ctx->f)
+			       : "memory");
+		__asm volatile("fscsr %0" : : "r"(ctx->fcsr));
+	}
+	/* Leave FS as found, a switch then saves nothing the task lacks */
+	csr_clr_bits_mstatus(FPU_MSTATUS_FS);
+	csr_set_bits_mstatus(ctx->mstatus & FPU_MSTATUS_FS);
 }
 
 #if (configSUPPORT_STATIC_ALLOCATION == 1)
@@ -89,6 +137,24 @@ vApplicationGetTimerTaskMemory(StaticTask_t **ppxTimerTaskTCBBuffer,
 }
 #endif
 
+#if (configGENERATE_RUN_TIME_STATS == 1)
+/**
+ * @brief Run time statistics clock.
+ *
+ * The low word of mtime: already running, one load per context
+ * switch. It wraps after an hour at 1 MHz, the kernel only
+ * accumulates differences.
+ */
+void RTOS_AppConfigureTimerForRuntimeStats(void)
+{
+}
+
+uint32_t RTOS_AppGetRuntimeCounterValueFromISR(void)
+{
+	return *(volatile uint32_t *)RISCV_MTIME_ADDR;
+}
+#endif
+
 /**
   Dummy implementation of the callback function vApplicationIdleHook().
 */
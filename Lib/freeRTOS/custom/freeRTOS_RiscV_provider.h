@@ -1,6 +1,8 @@
 #ifndef __freeRTOS_RiscV_provider_h__
 #define __freeRTOS_RiscV_provider_h__
 
+#include <stdint.h>
+
 /* *INDENT-OFF* */
 #ifdef __cplusplus
 extern "C" {
@@ -17,6 +19,28 @@ extern "C" {
  */
 void freertos_risc_v_provider_init(void);
 
+/**
+ * @brief FPU state an interrupt handler may clobber.
+ *
+ * The FPU context is switched lazily, so interrupt handlers run on
+ * the registers of the interrupted task. A handler using float keeps
+ * one of these on its stack and brackets the float code with
+ * freertos_risc_v_fpu_isr_enter() and freertos_risc_v_fpu_isr_exit().
+ * Only the caller saved registers are kept, the handler's own
+ * prologue preserves the rest.
+ */
+typedef struct {
+	uint32_t mstatus;
+	uint32_t fcsr;
+	uint32_t f[20];
+} freertos_fpu_ctx_t;
+
+/** @brief Save the interrupted task's FPU state if it has any */
+void freertos_risc_v_fpu_isr_enter(freertos_fpu_ctx_t *ctx);
+
+/** @brief Restore what freertos_risc_v_fpu_isr_enter() saved */
+void freertos_risc_v_fpu_isr_exit(const freertos_fpu_ctx_t *ctx);
+
 /* *INDENT-OFF* */
 #ifdef __cplusplus
 }
@@ -0,0 +1,82 @@
+#ifndef __FREERTOS_RISC_V_EXTENSIONS_H__
+#define __FREERTOS_RISC_V_EXTENSIONS_H__
+
+/*
+ * Chip extensions of the GCC RISC-V port for K1921VG015: the stock
+ * MTIME/CLINT settings plus a lazy FPU context (configENABLE_FPU is 0,
+ * the port saves integer registers only).
+ *
+ * Every trap frame gets room for the FPU registers, but they are
+ * stored only when a real task switch happens and the outgoing task
+ * left mstatus.FS dirty, and loaded only for a task that has them
+ * saved. Interrupts that return to the same task, and tasks that
+ * never touch the FPU, cost two stores and a compare.
+ *
+ * Interrupt handlers therefore run on the interrupted task's FPU
+ * registers: float code in an ISR goes between
+ * freertos_risc_v_fpu_isr_enter() and freertos_risc_v_fpu_isr_exit().
+ *
+ * Area layout in words, sp at entry: 0 mepc (written by the port),
+ * 1 saved flag, 2 fcsr, 3..34 f0..f31, 35 unused.
+ */
+
+#if !defined(__riscv_flen) || (__riscv_flen != 32)
+#error "Lazy FPU context is written for the single precision F extension"
+#endif
+
+#define portasmHAS_SIFIVE_CLINT 1
+#define portasmHAS_MTIME 1
+/* Must be even number on 32-bit cores */
+#define portasmADDITIONAL_CONTEXT_SIZE 36
+
+#define portasmFPU_FLAG 4
+#define portasmFPU_FCSR 8
+#define portasmFPU_REGS 12
+
+/* mstatus.FS, 3 is dirty */
+#define portasmMSTATUS_FS_SHIFT 13
+
+/* f0..f31 to or from the area at \base */
+.macro portasmFPU_REGS_OP op, base
+	.irp n, 0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15, \
+		16,17,18,19,20,21,22,23,24,25,26,27,28,29,30,31
+	\op f\n, (portasmFPU_REGS + 4 * \n)(\base)
+	.endr
+	.endm
+
+.macro portasmSAVE_ADDITIONAL_REGISTERS
+	addi sp, sp, -(portasmADDITIONAL_CONTEXT_SIZE * 4)
+	sw x0, portasmFPU_FLAG(sp)
+	/* Frame of the task being left, the restore compares against it */
+	la t0, freertos_risc_v_fpu_frame
+	sw sp, 0(t0)
+	.endm
+
+.macro portasmRESTORE_ADDITIONAL_REGISTERS
+	la t0, freertos_risc_v_fpu_frame
+	lw t1, 0(t0)
+	/* Back to the same task: its registers are still live */
+	beq t1, sp, .Lfpu_done\@
+	beqz t1, .Lfpu_load\@
+	csrr t2, mstatus
+	srli t2, t2, portasmMSTATUS_FS_SHIFT
+	andi t2, t2, 3
+	addi t2, t2, -3
+	bnez t2, .Lfpu_load\@
+	/* Task switch away from dirty state: save it in the old frame */
+	portasmFPU_REGS_OP fsw, t1
+	frcsr t2
+	sw t2, portasmFPU_FCSR(t1)
+	li t2, 1
+	sw t2, portasmFPU_FLAG(t1)
+.Lfpu_load\@:
+	lw t2, portasmFPU_FLAG(sp)
+	beqz t2, .Lfpu_done\@
+	portasmFPU_REGS_OP flw, sp
+	lw t2, portasmFPU_FCSR(sp)
+	fscsr t2
+.Lfpu_done\@:
+	addi sp, sp, (portasmADDITIONAL_CONTEXT_SIZE * 4)
+	.endm
+
+#endif /* __FREERTOS_RISC_V_EXTENSIONS_H__ */
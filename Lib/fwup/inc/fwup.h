@@ -0,0 +1,96 @@
+#ifndef __fwup_h__
+#define __fwup_h__
+
+#include <stdint.h>
+#include "fwup_boot.h"
+#include "buf.h"
+#include "uart.h"
+
+/*! CPP guard */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Update switch of the application, set by the FWUP_ENABLE
+ * CMake option together with the boot and slot images.
+ */
+#ifndef FWUP_ENABLE
+#define FWUP_ENABLE 0
+#endif
+
+/**
+ * @brief Data chunks are multiples of this, except the last one. A
+ * multiple of the flash program word (16 bytes on the internal flash).
+ */
+#define FWUP_ALIGN 16
+/** @brief Largest data chunk */
+#define FWUP_CHUNK_MAX 512
+
+typedef struct {
+	uint32_t images; /**< images committed */
+	uint32_t bytes; /**< image bytes programmed, resends excluded */
+	uint32_t resumed; /**< sessions continued from the resume log */
+	uint32_t crc_errors; /**< frames dropped on a bad checksum */
+	uint32_t seq_errors; /**< frames refused out of order */
+	uint32_t erase_ms; /**< last erase ahead of the stream */
+	uint32_t program_us_max; /**< longest chunk program */
+} fwup_stats_t;
+
+/**
+ * @brief Begin or resume an image for the slot not running.
+ * @param len Image size, up to the slot size
+ * @param crc CRC-32 of the whole image
+ * @param resume Filled with the offset to send from
+ * @return FWUP_OK, FWUP_ERR_STATE until the running slot is
+ *         confirmed (fwup_confirm()) or other error code
+ *
+ * A session for the same image and slot continues from its last
+ * programmed page; anything else starts over. The rest of the slot
+ * is erased here, so the stream never waits on an erase. The
+ * factory image (slot A without records) needs no confirmation.
+ */
+int fwup_begin(uint32_t len, uint32_t crc, uint32_t *resume);
+
+/**
+ * @brief Queue a chunk for programming, taking over the reference.
+ * @param off Image offset, must be the next expected one
+ * @param next Filled with the next expected offset
+ * @return FWUP_OK, FWUP_ERR_SEQ or an error of an earlier chunk
+ *
+ * Returns as soon as the chunk is queued: the next chunk is received
+ * while this one is programmed.
+ */
+int fwup_write(uint32_t off, buf_t *b, uint32_t *next);
+
+/**
+ * @brief Wait for the last chunk, verify the slot and commit it.
+ * @return FWUP_OK once the slot is recorded NEW for the next boot
+ */
+int fwup_finish(TickType_t timeout);
+
+/**
+ * @brief Set up the updater on a flash device.
+ * @param running Slot this image runs from
+ * @param prio Priority of the programming task
+ */
+int fwup_init(flash_dev_t *dev, const fwup_layout_t *lay,
+	      fwup_slot_t running, uint32_t prio);
+
+/**
+ * @brief Serve the update protocol on a port, see Tools/fwup.py.
+ *
+ * Frame: 0xA6, u8 type, u16 len, u32 offset, len bytes, CRC-32 of
+ * everything after the sync. Replies carry type | 0x80, the next
+ * offset the device expects and an int8 status.
+ * @return 0 on success, -1 on UART or task failure
+ */
+int fwup_serve(uart_port_t port, uint32_t baud, uint32_t prio);
+
+void fwup_get_stats(fwup_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif /* End of CPP guard */
+
+#endif //__fwup_h__
@@ -0,0 +1,135 @@
+#ifndef __fwup_boot_h__
+#define __fwup_boot_h__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "flash_dev.h"
+
+/*! CPP guard */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Internal flash map, offsets from the start of the flash.
+ *
+ * Boot image, then the boot record log (two pages used in turn),
+ * the resume log page, and two application slots. Matches
+ * k1921vg015_boot.ld and k1921vg015_slot_[ab].ld.
+ */
+#define FWUP_BOOT_SIZE 0x4000
+#define FWUP_CTL_BASE 0x4000
+#define FWUP_CTL_PAGE 0x1000
+#define FWUP_SLOT_BASE 0x8000
+#define FWUP_SLOT_SIZE 0x7C000
+
+#define FWUP_OK 0
+#define FWUP_ERR_PARAM -1
+#define FWUP_ERR_FLASH -2
+#define FWUP_ERR_CRC -3
+#define FWUP_ERR_SEQ -4 /**< data out of order, resend from the offset */
+#define FWUP_ERR_STATE -5
+#define FWUP_ERR_TIMEOUT -6
+
+#define FWUP_MAGIC_BOOT 0x544F4F42 /**< "BOOT", boot record log */
+#define FWUP_MAGIC_RESUME 0x454D5352 /**< "RSME", resume log */
+
+typedef enum {
+	FWUP_SLOT_A,
+	FWUP_SLOT_B,
+	FWUP_SLOT_COUNT
+} fwup_slot_t;
+
+typedef struct {
+	uint32_t ctl[2]; /**< boot record log pages */
+	uint32_t progress; /**< resume log page */
+	uint32_t slot[FWUP_SLOT_COUNT];
+	uint32_t slot_size;
+} fwup_layout_t;
+
+#define FWUP_LAYOUT_DEFAULT                                          \
+	{                                                            \
+		.ctl = { FWUP_CTL_BASE, FWUP_CTL_BASE + FWUP_CTL_PAGE }, \
+		.progress = FWUP_CTL_BASE + 2 * FWUP_CTL_PAGE,       \
+		.slot = { FWUP_SLOT_BASE,                            \
+			  FWUP_SLOT_BASE + FWUP_SLOT_SIZE },         \
+		.slot_size = FWUP_SLOT_SIZE,                         \
+	}
+
+/**
+ * @brief Slot states in the boot record log.
+ *
+ * The updater writes NEW once an image is verified in flash. The
+ * boot image turns it into BOOTED before the first start, and the
+ * application confirms with GOOD. A slot still BOOTED at the next
+ * boot never confirmed: the other slot starts if it is GOOD.
+ */
+typedef enum {
+	FWUP_STATE_NEW = 1,
+	FWUP_STATE_BOOTED,
+	FWUP_STATE_GOOD,
+} fwup_state_t;
+
+/** @brief Log record, one per bus word pair. Erased flash is invalid */
+typedef struct {
+	uint32_t magic;
+	uint32_t seq;
+	uint32_t len; /**< image bytes, 0 for an unverified factory image */
+	uint32_t crc; /**< CRC-32 of the image */
+	uint32_t off; /**< resume log: bytes programmed */
+	uint32_t run; /**< resume log: CRC state at off */
+	uint8_t slot;
+	uint8_t state;
+	uint16_t rsv;
+	uint32_t chk; /**< CRC-32 of the fields above */
+} fwup_rec_t;
+
+/** @brief Continue a CRC-32 (IEEE, as zlib crc32()), 0 to start */
+uint32_t fwup_crc32(uint32_t crc, const void *data, size_t len);
+
+/** @brief CRC-32 of len bytes of flash from addr, 0 on a read error */
+uint32_t fwup_crc32_flash(flash_dev_t *dev, uint32_t crc, uint32_t addr,
+			  uint32_t len);
+
+/**
+ * @brief Read record i of a log page.
+ * @return 1 if valid, 0 if torn or foreign, -1 if erased (end of log)
+ */
+int fwup_log_read(flash_dev_t *dev, uint32_t page, uint32_t i,
+		  uint32_t magic, fwup_rec_t *rec);
+
+/** @brief Seal rec with magic and chk and program it as record i */
+int fwup_log_write(flash_dev_t *dev, uint32_t page, uint32_t i,
+		   uint32_t magic, fwup_rec_t *rec);
+
+/**
+ * @brief Latest boot record of each slot.
+ * @param last Filled per slot, state 0 where the slot has none
+ * @return Sequence number of the newest record, 0 if none
+ */
+uint32_t fwup_boot_records(flash_dev_t *dev, const fwup_layout_t *lay,
+			   fwup_rec_t last[FWUP_SLOT_COUNT]);
+
+/** @brief Append a boot record, compacting into the other page if full */
+int fwup_boot_append(flash_dev_t *dev, const fwup_layout_t *lay,
+		     fwup_slot_t slot, fwup_state_t state, uint32_t len,
+		     uint32_t crc);
+
+/**
+ * @brief Pick the slot to start, the boot image's decision.
+ *
+ * Marks a NEW slot BOOTED once its CRC matches, falls back from an
+ * unconfirmed or corrupt slot to a GOOD one. GOOD slots are not
+ * read again. Slot A without records is the factory image.
+ */
+fwup_slot_t fwup_boot_select(flash_dev_t *dev, const fwup_layout_t *lay);
+
+/** @brief Confirm the running slot after a trial boot */
+int fwup_confirm(flash_dev_t *dev, const fwup_layout_t *lay,
+		 fwup_slot_t running);
+
+#ifdef __cplusplus
+}
+#endif /* End of CPP guard */
+
+#endif //__fwup_boot_h__
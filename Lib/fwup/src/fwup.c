@@ -0,0 +1,440 @@
+#include <string.h>
+#include "fwup.h"
+#include "ring.h"
+#include "riscv-csr.h"
+#include "riscv-irq.h"
+#include "system_k1921vg015.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+#define FWUP_SYNC 0xA6
+/** @brief Type, length and offset behind the sync byte */
+#define FWUP_HDR_LEN 7
+#define FWUP_CRC_LEN 4
+/** @brief Replies carry the status and the slot being written */
+#define FWUP_REPLY_LEN (1 + FWUP_HDR_LEN + 2 + FWUP_CRC_LEN)
+/**
+ * @brief Chunks queued to the programming task, a power of two.
+ * With the one programmed and the one received, all four 1 KiB
+ * pool buffers at most.
+ */
+#define FWUP_QUEUE 2
+/** @brief Silence inside a frame that drops it */
+#define FWUP_GAP_MS 100
+#define FWUP_FINISH_MS 5000
+
+enum {
+	FWUP_FRAME_START,
+	FWUP_FRAME_DATA,
+	FWUP_FRAME_END,
+	FWUP_FRAME_REPLY = 0x80,
+};
+
+static flash_dev_t *fw_dev;
+static fwup_layout_t fw_lay;
+static fwup_slot_t fw_target;
+static uart_port_t fw_port;
+
+/* Session, receiving side */
+static int fw_open;
+static uint32_t fw_len;
+static uint32_t fw_crc;
+static uint32_t fw_next; /**< next offset expected from the link */
+static uint32_t fw_queued; /**< chunks handed to the programming task */
+
+/* Programming task side, read by the receiver once caught up */
+static volatile uint32_t fw_taken; /**< chunks done with, good or not */
+static volatile int fw_err;
+static uint32_t fw_done; /**< image bytes programmed */
+static uint32_t fw_run; /**< CRC-32 of those bytes */
+static uint32_t fw_log; /**< next free resume log record */
+
+static ring_spsc_t fw_ring;
+static void *fw_slots[FWUP_QUEUE];
+static SemaphoreHandle_t fw_step; /**< given after every chunk */
+
+static fwup_stats_t fw_st;
+
+static inline uint32_t fwup_get32(const uint8_t *p)
+{
+	return p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 |
+	       (uint32_t)p[3] << 24;
+}
+
+static inline uint8_t *fwup_put32(uint8_t *p, uint32_t v)
+{
+	*p++ = (uint8_t)v;
+	*p++ = (uint8_t)(v >> 8);
+	*p++ = (uint8_t)(v >> 16);
+	*p++ = (uint8_t)(v >> 24);
+	return p;
+}
+
+/** @brief Log the bytes programmed so far for a later resume */
+static void fwup_checkpoint(void)
+{
+	fwup_rec_t r = {
+		.seq = fw_log,
+		.len = fw_len,
+		.crc = fw_crc,
+		.off = fw_done,
+		.run = fw_run,
+		.slot = (uint8_t)fw_target,
+		.state = 1,
+	};
+
+	/* A full or failing log only costs resume granularity */
+	fwup_log_write(fw_dev, fw_lay.progress, fw_log++, FWUP_MAGIC_RESUME,
+		       &r);
+}
+
+static int fwup_program(buf_t *b)
+{
+	uint32_t n = b->len, pad = -n & (FWUP_ALIGN - 1);
+	uint32_t old = fw_done, sector = fw_dev->sector_size, c0, us, mie;
+	int ret;
+
+	/* Only the last chunk is short: fill it up with erased bytes */
+	if (pad)
+		memset(buf_put(b, pad), 0xFF, pad);
+	c0 = csr_read_mcycle();
+	ret = flash_program(fw_dev, fw_lay.slot[fw_target] + old, b->data,
+			    n + pad);
+	us = (csr_read_mcycle() - c0) / (SystemCoreClock / 1000000);
+	if (ret != FLASH_OK)
+		return FWUP_ERR_FLASH;
+
+	fw_run = fwup_crc32(fw_run, b->data, n);
+	fw_done = old + n;
+	if (old / sector != fw_done / sector || fw_done == fw_len)
+		fwup_checkpoint();
+
+	mie = irq_save();
+	fw_st.bytes += n;
+	if (us > fw_st.program_us_max)
+		fw_st.program_us_max = us;
+	irq_restore(mie);
+	return FWUP_OK;
+}
+
+static void fwup_task(__attribute__((unused)) void *arg)
+{
+	void *b;
+
+	while (1) {
+		if (ring_spsc_receive(&fw_ring, &b, portMAX_DELAY) != RING_OK)
+			continue;
+		if (fw_err == FWUP_OK)
+			fw_err = fwup_program(b);
+		buf_free(b);
+		fw_taken++;
+		xSemaphoreGive(fw_step);
+	}
+}
+
+/** @brief Wait until the programming task caught up with the link */
+static int fwup_drain(TickType_t timeout)
+{
+	TimeOut_t to;
+
+	vTaskSetTimeOutState(&to);
+	while (fw_taken != fw_queued) {
+		if (xTaskCheckForTimeOut(&to, &timeout) == pdTRUE)
+			return FWUP_ERR_TIMEOUT;
+		xSemaphoreTake(fw_step, timeout);
+	}
+	return fw_err;
+}
+
+/**
+ * @brief Find where an interrupted session of this image stopped.
+ * @return Page aligned offset to continue from, 0 to start over
+ *
+ * The checkpoint is trusted only if the slot reads back to its CRC.
+ * The page it falls in is programmed again from its start, as later
+ * chunks may have reached it before the reset.
+ */
+static uint32_t fwup_resume(uint32_t len, uint32_t crc)
+{
+	uint32_t slot = fw_lay.slot[fw_target], off = 0, run = 0, page, c, i;
+	fwup_rec_t r;
+	int ret;
+
+	if (fwup_log_read(fw_dev, fw_lay.progress, 0, FWUP_MAGIC_RESUME, &r) !=
+		    1 ||
+	    r.state != 0 || r.slot != fw_target || r.len != len || r.crc != crc)
+		return 0;
+	for (i = 1; (ret = fwup_log_read(fw_dev, fw_lay.progress, i,
+					 FWUP_MAGIC_RESUME, &r)) >= 0;
+	     i++) {
+		if (ret == 1 && r.off > off && r.off <= len) {
+			off = r.off;
+			run = r.run;
+		}
+	}
+	fw_log = i;
+	if (off == 0)
+		return 0;
+
+	page = off - off % fw_dev->sector_size;
+	c = fwup_crc32_flash(fw_dev, 0, slot, page);
+	if (fwup_crc32_flash(fw_dev, c, slot + page, off - page) != run)
+		return 0;
+	fw_run = c;
+	return page;
+}
+
+int fwup_begin(uint32_t len, uint32_t crc, uint32_t *resume)
+{
+	uint32_t sector, end, off, mie;
+	fwup_rec_t r = { 0 }, last[FWUP_SLOT_COUNT];
+	fwup_slot_t run;
+	TickType_t t0;
+
+	*resume = 0;
+	if (fw_dev == NULL)
+		return FWUP_ERR_STATE;
+	if (len == 0 || len > fw_lay.slot_size)
+		return FWUP_ERR_PARAM;
+	/* Chunks of an abandoned session go first */
+	fwup_drain(portMAX_DELAY);
+	fw_open = 0;
+	sector = fw_dev->sector_size;
+
+	/*
+	 * The boot falls back to the target slot while the running one
+	 * is on trial, and trusts a GOOD record there without reading
+	 * the slot: it can only be erased under a confirmed image.
+	 */
+	run = fw_target == FWUP_SLOT_A ? FWUP_SLOT_B : FWUP_SLOT_A;
+	fwup_boot_records(fw_dev, &fw_lay, last);
+	if (last[run].state != FWUP_STATE_GOOD &&
+	    !(run == FWUP_SLOT_A && last[run].state == 0))
+		return FWUP_ERR_STATE;
+
+	t0 = xTaskGetTickCount();
+	off = fwup_resume(len, crc);
+	if (off == 0) {
+		r.len = len;
+		r.crc = crc;
+		r.slot = (uint8_t)fw_target;
+		if (flash_erase(fw_dev, fw_lay.progress, sector,
+				portMAX_DELAY) != FLASH_OK ||
+		    fwup_log_write(fw_dev, fw_lay.progress, 0,
+				   FWUP_MAGIC_RESUME, &r) != FWUP_OK)
+			return FWUP_ERR_FLASH;
+		fw_log = 1;
+		fw_run = 0;
+	}
+	end = (len + sector - 1) / sector * sector;
+	if (end > off && flash_erase(fw_dev, fw_lay.slot[fw_target] + off,
+				     end - off, portMAX_DELAY) != FLASH_OK)
+		return FWUP_ERR_FLASH;
+
+	fw_len = len;
+	fw_crc = crc;
+	fw_done = off;
+	fw_next = off;
+	fw_err = FWUP_OK;
+	fw_open = 1;
+	*resume = off;
+
+	mie = irq_save();
+	fw_st.erase_ms = (uint64_t)(xTaskGetTickCount() - t0) * 1000 /
+			 configTICK_RATE_HZ;
+	if (off)
+		fw_st.resumed++;
+	irq_restore(mie);
+	return FWUP_OK;
+}
+
+int fwup_write(uint32_t off, buf_t *b, uint32_t *next)
+{
+	uint32_t len = b->len, mie;
+	int ret = fw_open ? fw_err : FWUP_ERR_STATE;
+
+	if (ret == FWUP_OK && off != fw_next) {
+		ret = FWUP_ERR_SEQ;
+		mie = irq_save();
+		fw_st.seq_errors++;
+		irq_restore(mie);
+	} else if (ret == FWUP_OK &&
+		   (len == 0 || len > fw_len - off ||
+		    (len % FWUP_ALIGN && off + len != fw_len))) {
+		ret = FWUP_ERR_PARAM;
+	}
+	*next = fw_next;
+	if (ret != FWUP_OK) {
+		buf_free(b);
+		return ret;
+	}
+
+	fw_next += len;
+	fw_queued++;
+	/* Backpressure: stop reading the port until a chunk is done */
+	while (ring_spsc_push(&fw_ring, b, NULL) != RING_OK)
+		xSemaphoreTake(fw_step, portMAX_DELAY);
+	*next = fw_next;
+	return FWUP_OK;
+}
+
+int fwup_finish(TickType_t timeout)
+{
+	uint32_t slot = fw_lay.slot[fw_target], mie;
+	int ret;
+
+	if (!fw_open)
+		return FWUP_ERR_STATE;
+	if (fw_next != fw_len)
+		return FWUP_ERR_SEQ;
+	ret = fwup_drain(timeout);
+	if (ret != FWUP_OK)
+		return ret;
+	fw_open = 0;
+
+	/* What went in, then what reads back */
+	if (fw_run != fw_crc ||
+	    fwup_crc32_flash(fw_dev, 0, slot, fw_len) != fw_crc) {
+		flash_erase(fw_dev, fw_lay.progress, fw_dev->sector_size,
+			    portMAX_DELAY);
+		return FWUP_ERR_CRC;
+	}
+	ret = fwup_boot_append(fw_dev, &fw_lay, fw_target, FWUP_STATE_NEW,
+			       fw_len, fw_crc);
+	if (ret != FWUP_OK)
+		return ret;
+	/* A reset before this only repeats the last page and the commit */
+	flash_erase(fw_dev, fw_lay.progress, fw_dev->sector_size,
+		    portMAX_DELAY);
+
+	mie = irq_save();
+	fw_st.images++;
+	irq_restore(mie);
+	return FWUP_OK;
+}
+
+int fwup_init(flash_dev_t *dev, const fwup_layout_t *lay,
+	      fwup_slot_t running, uint32_t prio)
+{
+	if (dev == NULL || lay == NULL || running >= FWUP_SLOT_COUNT)
+		return FWUP_ERR_PARAM;
+	if (fw_dev)
+		return FWUP_ERR_STATE;
+	fw_lay = *lay;
+	fw_target = running == FWUP_SLOT_A ? FWUP_SLOT_B : FWUP_SLOT_A;
+	ring_spsc_init(&fw_ring, fw_slots, FWUP_QUEUE);
+	fw_step = xSemaphoreCreateBinary();
+	if (fw_step == NULL ||
+	    xTaskCreate(fwup_task, "fwup", 256, NULL, prio, NULL) != pdPASS)
+		return FWUP_ERR_STATE;
+	fw_dev = dev;
+	return FWUP_OK;
+}
+
+static void fwup_reply(uint8_t type, uint32_t next, int status)
+{
+	uint8_t f[FWUP_REPLY_LEN], *p = f;
+
+	*p++ = FWUP_SYNC;
+	*p++ = type | FWUP_FRAME_REPLY;
+	*p++ = 2;
+	*p++ = 0;
+	p = fwup_put32(p, next);
+	*p++ = (uint8_t)status;
+	*p++ = (uint8_t)fw_target;
+	p = fwup_put32(p, fwup_crc32(0, f + 1, (size_t)(p - f - 1)));
+	uart_write(fw_port, f, sizeof(f), pdMS_TO_TICKS(FWUP_GAP_MS));
+}
+
+static void fwup_serve_task(__attribute__((unused)) void *arg)
+{
+	uint8_t hdr[FWUP_HDR_LEN], c;
+
+	while (1) {
+		uint32_t len, off, next, mie;
+		buf_t *b;
+		int st;
+
+		if (uart_read(fw_port, &c, 1, portMAX_DELAY) != 1 ||
+		    c != FWUP_SYNC)
+			continue;
+		if (uart_read(fw_port, hdr, sizeof(hdr),
+			      pdMS_TO_TICKS(FWUP_GAP_MS)) != sizeof(hdr))
+			continue;
+		len = hdr[1] | (uint32_t)hdr[2] << 8;
+		off = fwup_get32(hdr + 3);
+		/* Not a header after all: resync on the next sync byte */
+		if (len > FWUP_CHUNK_MAX)
+			continue;
+
+		/* Chunks in flight come back as soon as they are programmed */
+		while ((b = buf_alloc(FWUP_CHUNK_MAX + FWUP_CRC_LEN)) == NULL)
+			vTaskDelay(1);
+		if (uart_read_buf(fw_port, b, len + FWUP_CRC_LEN,
+				  pdMS_TO_TICKS(FWUP_GAP_MS)) !=
+			    len + FWUP_CRC_LEN ||
+		    fwup_crc32(fwup_crc32(0, hdr, sizeof(hdr)), b->data, len) !=
+			    fwup_get32(b->data + len)) {
+			buf_free(b);
+			mie = irq_save();
+			fw_st.crc_errors++;
+			irq_restore(mie);
+			fwup_reply(hdr[0], fw_next, FWUP_ERR_CRC);
+			continue;
+		}
+		b->len = (uint16_t)len;
+
+		next = fw_next;
+		switch (hdr[0]) {
+		case FWUP_FRAME_START:
+			st = len == 8 ? fwup_begin(fwup_get32(b->data),
+						   fwup_get32(b->data + 4),
+						   &next) :
+					FWUP_ERR_PARAM;
+			buf_free(b);
+			break;
+		case FWUP_FRAME_DATA:
+			st = fwup_write(off, b, &next);
+			break;
+		case FWUP_FRAME_END:
+			buf_free(b);
+			st = fwup_finish(pdMS_TO_TICKS(FWUP_FINISH_MS));
+			next = fw_next;
+			break;
+		default:
+			buf_free(b);
+			st = FWUP_ERR_PARAM;
+			break;
+		}
+		fwup_reply(hdr[0], next, st);
+	}
+}
+
+int fwup_serve(uart_port_t port, uint32_t baud, uint32_t prio)
+{
+	/* Room for two whole frames: the host keeps two in flight */
+	uart_config_t cfg = {
+		.baud = baud,
+		.tx_buf_size = 64,
+		.rx_buf_size = 2048,
+		.use_dma = 0,
+		.irq_prio = 1,
+	};
+
+	if (fw_dev == NULL || uart_init(port, &cfg) != 0)
+		return -1;
+	fw_port = port;
+	if (xTaskCreate(fwup_serve_task, "fwup_rx", 512, NULL, prio, NULL) !=
+	    pdPASS)
+		return -1;
+	return 0;
+}
+
+void fwup_get_stats(fwup_stats_t *stats)
+{
+	uint32_t mie = irq_save();
+
+	*stats = fw_st;
+	irq_restore(mie);
+}
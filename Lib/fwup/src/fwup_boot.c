@@ -0,0 +1,230 @@
+#include <string.h>
+#include "fwup_boot.h"
+
+/** @brief Bytes read per step when checking an image */
+#define FWUP_READ_CHUNK 256
+
+/* One log page is one erase sector */
+#define FWUP_LOG_RECS(dev) ((dev)->sector_size / sizeof(fwup_rec_t))
+
+_Static_assert(sizeof(fwup_rec_t) == 32, "fwup_rec_t must stay 32 bytes");
+
+/* Nibble table: 64 bytes instead of 1 KiB, small enough for the boot image */
+static const uint32_t fwup_crc_tbl[16] = {
+	0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC,
+	0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+	0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+	0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+};
+
+uint32_t fwup_crc32(uint32_t crc, const void *data, size_t len)
+{
+	const uint8_t *p = data;
+
+	crc = ~crc;
+	while (len--) {
+		crc ^= *p++;
+		crc = (crc >> 4) ^ fwup_crc_tbl[crc & 15];
+		crc = (crc >> 4) ^ fwup_crc_tbl[crc & 15];
+	}
+	return ~crc;
+}
+
+uint32_t fwup_crc32_flash(flash_dev_t *dev, uint32_t crc, uint32_t addr,
+			  uint32_t len)
+{
+	uint8_t tmp[FWUP_READ_CHUNK];
+
+	while (len) {
+		uint32_t n = len < sizeof(tmp) ? len : sizeof(tmp);
+
+		if (flash_read(dev, addr, tmp, n) != FLASH_OK)
+			return 0;
+		crc = fwup_crc32(crc, tmp, n);
+		addr += n;
+		len -= n;
+	}
+	return crc;
+}
+
+int fwup_log_read(flash_dev_t *dev, uint32_t page, uint32_t i,
+		  uint32_t magic, fwup_rec_t *rec)
+{
+	const uint8_t *p = (const uint8_t *)rec;
+	size_t k;
+
+	if (i >= FWUP_LOG_RECS(dev) ||
+	    flash_read(dev, page + i * sizeof(*rec), rec, sizeof(*rec)) !=
+		    FLASH_OK)
+		return -1;
+	for (k = 0; k < sizeof(*rec) && p[k] == 0xFF; k++)
+		;
+	if (k == sizeof(*rec))
+		return -1;
+	return rec->magic == magic &&
+	       rec->chk == fwup_crc32(0, rec, offsetof(fwup_rec_t, chk));
+}
+
+int fwup_log_write(flash_dev_t *dev, uint32_t page, uint32_t i,
+		   uint32_t magic, fwup_rec_t *rec)
+{
+	if (i >= FWUP_LOG_RECS(dev))
+		return FWUP_ERR_PARAM;
+	rec->magic = magic;
+	rec->rsv = 0xFFFF;
+	rec->chk = fwup_crc32(0, rec, offsetof(fwup_rec_t, chk));
+	if (flash_program(dev, page + i * sizeof(*rec), rec, sizeof(*rec)) !=
+	    FLASH_OK)
+		return FWUP_ERR_FLASH;
+	return FWUP_OK;
+}
+
+/**
+ * @brief Scan both boot log pages.
+ * @param page Filled with the page holding the newest record
+ * @param free Filled with the first erased record there
+ */
+static uint32_t fwup_boot_scan(flash_dev_t *dev, const fwup_layout_t *lay,
+			       fwup_rec_t last[FWUP_SLOT_COUNT],
+			       uint32_t *page, uint32_t *free)
+{
+	uint32_t top = 0;
+	fwup_rec_t r;
+
+	memset(last, 0, sizeof(fwup_rec_t) * FWUP_SLOT_COUNT);
+	*page = lay->ctl[0];
+	*free = 0;
+	for (uint32_t p = 0; p < 2; p++) {
+		uint32_t i;
+		int ret;
+
+		for (i = 0; (ret = fwup_log_read(dev, lay->ctl[p], i,
+						 FWUP_MAGIC_BOOT, &r)) >= 0;
+		     i++) {
+			/* Torn records keep their place, nothing else */
+			if (ret == 0 || r.slot >= FWUP_SLOT_COUNT)
+				continue;
+			if (r.seq > last[r.slot].seq)
+				last[r.slot] = r;
+			if (r.seq > top) {
+				top = r.seq;
+				*page = lay->ctl[p];
+			}
+		}
+		if (*page == lay->ctl[p])
+			*free = i;
+	}
+	return top;
+}
+
+uint32_t fwup_boot_records(flash_dev_t *dev, const fwup_layout_t *lay,
+			   fwup_rec_t last[FWUP_SLOT_COUNT])
+{
+	uint32_t page, free;
+
+	return fwup_boot_scan(dev, lay, last, &page, &free);
+}
+
+int fwup_boot_append(flash_dev_t *dev, const fwup_layout_t *lay,
+		     fwup_slot_t slot, fwup_state_t state, uint32_t len,
+		     uint32_t crc)
+{
+	fwup_rec_t last[FWUP_SLOT_COUNT], r = { 0 };
+	uint32_t page, free, top;
+	int ret;
+
+	if (slot >= FWUP_SLOT_COUNT)
+		return FWUP_ERR_PARAM;
+	top = fwup_boot_scan(dev, lay, last, &page, &free);
+
+	/*
+	 * Full page: carry the latest record of each slot over to the
+	 * other one. The old page stays intact until the next turn, so a
+	 * reset halfway leaves the same newest record behind.
+	 */
+	if (free >= FWUP_LOG_RECS(dev)) {
+		page = page == lay->ctl[0] ? lay->ctl[1] : lay->ctl[0];
+		if (flash_erase(dev, page, dev->sector_size, portMAX_DELAY) !=
+		    FLASH_OK)
+			return FWUP_ERR_FLASH;
+		free = 0;
+		for (uint32_t s = 0; s < FWUP_SLOT_COUNT; s++) {
+			if (last[s].state == 0)
+				continue;
+			ret = fwup_log_write(dev, page, free++, FWUP_MAGIC_BOOT,
+					     &last[s]);
+			if (ret != FWUP_OK)
+				return ret;
+		}
+	}
+
+	r.seq = top + 1;
+	r.len = len;
+	r.crc = crc;
+	r.slot = (uint8_t)slot;
+	r.state = (uint8_t)state;
+	return fwup_log_write(dev, page, free, FWUP_MAGIC_BOOT, &r);
+}
+
+/** @brief Slot holds the image its record describes */
+static int fwup_slot_ok(flash_dev_t *dev, const fwup_layout_t *lay,
+			const fwup_rec_t *r)
+{
+	/* Factory images carry no length to check against */
+	if (r->len == 0)
+		return 1;
+	if (r->len > lay->slot_size)
+		return 0;
+	return fwup_crc32_flash(dev, 0, lay->slot[r->slot], r->len) == r->crc;
+}
+
+fwup_slot_t fwup_boot_select(flash_dev_t *dev, const fwup_layout_t *lay)
+{
+	fwup_rec_t last[FWUP_SLOT_COUNT];
+	uint32_t top = fwup_boot_records(dev, lay, last);
+	fwup_slot_t s, o;
+
+	if (top == 0)
+		return FWUP_SLOT_A;
+	s = last[FWUP_SLOT_B].seq == top ? FWUP_SLOT_B : FWUP_SLOT_A;
+	o = s == FWUP_SLOT_A ? FWUP_SLOT_B : FWUP_SLOT_A;
+
+	/*
+	 * Only a NEW image is read back: a GOOD one passed that check
+	 * before it confirmed itself, and reading up to a whole slot on
+	 * every reset would delay every start.
+	 */
+	switch (last[s].state) {
+	case FWUP_STATE_NEW:
+		/* One trial: unless confirmed, the next boot falls back */
+		if (fwup_slot_ok(dev, lay, &last[s]) &&
+		    fwup_boot_append(dev, lay, s, FWUP_STATE_BOOTED,
+				     last[s].len, last[s].crc) == FWUP_OK)
+			return s;
+		break;
+	case FWUP_STATE_GOOD:
+		return s;
+	default:
+		break;
+	}
+
+	if (last[o].state == FWUP_STATE_GOOD ||
+	    (o == FWUP_SLOT_A && last[o].state == 0))
+		return o;
+	/* Nothing better: an unconfirmed image beats no image */
+	return s;
+}
+
+int fwup_confirm(flash_dev_t *dev, const fwup_layout_t *lay,
+		 fwup_slot_t running)
+{
+	fwup_rec_t last[FWUP_SLOT_COUNT];
+
+	if (running >= FWUP_SLOT_COUNT)
+		return FWUP_ERR_PARAM;
+	fwup_boot_records(dev, lay, last);
+	if (last[running].state == FWUP_STATE_GOOD)
+		return FWUP_OK;
+	return fwup_boot_append(dev, lay, running, FWUP_STATE_GOOD,
+				last[running].len, last[running].crc);
+}
@@ -0,0 +1,99 @@
+#ifndef __hrtimer_h__
+#define __hrtimer_h__
+
+#include <stdint.h>
+
+/*! CPP guard */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Callback runs in the timer task instead of the TMR32 ISR */
+#define HRTIMER_DEFERRED 0x01
+
+typedef struct hrtimer hrtimer_t;
+
+/**
+ * @brief Expiry callback.
+ *
+ * ISR callbacks must be short and may only use FromISR APIs.
+ * A callback may restart or cancel its own timer.
+ */
+typedef void (*hrtimer_cb_t)(hrtimer_t *t, void *arg);
+
+/** @brief Timer instance, fields are private to the driver */
+struct hrtimer {
+	hrtimer_t *next;
+	hrtimer_t **pprev;
+	uint64_t expiry;
+	uint64_t period;
+	hrtimer_cb_t cb;
+	void *arg;
+	uint32_t overruns; /**< periods skipped because of late handling */
+	uint8_t flags;
+	uint8_t lvl; /**< wheel level and slot while armed */
+	uint8_t slot;
+	volatile uint8_t pending; /**< deferred callback queued */
+};
+
+/**
+ * @brief Start TMR32 free running and take over its interrupt.
+ *
+ * CAPCOM[1] is the compare channel of the service; CAPCOM[0] is
+ * left unused, CAPCOM[2..3] remain free for capture.
+ */
+void hrtimer_init(uint8_t irq_prio);
+
+/**
+ * @brief Time base frequency in Hz.
+ *
+ * The TMR32 clock at init. It stays the unit of hrtimer time when
+ * clk_set_op() changes the core clock, only the resolution drops.
+ */
+uint32_t hrtimer_freq(void);
+
+/** @brief Current 64-bit time in counter ticks */
+uint64_t hrtimer_now(void);
+
+/**
+ * @brief Raw 64-bit TMR32 count.
+ *
+ * Runs at the current TMR32 clock, unlike hrtimer time. Extends
+ * CAPCOM capture values taken less than one wrap ago (Lib/icap).
+ */
+uint64_t hrtimer_count(void);
+
+/** @brief Microseconds to counter ticks */
+uint64_t hrtimer_us(uint32_t us);
+
+/** @brief Bind callback and flags, timer is left inactive */
+void hrtimer_setup(hrtimer_t *t, hrtimer_cb_t cb, void *arg, uint8_t flags);
+
+/**
+ * @brief Arm a timer relative to now.
+ * @param delay Ticks to the first expiry
+ * @param period Ticks between expiries, 0 for one-shot
+ *
+ * Periodic expiries are scheduled from the previous expiry, not
+ * from the callback time, so latency never accumulates. Restarting
+ * an active timer moves it. Callable from ISRs.
+ */
+void hrtimer_start(hrtimer_t *t, uint64_t delay, uint64_t period);
+
+/** @brief Arm a timer at an absolute time (see hrtimer_now()) */
+void hrtimer_start_at(hrtimer_t *t, uint64_t expiry, uint64_t period);
+
+/** @brief Disarm a timer; no effect if inactive. Callable from ISRs */
+void hrtimer_cancel(hrtimer_t *t);
+
+/** @brief Timer is armed */
+static inline int hrtimer_active(const hrtimer_t *t)
+{
+	return t->pprev != 0;
+}
+
+#ifdef __cplusplus
+}
+#endif /* End of CPP guard */
+
+#endif //__hrtimer_h__
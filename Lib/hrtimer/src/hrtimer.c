@@ -0,0 +1,406 @@
+#include <stddef.h>
+#include "hrtimer.h"
+#include "clk.h"
+#include "K1921VG015.h"
+#include "plic.h"
+#include "riscv-irq.h"
+#include "FreeRTOS.h"
+#include "timers.h"
+
+/** @brief TMR32 compare channel owned by the service */
+#define HRT_CAPCOM 1
+/** @brief TMR32 interrupt bits: overflow, then one per CAPCOM */
+#define HRT_IRQ_OVF (1UL << 0)
+#define HRT_IRQ_CMP (1UL << (1 + HRT_CAPCOM))
+/** @brief Free running count-up mode */
+#define HRT_MODE_FREE 2
+
+/** @brief Compare closer than this to now may be missed: fire early */
+#define HRT_MIN_DELTA 32
+/** @brief Farthest compare, in time units: stays below 2^31 counts */
+#define HRT_MAX_PROGRAM 0x1FFFFFFFULL
+
+/*
+ * Hierarchical wheel. Level 0 slots are 2^HRT_GRAN_BITS ticks wide
+ * and keep their timers sorted, so the head gives the exact expiry.
+ * Level k slots span 64^k level 0 slots and are cascaded down when
+ * the wheel enters them. Occupancy bitmaps find the next non-empty
+ * slot of each level, so idle stretches are skipped in one step.
+ */
+#define HRT_GRAN_BITS 6
+#define HRT_LVL_BITS 6
+#define HRT_LVL_SIZE (1U << HRT_LVL_BITS)
+#define HRT_LVL_MASK (HRT_LVL_SIZE - 1)
+#define HRT_LEVELS 4
+/** @brief Deltas beyond the top level wait in its farthest slot */
+#define HRT_MAX_DELTA ((1ULL << (HRT_LVL_BITS * HRT_LEVELS)) - 1)
+
+typedef struct {
+	hrtimer_t *slot[HRT_LEVELS][HRT_LVL_SIZE];
+	uint64_t occupied[HRT_LEVELS];
+	uint64_t cur; /**< wheel position in level 0 slot units */
+	uint32_t ovf_hi; /**< upper half of the 64-bit count */
+	uint32_t freq; /**< time base rate: the clock at init */
+	uint32_t hz; /**< TMR32 clock now, differs after clk_set_op() */
+	uint64_t base_cnt; /**< count and time at the last re-timing */
+	uint64_t base;
+} hrt_wheel_t;
+
+static hrt_wheel_t hrt;
+static clk_notifier_t hrt_clk;
+
+/** @brief 64-bit TMR32 count, interrupts masked */
+static uint64_t hrt_count(void)
+{
+	uint32_t hi = hrt.ovf_hi;
+	uint32_t lo = TMR32->COUNT;
+
+	/* Wrapped but overflow not handled yet */
+	if (TMR32->RIS & HRT_IRQ_OVF) {
+		lo = TMR32->COUNT;
+		hi++;
+	}
+	return ((uint64_t)hi << 32) | lo;
+}
+
+/*
+ * Time keeps the rate of the clock at init whatever the core clock
+ * does: counts since the last re-timing are scaled by freq/hz. The
+ * base moves on every overflow while scaled, so the products fit.
+ */
+static uint64_t hrt_to_time(uint64_t cnt)
+{
+	if (hrt.hz == hrt.freq)
+		return hrt.base + (cnt - hrt.base_cnt);
+	return hrt.base + (cnt - hrt.base_cnt) * hrt.freq / hrt.hz;
+}
+
+/** @brief First count at or after time t, t not before the base */
+static uint64_t hrt_to_count(uint64_t t)
+{
+	if (hrt.hz == hrt.freq)
+		return hrt.base_cnt + (t - hrt.base);
+	return hrt.base_cnt +
+	       ((t - hrt.base) * hrt.hz + hrt.freq - 1) / hrt.freq;
+}
+
+/** @brief 64-bit time, interrupts masked */
+static uint64_t hrt_now(void)
+{
+	return hrt_to_time(hrt_count());
+}
+
+static void hrt_rebase(void)
+{
+	uint64_t cnt = hrt_count();
+
+	hrt.base = hrt_to_time(cnt);
+	hrt.base_cnt = cnt;
+}
+
+static void hrt_remove(hrtimer_t *t)
+{
+	if (t->next)
+		t->next->pprev = t->pprev;
+	*t->pprev = t->next;
+	t->next = NULL;
+	t->pprev = NULL;
+	if (hrt.slot[t->lvl][t->slot] == NULL)
+		hrt.occupied[t->lvl] &= ~(1ULL << t->slot);
+}
+
+static void hrt_insert(hrtimer_t *t)
+{
+	uint64_t unit = t->expiry >> HRT_GRAN_BITS;
+	uint64_t delta = unit > hrt.cur ? unit - hrt.cur : 0;
+	uint32_t lvl = 0, idx;
+	hrtimer_t **pp;
+
+	if (unit < hrt.cur)
+		unit = hrt.cur;
+	if (delta > HRT_MAX_DELTA) {
+		delta = HRT_MAX_DELTA;
+		unit = hrt.cur + HRT_MAX_DELTA;
+	}
+	while (delta >> (HRT_LVL_BITS * (lvl + 1)))
+		lvl++;
+	idx = (unit >> (HRT_LVL_BITS * lvl)) & HRT_LVL_MASK;
+
+	pp = &hrt.slot[lvl][idx];
+	/* Level 0 stays sorted, upper levels are only cascaded */
+	if (lvl == 0)
+		while (*pp && (*pp)->expiry <= t->expiry)
+			pp = &(*pp)->next;
+	t->next = *pp;
+	t->pprev = pp;
+	if (*pp)
+		(*pp)->pprev = &t->next;
+	*pp = t;
+	t->lvl = lvl;
+	t->slot = idx;
+	hrt.occupied[lvl] |= 1ULL << idx;
+}
+
+static inline uint64_t hrt_rotr(uint64_t v, uint32_t r)
+{
+	r &= 63;
+	return r ? (v >> r) | (v << (64 - r)) : v;
+}
+
+/**
+ * @brief Next wheel event: a level 0 expiry or an upper slot cascade.
+ * @return 0 if the wheel is empty
+ */
+static int hrt_next(uint64_t *tick)
+{
+	uint64_t best = UINT64_MAX;
+	uint64_t occ = hrt_rotr(hrt.occupied[0], hrt.cur & HRT_LVL_MASK);
+
+	if (occ) {
+		uint32_t idx = (hrt.cur + __builtin_ctzll(occ)) & HRT_LVL_MASK;
+
+		best = hrt.slot[0][idx]->expiry;
+	}
+
+	for (uint32_t lvl = 1; lvl < HRT_LEVELS; lvl++) {
+		uint32_t sh = HRT_LVL_BITS * lvl;
+		uint64_t blk = (hrt.cur >> sh) + 1;
+
+		occ = hrt_rotr(hrt.occupied[lvl], blk & HRT_LVL_MASK);
+		if (occ) {
+			uint64_t at = (blk + __builtin_ctzll(occ)) << sh;
+
+			if ((at << HRT_GRAN_BITS) < best)
+				best = at << HRT_GRAN_BITS;
+		}
+	}
+
+	*tick = best;
+	return best != UINT64_MAX;
+}
+
+/** @brief Re-file every timer of a slot; lands them in lower levels */
+static void hrt_cascade(uint32_t lvl, uint32_t idx)
+{
+	hrtimer_t *t = hrt.slot[lvl][idx];
+
+	hrt.slot[lvl][idx] = NULL;
+	hrt.occupied[lvl] &= ~(1ULL << idx);
+	while (t) {
+		hrtimer_t *next = t->next;
+
+		hrt_insert(t);
+		t = next;
+	}
+}
+
+/** @brief Move the wheel to unit, cascading the slots entered there */
+static void hrt_advance(uint64_t unit)
+{
+	hrt.cur = unit;
+	for (uint32_t lvl = HRT_LEVELS - 1; lvl > 0; lvl--) {
+		uint32_t sh = HRT_LVL_BITS * lvl;
+
+		if ((unit & ((1ULL << sh) - 1)) == 0)
+			hrt_cascade(lvl, (unit >> sh) & HRT_LVL_MASK);
+	}
+}
+
+static void hrt_deferred(void *arg, __attribute__((unused)) uint32_t unused)
+{
+	hrtimer_t *t = arg;
+
+	t->pending = 0;
+	t->cb(t, t->arg);
+}
+
+static void hrt_expire(hrtimer_t *t, uint64_t now, BaseType_t *woken)
+{
+	hrt_remove(t);
+	if (t->period) {
+		/* Next period from the planned expiry, skip the missed ones */
+		t->expiry += t->period;
+		if (t->expiry <= now) {
+			uint64_t miss = (now - t->expiry) / t->period + 1;
+
+			t->overruns += (uint32_t)miss;
+			t->expiry += miss * t->period;
+		}
+		hrt_insert(t);
+	}
+
+	if (!(t->flags & HRTIMER_DEFERRED)) {
+		t->cb(t, t->arg);
+	} else if (!t->pending) {
+		t->pending = 1;
+		if (xTimerPendFunctionCallFromISR(hrt_deferred, t, 0, woken) !=
+		    pdPASS) {
+			t->pending = 0;
+			t->overruns++;
+		}
+	}
+}
+
+/** @brief Program the compare register for the next event */
+static void hrt_program(void)
+{
+	uint64_t at, now = hrt_now();
+
+	if (!hrt_next(&at)) {
+		TMR32->IM &= ~HRT_IRQ_CMP;
+		return;
+	}
+	if (at < now + HRT_MIN_DELTA)
+		at = now + HRT_MIN_DELTA;
+	/* Far events take an intermediate match, 32-bit compare */
+	if (at - now > HRT_MAX_PROGRAM)
+		at = now + HRT_MAX_PROGRAM;
+	TMR32->CAPCOM[HRT_CAPCOM].VAL = (uint32_t)hrt_to_count(at);
+	TMR32->IC = HRT_IRQ_CMP;
+	TMR32->IM |= HRT_IRQ_CMP;
+}
+
+/** @brief Run all events due by now, then re-arm */
+static void hrt_run(BaseType_t *woken)
+{
+	uint64_t at, now = hrt_now();
+
+	while (hrt_next(&at) && at <= now) {
+		uint64_t unit = at >> HRT_GRAN_BITS;
+		hrtimer_t **head;
+
+		if (unit > hrt.cur)
+			hrt_advance(unit);
+		head = &hrt.slot[0][hrt.cur & HRT_LVL_MASK];
+		while (*head && (*head)->expiry <= now)
+			hrt_expire(*head, now, woken);
+		now = hrt_now();
+	}
+	hrt_program();
+}
+
+static void hrt_irq_handler(void)
+{
+	BaseType_t woken = pdFALSE;
+	uint32_t mis = TMR32->MIS;
+
+	if (mis & HRT_IRQ_OVF) {
+		TMR32->IC = HRT_IRQ_OVF;
+		hrt.ovf_hi++;
+		if (hrt.hz != hrt.freq)
+			hrt_rebase();
+	}
+	if (mis & HRT_IRQ_CMP)
+		TMR32->IC = HRT_IRQ_CMP;
+	hrt_run(&woken);
+	portYIELD_FROM_ISR(woken);
+}
+
+/**
+ * @brief Core clock change: TMR32 counts at the new rate from now on.
+ *
+ * Called with interrupts masked right after the switch; the counts
+ * since then are taken at the old rate, a few cycles at most.
+ */
+static int hrt_clk_cb(clk_event_t ev,
+		      __attribute__((unused)) uint32_t old_hz, uint32_t new_hz,
+		      __attribute__((unused)) void *arg)
+{
+	if (ev != CLK_CHANGE || new_hz == hrt.hz)
+		return 0;
+	hrt_rebase();
+	hrt.hz = new_hz;
+	hrt_program();
+	return 0;
+}
+
+void hrtimer_init(uint8_t irq_prio)
+{
+	RCU->CGCFGAPB_bit.TMR32EN = 1;
+	RCU->RSTDISAPB_bit.TMR32EN = 1;
+
+	hrt.freq = SystemCoreClock;
+	hrt.hz = SystemCoreClock;
+	hrt.base_cnt = 0;
+	hrt.base = 0;
+	TMR32->CTRL = 0;
+	TMR32->CAPCOM[HRT_CAPCOM].CTRL = 0;
+	TMR32->IC = HRT_IRQ_OVF | HRT_IRQ_CMP;
+	TMR32->IM = HRT_IRQ_OVF;
+	TMR32->CTRL_bit.MODE = HRT_MODE_FREE;
+
+	PLIC_SetIrqHandler(Plic_Mach_Target, IsrVect_IRQ_TMR32,
+			   hrt_irq_handler);
+	PLIC_SetPriority(IsrVect_IRQ_TMR32, irq_prio);
+	PLIC_IntEnable(Plic_Mach_Target, IsrVect_IRQ_TMR32);
+
+	clk_notifier_register(&hrt_clk, hrt_clk_cb, NULL);
+}
+
+uint32_t hrtimer_freq(void)
+{
+	return hrt.freq;
+}
+
+uint64_t hrtimer_now(void)
+{
+	uint32_t mie = irq_save();
+	uint64_t now = hrt_now();
+
+	irq_restore(mie);
+	return now;
+}
+
+uint64_t hrtimer_count(void)
+{
+	uint32_t mie = irq_save();
+	uint64_t cnt = hrt_count();
+
+	irq_restore(mie);
+	return cnt;
+}
+
+uint64_t hrtimer_us(uint32_t us)
+{
+	return (uint64_t)us * hrt.freq / 1000000;
+}
+
+void hrtimer_setup(hrtimer_t *t, hrtimer_cb_t cb, void *arg, uint8_t flags)
+{
+	t->next = NULL;
+	t->pprev = NULL;
+	t->cb = cb;
+	t->arg = arg;
+	t->flags = flags;
+	t->overruns = 0;
+	t->pending = 0;
+}
+
+void hrtimer_start_at(hrtimer_t *t, uint64_t expiry, uint64_t period)
+{
+	uint32_t mie = irq_save();
+
+	if (t->pprev)
+		hrt_remove(t);
+	t->expiry = expiry;
+	t->period = period;
+	hrt_insert(t);
+	hrt_program();
+	irq_restore(mie);
+}
+
+void hrtimer_start(hrtimer_t *t, uint64_t delay, uint64_t period)
+{
+	hrtimer_start_at(t, hrtimer_now() + delay, period);
+}
+
+void hrtimer_cancel(hrtimer_t *t)
+{
+	uint32_t mie = irq_save();
+
+	if (t->pprev) {
+		hrt_remove(t);
+		hrt_program();
+	}
+	irq_restore(mie);
+}
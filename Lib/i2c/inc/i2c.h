@@ -0,0 +1,140 @@
+#ifndef __i2c_h__
+#define __i2c_h__
+
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*! CPP guard */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define I2C_OK 0
+#define I2C_ERR_PARAM -1
+#define I2C_ERR_NACK -2 /**< address or data not acknowledged */
+#define I2C_ERR_ARB -3 /**< arbitration lost on every retry */
+#define I2C_ERR_TIMEOUT -4 /**< transaction exceeded its deadline */
+#define I2C_ERR_BUS -5 /**< unexpected controller state */
+#define I2C_ERR_FULL -6 /**< request queue full */
+/** @brief Status of a queued or running transaction */
+#define I2C_PENDING 1
+
+/** @brief Notification index i2c_wait() blocks on, 0 stays free */
+#define I2C_NOTIFY_INDEX 3
+
+/** @brief Default transaction deadline */
+#define I2C_TIMEOUT_MS_DEFAULT 20
+
+/**
+ * @brief One transfer segment.
+ *
+ * Write segments that follow each other are sent back to back
+ * under one address phase (register address and payload can live
+ * in separate buffers). Every read segment, and a write after a
+ * read, starts with a repeated start. A zero length write is an
+ * address probe.
+ */
+typedef struct {
+	uint8_t *buf;
+	uint16_t len;
+	uint8_t read;
+} i2c_seg_t;
+
+/**
+ * @brief Bus transaction: start, segments, stop.
+ *
+ * The structure and the segment buffers belong to the driver
+ * from i2c_submit() until status leaves I2C_PENDING.
+ */
+typedef struct {
+	uint8_t addr; /**< 7-bit device address */
+	uint8_t nsegs;
+	const i2c_seg_t *segs;
+	uint16_t timeout_ms; /**< 0 = I2C_TIMEOUT_MS_DEFAULT */
+	/* Driver owned */
+	TaskHandle_t owner;
+	volatile int status;
+} i2c_xfer_t;
+
+typedef struct {
+	uint32_t freq_hz; /**< SCL frequency, up to 1 MHz */
+	uint8_t queue_len; /**< transactions waiting for the bus */
+	uint8_t irq_prio;
+} i2c_config_t;
+
+/** @brief Bus statistics, counted since init or last reset */
+typedef struct {
+	uint32_t xfers;
+	uint32_t bytes;
+	uint32_t nacks;
+	uint32_t arb_lost;
+	uint32_t timeouts;
+	uint32_t bus_errors;
+	uint32_t recoveries;
+	uint32_t queue_hwm; /**< max transactions waiting at once */
+	uint64_t busy_ticks; /**< mtime ticks between start and stop */
+	uint64_t elapsed_ticks; /**< mtime ticks since reset */
+	uint32_t util_permille; /**< busy_ticks / elapsed_ticks */
+} i2c_stats_t;
+
+/**
+ * @brief Initialize controller, pins and request queue.
+ * @return I2C_OK, I2C_ERR_PARAM, I2C_ERR_BUS if a stuck bus could
+ *         not be released
+ *
+ * Must be called before the scheduler starts or from a single task.
+ */
+int i2c_init(const i2c_config_t *cfg);
+
+/**
+ * @brief Queue transactions without waiting for them.
+ * @param xfers Array of transactions
+ * @param n Number of transactions
+ * @param timeout Max time to wait for queue space
+ * @return Number of transactions queued
+ *
+ * The bus runs the queue from its interrupt, one transaction after
+ * another. A finished transaction notifies the task waiting on it.
+ */
+uint32_t i2c_submit(i2c_xfer_t *xfers, uint32_t n, TickType_t timeout);
+
+/**
+ * @brief Wait for a submitted transaction.
+ * @return Transaction status, I2C_PENDING if still running
+ *
+ * Blocks on notification I2C_NOTIFY_INDEX of the calling task.
+ * One task waits on a transaction at a time.
+ */
+int i2c_wait(i2c_xfer_t *xfer, TickType_t timeout);
+
+/** @brief Submit one transaction and wait for it */
+int i2c_transfer(i2c_xfer_t *xfer);
+
+/** @brief Write reg, repeated start, read len bytes */
+int i2c_reg_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/** @brief Write reg followed by len bytes in one transaction */
+int i2c_reg_write(uint8_t addr, uint8_t reg, const uint8_t *buf,
+		  uint16_t len);
+
+/**
+ * @brief Release a stuck bus.
+ *
+ * Clocks SCL until the slave lets SDA go (at most 9 pulses), then
+ * generates a stop condition. Called by the driver after timeouts
+ * and bus errors. Fails with I2C_ERR_BUS while a transaction runs.
+ */
+int i2c_recover(void);
+
+/** @brief Copy bus statistics */
+void i2c_get_stats(i2c_stats_t *stats);
+
+/** @brief Clear bus statistics and restart utilization window */
+void i2c_reset_stats(void);
+
+#ifdef __cplusplus
+}
+#endif /* End of CPP guard */
+
+#endif //__i2c_h__
@@ -0,0 +1,641 @@
+#include <string.h>
+#include "i2c.h"
+#include "clk.h"
+#include "K1921VG015.h"
+#include "plic.h"
+#include "mtimer.h"
+#include "queue.h"
+#include "timers.h"
+#include "riscv-csr.h"
+
+/** @brief Bus pins, the board can override the default routing */
+#ifndef I2C_GPIO
+#define I2C_GPIO GPIOA
+#endif
+#ifndef I2C_SCL_PIN
+#define I2C_SCL_PIN 14
+#endif
+#ifndef I2C_SDA_PIN
+#define I2C_SDA_PIN 15
+#endif
+#define I2C_PIN_AF 1
+
+/** @brief Restarts of a transaction after a lost arbitration */
+#define I2C_ARB_RETRIES 3
+/** @brief Deadline check period, granularity of the timeouts */
+#define I2C_WDT_PERIOD_MS 5
+/** @brief SCL half period of the recovery clock (100 kHz) */
+#define I2C_RECOVER_HALF_US 5
+
+/* Master states reported in ST.MODE */
+#define I2C_HW_STDONE 0x01 /**< start sent */
+#define I2C_HW_RSDONE 0x02 /**< repeated start sent */
+#define I2C_HW_IDLARL 0x03 /**< arbitration lost, back to idle */
+#define I2C_HW_MTADPA 0x04 /**< SLA+W sent, ACK */
+#define I2C_HW_MTADNA 0x05 /**< SLA+W sent, NACK */
+#define I2C_HW_MTDAPA 0x06 /**< data sent, ACK */
+#define I2C_HW_MTDANA 0x07 /**< data sent, NACK */
+#define I2C_HW_MRADPA 0x08 /**< SLA+R sent, ACK */
+#define I2C_HW_MRADNA 0x09 /**< SLA+R sent, NACK */
+#define I2C_HW_MRDAPA 0x0A /**< data received, ACK sent */
+#define I2C_HW_MRDANA 0x0B /**< data received, NACK sent */
+
+typedef struct {
+	QueueHandle_t queue;
+	TimerHandle_t wdt;
+	i2c_xfer_t *volatile cur;
+	uint8_t seg;
+	uint8_t retries;
+	uint16_t pos;
+	volatile uint8_t recover_req;
+	volatile uint8_t clk_hold; /**< no new transaction: clock change */
+	clk_notifier_t clk;
+	uint32_t freq_hz;
+	TickType_t deadline;
+	uint64_t t_start;
+	uint64_t t_reset;
+	i2c_stats_t stats;
+} i2c_ctx_t;
+
+static i2c_ctx_t i2c_ctx;
+
+static uint64_t i2c_mtime(void)
+{
+	volatile uint32_t *mtime = (volatile uint32_t *)RISCV_MTIME_ADDR;
+	uint32_t hi, lo;
+
+	do {
+		hi = mtime[1];
+		lo = mtime[0];
+	} while (hi != mtime[1]);
+	return ((uint64_t)hi << 32) | lo;
+}
+
+/* Controller access ------------------------------------------------------- */
+
+static void i2c_hw_set_freq(uint32_t freq_hz)
+{
+	/* F_scl = F_apb / (4 * SCLFRQ), SCLFRQ split over CTL1/CTL3 */
+	uint32_t div = (SystemCoreClock + 2 * freq_hz) / (4 * freq_hz);
+
+	if (div < 2)
+		div = 2;
+	I2C->CTL1_bit.SCLFRQ = div & 0x7F;
+	I2C->CTL3_bit.SCLFRQ = (div >> 7) & 0xFF;
+}
+
+static void i2c_hw_enable(uint32_t freq_hz)
+{
+	I2C->CTL1 = 0;
+	i2c_hw_set_freq(freq_hz);
+	I2C->CTL0 = 0;
+	I2C->CTL0_bit.INTEN = 1;
+	I2C->CTL1_bit.ENABLE = 1;
+}
+
+static void i2c_hw_disable(void)
+{
+	I2C->CTL0 = 0;
+	I2C->CTL1_bit.ENABLE = 0;
+}
+
+/** @brief Clearing the state flag lets the controller go on */
+static inline void i2c_hw_resume(void)
+{
+	I2C->CTL0_bit.CLRST = 1;
+}
+
+static inline void i2c_hw_start(void)
+{
+	I2C->CTL0_bit.START = 1;
+	i2c_hw_resume();
+}
+
+static inline void i2c_hw_stop(void)
+{
+	I2C->CTL0_bit.STOP = 1;
+	i2c_hw_resume();
+}
+
+/** @brief Acknowledge (or not) the byte about to be received */
+static inline void i2c_hw_rx(int nack)
+{
+	I2C->CTL0_bit.ACK = nack ? 1 : 0;
+	i2c_hw_resume();
+}
+
+/* Bus recovery ------------------------------------------------------------ */
+
+static void i2c_delay_us(uint32_t us)
+{
+	uint32_t t0 = csr_read_mcycle();
+	uint32_t cycles = SystemCoreClock / 1000000 * us;
+
+	while (csr_read_mcycle() - t0 < cycles) {
+	};
+}
+
+static void i2c_pins_af(void)
+{
+	uint32_t num = I2C_GPIO->ALTFUNCNUM;
+
+	num &= ~((3UL << (I2C_SCL_PIN * 2)) | (3UL << (I2C_SDA_PIN * 2)));
+	num |= ((uint32_t)I2C_PIN_AF << (I2C_SCL_PIN * 2)) |
+	       ((uint32_t)I2C_PIN_AF << (I2C_SDA_PIN * 2));
+	I2C_GPIO->ALTFUNCNUM = num;
+	I2C_GPIO->ALTFUNCSET = (1UL << I2C_SCL_PIN) | (1UL << I2C_SDA_PIN);
+}
+
+static int i2c_sda_high(void)
+{
+	return (I2C_GPIO->DATA >> I2C_SDA_PIN) & 1;
+}
+
+/**
+ * @brief Bit-bang the bus free with the controller disabled.
+ *
+ * Pins are open drain outputs meanwhile: writing 1 releases the
+ * line, so a slave still stretching SCL just delays the pulse.
+ */
+static int i2c_bus_release(void)
+{
+	const uint32_t scl = 1UL << I2C_SCL_PIN;
+	const uint32_t sda = 1UL << I2C_SDA_PIN;
+	uint32_t mode = I2C_GPIO->OUTMODE;
+
+	mode &= ~((3UL << (I2C_SCL_PIN * 2)) | (3UL << (I2C_SDA_PIN * 2)));
+	mode |= (1UL << (I2C_SCL_PIN * 2)) | (1UL << (I2C_SDA_PIN * 2));
+	I2C_GPIO->OUTMODE = mode;
+	I2C_GPIO->DATAOUTSET = scl | sda;
+	I2C_GPIO->OUTENSET = scl | sda;
+	I2C_GPIO->ALTFUNCCLR = scl | sda;
+	i2c_delay_us(I2C_RECOVER_HALF_US);
+
+	for (uint32_t i = 0; i < 9 && !i2c_sda_high(); i++) {
+		I2C_GPIO->DATAOUTCLR = scl;
+		i2c_delay_us(I2C_RECOVER_HALF_US);
+		I2C_GPIO->DATAOUTSET = scl;
+		i2c_delay_us(I2C_RECOVER_HALF_US);
+	}
+
+	/* Stop condition: SDA rises while SCL is high */
+	I2C_GPIO->DATAOUTCLR = scl;
+	i2c_delay_us(I2C_RECOVER_HALF_US);
+	I2C_GPIO->DATAOUTCLR = sda;
+	i2c_delay_us(I2C_RECOVER_HALF_US);
+	I2C_GPIO->DATAOUTSET = scl;
+	i2c_delay_us(I2C_RECOVER_HALF_US);
+	I2C_GPIO->DATAOUTSET = sda;
+	i2c_delay_us(I2C_RECOVER_HALF_US);
+
+	int ok = i2c_sda_high();
+
+	I2C_GPIO->OUTENCLR = scl | sda;
+	i2c_pins_af();
+	return ok ? I2C_OK : I2C_ERR_BUS;
+}
+
+/* Transaction engine ------------------------------------------------------ */
+
+/*
+ * Everything below up to i2c_irq_handler() runs with interrupts
+ * masked: in the ISR or inside a critical section.
+ */
+
+static void i2c_begin(i2c_xfer_t *x)
+{
+	uint16_t ms = x->timeout_ms ? x->timeout_ms : I2C_TIMEOUT_MS_DEFAULT;
+
+	i2c_ctx.cur = x;
+	i2c_ctx.seg = 0;
+	i2c_ctx.pos = 0;
+	i2c_ctx.retries = 0;
+	i2c_ctx.deadline = xTaskGetTickCountFromISR() + pdMS_TO_TICKS(ms) + 1;
+	i2c_ctx.t_start = i2c_mtime();
+	i2c_hw_start();
+}
+
+static void i2c_start_next(BaseType_t *woken)
+{
+	i2c_xfer_t *x;
+
+	if (i2c_ctx.cur || i2c_ctx.recover_req || i2c_ctx.clk_hold)
+		return;
+	if (xQueueReceiveFromISR(i2c_ctx.queue, &x, woken) == pdTRUE)
+		i2c_begin(x);
+}
+
+static void i2c_finish(int status, BaseType_t *woken)
+{
+	i2c_xfer_t *x = i2c_ctx.cur;
+
+	i2c_ctx.stats.busy_ticks += i2c_mtime() - i2c_ctx.t_start;
+	i2c_ctx.stats.xfers++;
+	i2c_ctx.cur = NULL;
+	x->status = status;
+	if (x->owner)
+		vTaskNotifyGiveIndexedFromISR(x->owner, I2C_NOTIFY_INDEX,
+					      woken);
+	i2c_start_next(woken);
+}
+
+/** @brief Send the next byte of the current write run */
+static int i2c_tx_byte(i2c_xfer_t *x)
+{
+	while (i2c_ctx.seg < x->nsegs) {
+		const i2c_seg_t *s = &x->segs[i2c_ctx.seg];
+
+		if (s->read)
+			return 0;
+		if (i2c_ctx.pos < s->len) {
+			I2C->SDA = s->buf[i2c_ctx.pos++];
+			i2c_ctx.stats.bytes++;
+			i2c_hw_resume();
+			return 1;
+		}
+		i2c_ctx.seg++;
+		i2c_ctx.pos = 0;
+	}
+	return 0;
+}
+
+/** @brief Current segment done: repeated start or stop */
+static void i2c_seg_next(i2c_xfer_t *x, BaseType_t *woken)
+{
+	if (i2c_ctx.seg < x->nsegs) {
+		i2c_hw_start();
+		return;
+	}
+	i2c_hw_stop();
+	i2c_finish(I2C_OK, woken);
+}
+
+static void i2c_fail(int status, BaseType_t *woken)
+{
+	switch (status) {
+	case I2C_ERR_NACK:
+		i2c_ctx.stats.nacks++;
+		i2c_hw_stop();
+		break;
+	case I2C_ERR_ARB:
+		i2c_hw_resume();
+		break;
+	default:
+		/* Unknown state: park the controller, watchdog recovers */
+		i2c_ctx.stats.bus_errors++;
+		i2c_ctx.recover_req = 1;
+		i2c_hw_disable();
+		break;
+	}
+	i2c_finish(status, woken);
+}
+
+static void i2c_irq_handler(void)
+{
+	BaseType_t woken = pdFALSE;
+	i2c_xfer_t *x = i2c_ctx.cur;
+	uint32_t mode = I2C->ST_bit.MODE;
+	const i2c_seg_t *s;
+
+	if (x == NULL) {
+		i2c_hw_resume();
+		return;
+	}
+	s = &x->segs[i2c_ctx.seg < x->nsegs ? i2c_ctx.seg : x->nsegs - 1];
+
+	switch (mode) {
+	case I2C_HW_STDONE:
+	case I2C_HW_RSDONE:
+		I2C->CTL0_bit.START = 0;
+		I2C->SDA = ((uint32_t)x->addr << 1) | (s->read ? 1 : 0);
+		i2c_hw_resume();
+		break;
+	case I2C_HW_MTADPA:
+	case I2C_HW_MTDAPA:
+		if (!i2c_tx_byte(x))
+			i2c_seg_next(x, &woken);
+		break;
+	case I2C_HW_MTDANA:
+		/* A slave may NACK the very last byte */
+		if (i2c_ctx.seg + 1 == x->nsegs && i2c_ctx.pos == s->len) {
+			i2c_hw_stop();
+			i2c_finish(I2C_OK, &woken);
+		} else {
+			i2c_fail(I2C_ERR_NACK, &woken);
+		}
+		break;
+	case I2C_HW_MRADPA:
+		i2c_hw_rx(s->len == 1);
+		break;
+	case I2C_HW_MRDAPA:
+	case I2C_HW_MRDANA:
+		s->buf[i2c_ctx.pos++] = (uint8_t)I2C->SDA;
+		i2c_ctx.stats.bytes++;
+		if (i2c_ctx.pos < s->len) {
+			i2c_hw_rx(i2c_ctx.pos + 1 == s->len);
+			break;
+		}
+		i2c_ctx.seg++;
+		i2c_ctx.pos = 0;
+		i2c_seg_next(x, &woken);
+		break;
+	case I2C_HW_MTADNA:
+	case I2C_HW_MRADNA:
+		i2c_fail(I2C_ERR_NACK, &woken);
+		break;
+	case I2C_HW_IDLARL:
+		/* Another master won: run the transaction again */
+		i2c_ctx.stats.arb_lost++;
+		if (i2c_ctx.retries++ < I2C_ARB_RETRIES) {
+			i2c_ctx.seg = 0;
+			i2c_ctx.pos = 0;
+			i2c_hw_start();
+		} else {
+			i2c_fail(I2C_ERR_ARB, &woken);
+		}
+		break;
+	default:
+		i2c_fail(I2C_ERR_BUS, &woken);
+		break;
+	}
+
+	portYIELD_FROM_ISR(woken);
+}
+
+/**
+ * @brief Release the bus and restart the queue.
+ *
+ * Called from task context with recover_req set, which keeps the
+ * interrupt from starting transactions meanwhile.
+ */
+static int i2c_bus_reset(void)
+{
+	BaseType_t woken = pdFALSE;
+	int ret = i2c_bus_release();
+
+	taskENTER_CRITICAL();
+	i2c_ctx.stats.recoveries++;
+	i2c_hw_enable(i2c_ctx.freq_hz);
+	i2c_ctx.recover_req = 0;
+	i2c_start_next(&woken);
+	taskEXIT_CRITICAL();
+	if (woken)
+		taskYIELD();
+	return ret;
+}
+
+/**
+ * @brief Deadline watchdog, runs in the timer task.
+ *
+ * A transaction past its deadline (slave stretching SCL forever,
+ * lost interrupt, stuck bus) is aborted, then the bus is released
+ * and the queue restarted.
+ */
+static void i2c_wdt_cb(__attribute__((unused)) TimerHandle_t t)
+{
+	BaseType_t woken = pdFALSE;
+	int recover;
+
+	taskENTER_CRITICAL();
+	if (i2c_ctx.cur &&
+	    (int32_t)(xTaskGetTickCount() - i2c_ctx.deadline) >= 0) {
+		i2c_ctx.stats.timeouts++;
+		i2c_ctx.recover_req = 1;
+		i2c_hw_disable();
+		i2c_finish(I2C_ERR_TIMEOUT, &woken);
+	}
+	recover = i2c_ctx.recover_req;
+	taskEXIT_CRITICAL();
+
+	if (recover)
+		i2c_bus_reset();
+	else if (woken)
+		taskYIELD();
+}
+
+/**
+ * @brief Core clock change, SCL is divided down from the APB clock.
+ *
+ * A transaction in flight vetoes the change, otherwise the queue is
+ * held until the divider is set for the new clock.
+ */
+static int i2c_clk_cb(clk_event_t ev, __attribute__((unused)) uint32_t old_hz,
+		      __attribute__((unused)) uint32_t new_hz,
+		      __attribute__((unused)) void *arg)
+{
+	BaseType_t woken = pdFALSE;
+	int ret = 0;
+
+	switch (ev) {
+	case CLK_PRE_CHANGE:
+		taskENTER_CRITICAL();
+		if (i2c_ctx.cur)
+			ret = -1;
+		else
+			i2c_ctx.clk_hold = 1;
+		taskEXIT_CRITICAL();
+		break;
+	case CLK_CHANGE:
+		i2c_hw_set_freq(i2c_ctx.freq_hz);
+		break;
+	default:
+		taskENTER_CRITICAL();
+		i2c_ctx.clk_hold = 0;
+		i2c_start_next(&woken);
+		taskEXIT_CRITICAL();
+		if (woken)
+			taskYIELD();
+		break;
+	}
+	return ret;
+}
+
+/* API --------------------------------------------------------------------- */
+
+int i2c_init(const i2c_config_t *cfg)
+{
+	int ret = I2C_OK;
+
+	if (cfg == NULL || cfg->freq_hz == 0 || cfg->freq_hz > 1000000 ||
+	    cfg->queue_len == 0)
+		return I2C_ERR_PARAM;
+
+	if (i2c_ctx.queue == NULL) {
+		i2c_ctx.queue =
+			xQueueCreate(cfg->queue_len, sizeof(i2c_xfer_t *));
+		i2c_ctx.wdt = xTimerCreate("i2c",
+					   pdMS_TO_TICKS(I2C_WDT_PERIOD_MS),
+					   pdTRUE, NULL, i2c_wdt_cb);
+	}
+	if (i2c_ctx.queue == NULL || i2c_ctx.wdt == NULL)
+		return I2C_ERR_PARAM;
+
+	i2c_ctx.freq_hz = cfg->freq_hz;
+	memset(&i2c_ctx.stats, 0, sizeof(i2c_ctx.stats));
+	i2c_ctx.t_reset = i2c_mtime();
+
+	RCU->CGCFGAHB_bit.GPIOAEN = 1;
+	RCU->RSTDISAHB_bit.GPIOAEN = 1;
+	RCU->CGCFGAPB_bit.I2CEN = 1;
+	RCU->RSTDISAPB_bit.I2CEN = 1;
+
+	/* A slave reset mid-transfer may still hold SDA low */
+	i2c_pins_af();
+	if (!i2c_sda_high()) {
+		ret = i2c_bus_release();
+		i2c_ctx.stats.recoveries++;
+	}
+	i2c_hw_enable(cfg->freq_hz);
+
+	PLIC_SetIrqHandler(Plic_Mach_Target, IsrVect_IRQ_I2C, i2c_irq_handler);
+	PLIC_SetPriority(IsrVect_IRQ_I2C, cfg->irq_prio);
+	PLIC_IntEnable(Plic_Mach_Target, IsrVect_IRQ_I2C);
+
+	clk_notifier_register(&i2c_ctx.clk, i2c_clk_cb, NULL);
+	xTimerStart(i2c_ctx.wdt, 0);
+	return ret;
+}
+
+static int i2c_xfer_ok(const i2c_xfer_t *x)
+{
+	if (x->nsegs == 0 || x->segs == NULL || x->addr > 0x7F)
+		return 0;
+	for (uint32_t i = 0; i < x->nsegs; i++)
+		if (x->segs[i].read && x->segs[i].len == 0)
+			return 0;
+	return 1;
+}
+
+uint32_t i2c_submit(i2c_xfer_t *xfers, uint32_t n, TickType_t timeout)
+{
+	BaseType_t woken = pdFALSE;
+	uint32_t done, waiting;
+
+	for (done = 0; done < n; done++) {
+		i2c_xfer_t *x = &xfers[done];
+
+		if (!i2c_xfer_ok(x)) {
+			x->status = I2C_ERR_PARAM;
+			continue;
+		}
+		x->owner = NULL;
+		x->status = I2C_PENDING;
+		if (xQueueSend(i2c_ctx.queue, &x, timeout) != pdTRUE) {
+			x->status = I2C_ERR_FULL;
+			break;
+		}
+
+		taskENTER_CRITICAL();
+		waiting = uxQueueMessagesWaiting(i2c_ctx.queue);
+		if (waiting > i2c_ctx.stats.queue_hwm)
+			i2c_ctx.stats.queue_hwm = waiting;
+		i2c_start_next(&woken);
+		taskEXIT_CRITICAL();
+	}
+	if (woken)
+		taskYIELD();
+	return done;
+}
+
+/** @brief Drop wake-ups no wait is going to take */
+static void i2c_notify_clear(void)
+{
+	(void)xTaskNotifyStateClearIndexed(NULL, I2C_NOTIFY_INDEX);
+	(void)ulTaskNotifyValueClearIndexed(NULL, I2C_NOTIFY_INDEX,
+					    UINT32_MAX);
+}
+
+int i2c_wait(i2c_xfer_t *xfer, TickType_t timeout)
+{
+	TimeOut_t to;
+
+	i2c_notify_clear();
+	taskENTER_CRITICAL();
+	if (xfer->status == I2C_PENDING)
+		xfer->owner = xTaskGetCurrentTaskHandle();
+	taskEXIT_CRITICAL();
+
+	vTaskSetTimeOutState(&to);
+	while (xfer->status == I2C_PENDING) {
+		if (xTaskCheckForTimeOut(&to, &timeout) == pdTRUE)
+			break;
+		(void)ulTaskNotifyTakeIndexed(I2C_NOTIFY_INDEX, pdTRUE,
+					      timeout);
+	}
+
+	/* A late completion must not wake the next wait */
+	taskENTER_CRITICAL();
+	xfer->owner = NULL;
+	taskEXIT_CRITICAL();
+	i2c_notify_clear();
+	return xfer->status;
+}
+
+int i2c_transfer(i2c_xfer_t *xfer)
+{
+	if (i2c_submit(xfer, 1, portMAX_DELAY) != 1)
+		return xfer->status;
+	/* The watchdog bounds every transaction */
+	return i2c_wait(xfer, portMAX_DELAY);
+}
+
+int i2c_reg_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+	const i2c_seg_t segs[2] = {
+		{ .buf = &reg, .len = 1, .read = 0 },
+		{ .buf = buf, .len = len, .read = 1 },
+	};
+	i2c_xfer_t x = { .addr = addr, .nsegs = 2, .segs = segs };
+
+	return i2c_transfer(&x);
+}
+
+int i2c_reg_write(uint8_t addr, uint8_t reg, const uint8_t *buf,
+		  uint16_t len)
+{
+	const i2c_seg_t segs[2] = {
+		{ .buf = &reg, .len = 1, .read = 0 },
+		{ .buf = (uint8_t *)buf, .len = len, .read = 0 },
+	};
+	i2c_xfer_t x = { .addr = addr, .nsegs = 2, .segs = segs };
+
+	return i2c_transfer(&x);
+}
+
+int i2c_recover(void)
+{
+	taskENTER_CRITICAL();
+	if (i2c_ctx.cur) {
+		taskEXIT_CRITICAL();
+		return I2C_ERR_BUS;
+	}
+	i2c_ctx.recover_req = 1;
+	i2c_hw_disable();
+	taskEXIT_CRITICAL();
+
+	return i2c_bus_reset();
+}
+
+void i2c_get_stats(i2c_stats_t *stats)
+{
+	uint64_t now = i2c_mtime();
+
+	taskENTER_CRITICAL();
+	*stats = i2c_ctx.stats;
+	stats->elapsed_ticks = now - i2c_ctx.t_reset;
+	taskEXIT_CRITICAL();
+
+	stats->util_permille =
+		stats->elapsed_ticks ?
+			(uint32_t)(stats->busy_ticks * 1000 /
+				   stats->elapsed_ticks) :
+			0;
+}
+
+void i2c_reset_stats(void)
+{
+	taskENTER_CRITICAL();
+	memset(&i2c_ctx.stats, 0, sizeof(i2c_ctx.stats));
+	i2c_ctx.t_reset = i2c_mtime();
+	taskEXIT_CRITICAL();
+}
@@ -0,0 +1,152 @@
+#ifndef __icap_h__
+#define __icap_h__
+
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "clk.h"
+#include "ring.h"
+
+/*! CPP guard */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief TMR32 capture channels left free by Lib/hrtimer */
+#define ICAP_CAPCOM_FIRST 2
+#define ICAP_CAPCOM_LAST 3
+/** @brief Max capture buffers of one channel */
+#define ICAP_BUF_MAX 8
+
+/** @brief Captured edges, the CAPEVT code of the CAPCOM channel */
+typedef enum {
+	ICAP_EDGE_RISE = 0,
+	ICAP_EDGE_FALL,
+	ICAP_EDGE_BOTH,
+} icap_edge_t;
+
+/**
+ * @brief Capture configuration.
+ *
+ * buf holds nbufs blocks of block_len counts; a block must fit one
+ * DMA cycle (DMA_XFER_MAX). With both edges block_len is even, so a
+ * dropped block keeps the rising/falling order of the next ones.
+ */
+typedef struct {
+	uint8_t capcom; /**< ICAP_CAPCOM_FIRST..ICAP_CAPCOM_LAST */
+	icap_edge_t edge;
+	uint8_t idle_high; /**< both edges: input level before the first */
+	uint8_t nbufs; /**< 3..ICAP_BUF_MAX */
+	uint8_t dma_ch; /**< channel wired to the TMR32 capture request */
+	uint16_t block_len;
+	uint32_t *buf;
+} icap_config_t;
+
+/** @brief Full block handed to the processing task */
+typedef struct {
+	uint64_t last; /**< 64-bit TMR32 count of the last edge */
+	uint64_t prev; /**< edge before the block, 0 after a gap */
+	uint32_t seq_no; /**< block counter, gaps mean dropped blocks */
+	uint32_t first; /**< number of the first edge since start */
+	uint16_t len;
+	uint8_t idx; /**< buffer index, pass back to icap_release() */
+	uint8_t edge; /**< icap_edge_t of the channel */
+	uint8_t rise_even; /**< both edges: even edge numbers are rising */
+	const uint32_t *cnt; /**< low 32 bits of the counts */
+} icap_block_t;
+
+/**
+ * @brief Block measurement, in TMR32 counts.
+ *
+ * Periods run rising to rising with both edges, edge to edge
+ * otherwise. The edge before the block takes part when known.
+ */
+typedef struct {
+	uint32_t periods;
+	uint32_t period_min;
+	uint32_t period_max;
+	uint32_t period_avg;
+	uint32_t freq_mhz; /**< mean frequency in mHz */
+	uint32_t duty_ppm; /**< high share, both edges only */
+} icap_meas_t;
+
+typedef struct {
+	uint32_t blocks;
+	uint32_t overruns; /**< blocks dropped: no free buffer for DMA */
+	/**
+	 * Both DMA halves filled before reloaded: edges were lost, with
+	 * both edges the rising/falling order may be off after it
+	 */
+	uint32_t stalls;
+} icap_stats_t;
+
+/**
+ * @brief Capture instance, treat as opaque.
+ *
+ * Same scheme as Lib/adc_acq: ping-pong DMA straight from the
+ * CAPCOM value register, full blocks through an SPSC ring.
+ */
+typedef struct {
+	icap_config_t cfg;
+	ring_spsc_t ready;
+	void *ready_slots[ICAP_BUF_MAX];
+	icap_block_t blk[ICAP_BUF_MAX];
+	volatile uint32_t free_msk;
+	uint8_t cur[2]; /**< buffer loaded in primary/alternate structure */
+	uint8_t alt_next;
+	uint8_t gap; /**< edges lost before the next block */
+	uint32_t seq_no;
+	uint32_t edges;
+	uint32_t hz; /**< TMR32 clock, fixed while running */
+	uint64_t last;
+	icap_stats_t stats;
+	clk_notifier_t clk;
+} icap_t;
+
+/**
+ * @brief Put a CAPCOM channel in capture mode and start the DMA.
+ *
+ * TMR32 must be running (hrtimer_init()). There is no interrupt per
+ * edge, only one per block. A running capture vetoes clk_set_op().
+ * @return 0 on success, -1 on bad configuration
+ */
+int icap_start(icap_t *cap, const icap_config_t *cfg);
+
+/** @brief Stop capture and DMA */
+void icap_stop(icap_t *cap);
+
+/** @brief Counts per second of the timestamps */
+uint32_t icap_hz(const icap_t *cap);
+
+/**
+ * @brief Wait for the next full block.
+ * @return pdTRUE if a block was received
+ */
+BaseType_t icap_get(icap_t *cap, icap_block_t *blk, TickType_t timeout);
+
+/** @brief Return a processed block's buffer to the capture */
+void icap_release(icap_t *cap, const icap_block_t *blk);
+
+/**
+ * @brief 64-bit counts of every edge of a block.
+ * @param ts blk->len entries
+ *
+ * Counts are rebuilt from the last edge backwards, edges closer than
+ * one TMR32 wrap to each other are exact.
+ */
+void icap_timestamps(const icap_block_t *blk, uint64_t *ts);
+
+/**
+ * @brief Period, frequency and duty over a whole block.
+ * @param hz icap_hz()
+ * @return 0, -1 if the block holds no whole period
+ */
+int icap_measure(const icap_block_t *blk, uint32_t hz, icap_meas_t *m);
+
+/** @brief Copy statistics */
+void icap_get_stats(icap_t *cap, icap_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif /* End of CPP guard */
+
+#endif //__icap_h__
@@ -0,0 +1,250 @@
+#include <string.h>
+#include "icap.h"
+#include "dma.h"
+#include "hrtimer.h"
+#include "task.h"
+
+/** @brief TMR32 capture event bit of a CAPCOM channel (IM, DMAIM) */
+#define ICAP_EVT(capcom) (1UL << (1 + (capcom)))
+
+static uint32_t *icap_buf(const icap_t *cap, uint32_t idx)
+{
+	return cap->cfg.buf + idx * cap->cfg.block_len;
+}
+
+static void icap_dma_load(icap_t *cap, int alt, uint32_t idx)
+{
+	dma_ch_setup(cap->cfg.dma_ch, &TMR32->CAPCOM[cap->cfg.capcom].VAL,
+		     icap_buf(cap, idx), cap->cfg.block_len,
+		     DMA_XFER_WORD | DMA_XFER_DST_INC | DMA_XFER_PINGPONG |
+			     (alt ? DMA_XFER_ALT : 0));
+	cap->cur[alt] = idx;
+}
+
+/**
+ * @brief Ping-pong half completed.
+ *
+ * Same buffer handling as adc_acq: the finished structure is
+ * reloaded with the next free buffer, or with the same one when
+ * none is free and the block is dropped. The last edge is extended
+ * to 64 bits here, less than a TMR32 wrap after it was captured.
+ */
+static void icap_half_done(icap_t *cap, BaseType_t *woken)
+{
+	int alt = cap->alt_next;
+	uint32_t idx = cap->cur[alt];
+	icap_block_t *blk = &cap->blk[idx];
+	const uint32_t *cnt = icap_buf(cap, idx);
+	uint32_t len = cap->cfg.block_len;
+	uint64_t now = hrtimer_count();
+	uint64_t prev = cap->gap ? 0 : cap->last;
+	uint32_t next;
+
+	cap->alt_next ^= 1;
+	cap->last = now - (uint32_t)((uint32_t)now - cnt[len - 1]);
+	blk->first = cap->edges;
+	blk->seq_no = cap->seq_no++;
+	cap->edges += len;
+
+	if (cap->free_msk == 0) {
+		cap->stats.overruns++;
+		cap->gap = 1;
+		icap_dma_load(cap, alt, idx);
+		return;
+	}
+
+	next = __builtin_ctz(cap->free_msk);
+	cap->free_msk &= ~(1UL << next);
+	icap_dma_load(cap, alt, next);
+	cap->gap = 0;
+
+	blk->last = cap->last;
+	blk->prev = prev;
+	blk->len = (uint16_t)len;
+	blk->idx = (uint8_t)idx;
+	blk->edge = (uint8_t)cap->cfg.edge;
+	blk->rise_even = !cap->cfg.idle_high;
+	blk->cnt = cnt;
+	cap->stats.blocks++;
+	/* At most nbufs - 2 blocks are out, the ring cannot fill */
+	ring_spsc_push(&cap->ready, blk, woken);
+}
+
+static void icap_dma_done(uint32_t ch, void *arg)
+{
+	icap_t *cap = arg;
+	BaseType_t woken = pdFALSE;
+
+	/* One interrupt may stand for both halves */
+	while (dma_ch_remaining(ch, cap->alt_next) == 0)
+		icap_half_done(cap, &woken);
+	/* Both were full: the controller stopped, edges since are lost */
+	if (!dma_ch_busy(ch)) {
+		cap->stats.stalls++;
+		cap->gap = 1;
+		dma_ch_enable(ch);
+	}
+	portYIELD_FROM_ISR(woken);
+}
+
+static int icap_clk_cb(clk_event_t ev, __attribute__((unused)) uint32_t old_hz,
+		       __attribute__((unused)) uint32_t new_hz,
+		       __attribute__((unused)) void *arg)
+{
+	return ev == CLK_PRE_CHANGE ? -1 : 0;
+}
+
+int icap_start(icap_t *cap, const icap_config_t *cfg)
+{
+	if (cfg->capcom < ICAP_CAPCOM_FIRST || cfg->capcom > ICAP_CAPCOM_LAST ||
+	    cfg->edge > ICAP_EDGE_BOTH || cfg->nbufs < 3 ||
+	    cfg->nbufs > ICAP_BUF_MAX || cfg->block_len < 2 ||
+	    cfg->block_len > DMA_XFER_MAX ||
+	    (cfg->edge == ICAP_EDGE_BOTH && (cfg->block_len & 1)) ||
+	    cfg->buf == NULL || cfg->dma_ch >= DMA_CH_COUNT)
+		return -1;
+
+	memset(cap, 0, sizeof(*cap));
+	cap->cfg = *cfg;
+	cap->hz = SystemCoreClock;
+	cap->gap = 1;
+	ring_spsc_init(&cap->ready, cap->ready_slots, ICAP_BUF_MAX);
+	cap->free_msk = ((1UL << cfg->nbufs) - 1) & ~3UL;
+
+	clk_notifier_register(&cap->clk, icap_clk_cb, cap);
+	dma_init();
+	dma_set_handler(cfg->dma_ch, icap_dma_done, cap);
+	dma_ch_use_primary(cfg->dma_ch);
+	icap_dma_load(cap, 0, 0);
+	icap_dma_load(cap, 1, 1);
+	dma_ch_enable(cfg->dma_ch);
+
+	TMR32->CAPCOM[cfg->capcom].CTRL = 0;
+	TMR32->CAPCOM[cfg->capcom].CTRL_bit.CAPEVT = cfg->edge;
+	TMR32->CAPCOM[cfg->capcom].CTRL_bit.CAPMODE = 1;
+	/* Request per capture, no interrupt: the DMA takes every edge */
+	taskENTER_CRITICAL();
+	TMR32->IC = ICAP_EVT(cfg->capcom);
+	TMR32->DMAIM |= ICAP_EVT(cfg->capcom);
+	taskEXIT_CRITICAL();
+	return 0;
+}
+
+void icap_stop(icap_t *cap)
+{
+	taskENTER_CRITICAL();
+	TMR32->DMAIM &= ~ICAP_EVT(cap->cfg.capcom);
+	taskEXIT_CRITICAL();
+	TMR32->CAPCOM[cap->cfg.capcom].CTRL = 0;
+	dma_ch_disable(cap->cfg.dma_ch);
+	dma_set_handler(cap->cfg.dma_ch, NULL, NULL);
+	clk_notifier_unregister(&cap->clk);
+}
+
+uint32_t icap_hz(const icap_t *cap)
+{
+	return cap->hz;
+}
+
+BaseType_t icap_get(icap_t *cap, icap_block_t *blk, TickType_t timeout)
+{
+	void *full;
+
+	if (ring_spsc_receive(&cap->ready, &full, timeout) != RING_OK)
+		return pdFALSE;
+	*blk = *(const icap_block_t *)full;
+	return pdTRUE;
+}
+
+void icap_release(icap_t *cap, const icap_block_t *blk)
+{
+	taskENTER_CRITICAL();
+	cap->free_msk |= 1UL << blk->idx;
+	taskEXIT_CRITICAL();
+}
+
+void icap_timestamps(const icap_block_t *blk, uint64_t *ts)
+{
+	uint32_t i = blk->len - 1;
+
+	ts[i] = blk->last;
+	while (i--)
+		ts[i] = ts[i + 1] - (uint32_t)(blk->cnt[i + 1] - blk->cnt[i]);
+}
+
+static void icap_period(icap_meas_t *m, uint32_t p, uint64_t *sum)
+{
+	if (p < m->period_min)
+		m->period_min = p;
+	if (p > m->period_max)
+		m->period_max = p;
+	m->periods++;
+	*sum += p;
+}
+
+/*
+ * Differences of the low 32 bits only: the 64-bit counts are not
+ * needed for intervals shorter than a wrap.
+ */
+int icap_measure(const icap_block_t *blk, uint32_t hz, icap_meas_t *m)
+{
+	const uint32_t *c = blk->cnt;
+	uint32_t k = blk->first, i = 0, p;
+	uint32_t rise = 0, high = 0;
+	uint64_t sum = 0, high_sum = 0;
+	uint8_t have_rise = 0, have_high = 0;
+
+	memset(m, 0, sizeof(*m));
+	m->period_min = UINT32_MAX;
+
+	if (blk->edge != ICAP_EDGE_BOTH) {
+		p = blk->prev ? (uint32_t)blk->prev : c[i++];
+		for (; i < blk->len; i++) {
+			icap_period(m, c[i] - p, &sum);
+			p = c[i];
+		}
+	} else {
+		if (blk->prev) {
+			p = (uint32_t)blk->prev;
+			k--;
+		} else {
+			p = c[i++];
+		}
+		/* Edge k rises when its parity matches rise_even */
+		for (;;) {
+			if (((k & 1) == 0) == (blk->rise_even != 0)) {
+				if (have_rise && have_high) {
+					icap_period(m, p - rise, &sum);
+					high_sum += high;
+				}
+				rise = p;
+				have_rise = 1;
+				have_high = 0;
+			} else if (have_rise) {
+				high = p - rise;
+				have_high = 1;
+			}
+			if (i == blk->len)
+				break;
+			p = c[i++];
+			k++;
+		}
+	}
+
+	if (m->periods == 0) {
+		m->period_min = 0;
+		return -1;
+	}
+	m->period_avg = (uint32_t)(sum / m->periods);
+	m->freq_mhz = (uint32_t)((uint64_t)m->periods * hz * 1000 / sum);
+	if (blk->edge == ICAP_EDGE_BOTH)
+		m->duty_ppm = (uint32_t)(high_sum * 1000000 / sum);
+	return 0;
+}
+
+void icap_get_stats(icap_t *cap, icap_stats_t *stats)
+{
+	taskENTER_CRITICAL();
+	*stats = cap->stats;
+	taskEXIT_CRITICAL();
+}
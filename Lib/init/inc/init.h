@@ -0,0 +1,120 @@
+#ifndef __init_h__
+#define __init_h__
+
+#include <stdint.h>
+
+/*! CPP guard */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Init levels, run in this order.
+ *
+ * EARLY and PRE_SCHED run from main() with interrupts masked,
+ * POST_SCHED runs in the init task once the scheduler is up.
+ * Work nobody waits for belongs in POST_SCHED or behind INIT_ONCE.
+ */
+typedef enum {
+	INIT_LEVEL_EARLY, /**< clocks, pins: nothing else is ready */
+	INIT_LEVEL_PRE_SCHED, /**< drivers the first tasks depend on */
+	INIT_LEVEL_POST_SCHED, /**< deferred, low priority init task */
+	INIT_LEVEL_LAZY, /**< INIT_ONCE, on first use */
+	INIT_LEVEL_COUNT
+} init_level_t;
+
+/** @brief Init function, non-zero return is recorded as a failure */
+typedef int (*init_fn_t)(void);
+
+/** @brief Table entry, placed in the init_tbl linker section */
+typedef struct {
+	init_fn_t fn;
+	const char *name;
+	uint8_t level;
+	uint8_t order; /**< lower runs first within a level */
+} init_entry_t;
+
+/**
+ * @brief Register fn at a level.
+ *
+ * The entry must sit in an object that is linked anyway: the linker
+ * does not pull library members for the table alone.
+ */
+#define INIT_ENTRY(lvl, ord, func)                                  \
+	static const init_entry_t init_entry_##func                 \
+		__attribute__((used, section("init_tbl"), aligned(4))) = { \
+			.fn = func,                                         \
+			.name = #func,                                      \
+			.level = lvl,                                       \
+			.order = ord,                                       \
+		}
+
+#define INIT_EARLY(func, ord) INIT_ENTRY(INIT_LEVEL_EARLY, ord, func)
+#define INIT_PRE_SCHED(func, ord) INIT_ENTRY(INIT_LEVEL_PRE_SCHED, ord, func)
+#define INIT_POST_SCHED(func, ord) INIT_ENTRY(INIT_LEVEL_POST_SCHED, ord, func)
+
+/** @brief Lazy init state, zero initialised */
+typedef struct {
+	volatile uint8_t state;
+	int8_t rc;
+} init_once_t;
+
+#define INIT_ONCE_INIT { 0, 0 }
+
+/** @brief Boot report record, times in mtime ticks since reset */
+typedef struct {
+	const char *name;
+	uint64_t start;
+	uint32_t dur;
+	int8_t rc;
+	uint8_t level; /**< INIT_LEVEL_COUNT for init_mark() milestones */
+} init_rec_t;
+
+/** @brief Report capacity, later records are counted but dropped */
+#define INIT_REC_MAX 32
+
+/**
+ * @brief Run every entry of a level, timing each one.
+ * @return Number of entries that failed
+ */
+int init_run(init_level_t level);
+
+/**
+ * @brief Run fn once, concurrent callers wait for the first one.
+ *
+ * Safe before and after the scheduler start, not from interrupts.
+ * @return fn's result, remembered for later calls
+ */
+int init_once(init_once_t *once, init_fn_t fn, const char *name);
+
+/** @brief Lazy init at the point of first use */
+#define INIT_ONCE(once, func) init_once(once, func, #func)
+
+/** @brief Record a milestone, e.g. "operational" */
+void init_mark(const char *name);
+
+/** @brief mtime ticks since reset */
+uint64_t init_now(void);
+
+/**
+ * @brief Print the records.
+ *
+ * One "boot,<name>,<level>,<start_us>,<dur_us>,<rc>" line per record,
+ * levels as early/pre_sched/post_sched/lazy/mark.
+ */
+void init_report(void);
+
+/**
+ * @brief Start the init task: POST_SCHED level, then the report.
+ *
+ * The task deletes itself when done. A priority below the
+ * application tasks keeps the deferred work off the critical path.
+ * @return 0 on success, -1 if the task could not be created
+ */
+int init_task_start(uint32_t prio);
+
+#ifdef __cplusplus
+}
+#endif /* End of CPP guard */
+
+#endif //__init_h__
@@ -0,0 +1,163 @@
+#include <stddef.h>
+#include <stdio.h>
+#include "init.h"
+#include "mtimer.h"
+#include "riscv-irq.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+enum { ONCE_IDLE, ONCE_RUNNING, ONCE_DONE };
+
+/**
+ * @brief Table bounds, from the linker script or the linker itself.
+ * Weak: an image without entries has no section and both are NULL.
+ */
+extern const init_entry_t __start_init_tbl[] __attribute__((weak));
+extern const init_entry_t __stop_init_tbl[] __attribute__((weak));
+
+static init_rec_t init_recs[INIT_REC_MAX];
+static uint32_t init_nrecs;
+static uint32_t init_dropped;
+
+static const char *const init_level_names[INIT_LEVEL_COUNT + 1] = {
+	"early", "pre_sched", "post_sched", "lazy", "mark",
+};
+
+uint64_t init_now(void)
+{
+	volatile uint32_t *mtime = (volatile uint32_t *)RISCV_MTIME_ADDR;
+	uint32_t hi, lo;
+
+	do {
+		hi = mtime[1];
+		lo = mtime[0];
+	} while (hi != mtime[1]);
+	return ((uint64_t)hi << 32) | lo;
+}
+
+static void init_record(const char *name, uint8_t level, uint64_t start,
+			uint64_t end, int rc)
+{
+	uint32_t mie = irq_save();
+
+	if (init_nrecs < INIT_REC_MAX) {
+		init_rec_t *r = &init_recs[init_nrecs++];
+
+		r->name = name;
+		r->level = level;
+		r->start = start;
+		r->dur = (uint32_t)(end - start);
+		r->rc = (int8_t)rc;
+	} else {
+		init_dropped++;
+	}
+	irq_restore(mie);
+}
+
+void init_mark(const char *name)
+{
+	uint64_t now = init_now();
+
+	init_record(name, INIT_LEVEL_COUNT, now, now, 0);
+}
+
+static int init_call(const char *name, uint8_t level, init_fn_t fn)
+{
+	uint64_t start = init_now();
+	int rc = fn();
+
+	init_record(name, level, start, init_now(), rc);
+	return rc;
+}
+
+int init_run(init_level_t level)
+{
+	const init_entry_t *e, *next, *last = NULL;
+	int failed = 0;
+
+	/*
+	 * The table is in link order, not sorted. Pick the next entry
+	 * by (order, position) each round: a few dozen entries at most,
+	 * cheaper than keeping the linker scripts sorting for both builds.
+	 */
+	while (1) {
+		next = NULL;
+		for (e = __start_init_tbl; e < __stop_init_tbl; e++) {
+			if (e->level != level)
+				continue;
+			if (last && (e->order < last->order ||
+				     (e->order == last->order && e <= last)))
+				continue;
+			if (!next || e->order < next->order)
+				next = e;
+		}
+		if (!next)
+			break;
+		if (init_call(next->name, level, next->fn) != 0)
+			failed++;
+		last = next;
+	}
+	return failed;
+}
+
+int init_once(init_once_t *once, init_fn_t fn, const char *name)
+{
+	uint32_t mie = irq_save();
+
+	if (once->state == ONCE_IDLE) {
+		once->state = ONCE_RUNNING;
+		irq_restore(mie);
+		once->rc = (int8_t)init_call(name, INIT_LEVEL_LAZY, fn);
+		once->state = ONCE_DONE;
+		return once->rc;
+	}
+	irq_restore(mie);
+
+	while (once->state != ONCE_DONE) {
+		if (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING)
+			vTaskDelay(1);
+	}
+	return once->rc;
+}
+
+void init_report(void)
+{
+	printf("boot,name,level,start_us,dur_us,rc\r\n");
+	for (uint32_t i = 0; i < init_nrecs; i++) {
+		const init_rec_t *r = &init_recs[i];
+
+		printf("boot,%s,%s,%llu,%lu,%d\r\n", r->name,
+		       init_level_names[r->level],
+		       (unsigned long long)(r->start * 1000000 /
+					    MTIME_FREQ_HZ),
+		       (unsigned long)((uint64_t)r->dur * 1000000 /
+				       MTIME_FREQ_HZ),
+		       r->rc);
+	}
+	if (init_dropped)
+		printf("boot,dropped,%lu\r\n", (unsigned long)init_dropped);
+}
+
+static void init_task(__attribute__((unused)) void *arg)
+{
+	init_mark("init_task");
+	init_run(INIT_LEVEL_POST_SCHED);
+	init_mark("post_sched_done");
+	init_report();
+	vTaskDelete(NULL);
+}
+
+int init_task_start(uint32_t prio)
+{
+	if (xTaskCreate(init_task, "init", 256, NULL, prio, NULL) != pdPASS)
+		return -1;
+	return 0;
+}
+
+#ifndef SIM_HOST
+/** @brief Startup hook after .data/.bss setup: time spent in crt0 */
+void app_init(void)
+{
+	init_mark("crt");
+}
+#endif
@@ -3,6 +3,8 @@
 
 #include <stdio.h>
 #include "K1921VG015.h"
+#include "prof.h"
+#include "buf.h"
 
 /*! CPP guard */
 #ifdef __cplusplus
@@ -10,18 +12,12 @@ extern "C" {
 #endif
 
 #define RETARGET_UART_BAUD 115200
-#define SystemCoreClock_uart 16000000
-#define RETARGET_UART UART0
 #define RETARGET_UART_NUM 0
-#define RETARGET_UART_PORT GPIOA
-#define RETARGET_UART_PIN_TX_POS 1
-#define RETARGET_UART_PIN_RX_POS 0
-#define RETARGET_UART_RX_IRQHandler UART0_IRQHandler
-#define RETARGET_UART_RX_IRQn UART0_IRQn
 
 #if (DEBUG_LOG > 0)
 #define FERROR(...)                                          \
 	{                                                    \
+		PROF_SCOPE(log);                             \
 		printf("%s:%d ERROR: ", __FILE__, __LINE__); \
 		printf(__VA_ARGS__);                         \
 		printf("\r\n");                              \
@@ -33,6 +29,7 @@ extern "C" {
 #if (DEBUG_LOG > 1)
 #define FWARNING(...)                                          \
 	{                                                      \
+		PROF_SCOPE(log);                               \
 		printf("%s:%d WARNING: ", __FILE__, __LINE__); \
 		printf(__VA_ARGS__);                           \
 		printf("\r\n");                                \
@@ -44,6 +41,7 @@ extern "C" {
 #if (DEBUG_LOG > 2)
 #define FINFO(...)                                          \
 	{                                                   \
+		PROF_SCOPE(log);                            \
 		printf("%s:%d INFO: ", __FILE__, __LINE__); \
 		printf(__VA_ARGS__);                        \
 		printf("\r\n");                             \
@@ -56,6 +54,20 @@ void retarget_init(void);
 int __io_putchar(int ch);
 int __io_getchar();
 
+/**
+ * @brief Write a buffer chain to the log port, polled unless redirected.
+ *
+ * Takes over the caller's reference, so a buffer on its way
+ * elsewhere is logged with retarget_write_buf(buf_ref(b)).
+ */
+void retarget_write_buf(buf_t *b);
+
+/**
+ * @brief Send the log through out instead of the polled UART,
+ * e.g. lzs_putc() of the compressed stream. NULL switches back.
+ */
+void retarget_redirect(int (*out)(int ch));
+
 #ifdef __cplusplus
 }
 #endif /* End of CPP guard */
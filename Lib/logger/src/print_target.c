@@ -1,45 +1,42 @@
 #include "logger.h"
+#include "uart.h"
+
+static int (*retarget_putc)(int ch);
 
 void retarget_init(void)
 {
-	uint32_t baud_icoef = SystemCoreClock_uart / (16 * RETARGET_UART_BAUD);
-	uint32_t baud_fcoef =
-		((SystemCoreClock_uart / (16.0f * RETARGET_UART_BAUD) -
-		  baud_icoef) *
-			 64 +
-		 0.5f);
-	uint32_t uartclk_ref = 1;
-
-	RCU->CGCFGAHB_bit.GPIOAEN = 1;
-	RCU->RSTDISAHB_bit.GPIOAEN = 1;
-	RCU->CGCFGAPB_bit.UART0EN = 1;
-	RCU->RSTDISAPB_bit.UART0EN = 1;
-
-	RETARGET_UART_PORT->ALTFUNCNUM_bit.PIN0 = 1;
-	RETARGET_UART_PORT->ALTFUNCNUM_bit.PIN1 = 1;
-	RETARGET_UART_PORT->ALTFUNCSET = (1 << RETARGET_UART_PIN_TX_POS) |
-					 (1 << RETARGET_UART_PIN_RX_POS);
-	RCU->UARTCLKCFG[RETARGET_UART_NUM].UARTCLKCFG =
-		(uartclk_ref << RCU_UARTCLKCFG_CLKSEL_Pos) |
-		RCU_UARTCLKCFG_CLKEN_Msk | RCU_UARTCLKCFG_RSTDIS_Msk;
-	RETARGET_UART->IBRD = baud_icoef;
-	RETARGET_UART->FBRD = baud_fcoef;
-	RETARGET_UART->LCRH = UART_LCRH_FEN_Msk | (3 << UART_LCRH_WLEN_Pos);
-	RETARGET_UART->CR = UART_CR_TXE_Msk | UART_CR_RXE_Msk |
-			    UART_CR_UARTEN_Msk;
+	/* Log output is polled: no stream buffers, usable from any context */
+	const uart_config_t cfg = {
+		.baud = RETARGET_UART_BAUD,
+	};
+
+	uart_init(RETARGET_UART_NUM, &cfg);
 }
 
 int __io_putchar(int ch)
 {
-	while (RETARGET_UART->FR_bit.BUSY) {
-	};
-	RETARGET_UART->DR = ch;
+	int (*out)(int ch) = retarget_putc;
+
+	if (out)
+		return out(ch);
+	uart_putc_polled(RETARGET_UART_NUM, ch);
 	return ch;
 }
 
 int __io_getchar()
 {
-	while (RETARGET_UART->FR_bit.RXFE) {
-	};
-	return (int)RETARGET_UART->DR_bit.DATA;
+	return uart_getc_polled(RETARGET_UART_NUM);
+}
+
+void retarget_redirect(int (*out)(int ch))
+{
+	retarget_putc = out;
+}
+
+void retarget_write_buf(buf_t *b)
+{
+	for (const buf_t *seg = b; seg; seg = seg->next)
+		for (uint16_t i = 0; i < seg->len; i++)
+			__io_putchar(seg->data[i]);
+	buf_free(b);
 }
@@ -0,0 +1,179 @@
+#ifndef __lzs_h__
+#define __lzs_h__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "buf.h"
+#include "uart.h"
+
+/*! CPP guard */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Compressed stream switch of the application, set by the
+ * LZS_ENABLE CMake option. The library itself is always built.
+ */
+#ifndef LZS_ENABLE
+#define LZS_ENABLE 0
+#endif
+
+/** @brief History matches may reach back into, at most 65535 */
+#ifndef LZS_WINDOW
+#define LZS_WINDOW 2048
+#endif
+/** @brief Uncompressed bytes per frame */
+#ifndef LZS_BLOCK
+#define LZS_BLOCK 512
+#endif
+/** @brief Match finder table, 2^bits entries of 2 bytes */
+#ifndef LZS_HASH_BITS
+#define LZS_HASH_BITS 10
+#endif
+/** @brief Frames between history resets, for decoders joining late */
+#ifndef LZS_RESET_EVERY
+#define LZS_RESET_EVERY 32
+#endif
+/** @brief Longest time data waits in a frame under steady input */
+#ifndef LZS_LATENCY_MS
+#define LZS_LATENCY_MS 100
+#endif
+/** @brief Byte FIFO of lzs_putc(), drained by the stream task */
+#ifndef LZS_PUTC_FIFO
+#define LZS_PUTC_FIFO 512
+#endif
+/** @brief Buffers queued to the stream task */
+#define LZS_QUEUE_LEN 16
+
+#define LZS_MIN_MATCH 4
+/** @brief Worst case compressed size of n bytes */
+#define LZS_BOUND(n) ((n) + (n) / 255 + 16)
+
+/**
+ * @brief Stream format, all integers little endian.
+ *
+ * Frame: 0xA7, u16 len, body of len bytes, u16 Fletcher-16 of body.
+ * Body: u8 flags, u8 seq, u16 raw_len, compressed data.
+ *
+ * The data is a run of LZ4 style sequences: token (literal count in
+ * the high nibble, match length - 4 in the low one, 15 meaning more
+ * length bytes of up to 255 follow), literals, u16 match offset,
+ * extra match length. The last sequence of a frame stops after its
+ * literals. Offsets reach into the previous frames' output, at most
+ * LZS_WINDOW bytes back; a frame with LZS_FLAG_RESET refers to
+ * nothing before it. A seq gap means a lost frame: skip up to the
+ * next reset frame.
+ */
+#define LZS_SYNC 0xA7
+#define LZS_FLAG_RESET 0x01
+
+/** @brief Encoder state, a fixed window plus the match finder */
+typedef struct {
+	uint8_t win[LZS_WINDOW + LZS_BLOCK];
+	uint16_t head[1 << LZS_HASH_BITS]; /**< last position + 1, 0 none */
+	uint16_t hist; /**< history bytes in front of the pending ones */
+	uint16_t pend;
+} lzs_enc_t;
+
+typedef struct {
+	uint8_t win[LZS_WINDOW + LZS_BLOCK];
+	uint16_t hist;
+} lzs_dec_t;
+
+/** @brief Forget history and pending input */
+void lzs_enc_reset(lzs_enc_t *e);
+
+/**
+ * @brief Append input to the pending block.
+ * @return Bytes taken, short once LZS_BLOCK bytes are pending
+ */
+size_t lzs_enc_put(lzs_enc_t *e, const void *data, size_t len);
+
+static inline size_t lzs_enc_pending(const lzs_enc_t *e)
+{
+	return e->pend;
+}
+
+/**
+ * @brief Compress the pending block.
+ * @param out LZS_BOUND(LZS_BLOCK) bytes
+ * @param reset Refer to nothing before this block
+ * @return Compressed length, 0 with nothing pending
+ */
+size_t lzs_enc_flush(lzs_enc_t *e, uint8_t *out, int reset);
+
+static inline void lzs_dec_reset(lzs_dec_t *d)
+{
+	d->hist = 0;
+}
+
+/**
+ * @brief Decompress one block.
+ * @param out Set to the output, valid until the next call
+ * @return Output length, -1 on corrupt input
+ */
+int lzs_dec_block(lzs_dec_t *d, const uint8_t *in, size_t len,
+		  const uint8_t **out);
+
+typedef struct {
+	uint32_t in_bytes; /**< bytes compressed */
+	uint32_t out_bytes; /**< frame bytes sent */
+	uint32_t frames;
+	uint32_t dropped; /**< frames lost: no buffer or the port stayed busy */
+	uint32_t in_dropped; /**< input refused: queue or FIFO full */
+	uint32_t cpb_x100; /**< compression cycles per input byte, x100 */
+} lzs_stats_t;
+
+/**
+ * @brief Start the stream task on a UART.
+ * @param port UART to send on, opened here, with DMA where it has it
+ * @param baud Port speed
+ * @param idle_ms Input pause that closes a frame
+ * @param prio Stream task priority, below the producers
+ * @return 0 on success, -1 on UART or task failure
+ *
+ * Input from any number of tasks is framed in arrival order, a buffer
+ * is never split by another one. A frame closes when LZS_BLOCK bytes
+ * are pending, after idle_ms without input, or LZS_LATENCY_MS after
+ * its first byte. A lost frame resets the history of the next one.
+ */
+int lzs_start(uart_port_t port, uint32_t baud, uint32_t idle_ms,
+	      uint32_t prio);
+
+/**
+ * @brief Queue a buffer chain, taking over the reference.
+ * @return Bytes queued, 0 if the queue stayed full; tasks only
+ *
+ * Same contract as uart_write_buf(), so it can stand in as a sink.
+ */
+size_t lzs_write_buf(buf_t *b, TickType_t timeout);
+
+/** @brief Copy data into pool buffers and queue it, tasks only */
+size_t lzs_write(const void *data, size_t len, TickType_t timeout);
+
+/**
+ * @brief Queue one byte, any context, never blocks.
+ *
+ * For the log (retarget_redirect()): bytes wait in a FIFO until
+ * the stream task wakes, at the latest after idle_ms.
+ * @return ch, or -1 when the FIFO is full and the byte is lost
+ */
+int lzs_putc(int ch);
+
+void lzs_get_stats(lzs_stats_t *stats);
+
+/**
+ * @brief Compress log and telemetry style data, print ratio and speed.
+ *
+ * Output lines are "bench,lzs,<corpus>_ratio_x100,<in/out>" and
+ * "bench,lzs,<corpus>_{enc,dec}_cpb_x100,<cycles per byte>".
+ * @return 0, -1 if a block did not decompress to its input
+ */
+int lzs_bench(void);
+
+#ifdef __cplusplus
+}
+#endif /* End of CPP guard */
+
+#endif //__lzs_h__
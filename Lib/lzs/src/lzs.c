@@ -0,0 +1,188 @@
+#include <string.h>
+#include "lzs.h"
+
+#if LZS_WINDOW > 0xFFFF || LZS_WINDOW + LZS_BLOCK > 0xFFFF
+#error "LZS_WINDOW and LZS_BLOCK must keep positions in 16 bits"
+#endif
+
+#define LZS_RUN 15
+
+static inline uint32_t lzs_read32(const uint8_t *p)
+{
+	uint32_t v;
+
+	memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+static inline uint32_t lzs_hash(const uint8_t *p)
+{
+	return (lzs_read32(p) * 2654435761u) >> (32 - LZS_HASH_BITS);
+}
+
+static uint8_t *lzs_len(uint8_t *op, uint32_t n)
+{
+	while (n >= 255) {
+		*op++ = 255;
+		n -= 255;
+	}
+	*op++ = (uint8_t)n;
+	return op;
+}
+
+/** @brief One sequence, mlen 0 for the closing literals */
+static uint8_t *lzs_seq(uint8_t *op, const uint8_t *lit, uint32_t nlit,
+			uint32_t off, uint32_t mlen)
+{
+	uint8_t *token = op++;
+	uint32_t m = mlen ? mlen - LZS_MIN_MATCH : 0;
+
+	*token = (uint8_t)((nlit < LZS_RUN ? nlit : LZS_RUN) << 4 |
+			   (m < LZS_RUN ? m : LZS_RUN));
+	if (nlit >= LZS_RUN)
+		op = lzs_len(op, nlit - LZS_RUN);
+	memcpy(op, lit, nlit);
+	op += nlit;
+	if (mlen == 0)
+		return op;
+	*op++ = (uint8_t)off;
+	*op++ = (uint8_t)(off >> 8);
+	if (m >= LZS_RUN)
+		op = lzs_len(op, m - LZS_RUN);
+	return op;
+}
+
+void lzs_enc_reset(lzs_enc_t *e)
+{
+	memset(e->head, 0, sizeof(e->head));
+	e->hist = 0;
+	e->pend = 0;
+}
+
+size_t lzs_enc_put(lzs_enc_t *e, const void *data, size_t len)
+{
+	size_t n = LZS_BLOCK - e->pend;
+
+	if (len < n)
+		n = len;
+	memcpy(e->win + e->hist + e->pend, data, n);
+	e->pend += (uint16_t)n;
+	return n;
+}
+
+/** @brief Keep the last LZS_WINDOW bytes, positions move down */
+static void lzs_enc_slide(lzs_enc_t *e)
+{
+	uint32_t d = e->hist - LZS_WINDOW;
+
+	memmove(e->win, e->win + d, LZS_WINDOW);
+	for (uint32_t i = 0; i < (1u << LZS_HASH_BITS); i++)
+		e->head[i] = e->head[i] > d ? (uint16_t)(e->head[i] - d) : 0;
+	e->hist = LZS_WINDOW;
+}
+
+/*
+ * Greedy parse with a single candidate per hash, like LZ4's fast
+ * mode; positions inside a match are hashed too, which costs a few
+ * cycles per byte and pays off on repeated log lines.
+ */
+size_t lzs_enc_flush(lzs_enc_t *e, uint8_t *out, int reset)
+{
+	const uint8_t *w = e->win;
+	uint32_t i = e->hist, end = e->hist + e->pend, lit = i;
+	uint8_t *op = out;
+
+	if (e->pend == 0)
+		return 0;
+	if (reset)
+		memset(e->head, 0, sizeof(e->head));
+
+	while (i + LZS_MIN_MATCH <= end) {
+		uint32_t h = lzs_hash(w + i), c = e->head[h], len;
+
+		e->head[h] = (uint16_t)(i + 1);
+		if (c-- == 0 || i - c > LZS_WINDOW ||
+		    lzs_read32(w + c) != lzs_read32(w + i)) {
+			i++;
+			continue;
+		}
+		len = LZS_MIN_MATCH;
+		while (i + len < end && w[c + len] == w[i + len])
+			len++;
+		op = lzs_seq(op, w + lit, i - lit, i - c, len);
+		for (uint32_t j = i + 1, k = i + len; j < k; j++)
+			if (j + LZS_MIN_MATCH <= end)
+				e->head[lzs_hash(w + j)] = (uint16_t)(j + 1);
+		i += len;
+		lit = i;
+	}
+	if (lit < end)
+		op = lzs_seq(op, w + lit, end - lit, 0, 0);
+
+	e->hist = (uint16_t)end;
+	e->pend = 0;
+	if (e->hist > LZS_WINDOW)
+		lzs_enc_slide(e);
+	return (size_t)(op - out);
+}
+
+static int lzs_dec_len(const uint8_t **ip, const uint8_t *end, uint32_t *n)
+{
+	uint8_t b;
+
+	do {
+		if (*ip == end)
+			return -1;
+		b = *(*ip)++;
+		*n += b;
+	} while (b == 255);
+	return 0;
+}
+
+int lzs_dec_block(lzs_dec_t *d, const uint8_t *in, size_t len,
+		  const uint8_t **out)
+{
+	const uint8_t *ip = in, *end = in + len;
+	uint8_t *base, *op, *lim;
+
+	if (d->hist > LZS_WINDOW) {
+		memmove(d->win, d->win + d->hist - LZS_WINDOW, LZS_WINDOW);
+		d->hist = LZS_WINDOW;
+	}
+	base = d->win + d->hist;
+	op = base;
+	lim = base + LZS_BLOCK;
+
+	while (ip < end) {
+		uint8_t token = *ip++;
+		uint32_t nlit = token >> 4, m = token & LZS_RUN, off;
+
+		if (nlit == LZS_RUN && lzs_dec_len(&ip, end, &nlit) != 0)
+			return -1;
+		if (nlit > (uint32_t)(end - ip) || nlit > (uint32_t)(lim - op))
+			return -1;
+		memcpy(op, ip, nlit);
+		op += nlit;
+		ip += nlit;
+		if (ip == end)
+			break;
+
+		if (end - ip < 2)
+			return -1;
+		off = ip[0] | (uint32_t)ip[1] << 8;
+		ip += 2;
+		if (m == LZS_RUN && lzs_dec_len(&ip, end, &m) != 0)
+			return -1;
+		m += LZS_MIN_MATCH;
+		if (off == 0 || off > LZS_WINDOW ||
+		    off > (uint32_t)(op - d->win) || m > (uint32_t)(lim - op))
+			return -1;
+		/* Byte by byte: a match may overlap its own output */
+		for (const uint8_t *s = op - off; m--;)
+			*op++ = *s++;
+	}
+
+	*out = base;
+	d->hist = (uint16_t)(op - d->win);
+	return (int)(op - base);
+}
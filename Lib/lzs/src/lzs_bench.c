@@ -0,0 +1,104 @@
+#include <stdio.h>
+#include <string.h>
+#include "lzs.h"
+#include "riscv-csr.h"
+
+#define LZS_BENCH_LEN (16 * 1024)
+
+static uint8_t bench_in[LZS_BENCH_LEN];
+static uint8_t bench_out[LZS_BOUND(LZS_BLOCK)];
+static lzs_enc_t bench_enc;
+static lzs_dec_t bench_dec;
+
+static uint32_t bench_rand(uint32_t *seed)
+{
+	*seed = *seed * 1103515245 + 12345;
+	return *seed >> 16;
+}
+
+/** @brief Log lines as the FINFO() macros print them */
+static void lzs_bench_log(void)
+{
+	static const char *const msg[] = {
+		"AppMain.c:%u INFO: adc ch%u = %u mV\r\n",
+		"Lib/clk/src/clk.c:%u INFO: governor %u%% load, %u MHz\r\n",
+		"Lib/uart/src/uart.c:%u WARNING: port %u rx dropped %u\r\n",
+	};
+	uint32_t seed = 1, n = 0;
+
+	while (n < LZS_BENCH_LEN) {
+		char line[96];
+		int k = snprintf(line, sizeof(line),
+				 msg[bench_rand(&seed) % 3],
+				 100 + bench_rand(&seed) % 300,
+				 bench_rand(&seed) % 8,
+				 1000 + bench_rand(&seed) % 2000);
+
+		for (int i = 0; i < k && n < LZS_BENCH_LEN; i++)
+			bench_in[n++] = (uint8_t)line[i];
+	}
+}
+
+/** @brief Varint deltas of slowly moving values, like Lib/telem */
+static void lzs_bench_telem(void)
+{
+	uint32_t seed = 7;
+
+	for (uint32_t i = 0; i < LZS_BENCH_LEN; i++) {
+		uint32_t r = bench_rand(&seed);
+
+		bench_in[i] = (uint8_t)(i % 24 < 4 ? r : r % 5);
+	}
+}
+
+static int lzs_bench_run(const char *name)
+{
+	uint32_t enc = 0, dec = 0, out = 0, c0;
+	const uint8_t *p;
+	int n;
+
+	lzs_enc_reset(&bench_enc);
+	for (uint32_t off = 0, blk = 0; off < LZS_BENCH_LEN;
+	     off += LZS_BLOCK, blk++) {
+		int reset = blk % LZS_RESET_EVERY == 0;
+		size_t len;
+
+		lzs_enc_put(&bench_enc, bench_in + off, LZS_BLOCK);
+		c0 = csr_read_mcycle();
+		len = lzs_enc_flush(&bench_enc, bench_out, reset);
+		enc += csr_read_mcycle() - c0;
+
+		if (reset)
+			lzs_dec_reset(&bench_dec);
+		c0 = csr_read_mcycle();
+		n = lzs_dec_block(&bench_dec, bench_out, len, &p);
+		dec += csr_read_mcycle() - c0;
+		if (n != LZS_BLOCK || memcmp(p, bench_in + off, LZS_BLOCK))
+			return -1;
+		out += (uint32_t)len;
+	}
+
+	printf("bench,lzs,%s_ratio_x100,%lu\r\n", name,
+	       (unsigned long)((uint64_t)LZS_BENCH_LEN * 100 / out));
+	printf("bench,lzs,%s_enc_cpb_x100,%lu\r\n", name,
+	       (unsigned long)((uint64_t)enc * 100 / LZS_BENCH_LEN));
+	printf("bench,lzs,%s_dec_cpb_x100,%lu\r\n", name,
+	       (unsigned long)((uint64_t)dec * 100 / LZS_BENCH_LEN));
+	return 0;
+}
+
+int lzs_bench(void)
+{
+	uint32_t seed = 3;
+
+	lzs_bench_log();
+	if (lzs_bench_run("log") != 0)
+		return -1;
+	lzs_bench_telem();
+	if (lzs_bench_run("telem") != 0)
+		return -1;
+	/* Worst case: nothing to find, every byte a literal */
+	for (uint32_t i = 0; i < LZS_BENCH_LEN; i++)
+		bench_in[i] = (uint8_t)bench_rand(&seed);
+	return lzs_bench_run("random");
+}
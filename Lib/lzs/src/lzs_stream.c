@@ -0,0 +1,269 @@
+#include <string.h>
+#include "lzs.h"
+#include "ring.h"
+#include "riscv-csr.h"
+#include "riscv-irq.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+/** @brief Sync, length and the fixed part of the body */
+#define LZS_HDR_LEN (1 + 2 + 1 + 1 + 2)
+#define LZS_SUM_LEN 2
+/** @brief Pieces of lzs_write(), a plentiful buffer class */
+#define LZS_CHUNK 256
+
+/* FIFO positions run freely and wrap */
+#if LZS_PUTC_FIFO & (LZS_PUTC_FIFO - 1)
+#error "LZS_PUTC_FIFO must be a power of two"
+#endif
+
+static uart_port_t lzs_port;
+static uint32_t lzs_idle_ms;
+static uint8_t lzs_running;
+
+/* Producers to the stream task */
+static ring_mpsc_t lzs_q;
+static ring_cell_t lzs_cells[LZS_QUEUE_LEN];
+static uint8_t lzs_fifo[LZS_PUTC_FIFO];
+static uint32_t lzs_fifo_head; /**< stream task position */
+static uint32_t lzs_fifo_tail; /**< lzs_putc() position */
+
+/* Stream task only */
+static lzs_enc_t lzs_enc;
+static uint8_t lzs_out[LZS_BOUND(LZS_BLOCK)];
+static TickType_t lzs_first; /**< arrival of the oldest pending byte */
+static uint8_t lzs_seq;
+static uint8_t lzs_reset = 1;
+static uint32_t lzs_since_reset;
+
+static uint64_t lzs_cycles;
+static lzs_stats_t lzs_st;
+
+static uint16_t lzs_fletcher16(const uint8_t *p, size_t n)
+{
+	uint32_t a = 0, b = 0;
+
+	while (n--) {
+		a = (a + *p++) % 255;
+		b = (b + a) % 255;
+	}
+	return (uint16_t)(b << 8 | a);
+}
+
+static void lzs_count(uint32_t *counter, uint32_t n)
+{
+	uint32_t mie = irq_save();
+
+	*counter += n;
+	irq_restore(mie);
+}
+
+/**
+ * @brief Compress the pending block into a frame and send it.
+ *
+ * A frame that does not make it out leaves the decoder without its
+ * bytes, so the next one starts over without history.
+ */
+static void lzs_send(void)
+{
+	uint32_t raw = (uint32_t)lzs_enc_pending(&lzs_enc), c0, n, len, mie;
+	uint8_t *p;
+	uint16_t f;
+	buf_t *b;
+
+	c0 = csr_read_mcycle();
+	n = (uint32_t)lzs_enc_flush(&lzs_enc, lzs_out, lzs_reset);
+	c0 = csr_read_mcycle() - c0;
+
+	len = 1 + 1 + 2 + n;
+	b = buf_alloc(LZS_HDR_LEN + n + LZS_SUM_LEN);
+	if (b != NULL) {
+		p = buf_put(b, LZS_HDR_LEN + n + LZS_SUM_LEN);
+		p[0] = LZS_SYNC;
+		p[1] = (uint8_t)len;
+		p[2] = (uint8_t)(len >> 8);
+		p[3] = lzs_reset ? LZS_FLAG_RESET : 0;
+		p[4] = lzs_seq;
+		p[5] = (uint8_t)raw;
+		p[6] = (uint8_t)(raw >> 8);
+		memcpy(p + LZS_HDR_LEN, lzs_out, n);
+		f = lzs_fletcher16(p + 3, len);
+		p[LZS_HDR_LEN + n] = (uint8_t)f;
+		p[LZS_HDR_LEN + n + 1] = (uint8_t)(f >> 8);
+	}
+	lzs_seq++;
+
+	if (b == NULL ||
+	    uart_write_buf(lzs_port, b, pdMS_TO_TICKS(LZS_LATENCY_MS)) == 0) {
+		lzs_count(&lzs_st.dropped, 1);
+		lzs_reset = 1;
+		return;
+	}
+	mie = irq_save();
+	lzs_st.frames++;
+	lzs_st.in_bytes += raw;
+	lzs_st.out_bytes += LZS_HDR_LEN + n + LZS_SUM_LEN;
+	lzs_cycles += c0;
+	irq_restore(mie);
+
+	lzs_reset = ++lzs_since_reset >= LZS_RESET_EVERY;
+	if (lzs_reset)
+		lzs_since_reset = 0;
+}
+
+static void lzs_feed(const uint8_t *data, size_t len)
+{
+	while (len) {
+		size_t n;
+
+		if (lzs_enc_pending(&lzs_enc) == 0)
+			lzs_first = xTaskGetTickCount();
+		n = lzs_enc_put(&lzs_enc, data, len);
+		data += n;
+		len -= n;
+		if (lzs_enc_pending(&lzs_enc) == LZS_BLOCK)
+			lzs_send();
+	}
+}
+
+/** @brief Move the lzs_putc() bytes into the encoder */
+static uint32_t lzs_drain(void)
+{
+	uint32_t tail = __atomic_load_n(&lzs_fifo_tail, __ATOMIC_ACQUIRE);
+	uint32_t n = tail - lzs_fifo_head;
+
+	while (lzs_fifo_head != tail) {
+		uint32_t at = lzs_fifo_head % LZS_PUTC_FIFO;
+		uint32_t k = tail - lzs_fifo_head;
+
+		if (k > LZS_PUTC_FIFO - at)
+			k = LZS_PUTC_FIFO - at;
+		lzs_feed(lzs_fifo + at, k);
+		__atomic_store_n(&lzs_fifo_head, lzs_fifo_head + k,
+				 __ATOMIC_RELEASE);
+	}
+	return n;
+}
+
+static void lzs_task(__attribute__((unused)) void *arg)
+{
+	while (1) {
+		void *item;
+		int got;
+		uint32_t n;
+
+		got = ring_mpsc_receive(&lzs_q, &item,
+					pdMS_TO_TICKS(lzs_idle_ms)) == RING_OK;
+		/* Log bytes first: they were written before the wakeup */
+		n = lzs_drain();
+		if (got) {
+			for (const buf_t *seg = item; seg; seg = seg->next)
+				lzs_feed(seg->data, seg->len);
+			buf_free(item);
+		}
+
+		if (lzs_enc_pending(&lzs_enc) &&
+		    ((!got && n == 0) ||
+		     xTaskGetTickCount() - lzs_first >=
+			     pdMS_TO_TICKS(LZS_LATENCY_MS)))
+			lzs_send();
+	}
+}
+
+size_t lzs_write_buf(buf_t *b, TickType_t timeout)
+{
+	size_t n = buf_total_len(b);
+	TimeOut_t to;
+
+	vTaskSetTimeOutState(&to);
+	while (lzs_running) {
+		if (ring_mpsc_push(&lzs_q, b, NULL) == RING_OK)
+			return n;
+		if (xTaskCheckForTimeOut(&to, &timeout) != pdFALSE)
+			break;
+		vTaskDelay(1);
+	}
+	buf_free(b);
+	lzs_count(&lzs_st.in_dropped, (uint32_t)n);
+	return 0;
+}
+
+size_t lzs_write(const void *data, size_t len, TickType_t timeout)
+{
+	const uint8_t *p = data;
+	size_t done = 0;
+
+	while (done < len) {
+		size_t n = len - done < LZS_CHUNK ? len - done : LZS_CHUNK;
+		buf_t *b = buf_alloc(n);
+
+		if (b == NULL) {
+			lzs_count(&lzs_st.in_dropped, (uint32_t)(len - done));
+			break;
+		}
+		memcpy(buf_put(b, n), p + done, n);
+		if (lzs_write_buf(b, timeout) == 0)
+			break;
+		done += n;
+	}
+	return done;
+}
+
+int lzs_putc(int ch)
+{
+	uint32_t mie = irq_save();
+	int ret = ch;
+
+	if (lzs_fifo_tail - __atomic_load_n(&lzs_fifo_head, __ATOMIC_ACQUIRE) <
+	    LZS_PUTC_FIFO) {
+		lzs_fifo[lzs_fifo_tail % LZS_PUTC_FIFO] = (uint8_t)ch;
+		__atomic_store_n(&lzs_fifo_tail, lzs_fifo_tail + 1,
+				 __ATOMIC_RELEASE);
+	} else {
+		lzs_st.in_dropped++;
+		ret = -1;
+	}
+	irq_restore(mie);
+	return ret;
+}
+
+void lzs_get_stats(lzs_stats_t *stats)
+{
+	uint32_t mie = irq_save();
+
+	*stats = lzs_st;
+	stats->cpb_x100 = lzs_st.in_bytes ?
+				  (uint32_t)(lzs_cycles * 100 /
+					     lzs_st.in_bytes) :
+				  0;
+	irq_restore(mie);
+}
+
+int lzs_start(uart_port_t port, uint32_t baud, uint32_t idle_ms,
+	      uint32_t prio)
+{
+	uart_config_t cfg = {
+		.baud = baud,
+		.tx_buf_size = 1024,
+		.rx_buf_size = 16,
+		.use_dma = 1,
+		.irq_prio = 1,
+	};
+
+	if (idle_ms == 0)
+		return -1;
+	/* Ports without TX DMA copy, slower but just as correct */
+	if (uart_init(port, &cfg) != 0) {
+		cfg.use_dma = 0;
+		if (uart_init(port, &cfg) != 0)
+			return -1;
+	}
+	lzs_port = port;
+	lzs_idle_ms = idle_ms;
+	lzs_enc_reset(&lzs_enc);
+	ring_mpsc_init(&lzs_q, lzs_cells, LZS_QUEUE_LEN);
+	if (xTaskCreate(lzs_task, "lzs", 256, NULL, prio, NULL) != pdPASS)
+		return -1;
+	lzs_running = 1;
+	return 0;
+}
@@ -0,0 +1,141 @@
+#ifndef __prof_h__
+#define __prof_h__
+
+#include <stdint.h>
+
+/*! CPP guard */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Cycle profiling switch, set by the PROF_ENABLE CMake option.
+ *
+ * With 0 every probe macro expands to nothing and the table is not
+ * linked.
+ */
+#ifndef PROF_ENABLE
+#define PROF_ENABLE 0
+#endif
+
+/** @brief Probes built into the libraries */
+#define PROF_PROBES(X)     \
+	X(dma_isr)         \
+	X(log)             \
+	X(flash_read)      \
+	X(flash_program)   \
+	X(flash_erase)
+
+/** @brief Application probes, define before including this header */
+#ifndef PROF_APP_PROBES
+#define PROF_APP_PROBES(X)
+#endif
+
+typedef enum {
+#define PROF_ID(name) PROF_ID_##name,
+	PROF_PROBES(PROF_ID) PROF_APP_PROBES(PROF_ID)
+#undef PROF_ID
+	PROF_ID_COUNT
+} prof_id_t;
+
+/** @brief Histogram bin n counts durations of [2^n, 2^(n+1)) cycles */
+#define PROF_HIST_BINS 24
+
+typedef struct {
+	uint32_t count;
+	uint32_t min;
+	uint32_t max;
+	uint64_t cycles;
+	uint64_t instret;
+	uint32_t hist[PROF_HIST_BINS];
+} prof_probe_t;
+
+#if PROF_ENABLE
+
+#include "riscv-csr.h"
+
+typedef struct {
+	uint32_t cycle;
+	uint32_t instret;
+	prof_id_t id;
+} prof_mark_t;
+
+void prof_record(prof_id_t id, uint32_t cycles, uint32_t instret);
+
+static inline prof_mark_t prof_begin(prof_id_t id)
+{
+	prof_mark_t m;
+
+	m.id = id;
+	m.instret = csr_read_minstret();
+	m.cycle = csr_read_mcycle();
+	return m;
+}
+
+static inline void prof_end(prof_mark_t *m)
+{
+	uint32_t cycle = csr_read_mcycle();
+	uint32_t instret = csr_read_minstret();
+
+	prof_record(m->id, cycle - m->cycle, instret - m->instret);
+}
+
+/** @brief Profile from here to the end of the enclosing block */
+#define PROF_SCOPE(name)                                 \
+	prof_mark_t prof_scope_##name                    \
+		__attribute__((cleanup(prof_end))) = prof_begin(PROF_ID_##name)
+
+/** @brief Explicit region, for code that is not one block */
+#define PROF_BEGIN(name) \
+	prof_mark_t prof_mark_##name = prof_begin(PROF_ID_##name)
+#define PROF_END(name) prof_end(&prof_mark_##name)
+
+/** @brief Copy one probe */
+void prof_get(prof_id_t id, prof_probe_t *probe);
+
+/** @brief Clear all probes */
+void prof_reset(void);
+
+/**
+ * @brief Print the table.
+ *
+ * One "prof,<name>,<count>,<min>,<avg>,<max>,<cycles>,<ipc_x100>"
+ * line and one "prof_hist,<name>,<bin0>,..." line per used probe.
+ * Durations exclude the probe's own overhead.
+ * @param reset Clear the table after printing
+ */
+void prof_dump(int reset);
+
+/**
+ * @brief Start a task that dumps and resets the table periodically.
+ * @return 0 on success, -1 if the task could not be created
+ */
+int prof_task_start(uint32_t period_ms, uint32_t prio);
+
+#else
+
+#define PROF_SCOPE(name) (void)0
+#define PROF_BEGIN(name) (void)0
+#define PROF_END(name) (void)0
+
+static inline void prof_reset(void)
+{
+}
+
+static inline void prof_dump(__attribute__((unused)) int reset)
+{
+}
+
+static inline int prof_task_start(__attribute__((unused)) uint32_t period_ms,
+				  __attribute__((unused)) uint32_t prio)
+{
+	return 0;
+}
+
+#endif /* PROF_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif /* End of CPP guard */
+
+#endif //__prof_h__
@@ -0,0 +1,120 @@
+#include "prof.h"
+
+#if PROF_ENABLE
+
+#include <stdio.h>
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+static const char *const prof_names[PROF_ID_COUNT] = {
+#define PROF_NAME(name) #name,
+	PROF_PROBES(PROF_NAME) PROF_APP_PROBES(PROF_NAME)
+#undef PROF_NAME
+};
+
+static prof_probe_t prof_table[PROF_ID_COUNT];
+/** @brief Cycles of an empty scope, subtracted from every sample */
+static uint32_t prof_overhead;
+static uint32_t prof_period_ms;
+
+void prof_record(prof_id_t id, uint32_t cycles, uint32_t instret)
+{
+	prof_probe_t *p = &prof_table[id];
+	uint32_t bin, mie;
+
+	cycles = cycles > prof_overhead ? cycles - prof_overhead : 0;
+	bin = cycles ? 31 - __builtin_clz(cycles) : 0;
+	if (bin >= PROF_HIST_BINS)
+		bin = PROF_HIST_BINS - 1;
+
+	mie = irq_save();
+	if (p->count == 0 || cycles < p->min)
+		p->min = cycles;
+	if (cycles > p->max)
+		p->max = cycles;
+	p->count++;
+	p->cycles += cycles;
+	p->instret += instret;
+	p->hist[bin]++;
+	irq_restore(mie);
+}
+
+static void prof_calibrate(void)
+{
+	uint32_t best = UINT32_MAX;
+
+	/* Minimum of a few runs: first ones pay for cache/pipeline warmup */
+	for (uint32_t i = 0; i < 8; i++) {
+		prof_mark_t m = prof_begin(PROF_ID_COUNT);
+		uint32_t d = csr_read_mcycle() - m.cycle;
+
+		if (d < best)
+			best = d;
+	}
+	prof_overhead = best;
+}
+
+void prof_get(prof_id_t id, prof_probe_t *probe)
+{
+	uint32_t mie = irq_save();
+
+	*probe = prof_table[id];
+	irq_restore(mie);
+}
+
+void prof_reset(void)
+{
+	uint32_t mie = irq_save();
+
+	memset(prof_table, 0, sizeof(prof_table));
+	irq_restore(mie);
+}
+
+void prof_dump(int reset)
+{
+	prof_probe_t p;
+
+	if (prof_overhead == 0)
+		prof_calibrate();
+
+	printf("prof,name,count,min,avg,max,cycles,ipc_x100\r\n");
+	for (uint32_t id = 0; id < PROF_ID_COUNT; id++) {
+		prof_get(id, &p);
+		if (p.count == 0)
+			continue;
+		printf("prof,%s,%lu,%lu,%lu,%lu,%llu,%lu\r\n", prof_names[id],
+		       (unsigned long)p.count, (unsigned long)p.min,
+		       (unsigned long)(p.cycles / p.count),
+		       (unsigned long)p.max, (unsigned long long)p.cycles,
+		       (unsigned long)(p.cycles ? p.instret * 100 / p.cycles :
+						  0));
+		printf("prof_hist,%s", prof_names[id]);
+		for (uint32_t b = 0; b < PROF_HIST_BINS; b++)
+			printf(",%lu", (unsigned long)p.hist[b]);
+		printf("\r\n");
+	}
+	if (reset)
+		prof_reset();
+}
+
+static void prof_task(__attribute__((unused)) void *arg)
+{
+	TickType_t last = xTaskGetTickCount();
+
+	while (1) {
+		vTaskDelayUntil(&last, pdMS_TO_TICKS(prof_period_ms));
+		prof_dump(1);
+	}
+}
+
+int prof_task_start(uint32_t period_ms, uint32_t prio)
+{
+	prof_calibrate();
+	prof_period_ms = period_ms;
+	if (xTaskCreate(prof_task, "prof", 256, NULL, prio, NULL) != pdPASS)
+		return -1;
+	return 0;
+}
+
+#endif /* PROF_ENABLE */
@@ -0,0 +1,119 @@
+#ifndef __flash_blk_h__
+#define __flash_blk_h__
+
+#include "flash_dev.h"
+#include "buf.h"
+
+/*! CPP guard */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Block view of a flash region.
+ *
+ * A block is one erase sector; writing a block erases it first.
+ */
+typedef struct {
+	flash_dev_t *dev;
+	uint32_t base;
+	uint32_t blocks;
+} flash_blk_t;
+
+/**
+ * @brief Streaming access to a flash region.
+ *
+ * Reads are served from a read-ahead buffer refilled in large
+ * (DMA sized) chunks. Writes are gathered into whole pages and
+ * sectors are erased as the stream enters them.
+ */
+typedef struct {
+	flash_dev_t *dev;
+	uint32_t base;
+	uint32_t size;
+	uint32_t pos;
+	uint8_t *buf;
+	uint32_t buf_size;
+	uint32_t buf_addr; /**< flash address of buf[0] */
+	uint32_t buf_len; /**< valid read-ahead bytes / gathered write bytes */
+	uint32_t erased; /**< flash address up to which sectors are erased */
+	uint8_t writing;
+} flash_stream_t;
+
+/**
+ * @brief Set up block view.
+ * @return FLASH_OK, FLASH_ERR_PARAM on unaligned or oversized region
+ */
+int flash_blk_init(flash_blk_t *blk, flash_dev_t *dev, uint32_t base,
+		   uint32_t size);
+
+/** @brief Block size in bytes */
+static inline uint32_t flash_blk_size(const flash_blk_t *blk)
+{
+	return blk->dev->sector_size;
+}
+
+int flash_blk_read(flash_blk_t *blk, uint32_t lba, void *buf,
+		   uint32_t count);
+int flash_blk_write(flash_blk_t *blk, uint32_t lba, const void *buf,
+		    uint32_t count);
+int flash_blk_erase(flash_blk_t *blk, uint32_t lba, uint32_t count);
+
+/**
+ * @brief Open a stream over [base, base + size).
+ * @param buf Work buffer, a multiple of the page size
+ *
+ * For writing, base must be sector aligned.
+ */
+int flash_stream_open(flash_stream_t *s, flash_dev_t *dev, uint32_t base,
+		      uint32_t size, uint8_t *buf, uint32_t buf_size);
+
+/** @brief Read up to len bytes, returns bytes read or error code */
+int flash_stream_read(flash_stream_t *s, void *dst, uint32_t len);
+
+/** @brief Append len bytes, returns bytes written or error code */
+int flash_stream_write(flash_stream_t *s, const void *src, uint32_t len);
+
+/**
+ * @brief Append a buffer chain, taking over the caller's reference.
+ * @return Bytes written or error code, the reference is dropped either way
+ */
+int flash_stream_write_buf(flash_stream_t *s, buf_t *b);
+
+/** @brief Reposition a read stream */
+int flash_stream_seek(flash_stream_t *s, uint32_t pos);
+
+/**
+ * @brief Program gathered data.
+ *
+ * The last page is padded with 0xFF, following writes continue
+ * at the next page boundary.
+ */
+int flash_stream_flush(flash_stream_t *s);
+
+/** @brief Sustained throughput figures, bytes per second */
+typedef struct {
+	uint32_t read_bps;
+	uint32_t write_bps;
+	uint32_t erase_bps;
+} flash_bench_t;
+
+/**
+ * @brief Measure sustained read/program/erase throughput.
+ * @param dev Device under test
+ * @param addr Sector aligned scratch region, its contents are lost
+ * @param len Scratch region length, multiple of the sector size
+ * @param buf Work buffer
+ * @param buf_size Work buffer size, multiple of the page size
+ * @param res Results
+ *
+ * Prints one machine readable line per figure in MB/s.
+ */
+int flash_bench(flash_dev_t *dev, uint32_t addr, uint32_t len, uint8_t *buf,
+		uint32_t buf_size, flash_bench_t *res);
+
+#ifdef __cplusplus
+}
+#endif /* End of CPP guard */
+
+#endif //__flash_blk_h__
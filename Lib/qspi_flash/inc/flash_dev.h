@@ -0,0 +1,137 @@
+#ifndef __flash_dev_h__
+#define __flash_dev_h__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "prof.h"
+
+/*! CPP guard */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FLASH_OK 0
+#define FLASH_ERR_PARAM -1
+#define FLASH_ERR_TIMEOUT -2
+#define FLASH_ERR_BUSY -3
+#define FLASH_ERR_IO -4
+
+typedef struct flash_dev flash_dev_t;
+
+/** @brief Erase completion callback, runs in timer service task context */
+typedef void (*flash_done_t)(flash_dev_t *dev, int status, void *arg);
+
+/**
+ * @brief Operations of a NOR flash device.
+ *
+ * program() never crosses a page boundary, erase_start() takes
+ * sector aligned ranges and returns as soon as the erase runs.
+ */
+typedef struct {
+	int (*read)(flash_dev_t *dev, uint32_t addr, void *buf, size_t len);
+	int (*program)(flash_dev_t *dev, uint32_t addr, const void *buf,
+		       size_t len);
+	int (*erase_start)(flash_dev_t *dev, uint32_t addr, uint32_t len,
+			   flash_done_t done, void *arg);
+	int (*wait_idle)(flash_dev_t *dev, TickType_t timeout);
+} flash_dev_ops_t;
+
+/**
+ * @brief NOR flash device.
+ *
+ * mmap is the base of a memory mapped read window, NULL when the
+ * device can only be read through ops->read().
+ */
+struct flash_dev {
+	const flash_dev_ops_t *ops;
+	uint32_t size;
+	uint32_t page_size;
+	uint32_t sector_size;
+	const volatile uint8_t *mmap;
+	void *priv;
+};
+
+static inline int flash_read(flash_dev_t *dev, uint32_t addr, void *buf,
+			     size_t len)
+{
+	PROF_SCOPE(flash_read);
+
+	return dev->ops->read(dev, addr, buf, len);
+}
+
+/**
+ * @brief Program a range, splitting it on page boundaries.
+ * @return FLASH_OK or error code
+ */
+int flash_program(flash_dev_t *dev, uint32_t addr, const void *buf,
+		  size_t len);
+
+/**
+ * @brief Erase a sector aligned range and wait for completion.
+ * @return FLASH_OK or error code
+ */
+int flash_erase(flash_dev_t *dev, uint32_t addr, uint32_t len,
+		TickType_t timeout);
+
+/**
+ * @brief Start erase of a sector aligned range.
+ * @param done Called once the whole range is erased, may be NULL
+ * @return FLASH_OK if started
+ */
+static inline int flash_erase_async(flash_dev_t *dev, uint32_t addr,
+				    uint32_t len, flash_done_t done,
+				    void *arg)
+{
+	return dev->ops->erase_start(dev, addr, len, done, arg);
+}
+
+/**
+ * @brief Wait for a running erase to finish.
+ * @return Status of the last erase, FLASH_ERR_TIMEOUT if still running
+ */
+static inline int flash_wait_idle(flash_dev_t *dev, TickType_t timeout)
+{
+	return dev->ops->wait_idle(dev, timeout);
+}
+
+/**
+ * @brief Initialize a RAM backed emulation of a NOR flash.
+ * @param dev Device to fill
+ * @param mem Backing storage of size bytes
+ * @param size Device size, multiple of sector_size
+ * @param page_size Program page size
+ * @param sector_size Erase sector size
+ *
+ * Follows NOR semantics: program can only clear bits, erase sets
+ * a whole sector to 0xFF and page crossing programs are rejected.
+ * The block layer is tested against it on the host build.
+ */
+void flash_emu_init(flash_dev_t *dev, uint8_t *mem, uint32_t size,
+		    uint32_t page_size, uint32_t sector_size);
+
+/**
+ * @brief Internal flash of the MCU (target build only).
+ *
+ * Whole 1 MB main region, memory mapped. Program takes bus word
+ * multiples at bus word aligned addresses; erase works on pages.
+ * Both busy wait: keep them out of the pages the caller runs from.
+ */
+void flash_int_init(flash_dev_t *dev);
+
+/**
+ * @brief Emulated NOR flash backed by a host file (host build only).
+ * @param path Image file, created or resized to size bytes
+ * @return FLASH_OK or FLASH_ERR_IO
+ *
+ * Same semantics as flash_emu_init(); the contents survive runs,
+ * bytes added to the file read as erased.
+ */
+int flash_file_init(flash_dev_t *dev, const char *path, uint32_t size,
+		    uint32_t page_size, uint32_t sector_size);
+
+#ifdef __cplusplus
+}
+#endif /* End of CPP guard */
+
+#endif //__flash_dev_h__
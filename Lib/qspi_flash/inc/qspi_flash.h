@@ -0,0 +1,40 @@
+#ifndef __qspi_flash_h__
+#define __qspi_flash_h__
+
+#include "flash_dev.h"
+
+/*! CPP guard */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Standard SPI NOR geometry */
+#define QSPI_FLASH_PAGE_SIZE 256
+#define QSPI_FLASH_SECTOR_SIZE 4096
+
+typedef struct {
+	uint32_t clk_div; /**< SCK = QSPI kernel clock / clk_div */
+	uint8_t use_dma; /**< move data phases larger than a FIFO by DMA */
+} qspi_flash_config_t;
+
+/**
+ * @brief Probe the external flash and fill the device descriptor.
+ * @param dev Device descriptor to fill
+ * @param cfg Controller configuration
+ * @return FLASH_OK, FLASH_ERR_IO if no flash answers
+ *
+ * Reads JEDEC ID to size the device, sets the Quad Enable bit and
+ * switches reads to Fast Read Quad I/O (0xEB) and programs to Quad
+ * Page Program (0x32). Must be called from a task, after the board
+ * code has routed the QSPI pins (SCK, CS, IO0-IO3) to the controller.
+ */
+int qspi_flash_init(flash_dev_t *dev, const qspi_flash_config_t *cfg);
+
+/** @brief JEDEC manufacturer/type/capacity read during init */
+uint32_t qspi_flash_jedec_id(void);
+
+#ifdef __cplusplus
+}
+#endif /* End of CPP guard */
+
+#endif //__qspi_flash_h__
@@ -0,0 +1,59 @@
+#include <stdio.h>
+#include "flash_blk.h"
+#include "task.h"
+
+static uint32_t flash_bench_rate(uint32_t bytes, TickType_t ticks)
+{
+	uint64_t ms = (uint64_t)ticks * 1000 / configTICK_RATE_HZ;
+
+	if (ms == 0)
+		ms = 1;
+	return (uint32_t)((uint64_t)bytes * 1000 / ms);
+}
+
+static void flash_bench_print(const char *name, uint32_t bps)
+{
+	printf("bench,flash,%s_MBps,%lu.%03lu\r\n", name,
+	       (unsigned long)(bps / 1000000),
+	       (unsigned long)(bps % 1000000 / 1000));
+}
+
+int flash_bench(flash_dev_t *dev, uint32_t addr, uint32_t len, uint8_t *buf,
+		uint32_t buf_size, flash_bench_t *res)
+{
+	TickType_t t0;
+	int ret;
+
+	if (buf_size == 0 || (len % buf_size))
+		return FLASH_ERR_PARAM;
+
+	for (uint32_t i = 0; i < buf_size; i++)
+		buf[i] = (uint8_t)(i * 7 + 1);
+
+	t0 = xTaskGetTickCount();
+	ret = flash_erase(dev, addr, len, portMAX_DELAY);
+	if (ret != FLASH_OK)
+		return ret;
+	res->erase_bps = flash_bench_rate(len, xTaskGetTickCount() - t0);
+
+	t0 = xTaskGetTickCount();
+	for (uint32_t off = 0; off < len; off += buf_size) {
+		ret = flash_program(dev, addr + off, buf, buf_size);
+		if (ret != FLASH_OK)
+			return ret;
+	}
+	res->write_bps = flash_bench_rate(len, xTaskGetTickCount() - t0);
+
+	t0 = xTaskGetTickCount();
+	for (uint32_t off = 0; off < len; off += buf_size) {
+		ret = flash_read(dev, addr + off, buf, buf_size);
+		if (ret != FLASH_OK)
+			return ret;
+	}
+	res->read_bps = flash_bench_rate(len, xTaskGetTickCount() - t0);
+
+	flash_bench_print("read", res->read_bps);
+	flash_bench_print("write", res->write_bps);
+	flash_bench_print("erase", res->erase_bps);
+	return FLASH_OK;
+}
@@ -0,0 +1,226 @@
+#include <string.h>
+#include "flash_blk.h"
+
+#define FLASH_BLK_ERASE_TIMEOUT pdMS_TO_TICKS(2000)
+
+int flash_blk_init(flash_blk_t *blk, flash_dev_t *dev, uint32_t base,
+		   uint32_t size)
+{
+	uint32_t msk = dev->sector_size - 1;
+
+	if ((base & msk) || (size & msk) || size == 0 ||
+	    base + size > dev->size)
+		return FLASH_ERR_PARAM;
+
+	blk->dev = dev;
+	blk->base = base;
+	blk->blocks = size / dev->sector_size;
+	return FLASH_OK;
+}
+
+int flash_blk_read(flash_blk_t *blk, uint32_t lba, void *buf, uint32_t count)
+{
+	uint32_t bs = flash_blk_size(blk);
+
+	if (lba + count > blk->blocks)
+		return FLASH_ERR_PARAM;
+	return flash_read(blk->dev, blk->base + lba * bs, buf, count * bs);
+}
+
+int flash_blk_write(flash_blk_t *blk, uint32_t lba, const void *buf,
+		    uint32_t count)
+{
+	uint32_t bs = flash_blk_size(blk);
+	uint32_t addr = blk->base + lba * bs;
+	int ret;
+
+	if (lba + count > blk->blocks)
+		return FLASH_ERR_PARAM;
+
+	ret = flash_erase(blk->dev, addr, count * bs,
+			  FLASH_BLK_ERASE_TIMEOUT * count);
+	if (ret != FLASH_OK)
+		return ret;
+	return flash_program(blk->dev, addr, buf, count * bs);
+}
+
+int flash_blk_erase(flash_blk_t *blk, uint32_t lba, uint32_t count)
+{
+	uint32_t bs = flash_blk_size(blk);
+
+	if (lba + count > blk->blocks)
+		return FLASH_ERR_PARAM;
+	return flash_erase(blk->dev, blk->base + lba * bs, count * bs,
+			   FLASH_BLK_ERASE_TIMEOUT * count);
+}
+
+int flash_stream_open(flash_stream_t *s, flash_dev_t *dev, uint32_t base,
+		      uint32_t size, uint8_t *buf, uint32_t buf_size)
+{
+	if (buf_size < dev->page_size || (buf_size & (dev->page_size - 1)) ||
+	    base + size > dev->size)
+		return FLASH_ERR_PARAM;
+
+	memset(s, 0, sizeof(*s));
+	s->dev = dev;
+	s->base = base;
+	s->size = size;
+	s->buf = buf;
+	s->buf_size = buf_size;
+	s->erased = base;
+	return FLASH_OK;
+}
+
+int flash_stream_read(flash_stream_t *s, void *dst, uint32_t len)
+{
+	uint8_t *out = dst;
+	uint32_t done = 0;
+
+	if (s->writing)
+		return FLASH_ERR_PARAM;
+	if (len > s->size - s->pos)
+		len = s->size - s->pos;
+
+	while (done < len) {
+		uint32_t addr = s->base + s->pos;
+		uint32_t left = len - done;
+		uint32_t n;
+		int ret;
+
+		if (addr >= s->buf_addr && addr < s->buf_addr + s->buf_len) {
+			uint32_t off = addr - s->buf_addr;
+
+			n = s->buf_len - off;
+			if (n > left)
+				n = left;
+			memcpy(out + done, s->buf + off, n);
+		} else if (left >= s->buf_size) {
+			/* Large request: skip the bounce buffer */
+			n = left - left % s->buf_size;
+			ret = flash_read(s->dev, addr, out + done, n);
+			if (ret != FLASH_OK)
+				return ret;
+		} else {
+			n = s->size - s->pos;
+			if (n > s->buf_size)
+				n = s->buf_size;
+			ret = flash_read(s->dev, addr, s->buf, n);
+			if (ret != FLASH_OK) {
+				s->buf_len = 0;
+				return ret;
+			}
+			s->buf_addr = addr;
+			s->buf_len = n;
+			continue;
+		}
+		done += n;
+		s->pos += n;
+	}
+	return done;
+}
+
+int flash_stream_seek(flash_stream_t *s, uint32_t pos)
+{
+	if (s->writing || pos > s->size)
+		return FLASH_ERR_PARAM;
+	s->pos = pos;
+	return FLASH_OK;
+}
+
+/** @brief Program buf[0..len) at buf_addr, erasing sectors on the way */
+static int flash_stream_commit(flash_stream_t *s, uint32_t len)
+{
+	flash_dev_t *dev = s->dev;
+	uint32_t end = s->buf_addr + len;
+	int ret;
+
+	if (end > s->erased) {
+		uint32_t msk = dev->sector_size - 1;
+		uint32_t to = (end + msk) & ~msk;
+
+		ret = flash_erase(dev, s->erased, to - s->erased,
+				  FLASH_BLK_ERASE_TIMEOUT *
+					  ((to - s->erased) / dev->sector_size));
+		if (ret != FLASH_OK)
+			return ret;
+		s->erased = to;
+	}
+
+	ret = flash_program(dev, s->buf_addr, s->buf, len);
+	if (ret != FLASH_OK)
+		return ret;
+	s->buf_addr = end;
+	s->buf_len = 0;
+	return FLASH_OK;
+}
+
+int flash_stream_write(flash_stream_t *s, const void *src, uint32_t len)
+{
+	const uint8_t *in = src;
+	uint32_t done = 0;
+
+	if (!s->writing) {
+		if (s->pos || (s->base & (s->dev->sector_size - 1)))
+			return FLASH_ERR_PARAM;
+		s->writing = 1;
+		s->buf_addr = s->base;
+		s->buf_len = 0;
+	}
+	if (len > s->size - s->pos)
+		len = s->size - s->pos;
+
+	while (done < len) {
+		uint32_t n = s->buf_size - s->buf_len;
+
+		if (n > len - done)
+			n = len - done;
+		memcpy(s->buf + s->buf_len, in + done, n);
+		s->buf_len += n;
+		s->pos += n;
+		done += n;
+
+		if (s->buf_len == s->buf_size) {
+			int ret = flash_stream_commit(s, s->buf_len);
+
+			if (ret != FLASH_OK)
+				return ret;
+		}
+	}
+	return done;
+}
+
+int flash_stream_write_buf(flash_stream_t *s, buf_t *b)
+{
+	int done = 0;
+
+	for (buf_t *seg = b; seg; seg = seg->next) {
+		int ret = flash_stream_write(s, seg->data, seg->len);
+
+		if (ret < 0) {
+			done = ret;
+			break;
+		}
+		done += ret;
+	}
+	buf_free(b);
+	return done;
+}
+
+int flash_stream_flush(flash_stream_t *s)
+{
+	uint32_t page = s->dev->page_size;
+	uint32_t len = (s->buf_len + page - 1) & ~(page - 1);
+	int ret;
+
+	if (!s->writing || s->buf_len == 0)
+		return FLASH_OK;
+
+	memset(s->buf + s->buf_len, 0xFF, len - s->buf_len);
+	ret = flash_stream_commit(s, len);
+	if (ret != FLASH_OK)
+		return ret;
+	s->pos = s->buf_addr - s->base;
+	if (s->pos > s->size)
+		s->pos = s->size;
+	return FLASH_OK;
+}
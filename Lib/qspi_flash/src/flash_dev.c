@@ -0,0 +1,32 @@
+#include "flash_dev.h"
+
+int flash_program(flash_dev_t *dev, uint32_t addr, const void *buf,
+		  size_t len)
+{
+	const uint8_t *src = buf;
+	PROF_SCOPE(flash_program);
+
+	while (len) {
+		size_t room = dev->page_size - (addr & (dev->page_size - 1));
+		size_t n = len < room ? len : room;
+		int ret = dev->ops->program(dev, addr, src, n);
+
+		if (ret != FLASH_OK)
+			return ret;
+		addr += n;
+		src += n;
+		len -= n;
+	}
+	return FLASH_OK;
+}
+
+int flash_erase(flash_dev_t *dev, uint32_t addr, uint32_t len,
+		TickType_t timeout)
+{
+	PROF_SCOPE(flash_erase);
+	int ret = dev->ops->erase_start(dev, addr, len, NULL, NULL);
+
+	if (ret != FLASH_OK)
+		return ret;
+	return dev->ops->wait_idle(dev, timeout);
+}
@@ -0,0 +1,66 @@
+#include <string.h>
+#include "flash_dev.h"
+
+static int emu_read(flash_dev_t *dev, uint32_t addr, void *buf, size_t len)
+{
+	const uint8_t *mem = dev->priv;
+
+	if (addr + len > dev->size)
+		return FLASH_ERR_PARAM;
+	memcpy(buf, mem + addr, len);
+	return FLASH_OK;
+}
+
+static int emu_program(flash_dev_t *dev, uint32_t addr, const void *buf,
+		       size_t len)
+{
+	uint8_t *mem = dev->priv;
+	const uint8_t *src = buf;
+
+	if (len == 0 || addr + len > dev->size ||
+	    (addr & (dev->page_size - 1)) + len > dev->page_size)
+		return FLASH_ERR_PARAM;
+	/* NOR cells can only go from 1 to 0 */
+	for (size_t i = 0; i < len; i++)
+		mem[addr + i] &= src[i];
+	return FLASH_OK;
+}
+
+static int emu_erase_start(flash_dev_t *dev, uint32_t addr, uint32_t len,
+			   flash_done_t done, void *arg)
+{
+	uint8_t *mem = dev->priv;
+
+	if (len == 0 || addr + len > dev->size ||
+	    ((addr | len) & (dev->sector_size - 1)))
+		return FLASH_ERR_PARAM;
+	memset(mem + addr, 0xFF, len);
+	if (done)
+		done(dev, FLASH_OK, arg);
+	return FLASH_OK;
+}
+
+static int emu_wait_idle(flash_dev_t *dev, TickType_t timeout)
+{
+	(void)dev;
+	(void)timeout;
+	return FLASH_OK;
+}
+
+static const flash_dev_ops_t emu_ops = {
+	.read = emu_read,
+	.program = emu_program,
+	.erase_start = emu_erase_start,
+	.wait_idle = emu_wait_idle,
+};
+
+void flash_emu_init(flash_dev_t *dev, uint8_t *mem, uint32_t size,
+		    uint32_t page_size, uint32_t sector_size)
+{
+	dev->ops = &emu_ops;
+	dev->size = size;
+	dev->page_size = page_size;
+	dev->sector_size = sector_size;
+	dev->mmap = mem;
+	dev->priv = mem;
+}
@@ -0,0 +1,31 @@
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "flash_dev.h"
+
+int flash_file_init(flash_dev_t *dev, const char *path, uint32_t size,
+		    uint32_t page_size, uint32_t sector_size)
+{
+	struct stat st;
+	uint8_t *mem;
+	int fd = open(path, O_RDWR | O_CREAT, 0644);
+
+	if (fd < 0)
+		return FLASH_ERR_IO;
+	if (fstat(fd, &st) != 0 || ftruncate(fd, size) != 0) {
+		close(fd);
+		return FLASH_ERR_IO;
+	}
+	mem = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (mem == MAP_FAILED)
+		return FLASH_ERR_IO;
+
+	/* Bytes the file did not have read as erased */
+	if ((uint64_t)st.st_size < size)
+		memset(mem + st.st_size, 0xFF, size - st.st_size);
+	flash_emu_init(dev, mem, size, page_size, sector_size);
+	return FLASH_OK;
+}
@@ -0,0 +1,83 @@
+#include <string.h>
+#include "flash_dev.h"
+#include "K1921VG015.h"
+#include "plib015_flash.h"
+
+#ifndef MEM_FLASH_BASE
+#define MEM_FLASH_BASE 0x80000000
+#endif
+#ifndef MEM_FLASH_SIZE
+#define MEM_FLASH_SIZE (1024 * 1024)
+#endif
+#ifndef MEM_FLASH_PAGE_SIZE
+#define MEM_FLASH_PAGE_SIZE 4096
+#endif
+
+#define INT_WORD_BYTES (MEM_FLASH_BUS_WIDTH_WORDS * 4)
+
+/*
+ * The controller programs one bus word per command and erases one
+ * page, busy waiting in both. Code keeps running from the other
+ * pages meanwhile, fetches stall for the duration of the command.
+ */
+static int int_read(flash_dev_t *dev, uint32_t addr, void *buf, size_t len)
+{
+	if (addr + len > dev->size)
+		return FLASH_ERR_PARAM;
+	memcpy(buf, (const uint8_t *)dev->mmap + addr, len);
+	return FLASH_OK;
+}
+
+static int int_program(flash_dev_t *dev, uint32_t addr, const void *buf,
+		       size_t len)
+{
+	uint32_t word[MEM_FLASH_BUS_WIDTH_WORDS];
+	const uint8_t *src = buf;
+
+	if (len == 0 || addr + len > dev->size ||
+	    ((addr | len) & (INT_WORD_BYTES - 1)))
+		return FLASH_ERR_PARAM;
+	for (size_t i = 0; i < len; i += INT_WORD_BYTES) {
+		/* Source buffers need not be word aligned */
+		memcpy(word, src + i, INT_WORD_BYTES);
+		FLASH_WriteData(addr + i, word, FLASH_Region_Main);
+	}
+	return FLASH_OK;
+}
+
+static int int_erase_start(flash_dev_t *dev, uint32_t addr, uint32_t len,
+			   flash_done_t done, void *arg)
+{
+	if (len == 0 || addr + len > dev->size ||
+	    ((addr | len) & (dev->sector_size - 1)))
+		return FLASH_ERR_PARAM;
+	for (uint32_t a = addr; a < addr + len; a += dev->sector_size)
+		FLASH_ErasePage(a, FLASH_Region_Main);
+	if (done)
+		done(dev, FLASH_OK, arg);
+	return FLASH_OK;
+}
+
+static int int_wait_idle(flash_dev_t *dev, TickType_t timeout)
+{
+	(void)dev;
+	(void)timeout;
+	return FLASH_OK;
+}
+
+static const flash_dev_ops_t int_ops = {
+	.read = int_read,
+	.program = int_program,
+	.erase_start = int_erase_start,
+	.wait_idle = int_wait_idle,
+};
+
+void flash_int_init(flash_dev_t *dev)
+{
+	dev->ops = &int_ops;
+	dev->size = MEM_FLASH_SIZE;
+	dev->page_size = MEM_FLASH_PAGE_SIZE;
+	dev->sector_size = MEM_FLASH_PAGE_SIZE;
+	dev->mmap = (const volatile uint8_t *)MEM_FLASH_BASE;
+	dev->priv = NULL;
+}
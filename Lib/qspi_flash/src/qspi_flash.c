@@ -0,0 +1,299 @@
+#include "qspi_flash.h"
+#include "qspi_hw.h"
+#include "task.h"
+#include "semphr.h"
+#include "timers.h"
+
+/** @brief SPI NOR instructions */
+#define NOR_WREN 0x06
+#define NOR_RDSR1 0x05
+#define NOR_RDSR2 0x35
+#define NOR_WRSR2 0x31
+#define NOR_RDID 0x9F
+#define NOR_QREAD 0xEB /**< Fast Read Quad I/O, 1-4-4 */
+#define NOR_QPP 0x32 /**< Quad Page Program, 1-1-4 */
+#define NOR_SE 0x20 /**< 4 KB sector erase */
+#define NOR_BE 0xD8 /**< 64 KB block erase */
+
+#define NOR_SR1_WIP (1 << 0)
+#define NOR_SR2_QE (1 << 1)
+
+#define NOR_BLOCK_SIZE 0x10000
+/** @brief Mode byte (2 clocks on 4 lines) + 4 dummy clocks of 0xEB */
+#define NOR_QREAD_DUMMY 6
+
+typedef struct {
+	SemaphoreHandle_t lock;
+	TimerHandle_t erase_poll;
+	volatile uint8_t erasing;
+	volatile int erase_status; /**< result of the last erase */
+	uint32_t erase_addr;
+	uint32_t erase_end;
+	flash_done_t erase_done;
+	void *erase_arg;
+	uint32_t jedec;
+} qspi_nor_t;
+
+static qspi_nor_t nor;
+
+static int nor_simple(uint8_t cmd)
+{
+	const qspi_cmd_t c = { .cmd = cmd };
+
+	return qspi_hw_xfer(&c, NULL, NULL, 0);
+}
+
+static uint8_t nor_read_reg(uint8_t cmd)
+{
+	const qspi_cmd_t c = { .cmd = cmd };
+	uint8_t val = 0xFF;
+
+	qspi_hw_xfer(&c, NULL, &val, 1);
+	return val;
+}
+
+/** @brief Poll WIP, yielding to same priority tasks between polls */
+static int nor_wait_ready(TickType_t timeout)
+{
+	TimeOut_t to;
+
+	vTaskSetTimeOutState(&to);
+	while (nor_read_reg(NOR_RDSR1) & NOR_SR1_WIP) {
+		if (xTaskCheckForTimeOut(&to, &timeout) == pdTRUE)
+			return FLASH_ERR_TIMEOUT;
+		taskYIELD();
+	}
+	return FLASH_OK;
+}
+
+/** @brief Issue erase of the next sector or block of the pending range */
+static int nor_erase_next(void)
+{
+	uint32_t left = nor.erase_end - nor.erase_addr;
+	qspi_cmd_t c = { .cmd = NOR_SE, .addr_bytes = 3 };
+
+	if ((nor.erase_addr & (NOR_BLOCK_SIZE - 1)) == 0 &&
+	    left >= NOR_BLOCK_SIZE)
+		c.cmd = NOR_BE;
+	c.addr = nor.erase_addr;
+	nor.erase_addr += (c.cmd == NOR_BE) ? NOR_BLOCK_SIZE :
+					      QSPI_FLASH_SECTOR_SIZE;
+
+	if (nor_simple(NOR_WREN) != 0)
+		return FLASH_ERR_IO;
+	return qspi_hw_xfer(&c, NULL, NULL, 0) ? FLASH_ERR_IO : FLASH_OK;
+}
+
+static void nor_erase_finish(flash_dev_t *dev, int status)
+{
+	flash_done_t done = nor.erase_done;
+
+	xTimerStop(nor.erase_poll, 0);
+	nor.erase_status = status;
+	nor.erasing = 0;
+	if (done)
+		done(dev, status, nor.erase_arg);
+}
+
+/**
+ * @brief Erase progress poll, runs in the timer service task.
+ *
+ * Never blocks: if a reader holds the bus the poll is retried on
+ * the next tick.
+ */
+static void nor_erase_poll(TimerHandle_t timer)
+{
+	flash_dev_t *dev = pvTimerGetTimerID(timer);
+	int status;
+
+	if (xSemaphoreTake(nor.lock, 0) != pdTRUE)
+		return;
+
+	if (nor_read_reg(NOR_RDSR1) & NOR_SR1_WIP) {
+		xSemaphoreGive(nor.lock);
+		return;
+	}
+
+	if (nor.erase_addr >= nor.erase_end) {
+		xSemaphoreGive(nor.lock);
+		nor_erase_finish(dev, FLASH_OK);
+		return;
+	}
+
+	status = nor_erase_next();
+	xSemaphoreGive(nor.lock);
+	if (status != FLASH_OK)
+		nor_erase_finish(dev, status);
+}
+
+static int nor_wait_idle(flash_dev_t *dev, TickType_t timeout)
+{
+	TimeOut_t to;
+
+	(void)dev;
+	vTaskSetTimeOutState(&to);
+	while (nor.erasing) {
+		if (xTaskCheckForTimeOut(&to, &timeout) == pdTRUE)
+			return FLASH_ERR_TIMEOUT;
+		vTaskDelay(1);
+	}
+	return nor.erase_status;
+}
+
+/**
+ * @brief Take the bus with no erase running.
+ *
+ * An erase may start between the wait and the take, so the flag is
+ * checked again under the lock.
+ */
+static int nor_lock_idle(flash_dev_t *dev)
+{
+	while (1) {
+		xSemaphoreTake(nor.lock, portMAX_DELAY);
+		if (!nor.erasing)
+			return FLASH_OK;
+		xSemaphoreGive(nor.lock);
+		if (nor_wait_idle(dev, portMAX_DELAY) == FLASH_ERR_TIMEOUT)
+			return FLASH_ERR_BUSY;
+	}
+}
+
+static int nor_read(flash_dev_t *dev, uint32_t addr, void *buf, size_t len)
+{
+	qspi_cmd_t c = {
+		.cmd = NOR_QREAD,
+		.addr_bytes = 3,
+		.dummy_cycles = NOR_QREAD_DUMMY,
+		.addr_quad = 1,
+		.data_quad = 1,
+	};
+	uint8_t *dst = buf;
+	int ret = FLASH_OK;
+
+	if (addr + len > dev->size)
+		return FLASH_ERR_PARAM;
+	if (nor_lock_idle(dev) != FLASH_OK)
+		return FLASH_ERR_BUSY;
+
+	while (len && ret == FLASH_OK) {
+		size_t n = len > QSPI_HW_XFER_MAX ? QSPI_HW_XFER_MAX : len;
+
+		c.addr = addr;
+		if (qspi_hw_xfer(&c, NULL, dst, n) != 0)
+			ret = FLASH_ERR_IO;
+		addr += n;
+		dst += n;
+		len -= n;
+	}
+	xSemaphoreGive(nor.lock);
+	return ret;
+}
+
+static int nor_program(flash_dev_t *dev, uint32_t addr, const void *buf,
+		       size_t len)
+{
+	const qspi_cmd_t c = {
+		.cmd = NOR_QPP,
+		.addr_bytes = 3,
+		.data_quad = 1,
+		.addr = addr,
+	};
+	int ret = FLASH_OK;
+
+	if (len == 0 || addr + len > dev->size ||
+	    (addr & (dev->page_size - 1)) + len > dev->page_size)
+		return FLASH_ERR_PARAM;
+	if (nor_lock_idle(dev) != FLASH_OK)
+		return FLASH_ERR_BUSY;
+
+	if (nor_simple(NOR_WREN) != 0 || qspi_hw_xfer(&c, buf, NULL, len) != 0)
+		ret = FLASH_ERR_IO;
+	else
+		ret = nor_wait_ready(pdMS_TO_TICKS(10));
+	xSemaphoreGive(nor.lock);
+	return ret;
+}
+
+static int nor_erase_start(flash_dev_t *dev, uint32_t addr, uint32_t len,
+			   flash_done_t done, void *arg)
+{
+	int ret;
+
+	if (len == 0 || addr + len > dev->size ||
+	    ((addr | len) & (dev->sector_size - 1)))
+		return FLASH_ERR_PARAM;
+
+	xSemaphoreTake(nor.lock, portMAX_DELAY);
+	if (nor.erasing) {
+		xSemaphoreGive(nor.lock);
+		return FLASH_ERR_BUSY;
+	}
+	nor.erase_addr = addr;
+	nor.erase_end = addr + len;
+	nor.erase_done = done;
+	nor.erase_arg = arg;
+	nor.erase_status = FLASH_OK;
+	ret = nor_erase_next();
+	if (ret == FLASH_OK) {
+		nor.erasing = 1;
+		vTimerSetTimerID(nor.erase_poll, dev);
+		xTimerStart(nor.erase_poll, portMAX_DELAY);
+	}
+	xSemaphoreGive(nor.lock);
+	return ret;
+}
+
+static const flash_dev_ops_t nor_ops = {
+	.read = nor_read,
+	.program = nor_program,
+	.erase_start = nor_erase_start,
+	.wait_idle = nor_wait_idle,
+};
+
+int qspi_flash_init(flash_dev_t *dev, const qspi_flash_config_t *cfg)
+{
+	const qspi_cmd_t rdid = { .cmd = NOR_RDID };
+	const qspi_cmd_t wrsr2 = { .cmd = NOR_WRSR2 };
+	uint8_t id[3] = { 0 };
+	uint8_t sr2;
+
+	if (nor.lock == NULL) {
+		nor.lock = xSemaphoreCreateMutex();
+		nor.erase_poll = xTimerCreate("qspi", 1, pdTRUE, NULL,
+					      nor_erase_poll);
+		if (nor.lock == NULL || nor.erase_poll == NULL)
+			return FLASH_ERR_IO;
+	}
+
+	qspi_hw_init(cfg->clk_div, cfg->use_dma);
+
+	qspi_hw_xfer(&rdid, NULL, id, sizeof(id));
+	nor.jedec = (id[0] << 16) | (id[1] << 8) | id[2];
+	if (nor.jedec == 0 || nor.jedec == 0xFFFFFF || id[2] < 16 ||
+	    id[2] > 24)
+		return FLASH_ERR_IO;
+
+	/* QE lives in SR2 on Winbond/GigaDevice style parts */
+	sr2 = nor_read_reg(NOR_RDSR2);
+	if (!(sr2 & NOR_SR2_QE)) {
+		sr2 |= NOR_SR2_QE;
+		nor_simple(NOR_WREN);
+		qspi_hw_xfer(&wrsr2, &sr2, NULL, 1);
+		if (nor_wait_ready(pdMS_TO_TICKS(50)) != FLASH_OK)
+			return FLASH_ERR_TIMEOUT;
+	}
+
+	dev->ops = &nor_ops;
+	dev->size = 1UL << id[2];
+	dev->page_size = QSPI_FLASH_PAGE_SIZE;
+	dev->sector_size = QSPI_FLASH_SECTOR_SIZE;
+	/* The controller has no memory mapped (XIP) window */
+	dev->mmap = NULL;
+	dev->priv = &nor;
+	return FLASH_OK;
+}
+
+uint32_t qspi_flash_jedec_id(void)
+{
+	return nor.jedec;
+}
@@ -0,0 +1,172 @@
+#include "qspi_hw.h"
+#include "dma.h"
+#include "K1921VG015.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+/** @brief DMA channels wired to the QSPI requests */
+#ifndef QSPI_DMA_TX_CH
+#define QSPI_DMA_TX_CH 22
+#endif
+#ifndef QSPI_DMA_RX_CH
+#define QSPI_DMA_RX_CH 23
+#endif
+
+/** @brief Data phases up to the FIFO depth are moved by the CPU */
+#define QSPI_FIFO_BYTES 16
+
+#define QSPI_FMODE_WRITE 0
+#define QSPI_FMODE_READ 1
+
+#define QSPI_LINES_NONE 0
+#define QSPI_LINES_1 1
+#define QSPI_LINES_4 3
+
+static uint8_t qspi_use_dma;
+static TaskHandle_t qspi_waiter;
+
+static void qspi_dma_done(__attribute__((unused)) uint32_t ch,
+			  __attribute__((unused)) void *arg)
+{
+	BaseType_t woken = pdFALSE;
+
+	QSPI->DMACR = 0;
+	if (qspi_waiter)
+		vTaskNotifyGiveIndexedFromISR(qspi_waiter, QSPI_NOTIFY_INDEX,
+					      &woken);
+	portYIELD_FROM_ISR(woken);
+}
+
+void qspi_hw_init(uint32_t clk_div, uint8_t use_dma)
+{
+	RCU->CGCFGAHB_bit.QSPIEN = 1;
+	RCU->RSTDISAHB_bit.QSPIEN = 1;
+	RCU->QSPICLKCFG.QSPICLKCFG = RCU_QSPICLKCFG_CLKEN_Msk |
+				     RCU_QSPICLKCFG_RSTDIS_Msk;
+
+	QSPI->CTRL = 0;
+	QSPI->CTRL_bit.DIV = clk_div ? clk_div - 1 : 0;
+	QSPI->CTRL_bit.EN = 1;
+
+	qspi_use_dma = use_dma;
+	if (use_dma) {
+		dma_init();
+		dma_set_handler(QSPI_DMA_TX_CH, qspi_dma_done, NULL);
+		dma_set_handler(QSPI_DMA_RX_CH, qspi_dma_done, NULL);
+	}
+}
+
+static void qspi_frame_start(const qspi_cmd_t *cmd, size_t len, int read)
+{
+	uint32_t data_lines = cmd->data_quad ? QSPI_LINES_4 : QSPI_LINES_1;
+	uint32_t addr_lines = cmd->addr_quad ? QSPI_LINES_4 : QSPI_LINES_1;
+
+	while (QSPI->SR_bit.BUSY) {
+	};
+
+	QSPI->FCFG = 0;
+	QSPI->FCFG_bit.FMODE = read ? QSPI_FMODE_READ : QSPI_FMODE_WRITE;
+	QSPI->FCFG_bit.IMODE = QSPI_LINES_1;
+	QSPI->FCFG_bit.ADMODE = cmd->addr_bytes ? addr_lines : QSPI_LINES_NONE;
+	QSPI->FCFG_bit.ADSIZE = cmd->addr_bytes ? cmd->addr_bytes - 1 : 0;
+	QSPI->FCFG_bit.DCYC = cmd->dummy_cycles;
+	QSPI->FCFG_bit.DMODE = len ? data_lines : QSPI_LINES_NONE;
+	QSPI->DLR = len ? len - 1 : 0;
+	/* Writing the instruction starts the frame, address follows */
+	QSPI->IR = cmd->cmd;
+	if (cmd->addr_bytes)
+		QSPI->AR = cmd->addr;
+}
+
+/** @brief Drop wake-ups no wait is going to take */
+static void qspi_notify_clear(void)
+{
+	(void)xTaskNotifyStateClearIndexed(NULL, QSPI_NOTIFY_INDEX);
+	(void)ulTaskNotifyValueClearIndexed(NULL, QSPI_NOTIFY_INDEX,
+					    UINT32_MAX);
+}
+
+/**
+ * @brief Move the data phase by DMA, the frame is already running.
+ *
+ * Word transfers fit QSPI_HW_XFER_MAX into one cycle; an unaligned
+ * buffer goes byte by byte in cycles of up to DMA_XFER_MAX, the
+ * controller holds the frame between them.
+ */
+static int qspi_xfer_dma(const void *tx, void *rx, size_t len)
+{
+	const uint32_t ch = rx ? QSPI_DMA_RX_CH : QSPI_DMA_TX_CH;
+	uintptr_t addr = (uintptr_t)(tx ? tx : rx);
+	uint32_t width = DMA_XFER_BYTE;
+
+	if (((addr | len) & 3) == 0)
+		width = DMA_XFER_WORD;
+
+	qspi_notify_clear();
+	qspi_waiter = xTaskGetCurrentTaskHandle();
+	while (len) {
+		uint32_t count = len >> width;
+
+		if (count > DMA_XFER_MAX)
+			count = DMA_XFER_MAX;
+
+		dma_ch_use_primary(ch);
+		if (rx) {
+			dma_ch_setup(ch, &QSPI->DR, (void *)addr, count,
+				     width | DMA_XFER_DST_INC);
+			dma_ch_enable(ch);
+			QSPI->DMACR_bit.RXDMAE = 1;
+		} else {
+			dma_ch_setup(ch, (const void *)addr, &QSPI->DR, count,
+				     width | DMA_XFER_SRC_INC);
+			dma_ch_enable(ch);
+			QSPI->DMACR_bit.TXDMAE = 1;
+		}
+
+		if (ulTaskNotifyTakeIndexed(QSPI_NOTIFY_INDEX, pdTRUE,
+					    pdMS_TO_TICKS(100)) == 0) {
+			QSPI->DMACR = 0;
+			dma_ch_disable(ch);
+			break;
+		}
+		addr += count << width;
+		len -= count << width;
+	}
+	/* A completion racing the timeout must not wake the next wait */
+	qspi_waiter = NULL;
+	qspi_notify_clear();
+	return len ? -1 : 0;
+}
+
+int qspi_hw_xfer(const qspi_cmd_t *cmd, const void *tx, void *rx, size_t len)
+{
+	const uint8_t *src = tx;
+	uint8_t *dst = rx;
+
+	if (len > QSPI_HW_XFER_MAX)
+		return -1;
+
+	qspi_frame_start(cmd, len, rx != NULL);
+
+	if (len > QSPI_FIFO_BYTES && qspi_use_dma &&
+	    xTaskGetSchedulerState() == taskSCHEDULER_RUNNING) {
+		if (qspi_xfer_dma(tx, rx, len) != 0)
+			return -1;
+	} else if (dst) {
+		for (size_t i = 0; i < len; i++) {
+			while (!QSPI->SR_bit.RXNE) {
+			};
+			dst[i] = QSPI->DR_byte;
+		}
+	} else if (src) {
+		for (size_t i = 0; i < len; i++) {
+			while (!QSPI->SR_bit.TXNF) {
+			};
+			QSPI->DR_byte = src[i];
+		}
+	}
+
+	while (QSPI->SR_bit.BUSY) {
+	};
+	return 0;
+}
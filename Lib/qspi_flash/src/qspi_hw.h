@@ -0,0 +1,51 @@
+#ifndef __qspi_hw_h__
+#define __qspi_hw_h__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief One QSPI command frame.
+ *
+ * Instruction always goes on one line; address (with the mode
+ * byte folded into dummy cycles) and data can use four lines.
+ */
+typedef struct {
+	uint8_t cmd;
+	uint8_t addr_bytes;
+	uint8_t dummy_cycles;
+	uint8_t addr_quad;
+	uint8_t data_quad;
+	uint32_t addr;
+} qspi_cmd_t;
+
+/**
+ * @brief Initialize QSPI controller clock and DMA channels.
+ * @param clk_div SCK divider
+ * @param use_dma Move long data phases by DMA
+ *
+ * Leaves the pins alone: the board code routes SCK, CS and IO0-IO3
+ * to their QSPI alternate function before qspi_flash_init().
+ */
+void qspi_hw_init(uint32_t clk_div, uint8_t use_dma);
+
+/**
+ * @brief Run a command frame.
+ * @param cmd Frame description
+ * @param tx Data to send or NULL
+ * @param rx Buffer for received data or NULL
+ * @param len Data phase length, at most QSPI_HW_XFER_MAX
+ * @return 0 on success
+ *
+ * Data phases longer than the FIFO are moved by DMA when enabled,
+ * the calling task sleeps on notification QSPI_NOTIFY_INDEX meanwhile.
+ */
+int qspi_hw_xfer(const qspi_cmd_t *cmd, const void *tx, void *rx, size_t len);
+
+/** @brief Largest data phase of one frame (DMA cycle of words) */
+#define QSPI_HW_XFER_MAX 4096
+
+/** @brief Notification index DMA data phases block on, 0 stays free */
+#define QSPI_NOTIFY_INDEX 4
+
+#endif //__qspi_hw_h__
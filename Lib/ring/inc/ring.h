@@ -0,0 +1,274 @@
+#ifndef __ring_h__
+#define __ring_h__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*! CPP guard */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Handoff rings of pointer sized items.
+ *
+ * SPSC: one producer, one consumer, each may be a task or an ISR.
+ * It only needs ordered loads and stores, which every core has.
+ * MPSC: any number of producers claim slots with compare-and-swap
+ * (bounded queue with per-slot sequence numbers), one consumer.
+ *
+ * Neither masks interrupts on the data path, except MPSC producers
+ * on cores without atomic read-modify-write, see RING_ATOMIC_RMW.
+ * A consumer blocked in *_receive() is woken by the push through
+ * task notification RING_NOTIFY_INDEX.
+ */
+
+/**
+ * @brief Atomic read-modify-write available.
+ *
+ * Detected from the A extension. Without it (rv32imfc) the MPSC
+ * compare-and-swap masks interrupts for a few instructions, which
+ * is only atomic on a single hart.
+ */
+#ifndef RING_ATOMIC_RMW
+#if defined(__riscv) && !defined(__riscv_atomic)
+#define RING_ATOMIC_RMW 0
+#else
+#define RING_ATOMIC_RMW 1
+#endif
+#endif
+
+#if !RING_ATOMIC_RMW
+#include "riscv-irq.h"
+#endif
+
+#define RING_OK 0
+#define RING_ERR_FULL -1
+#define RING_ERR_EMPTY -2
+
+/** @brief Notification index consumers wait on, 0 stays free */
+#define RING_NOTIFY_INDEX 1
+
+typedef struct {
+	void **slots;
+	uint32_t mask;
+	uint32_t head; /**< consumer position */
+	uint32_t tail; /**< producer position */
+	TaskHandle_t waiter; /**< consumer about to block, or NULL */
+} ring_spsc_t;
+
+typedef struct {
+	uint32_t seq;
+	void *item;
+} ring_cell_t;
+
+typedef struct {
+	ring_cell_t *cells;
+	uint32_t mask;
+	uint32_t head;
+	uint32_t tail;
+	TaskHandle_t waiter;
+} ring_mpsc_t;
+
+/** @brief Wake the consumer if it is waiting, woken NULL from tasks */
+static inline void ring_notify(TaskHandle_t *waiter, BaseType_t *woken)
+{
+	TaskHandle_t t;
+
+	/* Item store before waiter load, pairs with ring_wait() */
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	t = __atomic_load_n(waiter, __ATOMIC_RELAXED);
+	if (t == NULL)
+		return;
+	if (woken)
+		vTaskNotifyGiveIndexedFromISR(t, RING_NOTIFY_INDEX, woken);
+	else
+		xTaskNotifyGiveIndexed(t, RING_NOTIFY_INDEX);
+}
+
+/**
+ * @brief One step of a blocking receive after an empty pop.
+ *
+ * The first call only publishes the waiter: the caller pops once
+ * more, so an item pushed before the producer could see the waiter
+ * is not slept over.
+ * @return 0 on timeout, 1 to pop again
+ */
+static inline int ring_wait(TaskHandle_t *waiter, TimeOut_t *to,
+			    TickType_t *timeout)
+{
+	if (__atomic_load_n(waiter, __ATOMIC_RELAXED) == NULL) {
+		__atomic_store_n(waiter, xTaskGetCurrentTaskHandle(),
+				 __ATOMIC_RELAXED);
+		__atomic_thread_fence(__ATOMIC_SEQ_CST);
+		return 1;
+	}
+	if (xTaskCheckForTimeOut(to, timeout) == pdTRUE)
+		return 0;
+	ulTaskNotifyTakeIndexed(RING_NOTIFY_INDEX, pdTRUE, *timeout);
+	return 1;
+}
+
+static inline int ring_cas(uint32_t *p, uint32_t *expected, uint32_t desired)
+{
+#if RING_ATOMIC_RMW
+	return __atomic_compare_exchange_n(p, expected, desired, 1,
+					   __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+#else
+	uint32_t mie = irq_save();
+	int ok = *p == *expected;
+
+	if (ok)
+		*p = desired;
+	else
+		*expected = *p;
+	irq_restore(mie);
+	return ok;
+#endif
+}
+
+/* Single producer ---------------------------------------------------------- */
+
+/** @brief Set up a ring over slots, len a power of two */
+static inline void ring_spsc_init(ring_spsc_t *q, void **slots, uint32_t len)
+{
+	q->slots = slots;
+	q->mask = len - 1;
+	q->head = 0;
+	q->tail = 0;
+	q->waiter = NULL;
+}
+
+/**
+ * @brief Queue an item and wake the consumer.
+ * @param woken From an ISR as for xQueueSendFromISR(), NULL from tasks
+ * @return RING_OK, RING_ERR_FULL
+ */
+static inline int ring_spsc_push(ring_spsc_t *q, void *item,
+				 BaseType_t *woken)
+{
+	uint32_t tail = q->tail;
+
+	if (tail - __atomic_load_n(&q->head, __ATOMIC_ACQUIRE) > q->mask)
+		return RING_ERR_FULL;
+	q->slots[tail & q->mask] = item;
+	__atomic_store_n(&q->tail, tail + 1, __ATOMIC_RELEASE);
+	ring_notify(&q->waiter, woken);
+	return RING_OK;
+}
+
+/** @brief Take an item without blocking, RING_OK or RING_ERR_EMPTY */
+static inline int ring_spsc_pop(ring_spsc_t *q, void **item)
+{
+	uint32_t head = q->head;
+
+	if (__atomic_load_n(&q->tail, __ATOMIC_ACQUIRE) == head)
+		return RING_ERR_EMPTY;
+	*item = q->slots[head & q->mask];
+	__atomic_store_n(&q->head, head + 1, __ATOMIC_RELEASE);
+	return RING_OK;
+}
+
+/** @brief Take an item, blocking up to timeout. Task context only */
+static inline int ring_spsc_receive(ring_spsc_t *q, void **item,
+				    TickType_t timeout)
+{
+	TimeOut_t to;
+	int ret;
+
+	vTaskSetTimeOutState(&to);
+	while ((ret = ring_spsc_pop(q, item)) != RING_OK &&
+	       ring_wait(&q->waiter, &to, &timeout))
+		;
+	__atomic_store_n(&q->waiter, NULL, __ATOMIC_RELAXED);
+	return ret;
+}
+
+static inline uint32_t ring_spsc_count(const ring_spsc_t *q)
+{
+	return __atomic_load_n(&q->tail, __ATOMIC_ACQUIRE) -
+	       __atomic_load_n(&q->head, __ATOMIC_ACQUIRE);
+}
+
+/* Multiple producers ------------------------------------------------------- */
+
+/** @brief Set up a ring over cells, len a power of two */
+static inline void ring_mpsc_init(ring_mpsc_t *q, ring_cell_t *cells,
+				  uint32_t len)
+{
+	for (uint32_t i = 0; i < len; i++)
+		cells[i].seq = i;
+	q->cells = cells;
+	q->mask = len - 1;
+	q->head = 0;
+	q->tail = 0;
+	q->waiter = NULL;
+}
+
+/**
+ * @brief Queue an item and wake the consumer, any context.
+ *
+ * A producer preempted between claiming its cell and publishing it
+ * holds up the consumer at that cell until it resumes.
+ * @return RING_OK, RING_ERR_FULL
+ */
+static inline int ring_mpsc_push(ring_mpsc_t *q, void *item,
+				 BaseType_t *woken)
+{
+	uint32_t pos = __atomic_load_n(&q->tail, __ATOMIC_RELAXED);
+	ring_cell_t *c;
+
+	while (1) {
+		int32_t dif;
+
+		c = &q->cells[pos & q->mask];
+		dif = (int32_t)(__atomic_load_n(&c->seq, __ATOMIC_ACQUIRE) -
+				pos);
+		if (dif == 0) {
+			if (ring_cas(&q->tail, &pos, pos + 1))
+				break;
+		} else if (dif < 0) {
+			return RING_ERR_FULL;
+		} else {
+			pos = __atomic_load_n(&q->tail, __ATOMIC_RELAXED);
+		}
+	}
+	c->item = item;
+	__atomic_store_n(&c->seq, pos + 1, __ATOMIC_RELEASE);
+	ring_notify(&q->waiter, woken);
+	return RING_OK;
+}
+
+static inline int ring_mpsc_pop(ring_mpsc_t *q, void **item)
+{
+	ring_cell_t *c = &q->cells[q->head & q->mask];
+
+	if (__atomic_load_n(&c->seq, __ATOMIC_ACQUIRE) != q->head + 1)
+		return RING_ERR_EMPTY;
+	*item = c->item;
+	__atomic_store_n(&c->seq, q->head + q->mask + 1, __ATOMIC_RELEASE);
+	q->head++;
+	return RING_OK;
+}
+
+static inline int ring_mpsc_receive(ring_mpsc_t *q, void **item,
+				    TickType_t timeout)
+{
+	TimeOut_t to;
+	int ret;
+
+	vTaskSetTimeOutState(&to);
+	while ((ret = ring_mpsc_pop(q, item)) != RING_OK &&
+	       ring_wait(&q->waiter, &to, &timeout))
+		;
+	__atomic_store_n(&q->waiter, NULL, __ATOMIC_RELAXED);
+	return ret;
+}
+
+#ifdef __cplusplus
+}
+#endif /* End of CPP guard */
+
+#endif //__ring_h__
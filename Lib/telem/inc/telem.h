@@ -0,0 +1,163 @@
+#ifndef __telem_h__
+#define __telem_h__
+
+#include <stdint.h>
+#include "buf.h"
+#include "uart.h"
+
+/*! CPP guard */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Telemetry switch of the application, set by the TELEM_ENABLE
+ * CMake option. The library itself is always built.
+ */
+#ifndef TELEM_ENABLE
+#define TELEM_ENABLE 0
+#endif
+
+/** @brief Histogram bins: 0 counts zeros, n counts [2^(n-1), 2^n) */
+#define TELEM_HIST_BINS 16
+/** @brief Channel table capacity */
+#define TELEM_CHAN_MAX 64
+/** @brief Name bytes sent in the schema */
+#define TELEM_NAME_MAX 16
+
+/** @brief Frame buffer size, a Lib/buf class must hold it */
+#ifndef TELEM_FRAME_SIZE
+#define TELEM_FRAME_SIZE 1024
+#endif
+/** @brief Schema repeat period, for decoders joining late */
+#ifndef TELEM_SCHEMA_MS
+#define TELEM_SCHEMA_MS 5000
+#endif
+/** @brief Data frames per key frame */
+#ifndef TELEM_KEY_EVERY
+#define TELEM_KEY_EVERY 16
+#endif
+
+/**
+ * @brief Stream format, all integers little endian.
+ *
+ * Frame: 0xA5, u16 len, body of len bytes, u16 Fletcher-16 of body.
+ * Body: u8 type, u8 seq, varint tick0, u8 nticks, samples.
+ *
+ * Schema frames (type 0) carry varint period_ms, u8 count, then per
+ * channel u8 kind, u8 div, u8 name length and the name.
+ * Data frames cover nticks sampler periods from tick0. For every
+ * period, the channels due (tick % div == 0) follow in table order:
+ * counters as varint, gauges as zigzag varint, histograms as one
+ * varint per bin. Values are deltas to the channel's previous
+ * sample; the first sample of a channel since the last key frame
+ * (type 1) started is absolute. A seq gap means a lost frame: skip
+ * up to the next key frame.
+ */
+#define TELEM_SYNC 0xA5
+
+typedef enum {
+	TELEM_FRAME_SCHEMA,
+	TELEM_FRAME_KEY,
+	TELEM_FRAME_DELTA,
+} telem_frame_t;
+
+typedef enum {
+	TELEM_KIND_COUNTER, /**< uint32_t, wraps */
+	TELEM_KIND_GAUGE, /**< int32_t */
+	TELEM_KIND_HIST, /**< telem_hist_t */
+} telem_kind_t;
+
+typedef struct {
+	uint32_t bins[TELEM_HIST_BINS];
+} telem_hist_t;
+
+/** @brief Count v in its power of two bin, a handful of cycles */
+static inline void telem_hist_add(telem_hist_t *h, uint32_t v)
+{
+	uint32_t bin = v ? 32 - __builtin_clz(v) : 0;
+
+	if (bin >= TELEM_HIST_BINS)
+		bin = TELEM_HIST_BINS - 1;
+	h->bins[bin]++;
+}
+
+/** @brief Table entry, placed in the telem_tbl linker section */
+typedef struct {
+	const char *name;
+	const volatile void *src;
+	int32_t (*get)(void); /**< gauge read through a function */
+	uint32_t *prev; /**< last sent sample, private */
+	uint8_t kind;
+	uint8_t div; /**< sampled every div-th period */
+} telem_chan_t;
+
+#define TELEM_ENTRY(id, knd, dv, fn, source, nprev)                \
+	static uint32_t telem_prev_##id[nprev];                    \
+	static const telem_chan_t telem_chan_##id                  \
+		__attribute__((used, section("telem_tbl"), aligned(4))) = { \
+			.name = #id,                                       \
+			.src = source,                                     \
+			.get = fn,                                         \
+			.prev = telem_prev_##id,                           \
+			.kind = knd,                                       \
+			.div = dv,                                         \
+		}
+
+/**
+ * @brief Register a plain variable as a channel, named after it.
+ *
+ * Like INIT_ENTRY, the entry must sit in an object linked anyway.
+ * div sets the rate: a sample every div sampler periods.
+ */
+#define TELEM_COUNTER(var, div) \
+	TELEM_ENTRY(var, TELEM_KIND_COUNTER, div, NULL, &(var), 1)
+#define TELEM_GAUGE(var, div) \
+	TELEM_ENTRY(var, TELEM_KIND_GAUGE, div, NULL, &(var), 1)
+#define TELEM_GAUGE_FN(fn, div) \
+	TELEM_ENTRY(fn, TELEM_KIND_GAUGE, div, fn, NULL, 1)
+#define TELEM_HIST(var, div) \
+	TELEM_ENTRY(var, TELEM_KIND_HIST, div, NULL, &(var), TELEM_HIST_BINS)
+
+typedef struct {
+	uint32_t frames;
+	uint32_t bytes;
+	uint32_t samples;
+	uint32_t dropped; /**< frames lost: no buffer or the port stayed busy */
+	uint32_t tick_cycles_max; /**< worst sampling cost of one period */
+	uint32_t tick_cycles_avg;
+} telem_stats_t;
+
+/**
+ * @brief Start the sampler task.
+ * @param port UART to send on, opened here, with DMA where it has it
+ * @param baud Port speed
+ * @param period_ms Base sampling period
+ * @param batch Periods per frame, 1..255
+ * @param prio Sampler task priority
+ * @return 0 on success, -1 on a bad table, UART or task failure
+ *
+ * Frames are built in Lib/buf buffers and sent by handle, a frame
+ * closes before a period that might not fit. A schema frame
+ * opens the stream and repeats every TELEM_SCHEMA_MS.
+ */
+int telem_start(uart_port_t port, uint32_t baud, uint32_t period_ms,
+		uint8_t batch, uint32_t prio);
+
+/**
+ * @brief Frame sink: takes over the reference, returns 0 if the frame
+ * was dropped. uart_write_buf() without the port, e.g. lzs_write_buf().
+ */
+typedef size_t (*telem_sink_t)(buf_t *b, TickType_t timeout);
+
+/** @brief Start the sampler task on a sink instead of a port */
+int telem_start_sink(telem_sink_t sink, uint32_t period_ms, uint8_t batch,
+		     uint32_t prio);
+
+void telem_get_stats(telem_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif /* End of CPP guard */
+
+#endif //__telem_h__
@@ -0,0 +1,344 @@
+#include <stddef.h>
+#include <string.h>
+#include "telem.h"
+#include "buf.h"
+#include "riscv-csr.h"
+#include "riscv-irq.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+/** @brief Sync, length and the fixed part of the body */
+#define TELEM_HDR_MAX (1 + 2 + 1 + 1 + 5 + 1)
+#define TELEM_SUM_LEN 2
+/** @brief Longest varint of a 32 bit value */
+#define TELEM_VARINT_MAX 5
+
+/* Headers are prepended in place, see telem_close() */
+#if BUF_HEADROOM < TELEM_HDR_MAX
+#error "BUF_HEADROOM too small for the telemetry frame header"
+#endif
+
+/**
+ * @brief Table bounds, from the linker script or the linker itself.
+ * Weak: an image without channels has no section and both are NULL.
+ */
+extern const telem_chan_t __start_telem_tbl[] __attribute__((weak));
+extern const telem_chan_t __stop_telem_tbl[] __attribute__((weak));
+
+static uart_port_t telem_port;
+static telem_sink_t telem_sink;
+static uint32_t telem_period_ms;
+static uint8_t telem_batch;
+static uint32_t telem_nchan;
+static uint32_t telem_worst; /**< most sample bytes of one period */
+
+/* Frame being built, sampler task only */
+static buf_t *telem_b;
+static uint8_t telem_type;
+static uint32_t telem_tick0;
+static uint8_t telem_nticks;
+static uint8_t telem_seq;
+static uint64_t telem_fresh; /**< channels owing an absolute sample */
+
+static uint64_t telem_cycles_sum;
+static uint32_t telem_ticks;
+static telem_stats_t telem_st;
+
+static uint8_t *telem_varint(uint8_t *p, uint32_t v)
+{
+	while (v >= 0x80) {
+		*p++ = (uint8_t)(v | 0x80);
+		v >>= 7;
+	}
+	*p++ = (uint8_t)v;
+	return p;
+}
+
+static inline uint32_t telem_zigzag(uint32_t d)
+{
+	return (d << 1) ^ (uint32_t)((int32_t)d >> 31);
+}
+
+static uint16_t telem_fletcher16(const uint8_t *p, size_t n)
+{
+	uint32_t a = 0, b = 0;
+
+	while (n--) {
+		a = (a + *p++) % 255;
+		b = (b + a) % 255;
+	}
+	return (uint16_t)(b << 8 | a);
+}
+
+static size_t telem_name_len(const char *name)
+{
+	size_t n = strlen(name);
+
+	return n > TELEM_NAME_MAX ? TELEM_NAME_MAX : n;
+}
+
+/** @brief Schema bytes behind the frame header */
+static size_t telem_schema_len(void)
+{
+	size_t n = TELEM_VARINT_MAX + 1;
+
+	for (uint32_t i = 0; i < telem_nchan; i++)
+		n += 3 + telem_name_len(__start_telem_tbl[i].name);
+	return n;
+}
+
+static void telem_open(telem_frame_t type, uint32_t tick)
+{
+	uint32_t mie;
+
+	telem_b = buf_alloc(TELEM_FRAME_SIZE);
+	if (telem_b == NULL) {
+		/* Lost like a frame the port refused */
+		mie = irq_save();
+		telem_st.dropped++;
+		irq_restore(mie);
+		telem_seq++;
+		return;
+	}
+	telem_type = (uint8_t)type;
+	telem_tick0 = tick;
+	telem_nticks = 0;
+	if (type == TELEM_FRAME_KEY)
+		telem_fresh = ~0ull;
+}
+
+/**
+ * @brief Finish the frame in place and hand it to the port.
+ * @return 0 if sent, -1 if dropped
+ */
+static int telem_close(void)
+{
+	uint8_t hdr[TELEM_HDR_MAX], *p = hdr + 3, *sum;
+	buf_t *b = telem_b;
+	uint32_t len, mie;
+	uint16_t f;
+
+	*p++ = telem_type;
+	*p++ = telem_seq++;
+	p = telem_varint(p, telem_tick0);
+	*p++ = telem_nticks;
+	len = (uint32_t)(p - hdr) - 3 + b->len;
+	hdr[0] = TELEM_SYNC;
+	hdr[1] = (uint8_t)len;
+	hdr[2] = (uint8_t)(len >> 8);
+
+	memcpy(buf_push(b, (size_t)(p - hdr)), hdr, (size_t)(p - hdr));
+	f = telem_fletcher16(b->data + 3, len);
+	sum = buf_put(b, TELEM_SUM_LEN);
+	sum[0] = (uint8_t)f;
+	sum[1] = (uint8_t)(f >> 8);
+	telem_b = NULL;
+
+	len = b->len;
+	if (telem_sink(b, pdMS_TO_TICKS(telem_period_ms)) == 0) {
+		mie = irq_save();
+		telem_st.dropped++;
+		irq_restore(mie);
+		return -1;
+	}
+	mie = irq_save();
+	telem_st.frames++;
+	telem_st.bytes += len;
+	irq_restore(mie);
+	return 0;
+}
+
+static int telem_schema(uint32_t tick)
+{
+	uint8_t *p;
+
+	telem_open(TELEM_FRAME_SCHEMA, tick);
+	if (telem_b == NULL)
+		return -1;
+	p = telem_varint(telem_b->data, telem_period_ms);
+	*p++ = (uint8_t)telem_nchan;
+	for (uint32_t i = 0; i < telem_nchan; i++) {
+		const telem_chan_t *c = &__start_telem_tbl[i];
+		size_t n = telem_name_len(c->name);
+
+		*p++ = c->kind;
+		*p++ = c->div;
+		*p++ = (uint8_t)n;
+		memcpy(p, c->name, n);
+		p += n;
+	}
+	telem_b->len = (uint16_t)(p - telem_b->data);
+	return telem_close();
+}
+
+/** @brief Append the channels due at tick to the open frame */
+static uint32_t telem_sample(uint32_t tick)
+{
+	uint8_t *p = telem_b->data + telem_b->len;
+	uint32_t n = 0;
+
+	for (uint32_t i = 0; i < telem_nchan; i++) {
+		const telem_chan_t *c = &__start_telem_tbl[i];
+		uint64_t bit = 1ull << i;
+		uint32_t base, v;
+
+		if (tick % c->div)
+			continue;
+		base = telem_fresh & bit ? 0 : c->prev[0];
+		switch (c->kind) {
+		case TELEM_KIND_COUNTER:
+			v = *(const volatile uint32_t *)c->src;
+			p = telem_varint(p, v - base);
+			c->prev[0] = v;
+			break;
+		case TELEM_KIND_GAUGE:
+			v = c->get ? (uint32_t)c->get() :
+				     *(const volatile uint32_t *)c->src;
+			p = telem_varint(p, telem_zigzag(v - base));
+			c->prev[0] = v;
+			break;
+		default:
+			for (uint32_t j = 0; j < TELEM_HIST_BINS; j++) {
+				v = ((const volatile telem_hist_t *)c->src)
+					    ->bins[j];
+				base = telem_fresh & bit ? 0 : c->prev[j];
+				p = telem_varint(p, v - base);
+				c->prev[j] = v;
+			}
+			break;
+		}
+		telem_fresh &= ~bit;
+		n++;
+	}
+	telem_b->len = (uint16_t)(p - telem_b->data);
+	telem_nticks++;
+	return n;
+}
+
+static void telem_task(__attribute__((unused)) void *arg)
+{
+	TickType_t last = xTaskGetTickCount();
+	TickType_t schema_at = last;
+	uint32_t tick = 0, since_key = 0;
+	int key = 1, schema = 1;
+
+	while (1) {
+		uint32_t c0, d, n, mie;
+
+		vTaskDelayUntil(&last, pdMS_TO_TICKS(telem_period_ms));
+		if (schema ||
+		    last - schema_at >= pdMS_TO_TICKS(TELEM_SCHEMA_MS)) {
+			if (telem_b)
+				telem_close();
+			/* Retried every period until a decoder can have it */
+			schema = telem_schema(tick) != 0;
+			schema_at = last;
+			key = 1;
+		}
+		if (telem_b == NULL) {
+			if (key || since_key >= TELEM_KEY_EVERY) {
+				telem_open(TELEM_FRAME_KEY, tick);
+				since_key = 0;
+			} else {
+				telem_open(TELEM_FRAME_DELTA, tick);
+			}
+			/* Sent or not, the next frame is the one to decode */
+			key = telem_b == NULL;
+			since_key++;
+		}
+
+		if (telem_b) {
+			c0 = csr_read_mcycle();
+			n = telem_sample(tick);
+			d = csr_read_mcycle() - c0;
+
+			mie = irq_save();
+			telem_st.samples += n;
+			telem_cycles_sum += d;
+			telem_ticks++;
+			if (d > telem_st.tick_cycles_max)
+				telem_st.tick_cycles_max = d;
+			irq_restore(mie);
+
+			if ((telem_nticks == telem_batch ||
+			     buf_tailroom(telem_b) <
+				     telem_worst + TELEM_SUM_LEN) &&
+			    telem_close() != 0)
+				key = 1;
+		}
+		tick++;
+	}
+}
+
+void telem_get_stats(telem_stats_t *stats)
+{
+	uint32_t mie = irq_save();
+
+	*stats = telem_st;
+	stats->tick_cycles_avg =
+		telem_ticks ? telem_cycles_sum / telem_ticks : 0;
+	irq_restore(mie);
+}
+
+static size_t telem_uart(buf_t *b, TickType_t timeout)
+{
+	return uart_write_buf(telem_port, b, timeout);
+}
+
+/** @brief Check the table and the parameters */
+static int telem_setup(uint32_t period_ms, uint8_t batch)
+{
+	telem_nchan = (uint32_t)(__stop_telem_tbl - __start_telem_tbl);
+	if (telem_nchan > TELEM_CHAN_MAX || period_ms == 0 || batch == 0)
+		return -1;
+	telem_worst = 0;
+	for (uint32_t i = 0; i < telem_nchan; i++) {
+		const telem_chan_t *c = &__start_telem_tbl[i];
+
+		if (c->div == 0)
+			return -1;
+		telem_worst += c->kind == TELEM_KIND_HIST ?
+				       TELEM_VARINT_MAX * TELEM_HIST_BINS :
+				       TELEM_VARINT_MAX;
+	}
+	if (telem_worst + TELEM_SUM_LEN > TELEM_FRAME_SIZE ||
+	    telem_schema_len() + TELEM_SUM_LEN > TELEM_FRAME_SIZE)
+		return -1;
+	telem_period_ms = period_ms;
+	telem_batch = batch;
+	return 0;
+}
+
+int telem_start_sink(telem_sink_t sink, uint32_t period_ms, uint8_t batch,
+		     uint32_t prio)
+{
+	if (sink == NULL || telem_setup(period_ms, batch) != 0)
+		return -1;
+	telem_sink = sink;
+	if (xTaskCreate(telem_task, "telem", 256, NULL, prio, NULL) != pdPASS)
+		return -1;
+	return 0;
+}
+
+int telem_start(uart_port_t port, uint32_t baud, uint32_t period_ms,
+		uint8_t batch, uint32_t prio)
+{
+	uart_config_t cfg = {
+		.baud = baud,
+		.tx_buf_size = 1024,
+		.rx_buf_size = 16,
+		.use_dma = 1,
+		.irq_prio = 1,
+	};
+
+	if (telem_setup(period_ms, batch) != 0)
+		return -1;
+	/* Ports without TX DMA copy, slower but just as correct */
+	if (uart_init(port, &cfg) != 0) {
+		cfg.use_dma = 0;
+		if (uart_init(port, &cfg) != 0)
+			return -1;
+	}
+	telem_port = port;
+	return telem_start_sink(telem_uart, period_ms, batch, prio);
+}
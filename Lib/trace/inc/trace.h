@@ -0,0 +1,84 @@
+#ifndef __trace_h__
+#define __trace_h__
+
+#include <stdint.h>
+#include "trace_hooks.h"
+#include "uart.h"
+
+/*! CPP guard */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Kernel event tracing switch, set by the TRACE_ENABLE CMake
+ * option. With 0 the kernel hooks stay empty and the API below
+ * compiles to nothing.
+ */
+#ifndef TRACE_ENABLE
+#define TRACE_ENABLE 0
+#endif
+
+/** @brief Ring capacity in 8-byte records, power of two */
+#ifndef TRACE_RING_SIZE
+#define TRACE_RING_SIZE 1024
+#endif
+
+/** @brief Recorder statistics, also sent in TRACE_EV_STATS records */
+typedef struct {
+	uint32_t events; /**< records written to the ring */
+	uint32_t dropped; /**< records lost to a full ring */
+	uint32_t rec_cycles_max; /**< worst recorder cost, mcycle */
+	uint32_t rec_cycles_avg;
+	uint32_t ring_hwm; /**< max ring fill, records */
+	uint32_t sent_bytes;
+} trace_stats_t;
+
+#if TRACE_ENABLE
+
+/**
+ * @brief Start recording and streaming.
+ * @param port UART to stream on, opened here with DMA TX
+ * @param baud Port speed; one record is 8 bytes
+ * @param period_ms Ring drain period
+ * @param prio Streaming task priority
+ * @return 0 on success, -1 on UART or task creation failure
+ *
+ * The stream opens with a sync record, the clock and the names
+ * of all existing tasks. Events of the streaming task itself are
+ * recorded too, they mark every drain on the timeline.
+ */
+int trace_start(uart_port_t port, uint32_t baud, uint32_t period_ms,
+		uint32_t prio);
+
+/** @brief Application marker, shown as an instant event on the host */
+static inline void trace_mark(uint16_t id, uint8_t arg)
+{
+	trace_event(TRACE_EV_USER, arg, id);
+}
+
+/** @brief Copy recorder statistics */
+void trace_get_stats(trace_stats_t *stats);
+
+#else
+
+static inline int trace_start(__attribute__((unused)) uart_port_t port,
+			      __attribute__((unused)) uint32_t baud,
+			      __attribute__((unused)) uint32_t period_ms,
+			      __attribute__((unused)) uint32_t prio)
+{
+	return 0;
+}
+
+static inline void trace_mark(__attribute__((unused)) uint16_t id,
+			      __attribute__((unused)) uint8_t arg)
+{
+}
+
+#endif /* TRACE_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif /* End of CPP guard */
+
+#endif //__trace_h__
@@ -0,0 +1,139 @@
+#ifndef __trace_hooks_h__
+#define __trace_hooks_h__
+
+/*
+ * Kernel trace macros, pulled into FreeRTOSConfig.h when the
+ * TRACE_ENABLE option is on. The macros expand inside tasks.c and
+ * queue.c and read the kernel's private TCB and queue fields, so
+ * this header must not include any FreeRTOS header itself.
+ */
+
+#include <stdint.h>
+
+/*! CPP guard */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Event types of the binary stream.
+ *
+ * Every record is 8 bytes: mcycle timestamp, type, arg, id (all
+ * little endian). Types with TRACE_EV_PAYLOAD set are followed by
+ * arg bytes of payload, padded to whole records.
+ */
+#define TRACE_EV_PAYLOAD 0x80
+
+#define TRACE_EV_TASK_IN 0x01 /**< id task, arg priority */
+#define TRACE_EV_TASK_OUT 0x02 /**< id task, arg priority */
+#define TRACE_EV_TASK_READY 0x03 /**< id task, arg priority */
+#define TRACE_EV_TASK_DELETE 0x04 /**< id task */
+#define TRACE_EV_TASK_DELAY 0x05 /**< running task blocks on a delay */
+#define TRACE_EV_PRIO_INHERIT 0x06 /**< id mutex holder, arg new prio */
+#define TRACE_EV_PRIO_DISINHERIT 0x07 /**< id holder, arg restored prio */
+#define TRACE_EV_QUEUE_CREATE 0x10 /**< id queue, arg queue type */
+#define TRACE_EV_QUEUE_SEND 0x11 /**< id queue, arg items after */
+#define TRACE_EV_QUEUE_RECV 0x12
+#define TRACE_EV_QUEUE_BLOCK_SEND 0x13
+#define TRACE_EV_QUEUE_BLOCK_RECV 0x14
+#define TRACE_EV_QUEUE_SEND_ISR 0x15
+#define TRACE_EV_QUEUE_RECV_ISR 0x16
+#define TRACE_EV_NOTIFY_BLOCK 0x17 /**< running task waits a notification */
+#define TRACE_EV_NOTIFY_ISR 0x18 /**< id notified task */
+#define TRACE_EV_ISR_ENTER 0x20 /**< id mcause interrupt code */
+#define TRACE_EV_ISR_EXIT 0x21
+#define TRACE_EV_TICK 0x22 /**< only with TRACE_TICKS */
+#define TRACE_EV_USER 0x30 /**< trace_mark() */
+#define TRACE_EV_DROPPED 0x40 /**< id events lost before this one */
+#define TRACE_EV_TASK_NAME (TRACE_EV_PAYLOAD | 0x01) /**< id task */
+#define TRACE_EV_QUEUE_NAME (TRACE_EV_PAYLOAD | 0x02) /**< id queue */
+#define TRACE_EV_CLOCK (TRACE_EV_PAYLOAD | 0x03) /**< u32 mcycle Hz */
+#define TRACE_EV_STATS (TRACE_EV_PAYLOAD | 0x04) /**< trace_stats_t */
+/** @brief Stream alignment marker, ts holds TRACE_SYNC_MAGIC */
+#define TRACE_EV_SYNC 0xFF
+#define TRACE_SYNC_MAGIC 0x31435254UL /* "TRC1" */
+#define TRACE_SYNC_ID 0xA55A
+
+/** @brief Record one event, any context */
+void trace_event(uint8_t type, uint8_t arg, uint16_t id);
+/** @brief Record a name event (task or queue) */
+void trace_name(uint8_t type, uint16_t id, const char *name);
+/** @brief Next queue id, stored in the queue's uxQueueNumber */
+uint16_t trace_queue_id(void);
+/** @brief Record interrupt entry or exit with the current mcause */
+void trace_isr(uint8_t type);
+
+#define trace_tcb_event(type, tcb)                   \
+	trace_event((type), (uint8_t)(tcb)->uxPriority, \
+		    (uint16_t)(tcb)->uxTCBNumber)
+#define trace_queue_event(type, q)                          \
+	trace_event((type), (uint8_t)(q)->uxMessagesWaiting, \
+		    (uint16_t)(q)->uxQueueNumber)
+
+/* Scheduling */
+#define traceTASK_SWITCHED_IN() trace_tcb_event(TRACE_EV_TASK_IN, pxCurrentTCB)
+#define traceTASK_SWITCHED_OUT() \
+	trace_tcb_event(TRACE_EV_TASK_OUT, pxCurrentTCB)
+#define traceMOVED_TASK_TO_READY_STATE(pxTCB) \
+	trace_tcb_event(TRACE_EV_TASK_READY, pxTCB)
+#define traceTASK_CREATE(pxNewTCB)                         \
+	trace_name(TRACE_EV_TASK_NAME,                     \
+		   (uint16_t)(pxNewTCB)->uxTCBNumber,      \
+		   (pxNewTCB)->pcTaskName)
+#define traceTASK_DELETE(pxTCB) trace_tcb_event(TRACE_EV_TASK_DELETE, pxTCB)
+#define traceTASK_DELAY() trace_event(TRACE_EV_TASK_DELAY, 0, 0)
+#define traceTASK_DELAY_UNTIL(...) trace_event(TRACE_EV_TASK_DELAY, 0, 0)
+#define traceTASK_PRIORITY_INHERIT(pxTCB, uxPrio)             \
+	trace_event(TRACE_EV_PRIO_INHERIT, (uint8_t)(uxPrio), \
+		    (uint16_t)(pxTCB)->uxTCBNumber)
+#define traceTASK_PRIORITY_DISINHERIT(pxTCB, uxPrio)             \
+	trace_event(TRACE_EV_PRIO_DISINHERIT, (uint8_t)(uxPrio), \
+		    (uint16_t)(pxTCB)->uxTCBNumber)
+#define traceTASK_NOTIFY_TAKE_BLOCK(...) \
+	trace_event(TRACE_EV_NOTIFY_BLOCK, 0, 0)
+#define traceTASK_NOTIFY_WAIT_BLOCK(...) \
+	trace_event(TRACE_EV_NOTIFY_BLOCK, 0, 0)
+#define traceTASK_NOTIFY_GIVE_FROM_ISR(...) \
+	trace_tcb_event(TRACE_EV_NOTIFY_ISR, pxTCB)
+#define traceTASK_NOTIFY_FROM_ISR(...) \
+	trace_tcb_event(TRACE_EV_NOTIFY_ISR, pxTCB)
+
+/* Queues, semaphores and mutexes */
+#define traceQUEUE_CREATE(pxNewQueue)                                 \
+	do {                                                          \
+		(pxNewQueue)->uxQueueNumber = trace_queue_id();       \
+		trace_event(TRACE_EV_QUEUE_CREATE,                    \
+			    (pxNewQueue)->ucQueueType,                \
+			    (uint16_t)(pxNewQueue)->uxQueueNumber);   \
+	} while (0)
+#define traceQUEUE_REGISTRY_ADD(xQueue, pcQueueName) \
+	trace_name(TRACE_EV_QUEUE_NAME,              \
+		   (uint16_t)(xQueue)->uxQueueNumber, (pcQueueName))
+#define traceQUEUE_SEND(pxQueue) \
+	trace_queue_event(TRACE_EV_QUEUE_SEND, pxQueue)
+#define traceQUEUE_RECEIVE(pxQueue) \
+	trace_queue_event(TRACE_EV_QUEUE_RECV, pxQueue)
+#define traceBLOCKING_ON_QUEUE_SEND(pxQueue) \
+	trace_queue_event(TRACE_EV_QUEUE_BLOCK_SEND, pxQueue)
+#define traceBLOCKING_ON_QUEUE_RECEIVE(pxQueue) \
+	trace_queue_event(TRACE_EV_QUEUE_BLOCK_RECV, pxQueue)
+#define traceQUEUE_SEND_FROM_ISR(pxQueue) \
+	trace_queue_event(TRACE_EV_QUEUE_SEND_ISR, pxQueue)
+#define traceQUEUE_RECEIVE_FROM_ISR(pxQueue) \
+	trace_queue_event(TRACE_EV_QUEUE_RECV_ISR, pxQueue)
+
+/* Interrupts, called by freeRTOS_RiscV_provider.c */
+#define traceISR_ENTER() trace_isr(TRACE_EV_ISR_ENTER)
+#define traceISR_EXIT() trace_isr(TRACE_EV_ISR_EXIT)
+
+/** @brief Tick events cost 8 bytes per tick, off by default */
+#if defined(TRACE_TICKS) && (TRACE_TICKS == 1)
+#define traceTASK_INCREMENT_TICK(xTickCount) \
+	trace_event(TRACE_EV_TICK, 0, (uint16_t)(xTickCount))
+#endif
+
+#ifdef __cplusplus
+}
+#endif /* End of CPP guard */
+
+#endif //__trace_hooks_h__
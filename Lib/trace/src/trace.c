@@ -0,0 +1,277 @@
+#include "trace.h"
+
+#if TRACE_ENABLE
+
+#include <string.h>
+#include "K1921VG015.h"
+#include "system_k1921vg015.h"
+#include "riscv-csr.h"
+#include "riscv-irq.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "clk.h"
+
+#if (TRACE_RING_SIZE & (TRACE_RING_SIZE - 1)) != 0
+#error "TRACE_RING_SIZE must be a power of two"
+#endif
+
+#define TRACE_RING_MASK (TRACE_RING_SIZE - 1)
+/** @brief Longest name sent, bytes */
+#define TRACE_NAME_MAX 16
+/** @brief Period of TRACE_EV_STATS records */
+#define TRACE_STATS_PERIOD_MS 1000
+/**
+ * @brief Tasks named at stream start. With more tasks none are
+ * named there; tasks created later are named by their create event.
+ */
+#define TRACE_MAX_TASKS 16
+
+typedef struct {
+	uint32_t ts;
+	uint8_t type;
+	uint8_t arg;
+	uint16_t id;
+} trace_rec_t;
+
+static trace_rec_t trace_ring[TRACE_RING_SIZE];
+/* Free running record counters, head written by recorders only */
+static volatile uint32_t trace_head;
+static volatile uint32_t trace_tail;
+static volatile uint8_t trace_on;
+static uint32_t trace_lost; /**< drops not reported in the stream yet */
+static uint64_t trace_cycles_sum;
+static trace_stats_t trace_st;
+static uint16_t trace_queues;
+
+static uart_port_t trace_port;
+static uint32_t trace_period_ms;
+
+/**
+ * @brief Reserve n records, report earlier drops first.
+ * @return First record or NULL if the ring is full. Lock held.
+ */
+static trace_rec_t *trace_reserve(uint32_t n, uint32_t ts)
+{
+	uint32_t used = trace_head - trace_tail;
+	trace_rec_t *r;
+
+	if (used + n + (trace_lost ? 1 : 0) > TRACE_RING_SIZE) {
+		trace_lost += n;
+		trace_st.dropped += n;
+		return NULL;
+	}
+	if (trace_lost) {
+		r = &trace_ring[trace_head & TRACE_RING_MASK];
+		r->ts = ts;
+		r->type = TRACE_EV_DROPPED;
+		r->arg = 0;
+		r->id = trace_lost > 0xFFFF ? 0xFFFF : trace_lost;
+		trace_lost = 0;
+		trace_head++;
+		used++;
+	}
+	if (used + n > trace_st.ring_hwm)
+		trace_st.ring_hwm = used + n;
+	return &trace_ring[trace_head & TRACE_RING_MASK];
+}
+
+/** @brief Cost of the call, from its timestamp to now. Lock held. */
+static inline void trace_account(uint32_t t0, uint32_t n)
+{
+	uint32_t d = csr_read_mcycle() - t0;
+
+	trace_st.events += n;
+	trace_cycles_sum += d;
+	if (d > trace_st.rec_cycles_max)
+		trace_st.rec_cycles_max = d;
+}
+
+void trace_event(uint8_t type, uint8_t arg, uint16_t id)
+{
+	uint32_t t0 = csr_read_mcycle();
+	uint32_t mie;
+	trace_rec_t *r;
+
+	if (!trace_on)
+		return;
+
+	mie = irq_save();
+	r = trace_reserve(1, t0);
+	if (r) {
+		r->ts = t0;
+		r->type = type;
+		r->arg = arg;
+		r->id = id;
+		trace_head++;
+		trace_account(t0, 1);
+	}
+	irq_restore(mie);
+}
+
+/** @brief Header record and payload; payload may wrap the ring */
+static void trace_payload(uint8_t type, uint16_t id, const void *data,
+			  uint32_t len)
+{
+	uint32_t t0 = csr_read_mcycle();
+	uint32_t n = 1 + (len + sizeof(trace_rec_t) - 1) / sizeof(trace_rec_t);
+	const uint8_t *src = data;
+	uint32_t mie;
+	trace_rec_t *r;
+
+	if (!trace_on)
+		return;
+
+	mie = irq_save();
+	r = trace_reserve(n, t0);
+	if (r) {
+		r->ts = t0;
+		r->type = type;
+		r->arg = len;
+		r->id = id;
+		trace_head++;
+		while (len) {
+			uint32_t k = len < sizeof(trace_rec_t) ?
+					     len :
+					     sizeof(trace_rec_t);
+
+			r = &trace_ring[trace_head & TRACE_RING_MASK];
+			memset(r, 0, sizeof(*r));
+			memcpy(r, src, k);
+			src += k;
+			len -= k;
+			trace_head++;
+		}
+		trace_account(t0, n);
+	}
+	irq_restore(mie);
+}
+
+void trace_name(uint8_t type, uint16_t id, const char *name)
+{
+	uint32_t len = 0;
+
+	while (len < TRACE_NAME_MAX && name[len])
+		len++;
+	trace_payload(type, id, name, len);
+}
+
+uint16_t trace_queue_id(void)
+{
+	uint32_t mie = irq_save();
+	uint16_t id = ++trace_queues;
+
+	irq_restore(mie);
+	return id;
+}
+
+void trace_isr(uint8_t type)
+{
+	trace_event(type, 0, csr_read_mcause() & 0xFF);
+}
+
+void trace_get_stats(trace_stats_t *stats)
+{
+	uint32_t mie = irq_save();
+
+	*stats = trace_st;
+	stats->rec_cycles_avg =
+		trace_st.events ? trace_cycles_sum / trace_st.events : 0;
+	irq_restore(mie);
+}
+
+/** @brief Sync, clock and the names of tasks created before start */
+static void trace_header(void)
+{
+	static TaskStatus_t tasks[TRACE_MAX_TASKS];
+	uint32_t hz = SystemCoreClock;
+	UBaseType_t n;
+	uint32_t mie = irq_save();
+	trace_rec_t *r = trace_reserve(1, 0);
+
+	/* Sync goes first, recording starts behind it */
+	r->ts = TRACE_SYNC_MAGIC;
+	r->type = TRACE_EV_SYNC;
+	r->arg = 0;
+	r->id = TRACE_SYNC_ID;
+	trace_head++;
+	trace_on = 1;
+	irq_restore(mie);
+
+	trace_payload(TRACE_EV_CLOCK, 0, &hz, sizeof(hz));
+	n = uxTaskGetSystemState(tasks, TRACE_MAX_TASKS, NULL);
+	for (UBaseType_t i = 0; i < n; i++)
+		trace_name(TRACE_EV_TASK_NAME, tasks[i].xTaskNumber,
+			   tasks[i].pcTaskName);
+}
+
+/** @brief Send the filled part of the ring, in at most two pieces */
+static void trace_drain(void)
+{
+	uint32_t n;
+
+	while ((n = trace_head - trace_tail) != 0) {
+		uint32_t idx = trace_tail & TRACE_RING_MASK;
+		uint32_t bytes;
+
+		if (n > TRACE_RING_SIZE - idx)
+			n = TRACE_RING_SIZE - idx;
+		bytes = n * sizeof(trace_rec_t);
+		uart_write(trace_port, &trace_ring[idx], bytes,
+			   UART_WAIT_FOREVER);
+		trace_st.sent_bytes += bytes;
+		trace_tail += n;
+	}
+}
+
+static void trace_task(__attribute__((unused)) void *arg)
+{
+	TickType_t last = xTaskGetTickCount();
+	TickType_t stats_at = last;
+	trace_stats_t st;
+
+	trace_header();
+	while (1) {
+		vTaskDelayUntil(&last, pdMS_TO_TICKS(trace_period_ms));
+		if (last - stats_at >= pdMS_TO_TICKS(TRACE_STATS_PERIOD_MS)) {
+			stats_at = last;
+			trace_get_stats(&st);
+			trace_payload(TRACE_EV_STATS, 0, &st, sizeof(st));
+		}
+		trace_drain();
+	}
+}
+
+/** @brief mcycle changes rate with the core clock: tell the decoder */
+static int trace_clk_cb(clk_event_t ev,
+			__attribute__((unused)) uint32_t old_hz,
+			uint32_t new_hz, __attribute__((unused)) void *arg)
+{
+	if (ev == CLK_CHANGE && trace_on)
+		trace_payload(TRACE_EV_CLOCK, 0, &new_hz, sizeof(new_hz));
+	return 0;
+}
+
+int trace_start(uart_port_t port, uint32_t baud, uint32_t period_ms,
+		uint32_t prio)
+{
+	static clk_notifier_t clk;
+
+	const uart_config_t cfg = {
+		.baud = baud,
+		.tx_buf_size = 1024,
+		.rx_buf_size = 16,
+		.use_dma = 1,
+		.irq_prio = 1,
+	};
+
+	if (uart_init(port, &cfg) != 0)
+		return -1;
+	trace_port = port;
+	trace_period_ms = period_ms;
+	clk_notifier_register(&clk, trace_clk_cb, NULL);
+	if (xTaskCreate(trace_task, "trace", 256, NULL, prio, NULL) != pdPASS)
+		return -1;
+	return 0;
+}
+
+#endif /* TRACE_ENABLE */
@@ -0,0 +1,160 @@
+#ifndef __uart_h__
+#define __uart_h__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "buf.h"
+
+/*! CPP guard */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Return immediately if the request cannot be served */
+#define UART_NO_WAIT ((TickType_t)0)
+/** @brief Block until the whole request is served */
+#define UART_WAIT_FOREVER portMAX_DELAY
+
+typedef enum {
+	UART_PORT0 = 0,
+	UART_PORT1,
+	UART_PORT2,
+	UART_PORT3,
+	UART_PORT4,
+	UART_PORT_COUNT
+} uart_port_t;
+
+/**
+ * @brief Port configuration.
+ *
+ * Buffer sizes are the capacity of the TX/RX stream buffers.
+ * With use_dma set the TX path is fed by the port's DMA channel,
+ * otherwise by the FIFO interrupt. RX always runs on the FIFO
+ * level and receive timeout interrupts.
+ */
+typedef struct {
+	uint32_t baud;
+	uint16_t tx_buf_size;
+	uint16_t rx_buf_size;
+	uint8_t use_dma;
+	uint8_t irq_prio;
+} uart_config_t;
+
+/** @brief Port statistics, counted since init or last reset */
+typedef struct {
+	uint32_t tx_bytes;
+	uint32_t rx_bytes;
+	uint32_t rx_overruns; /**< bytes lost in the hardware FIFO */
+	uint32_t rx_dropped; /**< bytes lost due to a full RX stream buffer */
+	uint32_t framing_errors;
+	uint32_t parity_errors;
+	uint32_t breaks;
+	uint32_t rx_irq_max; /**< max bytes read in one RX interrupt */
+	uint32_t tx_dma_chunks;
+} uart_stats_t;
+
+/**
+ * @brief Default configuration: 115200 8N1, 256 byte buffers, no DMA.
+ */
+#define UART_CONFIG_DEFAULT                                      \
+	{                                                        \
+		.baud = 115200, .tx_buf_size = 256,              \
+		.rx_buf_size = 256, .use_dma = 0, .irq_prio = 1, \
+	}
+
+/**
+ * @brief Initialize UART port.
+ * @param port Port number
+ * @param cfg Port configuration
+ * @return 0 on success, -1 on bad arguments or lack of memory
+ *
+ * Enables clocks, routes the port pins (when the board pins are
+ * known to the driver), creates the stream buffers and enables
+ * the interrupts. Must be called before the scheduler starts or
+ * from a single task.
+ */
+int uart_init(uart_port_t port, const uart_config_t *cfg);
+
+/**
+ * @brief Queue data for transmission.
+ * @param port Port number
+ * @param data Data to send
+ * @param len Data length
+ * @param timeout Max time to wait for buffer space
+ * @return Number of bytes queued
+ *
+ * Thread safe: concurrent writers are serialized per port.
+ */
+size_t uart_write(uart_port_t port, const void *data, size_t len,
+		  TickType_t timeout);
+
+/**
+ * @brief Read received data.
+ * @param port Port number
+ * @param buf Destination buffer
+ * @param len Number of bytes wanted
+ * @param timeout Max time to wait for the whole request
+ * @return Number of bytes read
+ *
+ * Thread safe: concurrent readers are serialized per port.
+ */
+size_t uart_read(uart_port_t port, void *buf, size_t len, TickType_t timeout);
+
+/**
+ * @brief Read whatever arrived, waiting only for the first byte.
+ * @return Number of bytes read, 0 on timeout
+ */
+size_t uart_read_some(uart_port_t port, void *buf, size_t len,
+		      TickType_t timeout);
+
+/**
+ * @brief Send a buffer chain, taking over the caller's reference.
+ * @param port Port number
+ * @param b Chain to send, released once it left the transmitter
+ * @param timeout Max time to wait for the port
+ * @return Number of bytes queued, 0 if the port stayed busy
+ *
+ * On a DMA port the segments are sent straight from the buffers and
+ * the call returns as soon as the chain is queued; other ports copy
+ * into the TX stream buffer like uart_write(). The reference is
+ * dropped in every case.
+ */
+size_t uart_write_buf(uart_port_t port, buf_t *b, TickType_t timeout);
+
+/**
+ * @brief Append received data to a buffer.
+ * @param len Number of bytes wanted, clipped to the buffer's tailroom
+ * @return Number of bytes read, see uart_read()
+ */
+size_t uart_read_buf(uart_port_t port, buf_t *b, size_t len,
+		     TickType_t timeout);
+
+/**
+ * @brief Wait until all queued data left the transmitter.
+ * @return pdTRUE if drained within timeout
+ */
+BaseType_t uart_flush(uart_port_t port, TickType_t timeout);
+
+/**
+ * @brief Send a character bypassing the stream buffer.
+ *
+ * Busy-waits on the FIFO; usable before the scheduler starts,
+ * from interrupts and from fault handlers.
+ */
+void uart_putc_polled(uart_port_t port, char ch);
+
+/** @brief Receive a character bypassing the stream buffer (busy-wait) */
+int uart_getc_polled(uart_port_t port);
+
+/** @brief Copy port statistics */
+void uart_get_stats(uart_port_t port, uart_stats_t *stats);
+
+/** @brief Clear port statistics */
+void uart_reset_stats(uart_port_t port);
+
+#ifdef __cplusplus
+}
+#endif /* End of CPP guard */
+
+#endif //__uart_h__
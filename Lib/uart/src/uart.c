@@ -0,0 +1,550 @@
+#include <string.h>
+#include "uart.h"
+#include "dma.h"
+#include "plic.h"
+#include "task.h"
+#include "semphr.h"
+#include "stream_buffer.h"
+
+/** @brief UART kernel clock, every port is clocked from HSE */
+#define UART_CLK_HZ HSECLK_VAL
+/** @brief Depth of the hardware TX/RX FIFOs */
+#define UART_FIFO_DEPTH 16
+/** @brief Largest block handed to the TX DMA channel at once */
+#define UART_DMA_CHUNK 64
+
+#define UART_DR_ERR_Msk                                          \
+	(UART_DR_OE_Msk | UART_DR_BE_Msk | UART_DR_PE_Msk | \
+	 UART_DR_FE_Msk)
+
+/**
+ * @brief Fixed per-instance resources.
+ *
+ * Pin routing is only known for the ports wired on the board;
+ * ports with gpio == NULL expect the board code to route pins.
+ */
+typedef struct {
+	UART_TypeDef *regs;
+	IsrVect_TypeDef irq;
+	uint32_t cg_msk;
+	uint32_t rst_msk;
+	GPIO_TypeDef *gpio;
+	uint8_t rx_pin;
+	uint8_t tx_pin;
+	uint8_t dma_tx_ch;
+} uart_hw_t;
+
+typedef struct {
+	const uart_hw_t *hw;
+	StreamBufferHandle_t tx_sb;
+	StreamBufferHandle_t rx_sb;
+	SemaphoreHandle_t tx_lock;
+	SemaphoreHandle_t rx_lock;
+	SemaphoreHandle_t tx_slot; /**< given while no chain is queued */
+	buf_t *tx_chain; /**< chain being sent, released when done */
+	buf_t *tx_seg;
+	uint16_t tx_off;
+	volatile uint8_t tx_active;
+	uint8_t use_dma;
+	uart_stats_t stats;
+	uint8_t dma_buf[UART_DMA_CHUNK] __attribute__((aligned(4)));
+} uart_ctx_t;
+
+static const uart_hw_t uart_hw[UART_PORT_COUNT] = {
+	[UART_PORT0] = {
+		.regs = UART0,
+		.irq = IsrVect_IRQ_UART0,
+		.cg_msk = RCU_CGCFGAPB_UART0EN_Msk,
+		.rst_msk = RCU_RSTDISAPB_UART0EN_Msk,
+		.gpio = GPIOA,
+		.rx_pin = 0,
+		.tx_pin = 1,
+		.dma_tx_ch = DMA_CH_NONE,
+	},
+	[UART_PORT1] = {
+		.regs = UART1,
+		.irq = IsrVect_IRQ_UART1,
+		.cg_msk = RCU_CGCFGAPB_UART1EN_Msk,
+		.rst_msk = RCU_RSTDISAPB_UART1EN_Msk,
+		.gpio = GPIOA,
+		.rx_pin = 2,
+		.tx_pin = 3,
+		.dma_tx_ch = 9,
+	},
+	[UART_PORT2] = {
+		.regs = UART2,
+		.irq = IsrVect_IRQ_UART2,
+		.cg_msk = RCU_CGCFGAPB_UART2EN_Msk,
+		.rst_msk = RCU_RSTDISAPB_UART2EN_Msk,
+		.gpio = NULL,
+		.dma_tx_ch = DMA_CH_NONE,
+	},
+	[UART_PORT3] = {
+		.regs = UART3,
+		.irq = IsrVect_IRQ_UART3,
+		.cg_msk = RCU_CGCFGAPB_UART3EN_Msk,
+		.rst_msk = RCU_RSTDISAPB_UART3EN_Msk,
+		.gpio = NULL,
+		.dma_tx_ch = DMA_CH_NONE,
+	},
+	[UART_PORT4] = {
+		.regs = UART4,
+		.irq = IsrVect_IRQ_UART4,
+		.cg_msk = RCU_CGCFGAPB_UART4EN_Msk,
+		.rst_msk = RCU_RSTDISAPB_UART4EN_Msk,
+		.gpio = NULL,
+		.dma_tx_ch = DMA_CH_NONE,
+	},
+};
+
+static uart_ctx_t uart_ctx[UART_PORT_COUNT];
+
+static void uart_irq(uart_ctx_t *ctx);
+
+#define UART_IRQ_HANDLER(n)                     \
+	static void uart##n##_irq_handler(void) \
+	{                                       \
+		uart_irq(&uart_ctx[n]);         \
+	}
+
+UART_IRQ_HANDLER(0)
+UART_IRQ_HANDLER(1)
+UART_IRQ_HANDLER(2)
+UART_IRQ_HANDLER(3)
+UART_IRQ_HANDLER(4)
+
+static void (*const uart_irq_handlers[UART_PORT_COUNT])(void) = {
+	uart0_irq_handler, uart1_irq_handler, uart2_irq_handler,
+	uart3_irq_handler, uart4_irq_handler,
+};
+
+static void uart_set_baud(UART_TypeDef *regs, uint32_t baud)
+{
+	/* 16x oversampling, 6-bit fraction: divisor * 64 rounded */
+	uint32_t div64 = (UART_CLK_HZ * 4 + baud / 2) / baud;
+
+	regs->IBRD = div64 >> 6;
+	regs->FBRD = div64 & 0x3F;
+}
+
+static void uart_pins_init(const uart_hw_t *hw)
+{
+	uint32_t msk = (1UL << hw->rx_pin) | (1UL << hw->tx_pin);
+	uint32_t num = hw->gpio->ALTFUNCNUM;
+
+	num &= ~((3UL << (hw->rx_pin * 2)) | (3UL << (hw->tx_pin * 2)));
+	num |= (1UL << (hw->rx_pin * 2)) | (1UL << (hw->tx_pin * 2));
+	hw->gpio->ALTFUNCNUM = num;
+	hw->gpio->ALTFUNCSET = msk;
+}
+
+/** @brief Next DMA block of the queued chain, skipping empty segments */
+static size_t uart_tx_seg_next(uart_ctx_t *ctx, const uint8_t **src)
+{
+	while (ctx->tx_seg) {
+		buf_t *seg = ctx->tx_seg;
+		size_t n = seg->len - ctx->tx_off;
+
+		if (n) {
+			if (n > DMA_XFER_MAX)
+				n = DMA_XFER_MAX;
+			*src = seg->data + ctx->tx_off;
+			ctx->tx_off += n;
+			return n;
+		}
+		ctx->tx_seg = seg->next;
+		ctx->tx_off = 0;
+	}
+	return 0;
+}
+
+/**
+ * @brief Start next TX DMA block or go idle.
+ *
+ * Called with interrupts masked (ISR or critical section),
+ * which makes it the only reader of the TX stream buffer.
+ * Stream data always predates a queued chain, so it goes first.
+ */
+static void uart_tx_dma_next(uart_ctx_t *ctx, BaseType_t *woken)
+{
+	const uart_hw_t *hw = ctx->hw;
+	const uint8_t *src = ctx->dma_buf;
+	size_t n = xStreamBufferReceiveFromISR(ctx->tx_sb, ctx->dma_buf,
+					       UART_DMA_CHUNK, woken);
+
+	if (n == 0)
+		n = uart_tx_seg_next(ctx, &src);
+	if (n == 0) {
+		if (ctx->tx_chain) {
+			buf_free(ctx->tx_chain);
+			ctx->tx_chain = NULL;
+			xSemaphoreGiveFromISR(ctx->tx_slot, woken);
+		}
+		hw->regs->DMACR_bit.TXDMAE = 0;
+		ctx->tx_active = 0;
+		return;
+	}
+
+	dma_ch_use_primary(hw->dma_tx_ch);
+	dma_ch_setup(hw->dma_tx_ch, src, &hw->regs->DR, n,
+		     DMA_XFER_BYTE | DMA_XFER_SRC_INC);
+	dma_ch_enable(hw->dma_tx_ch);
+	ctx->stats.tx_bytes += n;
+	ctx->stats.tx_dma_chunks++;
+	ctx->tx_active = 1;
+	hw->regs->DMACR_bit.TXDMAE = 1;
+}
+
+static void uart_tx_dma_done(__attribute__((unused)) uint32_t ch, void *arg)
+{
+	BaseType_t woken = pdFALSE;
+
+	uart_tx_dma_next((uart_ctx_t *)arg, &woken);
+	portYIELD_FROM_ISR(woken);
+}
+
+/**
+ * @brief Move pending TX data into the FIFO.
+ *
+ * Called with interrupts masked. Keeps TX interrupt armed while
+ * data remains in the stream buffer.
+ */
+static void uart_tx_fifo_fill(uart_ctx_t *ctx, BaseType_t *woken)
+{
+	UART_TypeDef *regs = ctx->hw->regs;
+	uint8_t chunk[UART_FIFO_DEPTH];
+	size_t want = regs->FR_bit.TXFE ? UART_FIFO_DEPTH : 1;
+
+	while (!regs->FR_bit.TXFF) {
+		size_t n = xStreamBufferReceiveFromISR(ctx->tx_sb, chunk, want,
+						       woken);
+
+		for (size_t i = 0; i < n; i++)
+			regs->DR = chunk[i];
+		ctx->stats.tx_bytes += n;
+		if (n < want) {
+			if (xStreamBufferIsEmpty(ctx->tx_sb)) {
+				regs->IMSC &= ~UART_IMSC_TXIM_Msk;
+				ctx->tx_active = 0;
+				return;
+			}
+			break;
+		}
+		want = 1;
+	}
+	regs->IMSC |= UART_IMSC_TXIM_Msk;
+	ctx->tx_active = 1;
+}
+
+/** @brief Restart the transmitter if it went idle */
+static void uart_tx_kick(uart_ctx_t *ctx)
+{
+	BaseType_t woken = pdFALSE;
+
+	taskENTER_CRITICAL();
+	if (!ctx->tx_active) {
+		if (ctx->use_dma)
+			uart_tx_dma_next(ctx, &woken);
+		else
+			uart_tx_fifo_fill(ctx, &woken);
+	}
+	taskEXIT_CRITICAL();
+	if (woken)
+		taskYIELD();
+}
+
+static void uart_rx_drain(uart_ctx_t *ctx, BaseType_t *woken)
+{
+	UART_TypeDef *regs = ctx->hw->regs;
+	uint8_t chunk[UART_FIFO_DEPTH];
+	uint32_t total = 0;
+
+	while (!regs->FR_bit.RXFE) {
+		size_t n = 0;
+
+		while (n < sizeof(chunk) && !regs->FR_bit.RXFE) {
+			uint32_t dr = regs->DR;
+
+			if (dr & UART_DR_ERR_Msk) {
+				if (dr & UART_DR_OE_Msk)
+					ctx->stats.rx_overruns++;
+				if (dr & UART_DR_FE_Msk)
+					ctx->stats.framing_errors++;
+				if (dr & UART_DR_PE_Msk)
+					ctx->stats.parity_errors++;
+				if (dr & UART_DR_BE_Msk) {
+					ctx->stats.breaks++;
+					continue;
+				}
+			}
+			chunk[n++] = (uint8_t)dr;
+		}
+		total += n;
+		size_t sent = xStreamBufferSendFromISR(ctx->rx_sb, chunk, n,
+						       woken);
+		ctx->stats.rx_dropped += n - sent;
+	}
+
+	ctx->stats.rx_bytes += total;
+	if (total > ctx->stats.rx_irq_max)
+		ctx->stats.rx_irq_max = total;
+}
+
+static void uart_irq(uart_ctx_t *ctx)
+{
+	UART_TypeDef *regs = ctx->hw->regs;
+	BaseType_t woken = pdFALSE;
+	uint32_t mis = regs->MIS;
+
+	regs->ICR = mis;
+	if (mis & (UART_MIS_RXMIS_Msk | UART_MIS_RTMIS_Msk))
+		uart_rx_drain(ctx, &woken);
+	if (mis & UART_MIS_TXMIS_Msk)
+		uart_tx_fifo_fill(ctx, &woken);
+
+	portYIELD_FROM_ISR(woken);
+}
+
+int uart_init(uart_port_t port, const uart_config_t *cfg)
+{
+	if (port >= UART_PORT_COUNT || cfg == NULL || cfg->baud == 0)
+		return -1;
+
+	const uart_hw_t *hw = &uart_hw[port];
+	uart_ctx_t *ctx = &uart_ctx[port];
+	UART_TypeDef *regs = hw->regs;
+
+	if (cfg->use_dma && hw->dma_tx_ch == DMA_CH_NONE)
+		return -1;
+
+	ctx->hw = hw;
+	ctx->use_dma = cfg->use_dma;
+	memset(&ctx->stats, 0, sizeof(ctx->stats));
+
+	/* Zero sized buffers make a polled-only port */
+	if (cfg->tx_buf_size && cfg->rx_buf_size) {
+		if (ctx->tx_sb == NULL) {
+			ctx->tx_sb = xStreamBufferCreate(cfg->tx_buf_size, 1);
+			ctx->rx_sb = xStreamBufferCreate(cfg->rx_buf_size, 1);
+			ctx->tx_lock = xSemaphoreCreateMutex();
+			ctx->rx_lock = xSemaphoreCreateMutex();
+		}
+		if (!ctx->tx_sb || !ctx->rx_sb || !ctx->tx_lock ||
+		    !ctx->rx_lock)
+			return -1;
+		if (ctx->use_dma && ctx->tx_slot == NULL) {
+			ctx->tx_slot = xSemaphoreCreateBinary();
+			if (ctx->tx_slot == NULL)
+				return -1;
+			xSemaphoreGive(ctx->tx_slot);
+		}
+	}
+
+	RCU->CGCFGAPB |= hw->cg_msk;
+	RCU->RSTDISAPB |= hw->rst_msk;
+
+	if (hw->gpio) {
+		RCU->CGCFGAHB_bit.GPIOAEN = 1;
+		RCU->RSTDISAHB_bit.GPIOAEN = 1;
+		uart_pins_init(hw);
+	}
+
+	RCU->UARTCLKCFG[port].UARTCLKCFG =
+		(RCU_UARTCLKCFG_CLKSEL_HSE << RCU_UARTCLKCFG_CLKSEL_Pos) |
+		RCU_UARTCLKCFG_CLKEN_Msk | RCU_UARTCLKCFG_RSTDIS_Msk;
+
+	regs->CR = 0;
+	uart_set_baud(regs, cfg->baud);
+	regs->LCRH = UART_LCRH_FEN_Msk | (3 << UART_LCRH_WLEN_Pos);
+	/* RX interrupt at 1/2 FIFO, TX interrupt at 1/8 FIFO */
+	regs->IFLS = (2 << UART_IFLS_RXIFLSEL_Pos) |
+		     (0 << UART_IFLS_TXIFLSEL_Pos);
+	regs->ICR = 0x7FF;
+
+	if (ctx->rx_sb) {
+		if (ctx->use_dma) {
+			dma_init();
+			dma_set_handler(hw->dma_tx_ch, uart_tx_dma_done, ctx);
+		}
+		regs->IMSC = UART_IMSC_RXIM_Msk | UART_IMSC_RTIM_Msk;
+		PLIC_SetIrqHandler(Plic_Mach_Target, hw->irq,
+				   uart_irq_handlers[port]);
+		PLIC_SetPriority(hw->irq, cfg->irq_prio);
+		PLIC_IntEnable(Plic_Mach_Target, hw->irq);
+	}
+
+	regs->CR = UART_CR_TXE_Msk | UART_CR_RXE_Msk | UART_CR_UARTEN_Msk;
+	return 0;
+}
+
+size_t uart_write(uart_port_t port, const void *data, size_t len,
+		  TickType_t timeout)
+{
+	uart_ctx_t *ctx = &uart_ctx[port];
+	const uint8_t *p = data;
+	size_t done = 0;
+	TimeOut_t to;
+
+	if (port >= UART_PORT_COUNT || ctx->tx_sb == NULL)
+		return 0;
+
+	vTaskSetTimeOutState(&to);
+	if (xSemaphoreTake(ctx->tx_lock, timeout) != pdTRUE)
+		return 0;
+	/* A queued chain goes out before this data */
+	if (ctx->use_dma) {
+		if (xSemaphoreTake(ctx->tx_slot, timeout) != pdTRUE)
+			len = 0;
+		else
+			xSemaphoreGive(ctx->tx_slot);
+	}
+
+	while (done < len) {
+		done += xStreamBufferSend(ctx->tx_sb, p + done, len - done,
+					  timeout);
+		uart_tx_kick(ctx);
+		if (done < len && xTaskCheckForTimeOut(&to, &timeout) == pdTRUE)
+			break;
+	}
+
+	xSemaphoreGive(ctx->tx_lock);
+	return done;
+}
+
+size_t uart_write_buf(uart_port_t port, buf_t *b, TickType_t timeout)
+{
+	uart_ctx_t *ctx = &uart_ctx[port];
+	size_t len = buf_total_len(b);
+
+	if (port >= UART_PORT_COUNT || ctx->tx_sb == NULL) {
+		buf_free(b);
+		return 0;
+	}
+	if (!ctx->use_dma) {
+		size_t done = 0;
+
+		for (buf_t *seg = b; seg; seg = seg->next)
+			done += uart_write(port, seg->data, seg->len, timeout);
+		buf_free(b);
+		return done;
+	}
+
+	if (xSemaphoreTake(ctx->tx_lock, timeout) != pdTRUE) {
+		buf_free(b);
+		return 0;
+	}
+	/* The slot comes back from the DMA handler once the chain is out */
+	if (xSemaphoreTake(ctx->tx_slot, timeout) != pdTRUE) {
+		xSemaphoreGive(ctx->tx_lock);
+		buf_free(b);
+		return 0;
+	}
+	taskENTER_CRITICAL();
+	ctx->tx_chain = b;
+	ctx->tx_seg = b;
+	ctx->tx_off = 0;
+	taskEXIT_CRITICAL();
+	uart_tx_kick(ctx);
+	xSemaphoreGive(ctx->tx_lock);
+	return len;
+}
+
+size_t uart_read(uart_port_t port, void *buf, size_t len, TickType_t timeout)
+{
+	uart_ctx_t *ctx = &uart_ctx[port];
+	uint8_t *p = buf;
+	size_t done = 0;
+	TimeOut_t to;
+
+	if (port >= UART_PORT_COUNT || ctx->rx_sb == NULL)
+		return 0;
+
+	vTaskSetTimeOutState(&to);
+	if (xSemaphoreTake(ctx->rx_lock, timeout) != pdTRUE)
+		return 0;
+
+	while (done < len) {
+		done += xStreamBufferReceive(ctx->rx_sb, p + done, len - done,
+					     timeout);
+		if (done < len && xTaskCheckForTimeOut(&to, &timeout) == pdTRUE)
+			break;
+	}
+
+	xSemaphoreGive(ctx->rx_lock);
+	return done;
+}
+
+size_t uart_read_buf(uart_port_t port, buf_t *b, size_t len,
+		     TickType_t timeout)
+{
+	if (len > buf_tailroom(b))
+		len = buf_tailroom(b);
+	len = uart_read(port, b->data + b->len, len, timeout);
+	buf_put(b, len);
+	return len;
+}
+
+size_t uart_read_some(uart_port_t port, void *buf, size_t len,
+		      TickType_t timeout)
+{
+	uart_ctx_t *ctx = &uart_ctx[port];
+	size_t n;
+
+	if (port >= UART_PORT_COUNT || ctx->rx_sb == NULL)
+		return 0;
+	if (xSemaphoreTake(ctx->rx_lock, timeout) != pdTRUE)
+		return 0;
+	n = xStreamBufferReceive(ctx->rx_sb, buf, len, timeout);
+	xSemaphoreGive(ctx->rx_lock);
+	return n;
+}
+
+BaseType_t uart_flush(uart_port_t port, TickType_t timeout)
+{
+	uart_ctx_t *ctx = &uart_ctx[port];
+	TimeOut_t to;
+
+	if (port >= UART_PORT_COUNT || ctx->tx_sb == NULL)
+		return pdFALSE;
+
+	vTaskSetTimeOutState(&to);
+	while (ctx->tx_active || !xStreamBufferIsEmpty(ctx->tx_sb) ||
+	       ctx->hw->regs->FR_bit.BUSY) {
+		if (xTaskCheckForTimeOut(&to, &timeout) == pdTRUE)
+			return pdFALSE;
+		vTaskDelay(1);
+	}
+	return pdTRUE;
+}
+
+void uart_putc_polled(uart_port_t port, char ch)
+{
+	UART_TypeDef *regs = uart_hw[port].regs;
+
+	while (regs->FR_bit.TXFF) {
+	};
+	regs->DR = ch;
+}
+
+int uart_getc_polled(uart_port_t port)
+{
+	UART_TypeDef *regs = uart_hw[port].regs;
+
+	while (regs->FR_bit.RXFE) {
+	};
+	return (int)regs->DR_bit.DATA;
+}
+
+void uart_get_stats(uart_port_t port, uart_stats_t *stats)
+{
+	taskENTER_CRITICAL();
+	*stats = uart_ctx[port].stats;
+	taskEXIT_CRITICAL();
+}
+
+void uart_reset_stats(uart_port_t port)
+{
+	taskENTER_CRITICAL();
+	memset(&uart_ctx[port].stats, 0, sizeof(uart_stats_t));
+	taskEXIT_CRITICAL();
+}
@@ -0,0 +1,432 @@
+#define _GNU_SOURCE
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+#include "uart.h"
+#include "sim.h"
+#include "task.h"
+#include "semphr.h"
+#include "stream_buffer.h"
+
+/*
+ * Host simulation stand-in of the UART driver: same API and
+ * statistics, the wire is a host file descriptor chosen per port by
+ * the SIM_UART<n> environment variable:
+ *   stdio  stdin/stdout (default of UART0)
+ *   pty    a pseudo terminal, its path is printed (default of others)
+ *   loop   TX looped back to RX
+ *   null   TX discarded, nothing received
+ *   <path> TX written to a file, nothing received
+ * TX drains at the configured baud rate (10 bits per byte), so
+ * throughput and flush timing match the target within a tick.
+ */
+
+/** @brief Depth of the hardware TX/RX FIFOs */
+#define UART_FIFO_DEPTH 16
+/** @brief Bytes moved from/to the stream buffers per step at most */
+#define UART_SIM_CHUNK 64
+/** @brief Host side receive ring, filled by the reader thread */
+#define UART_SIM_RX_RING 1024
+#define UART_SIM_BITS_PER_BYTE 10
+
+typedef enum {
+	UART_SIM_NONE = 0,
+	UART_SIM_FD,
+	UART_SIM_LOOP,
+	UART_SIM_NULL,
+} uart_sim_kind_t;
+
+typedef struct {
+	StreamBufferHandle_t tx_sb;
+	StreamBufferHandle_t rx_sb;
+	SemaphoreHandle_t tx_lock;
+	SemaphoreHandle_t rx_lock;
+	volatile uint8_t tx_active;
+	uart_stats_t stats;
+	uart_sim_kind_t kind;
+	int fd_in;
+	int fd_out;
+	uint32_t baud;
+	uint64_t line_free; /**< cycle the transmitter gets idle */
+	uint8_t ring[UART_SIM_RX_RING];
+	uint32_t ring_head; /**< written by the reader thread only */
+	uint32_t ring_tail;
+	uint32_t ring_lost;
+} uart_ctx_t;
+
+static uart_ctx_t uart_ctx[UART_PORT_COUNT];
+static uint8_t uart_model_added;
+
+static void uart_ring_put(uart_ctx_t *ctx, const uint8_t *p, size_t n)
+{
+	uint32_t head = __atomic_load_n(&ctx->ring_head, __ATOMIC_RELAXED);
+
+	for (size_t i = 0; i < n; i++) {
+		uint32_t tail = __atomic_load_n(&ctx->ring_tail,
+						__ATOMIC_ACQUIRE);
+
+		if (head - tail >= UART_SIM_RX_RING) {
+			__atomic_fetch_add(&ctx->ring_lost, n - i,
+					   __ATOMIC_RELAXED);
+			break;
+		}
+		ctx->ring[head++ % UART_SIM_RX_RING] = p[i];
+	}
+	__atomic_store_n(&ctx->ring_head, head, __ATOMIC_RELEASE);
+}
+
+static int uart_ring_get(uart_ctx_t *ctx)
+{
+	uint32_t tail = ctx->ring_tail;
+	int ch;
+
+	if (tail == __atomic_load_n(&ctx->ring_head, __ATOMIC_ACQUIRE))
+		return -1;
+	ch = ctx->ring[tail % UART_SIM_RX_RING];
+	__atomic_store_n(&ctx->ring_tail, tail + 1, __ATOMIC_RELEASE);
+	return ch;
+}
+
+/** @brief Host thread: the receive wire */
+static void *uart_reader(void *arg)
+{
+	uart_ctx_t *ctx = arg;
+	uint8_t buf[UART_SIM_CHUNK];
+	sigset_t all;
+	ssize_t n;
+
+	/* Kernel signals belong to the scheduler threads */
+	sigfillset(&all);
+	pthread_sigmask(SIG_BLOCK, &all, NULL);
+
+	while ((n = read(ctx->fd_in, buf, sizeof(buf))) > 0)
+		uart_ring_put(ctx, buf, (size_t)n);
+	return NULL;
+}
+
+static int uart_open_pty(uart_port_t port)
+{
+	struct termios tio;
+	int fd = posix_openpt(O_RDWR | O_NOCTTY);
+
+	if (fd < 0 || grantpt(fd) || unlockpt(fd)) {
+		if (fd >= 0)
+			close(fd);
+		return -1;
+	}
+	if (tcgetattr(fd, &tio) == 0) {
+		cfmakeraw(&tio);
+		tcsetattr(fd, TCSANOW, &tio);
+	}
+	fprintf(stderr, "sim: UART%d on %s\n", (int)port, ptsname(fd));
+	return fd;
+}
+
+/** @brief Attach the port to its host backend, once */
+static int uart_open(uart_port_t port)
+{
+	uart_ctx_t *ctx = &uart_ctx[port];
+	char var[] = "SIM_UART0";
+	const char *cfg;
+	pthread_t th;
+
+	if (ctx->kind != UART_SIM_NONE)
+		return 0;
+
+	var[sizeof(var) - 2] = (char)('0' + port);
+	cfg = getenv(var);
+	if (cfg == NULL)
+		cfg = port == UART_PORT0 ? "stdio" : "pty";
+
+	ctx->fd_in = -1;
+	ctx->fd_out = -1;
+	if (strcmp(cfg, "loop") == 0) {
+		ctx->kind = UART_SIM_LOOP;
+		return 0;
+	}
+	if (strcmp(cfg, "null") == 0) {
+		ctx->kind = UART_SIM_NULL;
+		return 0;
+	}
+	if (strcmp(cfg, "stdio") == 0) {
+		ctx->fd_in = STDIN_FILENO;
+		ctx->fd_out = STDOUT_FILENO;
+	} else if (strcmp(cfg, "pty") == 0) {
+		ctx->fd_in = uart_open_pty(port);
+		ctx->fd_out = ctx->fd_in;
+	} else {
+		ctx->fd_out = open(cfg, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	}
+	if (ctx->fd_out < 0)
+		return -1;
+
+	ctx->kind = UART_SIM_FD;
+	if (ctx->fd_in >= 0 &&
+	    pthread_create(&th, NULL, uart_reader, ctx) == 0)
+		pthread_detach(th);
+	return 0;
+}
+
+static void uart_wire_out(uart_ctx_t *ctx, const uint8_t *p, size_t n)
+{
+	if (ctx->kind == UART_SIM_LOOP)
+		uart_ring_put(ctx, p, n);
+	else if (ctx->kind == UART_SIM_FD && write(ctx->fd_out, p, n) < 0)
+		ctx->kind = UART_SIM_NULL;
+}
+
+static void uart_step_tx(uart_ctx_t *ctx, uint64_t now, BaseType_t *woken)
+{
+	uint64_t byte_cyc = (uint64_t)SIM_CPU_HZ * UART_SIM_BITS_PER_BYTE /
+			    ctx->baud;
+	uint8_t chunk[UART_SIM_CHUNK];
+
+	/* An idle line starts with a full FIFO worth of credit */
+	if (ctx->line_free + byte_cyc * UART_FIFO_DEPTH < now)
+		ctx->line_free = now - byte_cyc * UART_FIFO_DEPTH;
+
+	while (ctx->line_free < now) {
+		size_t want = (now - ctx->line_free) / byte_cyc;
+		size_t n;
+
+		if (want == 0)
+			break;
+		if (want > sizeof(chunk))
+			want = sizeof(chunk);
+		n = xStreamBufferReceiveFromISR(ctx->tx_sb, chunk, want, woken);
+		if (n == 0)
+			break;
+		uart_wire_out(ctx, chunk, n);
+		ctx->line_free += n * byte_cyc;
+		ctx->stats.tx_bytes += n;
+	}
+	ctx->tx_active = !xStreamBufferIsEmpty(ctx->tx_sb) ||
+			 ctx->line_free > now;
+}
+
+static void uart_step_rx(uart_ctx_t *ctx, BaseType_t *woken)
+{
+	uint8_t chunk[UART_SIM_CHUNK];
+	uint32_t total = 0;
+	size_t n;
+	int ch;
+
+	ctx->stats.rx_overruns +=
+		__atomic_exchange_n(&ctx->ring_lost, 0, __ATOMIC_RELAXED);
+	do {
+		for (n = 0; n < sizeof(chunk); n++) {
+			ch = uart_ring_get(ctx);
+			if (ch < 0)
+				break;
+			chunk[n] = (uint8_t)ch;
+		}
+		if (n) {
+			size_t sent = xStreamBufferSendFromISR(ctx->rx_sb,
+							       chunk, n, woken);
+
+			ctx->stats.rx_dropped += n - sent;
+			total += n;
+		}
+	} while (n == sizeof(chunk));
+
+	ctx->stats.rx_bytes += total;
+	if (total > ctx->stats.rx_irq_max)
+		ctx->stats.rx_irq_max = total;
+}
+
+/** @brief Model step of every buffered port, interrupt context */
+static void uart_model(void)
+{
+	BaseType_t woken = pdFALSE;
+	uint64_t now = sim_cycles();
+
+	for (uint32_t port = 0; port < UART_PORT_COUNT; port++) {
+		uart_ctx_t *ctx = &uart_ctx[port];
+
+		if (ctx->tx_sb == NULL || ctx->baud == 0)
+			continue;
+		uart_step_tx(ctx, now, &woken);
+		uart_step_rx(ctx, &woken);
+	}
+	portYIELD_FROM_ISR(woken);
+}
+
+int uart_init(uart_port_t port, const uart_config_t *cfg)
+{
+	if (port >= UART_PORT_COUNT || cfg == NULL || cfg->baud == 0)
+		return -1;
+
+	uart_ctx_t *ctx = &uart_ctx[port];
+
+	/* Same argument rules as the target: only UART1 has TX DMA */
+	if (cfg->use_dma && port != UART_PORT1)
+		return -1;
+	if (uart_open(port) != 0)
+		return -1;
+
+	memset(&ctx->stats, 0, sizeof(ctx->stats));
+
+	if (cfg->tx_buf_size && cfg->rx_buf_size) {
+		if (ctx->tx_sb == NULL) {
+			ctx->tx_sb = xStreamBufferCreate(cfg->tx_buf_size, 1);
+			ctx->rx_sb = xStreamBufferCreate(cfg->rx_buf_size, 1);
+			ctx->tx_lock = xSemaphoreCreateMutex();
+			ctx->rx_lock = xSemaphoreCreateMutex();
+		}
+		if (!ctx->tx_sb || !ctx->rx_sb || !ctx->tx_lock ||
+		    !ctx->rx_lock)
+			return -1;
+		if (!uart_model_added) {
+			uart_model_added = 1;
+			sim_model_add(uart_model);
+		}
+	}
+	ctx->line_free = sim_cycles();
+	ctx->baud = cfg->baud;
+	return 0;
+}
+
+size_t uart_write(uart_port_t port, const void *data, size_t len,
+		  TickType_t timeout)
+{
+	uart_ctx_t *ctx = &uart_ctx[port];
+	const uint8_t *p = data;
+	size_t done = 0;
+	TimeOut_t to;
+
+	if (port >= UART_PORT_COUNT || ctx->tx_sb == NULL)
+		return 0;
+
+	vTaskSetTimeOutState(&to);
+	if (xSemaphoreTake(ctx->tx_lock, timeout) != pdTRUE)
+		return 0;
+
+	while (done < len) {
+		done += xStreamBufferSend(ctx->tx_sb, p + done, len - done,
+					  timeout);
+		ctx->tx_active = 1;
+		sim_wake();
+		if (done < len && xTaskCheckForTimeOut(&to, &timeout) == pdTRUE)
+			break;
+	}
+
+	xSemaphoreGive(ctx->tx_lock);
+	return done;
+}
+
+/* No DMA model: chains are copied into the stream buffer */
+size_t uart_write_buf(uart_port_t port, buf_t *b, TickType_t timeout)
+{
+	size_t done = 0;
+
+	for (buf_t *seg = b; seg; seg = seg->next)
+		done += uart_write(port, seg->data, seg->len, timeout);
+	buf_free(b);
+	return done;
+}
+
+size_t uart_read(uart_port_t port, void *buf, size_t len, TickType_t timeout)
+{
+	uart_ctx_t *ctx = &uart_ctx[port];
+	uint8_t *p = buf;
+	size_t done = 0;
+	TimeOut_t to;
+
+	if (port >= UART_PORT_COUNT || ctx->rx_sb == NULL)
+		return 0;
+
+	vTaskSetTimeOutState(&to);
+	if (xSemaphoreTake(ctx->rx_lock, timeout) != pdTRUE)
+		return 0;
+
+	while (done < len) {
+		done += xStreamBufferReceive(ctx->rx_sb, p + done, len - done,
+					     timeout);
+		if (done < len && xTaskCheckForTimeOut(&to, &timeout) == pdTRUE)
+			break;
+	}
+
+	xSemaphoreGive(ctx->rx_lock);
+	return done;
+}
+
+size_t uart_read_buf(uart_port_t port, buf_t *b, size_t len,
+		     TickType_t timeout)
+{
+	if (len > buf_tailroom(b))
+		len = buf_tailroom(b);
+	len = uart_read(port, b->data + b->len, len, timeout);
+	buf_put(b, len);
+	return len;
+}
+
+size_t uart_read_some(uart_port_t port, void *buf, size_t len,
+		      TickType_t timeout)
+{
+	uart_ctx_t *ctx = &uart_ctx[port];
+	size_t n;
+
+	if (port >= UART_PORT_COUNT || ctx->rx_sb == NULL)
+		return 0;
+	if (xSemaphoreTake(ctx->rx_lock, timeout) != pdTRUE)
+		return 0;
+	n = xStreamBufferReceive(ctx->rx_sb, buf, len, timeout);
+	xSemaphoreGive(ctx->rx_lock);
+	return n;
+}
+
+BaseType_t uart_flush(uart_port_t port, TickType_t timeout)
+{
+	uart_ctx_t *ctx = &uart_ctx[port];
+	TimeOut_t to;
+
+	if (port >= UART_PORT_COUNT || ctx->tx_sb == NULL)
+		return pdFALSE;
+
+	vTaskSetTimeOutState(&to);
+	while (ctx->tx_active || !xStreamBufferIsEmpty(ctx->tx_sb)) {
+		if (xTaskCheckForTimeOut(&to, &timeout) == pdTRUE)
+			return pdFALSE;
+		vTaskDelay(1);
+	}
+	return pdTRUE;
+}
+
+void uart_putc_polled(uart_port_t port, char ch)
+{
+	uint8_t c = (uint8_t)ch;
+
+	if (port >= UART_PORT_COUNT || uart_open(port) != 0)
+		return;
+	uart_wire_out(&uart_ctx[port], &c, 1);
+}
+
+int uart_getc_polled(uart_port_t port)
+{
+	int ch;
+
+	if (port >= UART_PORT_COUNT || uart_open(port) != 0)
+		return -1;
+	while ((ch = uart_ring_get(&uart_ctx[port])) < 0)
+		usleep(100);
+	return ch;
+}
+
+void uart_get_stats(uart_port_t port, uart_stats_t *stats)
+{
+	taskENTER_CRITICAL();
+	*stats = uart_ctx[port].stats;
+	taskEXIT_CRITICAL();
+}
+
+void uart_reset_stats(uart_port_t port)
+{
+	taskENTER_CRITICAL();
+	memset(&uart_ctx[port].stats, 0, sizeof(uart_stats_t));
+	taskEXIT_CRITICAL();
+}
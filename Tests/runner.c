@@ -0,0 +1,68 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "test.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "system_k1921vg015.h"
+#include "freeRTOS_RiscV_provider.h"
+
+#define TEST_TASK_STACK 2048
+#define TEST_TASK_PRIO 5
+
+static test_case_t *test_head;
+static test_case_t **test_tail = &test_head;
+static const char *test_filter;
+static int test_failed;
+
+void test_register(test_case_t *tc)
+{
+	/* Constructors run in link order: keep it */
+	*test_tail = tc;
+	test_tail = &tc->next;
+}
+
+void test_fail(const char *file, int line, const char *expr)
+{
+	printf("  %s:%d: CHECK(%s) failed\n", file, line, expr);
+	test_failed = 1;
+}
+
+static void test_task(__attribute__((unused)) void *arg)
+{
+	int run = 0, failed = 0;
+
+	for (test_case_t *tc = test_head; tc; tc = tc->next) {
+		if (test_filter && !strstr(tc->name, test_filter))
+			continue;
+		test_failed = 0;
+		tc->fn();
+		printf("%s %s\n", test_failed ? "FAIL" : "PASS", tc->name);
+		run++;
+		failed += test_failed;
+	}
+
+	printf("%d run, %d failed\n", run, failed);
+	fflush(stdout);
+	exit(failed || !run);
+}
+
+int main(int argc, char **argv)
+{
+	if (argc > 1)
+		test_filter = argv[1];
+
+	InterruptDisable();
+	freertos_risc_v_provider_init();
+	SystemInit();
+
+	if (xTaskCreate(test_task, "test", TEST_TASK_STACK, NULL,
+			TEST_TASK_PRIO, NULL) != pdPASS) {
+		printf("test task creation failed\n");
+		return 1;
+	}
+
+	InterruptEnable();
+	vTaskStartScheduler();
+	return 1;
+}
@@ -0,0 +1,58 @@
+#ifndef __test_h__
+#define __test_h__
+
+#include <math.h>
+#include <stdint.h>
+
+/*! CPP guard */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Host test runner.
+ *
+ * TEST(name) defines a test case that registers itself before
+ * main(). The runner starts the scheduler, runs the cases one by
+ * one in a task (optionally only those whose name contains argv[1])
+ * and exits with the number of failed cases.
+ */
+
+typedef struct test_case {
+	const char *name;
+	void (*fn)(void);
+	struct test_case *next;
+} test_case_t;
+
+void test_register(test_case_t *tc);
+
+/** @brief Record a failed check of the running case */
+void test_fail(const char *file, int line, const char *expr);
+
+#define TEST(name)                                                  \
+	static void test_##name(void);                              \
+	static test_case_t test_case_##name = { #name, test_##name, \
+						0 };                \
+	__attribute__((constructor)) static void test_reg_##name(void) \
+	{                                                           \
+		test_register(&test_case_##name);                   \
+	}                                                           \
+	static void test_##name(void)
+
+/** @brief Fail the case and leave it if cond is false */
+#define CHECK(cond)                                            \
+	do {                                                   \
+		if (!(cond)) {                                 \
+			test_fail(__FILE__, __LINE__, #cond);  \
+			return;                                \
+		}                                              \
+	} while (0)
+
+#define CHECK_EQ(a, b) CHECK((a) == (b))
+#define CHECK_NEAR(a, b, tol) CHECK(fabs((double)(a) - (double)(b)) <= (tol))
+
+#ifdef __cplusplus
+}
+#endif /* End of CPP guard */
+
+#endif //__test_h__
@@ -0,0 +1,97 @@
+#include <string.h>
+#include "test.h"
+#include "buf.h"
+
+/* Default classes: 64 x 32, 256 x 16, 1024 x 4 */
+
+TEST(buf_class)
+{
+	buf_t *a = buf_alloc(10);
+	buf_t *b = buf_alloc(65);
+	buf_t *c = buf_alloc(2000);
+
+	CHECK(a != NULL && b != NULL);
+	CHECK(c == NULL);
+	CHECK_EQ(buf_size(a), BUF_HEADROOM + 64);
+	CHECK_EQ(buf_size(b), BUF_HEADROOM + 256);
+	CHECK_EQ(buf_headroom(a), BUF_HEADROOM);
+	CHECK_EQ(buf_tailroom(a), 64);
+	CHECK_EQ(((uintptr_t)a->data & 3), 0);
+	buf_free(a);
+	buf_free(b);
+}
+
+TEST(buf_edit)
+{
+	buf_t *b = buf_alloc(32);
+	uint8_t *p;
+
+	CHECK(b != NULL);
+	p = buf_put(b, 4);
+	CHECK(p == b->data);
+	memcpy(p, "data", 4);
+	p = buf_push(b, 2);
+	CHECK(p != NULL);
+	memcpy(p, "hd", 2);
+	CHECK_EQ(b->len, 6);
+	CHECK(memcmp(b->data, "hddata", 6) == 0);
+	CHECK(buf_push(b, BUF_HEADROOM) == NULL);
+	CHECK(buf_put(b, buf_tailroom(b) + 1) == NULL);
+	CHECK(buf_pull(b, 2) != NULL);
+	CHECK(memcmp(b->data, "data", 4) == 0);
+	CHECK(buf_pull(b, 5) == NULL);
+	buf_free(b);
+}
+
+TEST(buf_chain_ref)
+{
+	buf_stats_t st0, st;
+	buf_t *a, *b;
+
+	buf_get_stats(&st0);
+	a = buf_alloc(8);
+	b = buf_alloc(200);
+	CHECK(a != NULL && b != NULL);
+	buf_put(a, 8);
+	buf_put(b, 100);
+	buf_chain(a, b);
+	CHECK_EQ(buf_total_len(a), 108);
+
+	/* A second holder of the tail keeps it alive past the chain */
+	buf_ref(b);
+	buf_free(a);
+	buf_get_stats(&st);
+	CHECK_EQ(st.cls[0].used, st0.cls[0].used);
+	CHECK_EQ(st.cls[1].used, st0.cls[1].used + 1);
+	buf_free(b);
+	buf_get_stats(&st);
+	CHECK_EQ(st.cls[1].used, st0.cls[1].used);
+}
+
+TEST(buf_exhaust)
+{
+	buf_t *held[32 + 16 + 4];
+	buf_stats_t st0, st;
+	uint32_t n = 0;
+
+	buf_get_stats(&st0);
+	/* Small requests spill into the larger classes before failing */
+	while (n < sizeof(held) / sizeof(held[0]) &&
+	       (held[n] = buf_alloc(1)) != NULL)
+		n++;
+	CHECK_EQ(n, 32u + 16 + 4 - st0.cls[0].used - st0.cls[1].used -
+			    st0.cls[2].used);
+	CHECK(buf_alloc(1) == NULL);
+	CHECK(buf_alloc(5000) == NULL);
+
+	buf_get_stats(&st);
+	CHECK_EQ(st.cls[0].used, 32);
+	CHECK_EQ(st.cls[2].peak, 4);
+	CHECK(st.cls[2].fails > st0.cls[2].fails);
+	CHECK_EQ(st.oversize, st0.oversize + 1);
+
+	while (n)
+		buf_free(held[--n]);
+	buf_get_stats(&st);
+	CHECK_EQ(st.cls[0].used + st.cls[1].used + st.cls[2].used, 0);
+}
@@ -0,0 +1,79 @@
+#include <string.h>
+#include "test.h"
+#include "clk.h"
+#include "mtimer.h"
+
+static char events[16];
+static uint32_t nevents;
+static int veto;
+
+static int on_clk(clk_event_t ev, __attribute__((unused)) uint32_t old_hz,
+		  __attribute__((unused)) uint32_t new_hz, void *arg)
+{
+	if (nevents < sizeof(events))
+		events[nevents++] = "PCXA"[ev];
+	return arg == &veto && ev == CLK_PRE_CHANGE ? veto : 0;
+}
+
+TEST(clk_switch)
+{
+	static clk_notifier_t a, b;
+	clk_stats_t st0, st;
+
+	clk_get_stats(&st0);
+	clk_notifier_register(&a, on_clk, NULL);
+	clk_notifier_register(&b, on_clk, &veto);
+	clk_notifier_register(&a, on_clk, NULL);
+	CHECK_EQ(clk_get_op(), CLK_OP_PLL);
+
+	nevents = 0;
+	CHECK_EQ(clk_set_op(CLK_OP_HSE), CLK_OK);
+	CHECK_EQ(clk_get_op(), CLK_OP_HSE);
+	/* Timestamps keep their rate across the switch */
+	CHECK_EQ(clk_mtime_hz(), MTIME_FREQ_HZ);
+	CHECK_EQ(nevents, 6);
+	CHECK(memcmp(events, "PPCCXX", 6) == 0);
+
+	/* Same point: nothing to notify */
+	nevents = 0;
+	CHECK_EQ(clk_set_op(CLK_OP_HSE), CLK_OK);
+	CHECK_EQ(nevents, 0);
+
+	CHECK_EQ(clk_set_op(CLK_OP_PLL), CLK_OK);
+	CHECK_EQ(clk_set_op(CLK_OP_COUNT), CLK_ERR_PARAM);
+
+	clk_get_stats(&st);
+	CHECK_EQ(st.switches - st0.switches, 2);
+	clk_notifier_unregister(&a);
+	clk_notifier_unregister(&b);
+}
+
+TEST(clk_veto)
+{
+	static clk_notifier_t a, b;
+	clk_stats_t st0, st;
+
+	clk_get_stats(&st0);
+	clk_notifier_register(&a, on_clk, NULL);
+	clk_notifier_register(&b, on_clk, &veto);
+	veto = -1;
+	nevents = 0;
+	CHECK_EQ(clk_set_op(CLK_OP_HSE), CLK_ERR_BUSY);
+	CHECK_EQ(clk_get_op(), CLK_OP_PLL);
+	CHECK_EQ(nevents, 3);
+	CHECK(memcmp(events, "PPA", 3) == 0);
+	clk_get_stats(&st);
+	CHECK_EQ(st.vetoes - st0.vetoes, 1);
+
+	veto = 0;
+	clk_notifier_unregister(&a);
+	clk_notifier_unregister(&b);
+}
+
+TEST(clk_boost)
+{
+	CHECK_EQ(clk_set_op(CLK_OP_HSE), CLK_OK);
+	CHECK_EQ(clk_boost_get(), CLK_OK);
+	CHECK_EQ(clk_get_op(), CLK_OP_PLL);
+	clk_boost_put();
+}
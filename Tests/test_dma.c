@@ -0,0 +1,188 @@
+#include <string.h>
+#include "test.h"
+#include "dma.h"
+#include "dma_mem.h"
+#include "FreeRTOS.h"
+#include "semphr.h"
+
+#define CH 0
+#define WORDS 256
+
+static uint32_t src[WORDS];
+static uint32_t dst[WORDS];
+static SemaphoreHandle_t done;
+
+static void on_done(__attribute__((unused)) uint32_t ch, void *arg)
+{
+	BaseType_t woken = pdFALSE;
+
+	xSemaphoreGiveFromISR((SemaphoreHandle_t)arg, &woken);
+	portYIELD_FROM_ISR(woken);
+}
+
+static void setup(void)
+{
+	dma_init();
+	if (done == NULL)
+		done = xSemaphoreCreateBinary();
+	dma_set_handler(CH, on_done, done);
+	memset(dst, 0, sizeof(dst));
+}
+
+TEST(dma_mem_copy)
+{
+	setup();
+	for (uint32_t i = 0; i < WORDS; i++)
+		src[i] = i * 0x01010101u;
+
+	dma_ch_setup(CH, src, dst, WORDS,
+		     DMA_XFER_WORD | DMA_XFER_SRC_INC | DMA_XFER_DST_INC |
+			     DMA_XFER_AUTOREQ);
+	dma_ch_enable(CH);
+	dma_ch_request(CH);
+
+	CHECK_EQ(xSemaphoreTake(done, pdMS_TO_TICKS(10)), pdTRUE);
+	CHECK(memcmp(src, dst, sizeof(src)) == 0);
+	CHECK(!dma_ch_busy(CH));
+	CHECK_EQ(dma_ch_remaining(CH, 0), 0);
+}
+
+TEST(dma_fill)
+{
+	static const uint8_t pattern = 0xA5;
+	uint8_t *p = (uint8_t *)dst;
+
+	setup();
+	dma_ch_setup(CH, &pattern, dst, 100,
+		     DMA_XFER_BYTE | DMA_XFER_DST_INC | DMA_XFER_AUTOREQ);
+	dma_ch_enable(CH);
+	dma_ch_request(CH);
+
+	CHECK_EQ(xSemaphoreTake(done, pdMS_TO_TICKS(10)), pdTRUE);
+	CHECK_EQ(p[0], 0xA5);
+	CHECK_EQ(p[99], 0xA5);
+	CHECK_EQ(p[100], 0);
+}
+
+#define MEM_CH 1
+#define MEM_LEN 6000
+
+static uint8_t mem_a[MEM_LEN + 8];
+static uint8_t mem_b[MEM_LEN + 8];
+static uint8_t mem_c[MEM_LEN + 8];
+static dma_mem_xfer_t mem_x[4];
+static uint32_t mem_order[4];
+static uint32_t mem_done;
+
+static void on_mem_done(__attribute__((unused)) dma_mem_xfer_t *x, void *arg)
+{
+	mem_order[mem_done++] = (uint32_t)(uintptr_t)arg;
+}
+
+TEST(dma_mem_align)
+{
+	CHECK_EQ(dma_mem_init(MEM_CH), DMA_MEM_OK);
+	for (uint32_t i = 0; i < sizeof(mem_a); i++)
+		mem_a[i] = (uint8_t)(i * 7 + 1);
+
+	/* Word, halfword and byte transfers with CPU ends */
+	for (uint32_t so = 0; so < 4; so++) {
+		for (uint32_t d = 0; d < 4; d++) {
+			uint32_t len = 1000 + so + d;
+
+			memset(mem_b, 0, sizeof(mem_b));
+			CHECK_EQ(dma_memcpy(&mem_x[0], mem_b + d, mem_a + so,
+					    len, NULL, NULL),
+				 DMA_MEM_PENDING);
+			CHECK_EQ(dma_mem_wait(&mem_x[0], pdMS_TO_TICKS(10)),
+				 DMA_MEM_OK);
+			CHECK(memcmp(mem_b + d, mem_a + so, len) == 0);
+			CHECK(d == 0 || mem_b[d - 1] == 0);
+			CHECK_EQ(mem_b[d + len], 0);
+		}
+	}
+
+	memset(mem_b, 0, sizeof(mem_b));
+	CHECK_EQ(dma_memset(&mem_x[0], mem_b + 3, 0x5A, 998, NULL, NULL),
+		 DMA_MEM_PENDING);
+	CHECK_EQ(dma_mem_wait(&mem_x[0], pdMS_TO_TICKS(10)), DMA_MEM_OK);
+	CHECK_EQ(mem_b[2], 0);
+	CHECK_EQ(mem_b[3], 0x5A);
+	CHECK_EQ(mem_b[1000], 0x5A);
+	CHECK_EQ(mem_b[1001], 0);
+
+	/* At or below the threshold the CPU is done before returning */
+	CHECK_EQ(dma_memcpy(&mem_x[0], mem_c, mem_a, DMA_MEM_CPU_MAX, NULL,
+			    NULL),
+		 DMA_MEM_OK);
+	CHECK(memcmp(mem_c, mem_a, DMA_MEM_CPU_MAX) == 0);
+}
+
+TEST(dma_mem_queue)
+{
+	dma_mem_stats_t st;
+
+	CHECK_EQ(dma_mem_init(MEM_CH), DMA_MEM_OK);
+	dma_mem_set_cpu_max(DMA_MEM_CPU_MAX);
+	for (uint32_t i = 0; i < sizeof(mem_a); i++)
+		mem_a[i] = (uint8_t)(i * 13 + 5);
+	memset(mem_b, 0, sizeof(mem_b));
+	memset(mem_c, 0, sizeof(mem_c));
+	mem_done = 0;
+
+	/*
+	 * Several DMA cycles each; the second copy reads what the first
+	 * writes, the small one waits its turn behind them
+	 */
+	CHECK_EQ(dma_memcpy(&mem_x[0], mem_b, mem_a, MEM_LEN, on_mem_done,
+			    (void *)0),
+		 DMA_MEM_PENDING);
+	CHECK_EQ(dma_memcpy(&mem_x[1], mem_c, mem_b, MEM_LEN, on_mem_done,
+			    (void *)1),
+		 DMA_MEM_PENDING);
+	CHECK_EQ(dma_memset(&mem_x[2], mem_b, 0, 16, on_mem_done, (void *)2),
+		 DMA_MEM_PENDING);
+	CHECK_EQ(dma_memset(&mem_x[3], mem_c + MEM_LEN - 1, 0xEE, 2,
+			    on_mem_done, (void *)3),
+		 DMA_MEM_PENDING);
+
+	CHECK_EQ(dma_mem_wait(&mem_x[3], pdMS_TO_TICKS(50)), DMA_MEM_OK);
+	CHECK_EQ(mem_done, 4);
+	for (uint32_t i = 0; i < 4; i++)
+		CHECK_EQ(mem_order[i], i);
+	CHECK(memcmp(mem_c, mem_a, MEM_LEN - 1) == 0);
+	CHECK_EQ(mem_c[MEM_LEN - 1], 0xEE);
+	CHECK_EQ(mem_c[MEM_LEN], 0xEE);
+	CHECK_EQ(mem_b[0], 0);
+	CHECK_EQ(mem_b[15], 0);
+	CHECK_EQ(mem_b[16], mem_a[16]);
+
+	dma_mem_get_stats(&st);
+	CHECK(st.queue_hwm >= 4);
+}
+
+TEST(dma_mem_bench)
+{
+	CHECK_EQ(dma_mem_init(MEM_CH), DMA_MEM_OK);
+	CHECK(dma_mem_bench() >= 0);
+	CHECK_EQ(dma_mem_set_cpu_max(DMA_MEM_CPU_LIMIT + 1), DMA_MEM_CPU_LIMIT);
+	CHECK_EQ(dma_mem_set_cpu_max(DMA_MEM_CPU_MAX), DMA_MEM_CPU_MAX);
+}
+
+TEST(dma_mem_stray)
+{
+	CHECK_EQ(dma_mem_init(MEM_CH), DMA_MEM_OK);
+	dma_mem_set_cpu_max(DMA_MEM_CPU_MAX);
+
+	/* Completion with no request of the driver on the channel */
+	dma_ch_setup(MEM_CH, src, dst, 1, DMA_XFER_WORD | DMA_XFER_AUTOREQ);
+	dma_ch_enable(MEM_CH);
+	dma_ch_request(MEM_CH);
+	vTaskDelay(pdMS_TO_TICKS(2));
+
+	memset(mem_b, 0, sizeof(mem_b));
+	CHECK_EQ(dma_memcpy(&mem_x[0], mem_b, mem_a, 1000, NULL, NULL),
+		 DMA_MEM_PENDING);
+	CHECK_EQ(dma_mem_wait(&mem_x[0], pdMS_TO_TICKS(10)), DMA_MEM_OK);
+	CHECK(memcmp(mem_b, mem_a, 1000) == 0);
+}
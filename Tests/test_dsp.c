@@ -0,0 +1,371 @@
+#include <math.h>
+#include <string.h>
+#include "test.h"
+#include "dsp.h"
+
+#define N 256
+#define PI 3.14159265358979f
+
+static float buf[N];
+static float out[N];
+static float state[N + 16];
+
+TEST(dsp_fir_impulse)
+{
+	static const float b[5] = { 0.1f, 0.2f, 0.4f, 0.2f, 0.1f };
+	dsp_fir_f32_t f;
+
+	dsp_fir_init_f32(&f, b, state, 5, 1);
+	memset(buf, 0, sizeof(buf));
+	buf[0] = 1.0f;
+	dsp_fir_f32(&f, buf, out, 32);
+	for (int i = 0; i < 5; i++)
+		CHECK_NEAR(out[i], b[i], 1e-6);
+	CHECK_NEAR(out[5], 0.0f, 1e-6);
+}
+
+TEST(dsp_biquad_dc_gain)
+{
+	/* b = {1, 0, 0}, a1 = -0.5: DC gain 2 */
+	static const float c[5] = { 1.0f, 0.0f, 0.0f, -0.5f, 0.0f };
+	dsp_biquad_f32_t f;
+
+	dsp_biquad_init_f32(&f, c, state, 1);
+	for (int i = 0; i < N; i++)
+		buf[i] = 1.0f;
+	dsp_biquad_f32(&f, buf, out, N);
+	CHECK_NEAR(out[N - 1], 2.0f, 1e-4);
+}
+
+TEST(dsp_rfft_tone)
+{
+	float power[N / 2 + 1];
+	uint32_t idx;
+
+	for (int i = 0; i < N; i++)
+		buf[i] = sinf(2 * PI * 10 * i / N);
+	CHECK_EQ(dsp_rfft_f32(buf, N), 0);
+	dsp_rfft_power_f32(buf, power, N);
+	dsp_peak_f32(power, N / 2 + 1, &idx);
+	CHECK_EQ(idx, 10);
+	/* |X[k]| = N / 2 for a unit sine on bin k */
+	CHECK_NEAR(sqrtf(power[10]), N / 2, 1e-2 * N);
+}
+
+TEST(dsp_rfft_bad_length)
+{
+	CHECK_EQ(dsp_rfft_f32(buf, 100), -1);
+}
+
+TEST(dsp_rms_sine)
+{
+	for (int i = 0; i < N; i++)
+		buf[i] = sinf(2 * PI * 4 * i / N);
+	CHECK_NEAR(dsp_rms_f32(buf, N), sqrtf(0.5f), 1e-4);
+}
+
+TEST(dsp_q15_saturation)
+{
+	CHECK_EQ(dsp_sat_q15(40000), INT16_MAX);
+	CHECK_EQ(dsp_sat_q15(-40000), INT16_MIN);
+	CHECK_EQ(dsp_sat_q15(123), 123);
+}
+
+TEST(dsp_biquad_shift_clamp)
+{
+	/* b0 = 1 at the largest shift: the output is the input */
+	static const q15_t c15[5] = { 1, 0, 0, 0, 0 };
+	static const q31_t c31[5] = { 1, 0, 0, 0, 0 };
+	q15_t st15[4], in15[8], out15[8];
+	q31_t st31[4], in31[8], out31[8];
+	dsp_biquad_q15_t f15;
+	dsp_biquad_q31_t f31;
+
+	dsp_biquad_init_q15(&f15, c15, st15, 1, 40);
+	dsp_biquad_init_q31(&f31, c31, st31, 1, 40);
+	CHECK_EQ(f15.shift, 15);
+	CHECK_EQ(f31.shift, 31);
+	for (int i = 0; i < 8; i++) {
+		in15[i] = (q15_t)(i * 4000 - 16000);
+		in31[i] = (q31_t)(i * 250000000 - 1000000000);
+	}
+	dsp_biquad_q15(&f15, in15, out15, 8);
+	dsp_biquad_q31(&f31, in31, out31, 8);
+	for (int i = 0; i < 8; i++) {
+		CHECK_EQ(out15[i], in15[i]);
+		CHECK_EQ(out31[i], in31[i]);
+	}
+}
+
+/*
+ * Reference accuracy: every kernel against a double precision model
+ * on deterministic noise, with the bound its arithmetic should meet.
+ */
+
+#define DPI 3.14159265358979323846
+
+static float cbuf[2 * DSP_FFT_MAX];
+static double ref[2 * DSP_FFT_MAX];
+static uint32_t seed;
+
+/** @brief Uniform in [-1, 1) */
+static float noise(void)
+{
+	seed = seed * 1664525u + 1013904223u;
+	return (float)(int32_t)seed / 2147483648.0f;
+}
+
+/** @brief Naive DFT of n complex points into ref */
+static void dft(const float *x, uint32_t n)
+{
+	for (uint32_t k = 0; k < n; k++) {
+		double re = 0.0, im = 0.0;
+
+		for (uint32_t m = 0; m < n; m++) {
+			double a = -2.0 * DPI * (double)((k * m) % n) / n;
+
+			re += x[2 * m] * cos(a) - x[2 * m + 1] * sin(a);
+			im += x[2 * m] * sin(a) + x[2 * m + 1] * cos(a);
+		}
+		ref[2 * k] = re;
+		ref[2 * k + 1] = im;
+	}
+}
+
+TEST(dsp_cfft_vs_dft)
+{
+	static float x[2 * DSP_FFT_MAX / 2];
+
+	/* Float rounding grows with log2(n), 1e-7 * n covers |X| <= n */
+	for (uint32_t n = 2; n <= DSP_FFT_MAX / 2; n <<= 1) {
+		seed = n;
+		for (uint32_t i = 0; i < 2 * n; i++)
+			x[i] = cbuf[i] = noise();
+		dft(x, n);
+		CHECK_EQ(dsp_cfft_f32(cbuf, n), 0);
+		for (uint32_t i = 0; i < 2 * n; i++)
+			CHECK_NEAR(cbuf[i], ref[i], 1e-7 * n);
+	}
+}
+
+TEST(dsp_rfft_vs_dft)
+{
+	static float x[2 * DSP_FFT_MAX];
+
+	for (uint32_t n = 4; n <= DSP_FFT_MAX; n <<= 1) {
+		seed = n;
+		for (uint32_t i = 0; i < n; i++) {
+			cbuf[i] = x[2 * i] = noise();
+			x[2 * i + 1] = 0.0f;
+		}
+		dft(x, n);
+		CHECK_EQ(dsp_rfft_f32(cbuf, n), 0);
+		CHECK_NEAR(cbuf[0], ref[0], 1e-7 * n);
+		CHECK_NEAR(cbuf[1], ref[n], 1e-7 * n);
+		for (uint32_t k = 2; k < n; k++)
+			CHECK_NEAR(cbuf[k], ref[k], 1e-7 * n);
+	}
+}
+
+TEST(dsp_fir_decim_vs_downsample)
+{
+	enum { TAPS = 15, D = 4, BLK = 64 };
+	float b[TAPS], x[2 * BLK], y[BLK / D];
+	dsp_fir_f32_t f;
+
+	seed = 1;
+	for (int k = 0; k < TAPS; k++)
+		b[k] = noise() / TAPS;
+	for (int i = 0; i < 2 * BLK; i++)
+		x[i] = noise();
+
+	/* Two blocks, so the history carries across the call */
+	dsp_fir_init_f32(&f, b, state, TAPS, D);
+	for (int blk = 0; blk < 2; blk++) {
+		dsp_fir_f32(&f, x + blk * BLK, y, BLK);
+		for (int j = 0; j < BLK / D; j++) {
+			int i = blk * BLK + j * D;
+			double acc = 0.0;
+
+			for (int k = 0; k < TAPS && k <= i; k++)
+				acc += (double)b[k] * x[i - k];
+			CHECK_NEAR(y[j], acc, 1e-7);
+		}
+	}
+}
+
+/** @brief Float value of a noise sample rounded to Q15 */
+static float noise_q15(q15_t *q, float amp)
+{
+	*q = (q15_t)lrintf(noise() * amp * 32768.0f);
+	return *q / 32768.0f;
+}
+
+TEST(dsp_fir_fixed_vs_f32)
+{
+	enum { TAPS = 15, D = 2 };
+	static q15_t st15[TAPS + N], x15[N], y15[N];
+	static q31_t st31[TAPS + N], x31[N], y31[N];
+	q15_t b15[TAPS];
+	q31_t b31[TAPS];
+	float b[TAPS];
+	dsp_fir_q15_t f15;
+	dsp_fir_q31_t f31;
+	dsp_fir_f32_t f;
+
+	/* Taps below 1/TAPS: the sum never saturates */
+	seed = 2;
+	for (int k = 0; k < TAPS; k++) {
+		b[k] = noise_q15(&b15[k], 1.0f / TAPS);
+		b31[k] = (q31_t)b15[k] * 65536;
+	}
+	for (int i = 0; i < N; i++) {
+		buf[i] = noise_q15(&x15[i], 1.0f);
+		x31[i] = (q31_t)x15[i] * 65536;
+	}
+	dsp_fir_init_f32(&f, b, state, TAPS, D);
+	dsp_fir_init_q15(&f15, b15, st15, TAPS, D);
+	dsp_fir_init_q31(&f31, b31, st31, TAPS, D);
+	dsp_fir_f32(&f, buf, out, N);
+	dsp_fir_q15(&f15, x15, y15, N);
+	dsp_fir_q31(&f31, x31, y31, N);
+
+	/*
+	 * Q15 rounds once at the end: half an LSB, plus the float
+	 * reference's own rounding; Q31 truncates far below float.
+	 */
+	for (int j = 0; j < N / D; j++) {
+		CHECK_NEAR(y15[j], out[j] * 32768.0, 0.5 + 1e-2);
+		CHECK_NEAR(y31[j] / 2147483648.0, out[j], 1e-7);
+	}
+}
+
+TEST(dsp_biquad_fixed_vs_f32)
+{
+	/* Two low-pass stages, DC gain 2 and 4/3, coefficients halved */
+	static const float c[10] = {
+		0.2f, 0.3f, 0.1f, -0.9f, 0.2f,
+		0.25f, 0.5f, 0.25f, -0.5f, 0.25f,
+	};
+	static q15_t x15[N], y15[N];
+	static q31_t x31[N], y31[N];
+	q15_t c15[10], st15[8];
+	q31_t c31[10], st31[8];
+	float cq[10];
+	dsp_biquad_q15_t f15;
+	dsp_biquad_q31_t f31;
+	dsp_biquad_f32_t f;
+
+	for (int i = 0; i < 10; i++) {
+		c15[i] = (q15_t)lrintf(c[i] * 16384.0f);
+		c31[i] = (q31_t)c15[i] * 65536;
+		cq[i] = c15[i] / 16384.0f;
+	}
+	seed = 3;
+	for (int i = 0; i < N; i++) {
+		buf[i] = noise_q15(&x15[i], 0.25f);
+		x31[i] = (q31_t)x15[i] * 65536;
+	}
+	dsp_biquad_init_f32(&f, cq, state, 2);
+	dsp_biquad_init_q15(&f15, c15, st15, 2, 1);
+	dsp_biquad_init_q31(&f31, c31, st31, 2, 1);
+	dsp_biquad_f32(&f, buf, out, N);
+	dsp_biquad_q15(&f15, x15, y15, N);
+	dsp_biquad_q31(&f31, x31, y31, N);
+
+	/*
+	 * Every stage rounds its output and feeds the rounding back, the
+	 * recursion amplifies it by the noise gain of 1 / A(z): a few LSB.
+	 */
+	for (int i = 0; i < N; i++) {
+		CHECK_NEAR(y15[i], out[i] * 32768.0, 3.0);
+		CHECK_NEAR(y31[i] / 2147483648.0, out[i], 2e-7);
+	}
+}
+
+TEST(dsp_cfft_q15_vs_f32)
+{
+	static q15_t q[2 * DSP_FFT_MAX / 2];
+
+	/* Q15 is scaled by 1/n, one rounding per pass */
+	for (uint32_t n = 2; n <= DSP_FFT_MAX / 2; n <<= 1) {
+		seed = n;
+		for (uint32_t i = 0; i < 2 * n; i++)
+			cbuf[i] = noise_q15(&q[i], 0.5f);
+		CHECK_EQ(dsp_cfft_f32(cbuf, n), 0);
+		CHECK_EQ(dsp_cfft_q15(q, n), 0);
+		for (uint32_t i = 0; i < 2 * n; i++)
+			CHECK_NEAR(q[i], cbuf[i] / n * 32768.0, 4.0);
+	}
+}
+
+/** @brief Noise in Q31, returned exactly as float */
+static float noise_q31(q31_t *q, float amp)
+{
+	*q = (q31_t)lrintf(noise() * amp * 2147483648.0f);
+	return (float)(*q / 2147483648.0);
+}
+
+TEST(dsp_cfft_q31_vs_dft)
+{
+	static q31_t q[2 * DSP_FFT_MAX / 2];
+	static float x[2 * DSP_FFT_MAX / 2];
+
+	/* Scaled by 1/n: under 8 LSB of truncation and rounding in all */
+	for (uint32_t n = 2; n <= DSP_FFT_MAX / 2; n <<= 1) {
+		seed = n;
+		for (uint32_t i = 0; i < 2 * n; i++)
+			x[i] = noise_q31(&q[i], 0.5f);
+		dft(x, n);
+		CHECK_EQ(dsp_cfft_q31(q, n), 0);
+		for (uint32_t i = 0; i < 2 * n; i++)
+			CHECK_NEAR(q[i], ref[i] / n * 2147483648.0, 8.0);
+	}
+}
+
+TEST(dsp_rfft_q31_vs_dft)
+{
+	static q31_t q[DSP_FFT_MAX];
+	static float x[2 * DSP_FFT_MAX];
+
+	for (uint32_t n = 4; n <= DSP_FFT_MAX; n <<= 1) {
+		seed = n;
+		for (uint32_t i = 0; i < n; i++) {
+			x[2 * i] = noise_q31(&q[i], 0.5f);
+			x[2 * i + 1] = 0.0f;
+		}
+		dft(x, n);
+		CHECK_EQ(dsp_rfft_q31(q, n), 0);
+		CHECK_NEAR(q[0], ref[0] / n * 2147483648.0, 8.0);
+		CHECK_NEAR(q[1], ref[n] / n * 2147483648.0, 8.0);
+		for (uint32_t k = 2; k < n; k++)
+			CHECK_NEAR(q[k], ref[k] / n * 2147483648.0, 8.0);
+	}
+	CHECK_EQ(dsp_rfft_q31(q, 100), -1);
+}
+
+TEST(dsp_window_vs_formula)
+{
+	static q15_t wq[N];
+	static const dsp_window_t types[] = {
+		DSP_WIN_HANN, DSP_WIN_HAMMING, DSP_WIN_BLACKMAN,
+	};
+
+	for (int t = 0; t < 3; t++) {
+		dsp_window_f32(buf, N, types[t]);
+		dsp_window_q15(wq, N, types[t]);
+		for (int i = 0; i < N; i++) {
+			double x = 2.0 * DPI * i / N, w;
+
+			if (types[t] == DSP_WIN_HANN)
+				w = 0.5 - 0.5 * cos(x);
+			else if (types[t] == DSP_WIN_HAMMING)
+				w = 0.54 - 0.46 * cos(x);
+			else
+				w = 0.42 - 0.5 * cos(x) + 0.08 * cos(2 * x);
+			/* cosf() is good to a few ulp; Q15 1.0 saturates */
+			CHECK_NEAR(buf[i], w, 1e-6);
+			CHECK_NEAR(wq[i], w * 32768.0, 1.0);
+		}
+	}
+}
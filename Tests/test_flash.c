@@ -0,0 +1,133 @@
+#include <string.h>
+#include <unistd.h>
+#include "test.h"
+#include "flash_blk.h"
+#include "qspi_flash.h"
+
+#define IMG "test_flash.img"
+#define SIZE (64 * 1024)
+#define PAGE 256
+#define SECTOR 4096
+
+static flash_dev_t dev;
+static uint8_t wbuf[SECTOR];
+static uint8_t rbuf[SECTOR];
+
+static int open_image(int fresh)
+{
+	if (fresh)
+		unlink(IMG);
+	return flash_file_init(&dev, IMG, SIZE, PAGE, SECTOR);
+}
+
+TEST(flash_nor_semantics)
+{
+	uint8_t b = 0x0F;
+
+	CHECK_EQ(open_image(1), FLASH_OK);
+	CHECK_EQ(flash_read(&dev, 0, rbuf, 16), FLASH_OK);
+	CHECK_EQ(rbuf[0], 0xFF);
+
+	/* Program only clears bits */
+	CHECK_EQ(flash_program(&dev, 0, &b, 1), FLASH_OK);
+	b = 0xF0;
+	CHECK_EQ(flash_program(&dev, 0, &b, 1), FLASH_OK);
+	CHECK_EQ(flash_read(&dev, 0, rbuf, 1), FLASH_OK);
+	CHECK_EQ(rbuf[0], 0x00);
+
+	/* A single device program may not cross a page */
+	CHECK_EQ(dev.ops->program(&dev, PAGE - 1, wbuf, 2), FLASH_ERR_PARAM);
+	CHECK_EQ(flash_erase(&dev, 1, SECTOR, 0), FLASH_ERR_PARAM);
+	CHECK_EQ(flash_erase(&dev, 0, SECTOR, 0), FLASH_OK);
+	CHECK_EQ(flash_read(&dev, 0, rbuf, 1), FLASH_OK);
+	CHECK_EQ(rbuf[0], 0xFF);
+}
+
+TEST(flash_blk_persistence)
+{
+	flash_blk_t blk;
+
+	for (uint32_t i = 0; i < SECTOR; i++)
+		wbuf[i] = (uint8_t)(i * 7 + 3);
+
+	CHECK_EQ(open_image(1), FLASH_OK);
+	CHECK_EQ(flash_blk_init(&blk, &dev, SECTOR, 4 * SECTOR), FLASH_OK);
+	CHECK_EQ(flash_blk_write(&blk, 2, wbuf, 1), FLASH_OK);
+
+	/* Image file keeps the data across a re-open */
+	CHECK_EQ(open_image(0), FLASH_OK);
+	CHECK_EQ(flash_blk_init(&blk, &dev, SECTOR, 4 * SECTOR), FLASH_OK);
+	CHECK_EQ(flash_blk_read(&blk, 2, rbuf, 1), FLASH_OK);
+	CHECK(memcmp(wbuf, rbuf, SECTOR) == 0);
+}
+
+TEST(flash_stream_roundtrip)
+{
+	static uint8_t work[2 * PAGE];
+	flash_stream_t s;
+	uint8_t chunk[100];
+	uint32_t total = 0;
+
+	CHECK_EQ(open_image(1), FLASH_OK);
+	CHECK_EQ(flash_stream_open(&s, &dev, 0, 3 * SECTOR, work,
+				   sizeof(work)),
+		 FLASH_OK);
+	for (uint32_t i = 0; i < 50; i++) {
+		memset(chunk, (int)i, sizeof(chunk));
+		CHECK_EQ(flash_stream_write(&s, chunk, sizeof(chunk)),
+			 (int)sizeof(chunk));
+	}
+	CHECK_EQ(flash_stream_flush(&s), FLASH_OK);
+
+	CHECK_EQ(flash_stream_open(&s, &dev, 0, 3 * SECTOR, work,
+				   sizeof(work)),
+		 FLASH_OK);
+	while (total < 50 * sizeof(chunk)) {
+		CHECK_EQ(flash_stream_read(&s, chunk, sizeof(chunk)),
+			 (int)sizeof(chunk));
+		CHECK_EQ(chunk[0], total / sizeof(chunk));
+		CHECK_EQ(chunk[sizeof(chunk) - 1], total / sizeof(chunk));
+		total += sizeof(chunk);
+	}
+}
+
+TEST(flash_bench_runs)
+{
+	flash_bench_t res;
+
+	CHECK_EQ(open_image(1), FLASH_OK);
+	CHECK_EQ(flash_bench(&dev, 0, SIZE, wbuf, sizeof(wbuf), &res),
+		 FLASH_OK);
+	CHECK(res.read_bps > 0);
+	CHECK(res.write_bps > 0);
+}
+
+TEST(flash_qspi_unaligned_dma)
+{
+	static const qspi_flash_config_t cfg = { .clk_div = 2, .use_dma = 1 };
+	static uint8_t pat[3 * SECTOR + 1], got[3 * SECTOR + 1];
+	const uint32_t len = 3 * SECTOR - 100;
+	flash_dev_t q;
+
+	CHECK_EQ(qspi_flash_init(&q, &cfg), FLASH_OK);
+	CHECK_EQ(qspi_flash_jedec_id(), 0xEF4016);
+	for (uint32_t i = 0; i < sizeof(pat); i++)
+		pat[i] = (uint8_t)(i * 13 + 5);
+
+	/*
+	 * Odd buffers go byte by byte: more than DMA_XFER_MAX bytes per
+	 * frame, both in full QSPI_HW_XFER_MAX frames and in the rest
+	 */
+	CHECK_EQ(flash_erase(&q, 0, 3 * SECTOR, portMAX_DELAY), FLASH_OK);
+	CHECK_EQ(flash_program(&q, 0, pat + 1, len), FLASH_OK);
+	memset(got, 0, sizeof(got));
+	CHECK_EQ(flash_read(&q, 0, got + 1, len), FLASH_OK);
+	CHECK(memcmp(got + 1, pat + 1, len) == 0);
+	CHECK_EQ(got[len + 1], 0);
+
+	/* Word aligned, one cycle per frame */
+	CHECK_EQ(flash_read(&q, 0, got, 2 * SECTOR), FLASH_OK);
+	CHECK(memcmp(got, pat + 1, 2 * SECTOR) == 0);
+	CHECK_EQ(flash_read(&q, len, got, 4), FLASH_OK);
+	CHECK_EQ(got[0], 0xFF);
+}
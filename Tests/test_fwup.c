@@ -0,0 +1,268 @@
+#include <string.h>
+#include "test.h"
+#include "fwup.h"
+#include "task.h"
+
+#define SIZE (128 * 1024)
+#define PAGE 256
+#define SECTOR 4096
+#define SLOT_SIZE 0xE000
+#define IMG_LEN 20008 /* last chunk padded */
+#define RECS (SECTOR / sizeof(fwup_rec_t))
+
+static const fwup_layout_t lay = {
+	.ctl = { 0x0000, 0x1000 },
+	.progress = 0x2000,
+	.slot = { 0x4000, 0x4000 + SLOT_SIZE },
+	.slot_size = SLOT_SIZE,
+};
+
+static uint8_t mem[SIZE];
+static flash_dev_t dev;
+static uint8_t img[IMG_LEN];
+static uint8_t rbuf[IMG_LEN];
+
+/* The updater sets up once per process */
+static int setup(void)
+{
+	static int done;
+	uint32_t x = 12345;
+
+	if (done)
+		return FWUP_OK;
+	done = 1;
+	flash_emu_init(&dev, mem, SIZE, PAGE, SECTOR);
+	for (uint32_t i = 0; i < IMG_LEN; i++) {
+		x = x * 1103515245 + 12345;
+		img[i] = (uint8_t)(x >> 16);
+	}
+	return fwup_init(&dev, &lay, FWUP_SLOT_A, uxTaskPriorityGet(NULL) + 1);
+}
+
+/** @brief Send image bytes [off, end) in chunks, as the link would */
+static int send(uint32_t off, uint32_t end)
+{
+	uint32_t next;
+
+	while (off < end) {
+		uint32_t n = end - off < FWUP_CHUNK_MAX ? end - off :
+							  FWUP_CHUNK_MAX;
+		buf_t *b;
+		int ret;
+
+		/* Chunks in flight come back once programmed */
+		while ((b = buf_alloc(FWUP_CHUNK_MAX + 4)) == NULL)
+			vTaskDelay(1);
+		memcpy(buf_put(b, n), img + off, n);
+		ret = fwup_write(off, b, &next);
+		if (ret != FWUP_OK)
+			return ret;
+		if (next != off + n)
+			return -100;
+		off = next;
+	}
+	return FWUP_OK;
+}
+
+TEST(fwup_update)
+{
+	uint32_t crc, resume = 1, next;
+	fwup_rec_t last[FWUP_SLOT_COUNT];
+	buf_t *b;
+
+	CHECK_EQ(setup(), FWUP_OK);
+	crc = fwup_crc32(0, img, IMG_LEN);
+	CHECK_EQ(fwup_begin(0, crc, &resume), FWUP_ERR_PARAM);
+	CHECK_EQ(fwup_begin(SLOT_SIZE + 1, crc, &resume), FWUP_ERR_PARAM);
+	CHECK_EQ(fwup_begin(IMG_LEN, crc, &resume), FWUP_OK);
+	CHECK_EQ(resume, 0);
+
+	CHECK_EQ(send(0, 2048), FWUP_OK);
+	/* Out of order and unaligned chunks are refused, nothing queued */
+	b = buf_alloc(64);
+	CHECK(b != NULL);
+	buf_put(b, 16);
+	CHECK_EQ(fwup_write(4096, b, &next), FWUP_ERR_SEQ);
+	CHECK_EQ(next, 2048);
+	b = buf_alloc(64);
+	CHECK(b != NULL);
+	buf_put(b, 17);
+	CHECK_EQ(fwup_write(2048, b, &next), FWUP_ERR_PARAM);
+	CHECK_EQ(fwup_finish(pdMS_TO_TICKS(1000)), FWUP_ERR_SEQ);
+
+	CHECK_EQ(send(2048, IMG_LEN), FWUP_OK);
+	CHECK_EQ(fwup_finish(pdMS_TO_TICKS(1000)), FWUP_OK);
+	CHECK_EQ(flash_read(&dev, lay.slot[FWUP_SLOT_B], rbuf, IMG_LEN),
+		 FLASH_OK);
+	CHECK(memcmp(rbuf, img, IMG_LEN) == 0);
+	/* Padding of the last chunk stays erased */
+	CHECK_EQ(mem[lay.slot[FWUP_SLOT_B] + IMG_LEN], 0xFF);
+
+	CHECK(fwup_boot_records(&dev, &lay, last) > 0);
+	CHECK_EQ(last[FWUP_SLOT_B].state, FWUP_STATE_NEW);
+	CHECK_EQ(last[FWUP_SLOT_B].len, IMG_LEN);
+	CHECK_EQ(last[FWUP_SLOT_B].crc, crc);
+	CHECK_EQ(fwup_finish(pdMS_TO_TICKS(1000)), FWUP_ERR_STATE);
+}
+
+TEST(fwup_resume)
+{
+	uint32_t crc, resume;
+	fwup_stats_t st0, st;
+
+	CHECK_EQ(setup(), FWUP_OK);
+	crc = fwup_crc32(0, img, IMG_LEN);
+	fwup_get_stats(&st0);
+	CHECK_EQ(fwup_begin(IMG_LEN, crc, &resume), FWUP_OK);
+	CHECK_EQ(resume, 0);
+	/* Link lost in the middle of the third page */
+	CHECK_EQ(send(0, 2 * SECTOR + 1536), FWUP_OK);
+
+	/* Same image again: continues on the last whole page */
+	CHECK_EQ(fwup_begin(IMG_LEN, crc, &resume), FWUP_OK);
+	CHECK_EQ(resume, 2 * SECTOR);
+	CHECK_EQ(send(resume, IMG_LEN), FWUP_OK);
+	CHECK_EQ(fwup_finish(pdMS_TO_TICKS(1000)), FWUP_OK);
+	CHECK_EQ(flash_read(&dev, lay.slot[FWUP_SLOT_B], rbuf, IMG_LEN),
+		 FLASH_OK);
+	CHECK(memcmp(rbuf, img, IMG_LEN) == 0);
+
+	fwup_get_stats(&st);
+	CHECK_EQ(st.resumed, st0.resumed + 1);
+	CHECK_EQ(st.images, st0.images + 1);
+	CHECK_EQ(st.bytes - st0.bytes, 2 * SECTOR + 1536 + IMG_LEN - resume);
+
+	/* Committed: nothing left to resume, another image starts over */
+	CHECK_EQ(fwup_begin(IMG_LEN, crc, &resume), FWUP_OK);
+	CHECK_EQ(resume, 0);
+	CHECK_EQ(send(0, SECTOR + 512), FWUP_OK);
+	CHECK_EQ(fwup_begin(IMG_LEN, crc ^ 1, &resume), FWUP_OK);
+	CHECK_EQ(resume, 0);
+}
+
+TEST(fwup_bad_image)
+{
+	uint32_t crc, resume, top;
+	fwup_rec_t last[FWUP_SLOT_COUNT];
+
+	CHECK_EQ(setup(), FWUP_OK);
+	crc = fwup_crc32(0, img, IMG_LEN) ^ 0x80;
+	top = fwup_boot_records(&dev, &lay, last);
+	CHECK_EQ(fwup_begin(IMG_LEN, crc, &resume), FWUP_OK);
+	CHECK_EQ(send(0, IMG_LEN), FWUP_OK);
+	CHECK_EQ(fwup_finish(pdMS_TO_TICKS(1000)), FWUP_ERR_CRC);
+	/* Not committed, and the next attempt starts from scratch */
+	CHECK_EQ(fwup_boot_records(&dev, &lay, last), top);
+	CHECK_EQ(fwup_begin(IMG_LEN, crc, &resume), FWUP_OK);
+	CHECK_EQ(resume, 0);
+}
+
+TEST(fwup_trial_refused)
+{
+	static uint8_t snap[IMG_LEN];
+	uint32_t crc, resume;
+
+	CHECK_EQ(setup(), FWUP_OK);
+	crc = fwup_crc32(0, img, IMG_LEN);
+	/* Running A on trial: B is what the boot falls back to */
+	CHECK_EQ(fwup_boot_append(&dev, &lay, FWUP_SLOT_A, FWUP_STATE_NEW,
+				  0, 0),
+		 FWUP_OK);
+	CHECK_EQ(fwup_boot_append(&dev, &lay, FWUP_SLOT_A,
+				  FWUP_STATE_BOOTED, 0, 0),
+		 FWUP_OK);
+	memcpy(snap, mem + lay.slot[FWUP_SLOT_B], IMG_LEN);
+	CHECK_EQ(fwup_begin(IMG_LEN, crc, &resume), FWUP_ERR_STATE);
+	CHECK(memcmp(snap, mem + lay.slot[FWUP_SLOT_B], IMG_LEN) == 0);
+
+	CHECK_EQ(fwup_confirm(&dev, &lay, FWUP_SLOT_A), FWUP_OK);
+	CHECK_EQ(fwup_begin(IMG_LEN, crc, &resume), FWUP_OK);
+	CHECK_EQ(resume, 0);
+}
+
+TEST(fwup_boot_select)
+{
+	static uint8_t bmem[SIZE], bimg[IMG_LEN];
+	uint32_t crc, top;
+	fwup_rec_t last[FWUP_SLOT_COUNT], r;
+	flash_dev_t d;
+	uint8_t zero = 0;
+
+	flash_emu_init(&d, bmem, SIZE, PAGE, SECTOR);
+	memset(bmem, 0xFF, SIZE);
+	for (uint32_t i = 0; i < IMG_LEN; i++)
+		bimg[i] = (uint8_t)(i * 7);
+	crc = fwup_crc32(0, bimg, IMG_LEN);
+
+	/* Factory image in A, no records yet */
+	CHECK_EQ(fwup_boot_select(&d, &lay), FWUP_SLOT_A);
+	CHECK_EQ(fwup_confirm(&d, &lay, FWUP_SLOT_A), FWUP_OK);
+	CHECK_EQ(fwup_boot_records(&d, &lay, last), 1);
+	CHECK_EQ(last[FWUP_SLOT_A].state, FWUP_STATE_GOOD);
+	CHECK_EQ(last[FWUP_SLOT_A].len, 0);
+
+	/* New image in B: one trial boot, then back to A */
+	CHECK_EQ(flash_program(&d, lay.slot[FWUP_SLOT_B], bimg, IMG_LEN),
+		 FLASH_OK);
+	CHECK_EQ(fwup_boot_append(&d, &lay, FWUP_SLOT_B, FWUP_STATE_NEW,
+				  IMG_LEN, crc),
+		 FWUP_OK);
+	CHECK_EQ(fwup_boot_select(&d, &lay), FWUP_SLOT_B);
+	fwup_boot_records(&d, &lay, last);
+	CHECK_EQ(last[FWUP_SLOT_B].state, FWUP_STATE_BOOTED);
+	CHECK_EQ(fwup_boot_select(&d, &lay), FWUP_SLOT_A);
+
+	/* Confirmed this time: B stays */
+	CHECK_EQ(fwup_boot_append(&d, &lay, FWUP_SLOT_B, FWUP_STATE_NEW,
+				  IMG_LEN, crc),
+		 FWUP_OK);
+	CHECK_EQ(fwup_boot_select(&d, &lay), FWUP_SLOT_B);
+	CHECK_EQ(fwup_confirm(&d, &lay, FWUP_SLOT_B), FWUP_OK);
+	CHECK_EQ(fwup_boot_select(&d, &lay), FWUP_SLOT_B);
+	CHECK_EQ(fwup_boot_select(&d, &lay), FWUP_SLOT_B);
+
+	/* A torn record is skipped, the next one goes behind it */
+	top = fwup_boot_records(&d, &lay, last);
+	memset(&r, 0, sizeof(r));
+	r.magic = FWUP_MAGIC_BOOT;
+	r.seq = top + 10;
+	r.slot = FWUP_SLOT_A;
+	r.state = FWUP_STATE_NEW;
+	CHECK_EQ(flash_program(&d, lay.ctl[0] + 6 * sizeof(r), &r,
+			       sizeof(r) - 8),
+		 FLASH_OK);
+	CHECK_EQ(fwup_boot_records(&d, &lay, last), top);
+	CHECK_EQ(fwup_boot_select(&d, &lay), FWUP_SLOT_B);
+
+	/* Many confirms fill the page: compaction keeps both slots */
+	for (uint32_t i = 0; i < 3 * RECS; i++)
+		CHECK_EQ(fwup_boot_append(&d, &lay, FWUP_SLOT_A,
+					  FWUP_STATE_GOOD, 0, 0),
+			 FWUP_OK);
+	CHECK_EQ(fwup_boot_append(&d, &lay, FWUP_SLOT_B, FWUP_STATE_GOOD,
+				  IMG_LEN, crc),
+		 FWUP_OK);
+	CHECK_EQ(fwup_boot_records(&d, &lay, last), top + 3 * RECS + 1);
+	CHECK_EQ(last[FWUP_SLOT_A].state, FWUP_STATE_GOOD);
+	CHECK_EQ(last[FWUP_SLOT_B].state, FWUP_STATE_GOOD);
+	CHECK_EQ(last[FWUP_SLOT_B].crc, crc);
+	CHECK_EQ(fwup_boot_select(&d, &lay), FWUP_SLOT_B);
+
+	/* A corrupt new image never starts: back to the good A */
+	CHECK_EQ(flash_program(&d, lay.slot[FWUP_SLOT_B] + 100, &zero, 1),
+		 FLASH_OK);
+	CHECK_EQ(fwup_boot_append(&d, &lay, FWUP_SLOT_B, FWUP_STATE_NEW,
+				  IMG_LEN, crc),
+		 FWUP_OK);
+	CHECK_EQ(fwup_boot_select(&d, &lay), FWUP_SLOT_A);
+	fwup_boot_records(&d, &lay, last);
+	CHECK_EQ(last[FWUP_SLOT_B].state, FWUP_STATE_NEW);
+}
+
+TEST(fwup_crc32)
+{
+	/* IEEE check value, the one zlib.crc32() gives */
+	CHECK_EQ(fwup_crc32(0, "123456789", 9), 0xCBF43926);
+	CHECK_EQ(fwup_crc32(fwup_crc32(0, "1234", 4), "56789", 5),
+		 0xCBF43926);
+}
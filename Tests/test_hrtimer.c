@@ -0,0 +1,88 @@
+#include "test.h"
+#include "hrtimer.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+/** @brief Simulated interrupts run once per tick at worst */
+#define LATENCY_US 5000
+
+static volatile uint32_t fired;
+static volatile uint64_t fired_at;
+static volatile TaskHandle_t fired_in;
+
+static void on_timer(__attribute__((unused)) hrtimer_t *t,
+		     __attribute__((unused)) void *arg)
+{
+	fired++;
+	fired_at = hrtimer_now();
+	fired_in = xTaskGetCurrentTaskHandle();
+}
+
+static void setup(void)
+{
+	static int ready;
+
+	if (!ready) {
+		hrtimer_init(1);
+		ready = 1;
+	}
+	fired = 0;
+	fired_in = NULL;
+}
+
+TEST(hrtimer_oneshot)
+{
+	hrtimer_t t;
+	uint64_t due;
+
+	setup();
+	hrtimer_setup(&t, on_timer, NULL, 0);
+	due = hrtimer_now() + hrtimer_us(5000);
+	hrtimer_start_at(&t, due, 0);
+	vTaskDelay(pdMS_TO_TICKS(20));
+
+	CHECK_EQ(fired, 1);
+	CHECK(fired_at >= due);
+	CHECK(fired_at < due + hrtimer_us(LATENCY_US));
+	CHECK(!hrtimer_active(&t));
+}
+
+TEST(hrtimer_periodic)
+{
+	hrtimer_t t;
+
+	setup();
+	hrtimer_setup(&t, on_timer, NULL, 0);
+	hrtimer_start(&t, hrtimer_us(2000), hrtimer_us(2000));
+	vTaskDelay(pdMS_TO_TICKS(100));
+	hrtimer_cancel(&t);
+
+	/* Late periods are skipped and counted, never bunched up */
+	CHECK(fired + t.overruns >= 45);
+	CHECK(fired + t.overruns <= 51);
+}
+
+TEST(hrtimer_cancel)
+{
+	hrtimer_t t;
+
+	setup();
+	hrtimer_setup(&t, on_timer, NULL, 0);
+	hrtimer_start(&t, hrtimer_us(5000), 0);
+	hrtimer_cancel(&t);
+	vTaskDelay(pdMS_TO_TICKS(10));
+	CHECK_EQ(fired, 0);
+}
+
+TEST(hrtimer_deferred)
+{
+	hrtimer_t t;
+
+	setup();
+	hrtimer_setup(&t, on_timer, NULL, HRTIMER_DEFERRED);
+	hrtimer_start(&t, hrtimer_us(1000), 0);
+	vTaskDelay(pdMS_TO_TICKS(10));
+	CHECK_EQ(fired, 1);
+	CHECK(fired_in == xTimerGetTimerDaemonTaskHandle());
+}
@@ -0,0 +1,139 @@
+#include "test.h"
+#include "icap.h"
+#include "hrtimer.h"
+#include "sim.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define CH 3
+#define DMA_CH 5
+#define NBUFS 4
+#define LEN 1024
+
+/* 50 kHz at the 50 MHz simulated clock, 30 % high */
+#define PERIOD 1000
+#define HIGH 300
+
+static uint32_t buf[NBUFS * LEN];
+static uint64_t ts[LEN];
+
+static void setup(icap_t *cap, icap_edge_t edge, uint32_t edges)
+{
+	static int ready;
+	icap_config_t cfg = {
+		.capcom = CH,
+		.edge = edge,
+		.nbufs = NBUFS,
+		.dma_ch = DMA_CH,
+		.block_len = LEN,
+		.buf = buf,
+	};
+
+	if (!ready) {
+		hrtimer_init(1);
+		ready = 1;
+	}
+	icap_start(cap, &cfg);
+	sim_tmr32_pulses(CH, DMA_CH, PERIOD, HIGH, edges);
+}
+
+TEST(icap_both_edges)
+{
+	icap_t cap;
+	icap_block_t blk;
+	icap_meas_t m;
+	icap_stats_t st;
+	uint64_t prev = 0;
+
+	setup(&cap, ICAP_EDGE_BOTH, 4 * LEN);
+	for (uint32_t n = 0; n < 4; n++) {
+		CHECK(icap_get(&cap, &blk, pdMS_TO_TICKS(100)));
+		CHECK_EQ(blk.seq_no, n);
+		CHECK_EQ(blk.first, n * LEN);
+		CHECK_EQ(icap_measure(&blk, icap_hz(&cap), &m), 0);
+		CHECK_EQ(m.period_min, PERIOD);
+		CHECK_EQ(m.period_max, PERIOD);
+		CHECK_EQ(m.duty_ppm, 300000);
+		CHECK_EQ(m.freq_mhz, SIM_CPU_HZ / PERIOD * 1000);
+
+		/* Rebuilt edges alternate high and low phases */
+		icap_timestamps(&blk, ts);
+		CHECK_EQ(blk.prev, prev);
+		if (prev)
+			CHECK_EQ(ts[0] - prev, PERIOD - HIGH);
+		for (uint32_t i = 1; i < LEN; i++)
+			CHECK_EQ(ts[i] - ts[i - 1],
+				 i & 1 ? HIGH : PERIOD - HIGH);
+		CHECK(ts[LEN - 1] <= hrtimer_count());
+		prev = blk.last;
+		icap_release(&cap, &blk);
+	}
+	icap_get_stats(&cap, &st);
+	icap_stop(&cap);
+	CHECK_EQ(st.blocks, 4);
+	CHECK_EQ(st.overruns + st.stalls, 0);
+}
+
+TEST(icap_rising)
+{
+	icap_t cap;
+	icap_block_t blk;
+	icap_meas_t m;
+
+	setup(&cap, ICAP_EDGE_RISE, 4 * LEN);
+	CHECK(icap_get(&cap, &blk, pdMS_TO_TICKS(100)));
+	CHECK_EQ(icap_measure(&blk, icap_hz(&cap), &m), 0);
+	icap_release(&cap, &blk);
+	icap_stop(&cap);
+	CHECK_EQ(m.periods, LEN - 1);
+	CHECK_EQ(m.period_avg, PERIOD);
+	CHECK_EQ(m.duty_ppm, 0);
+}
+
+TEST(icap_overrun)
+{
+	icap_t cap;
+	icap_block_t blk, held;
+	icap_stats_t st;
+
+	/* Nothing released: two blocks out, the rest dropped */
+	setup(&cap, ICAP_EDGE_BOTH, 8 * LEN);
+	vTaskDelay(pdMS_TO_TICKS(250));
+	CHECK(icap_get(&cap, &held, 0));
+	CHECK(icap_get(&cap, &blk, 0));
+	CHECK(!icap_get(&cap, &blk, 0));
+	icap_get_stats(&cap, &st);
+	CHECK_EQ(st.blocks, 2);
+	CHECK(st.overruns >= 4);
+
+	/* Continues after a gap, the seq_no jump shows the loss */
+	icap_release(&cap, &held);
+	icap_release(&cap, &blk);
+	sim_tmr32_pulses(CH, DMA_CH, PERIOD, HIGH, 2 * LEN);
+	CHECK(icap_get(&cap, &blk, pdMS_TO_TICKS(100)));
+	icap_stop(&cap);
+	CHECK(blk.seq_no > 2);
+	CHECK_EQ(blk.prev, 0);
+}
+
+TEST(icap_bad_config)
+{
+	icap_t cap;
+	icap_config_t cfg = {
+		.capcom = CH,
+		.edge = ICAP_EDGE_BOTH,
+		.nbufs = NBUFS,
+		.dma_ch = DMA_CH,
+		.block_len = LEN,
+		.buf = buf,
+	};
+
+	cfg.capcom = 0;
+	CHECK_EQ(icap_start(&cap, &cfg), -1);
+	cfg.capcom = CH;
+	cfg.block_len = LEN - 1;
+	CHECK_EQ(icap_start(&cap, &cfg), -1);
+	cfg.block_len = LEN;
+	cfg.nbufs = 2;
+	CHECK_EQ(icap_start(&cap, &cfg), -1);
+}
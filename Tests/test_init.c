@@ -0,0 +1,66 @@
+#include "test.h"
+#include "init.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+static char trail[8];
+static uint32_t ntrail;
+static uint32_t once_calls;
+
+static int step_a(void)
+{
+	trail[ntrail++] = 'a';
+	return 0;
+}
+
+static int step_b(void)
+{
+	trail[ntrail++] = 'b';
+	return -1;
+}
+
+static int step_c(void)
+{
+	trail[ntrail++] = 'c';
+	return 0;
+}
+
+static int step_once(void)
+{
+	once_calls++;
+	return 3;
+}
+
+/* Registered out of order on purpose, the table is in link order */
+INIT_PRE_SCHED(step_c, 20);
+INIT_PRE_SCHED(step_b, 20);
+INIT_PRE_SCHED(step_a, 10);
+
+TEST(init_order)
+{
+	ntrail = 0;
+	CHECK_EQ(init_run(INIT_LEVEL_PRE_SCHED), 1);
+	CHECK_EQ(ntrail, 3);
+	CHECK_EQ(trail[0], 'a');
+	/* Equal order: table position decides, each runs once */
+	CHECK(trail[1] != trail[2]);
+	CHECK_EQ(init_run(INIT_LEVEL_EARLY), 0);
+	CHECK_EQ(ntrail, 3);
+}
+
+TEST(init_once)
+{
+	static init_once_t once = INIT_ONCE_INIT;
+
+	CHECK_EQ(INIT_ONCE(&once, step_once), 3);
+	CHECK_EQ(INIT_ONCE(&once, step_once), 3);
+	CHECK_EQ(once_calls, 1);
+}
+
+TEST(init_clock)
+{
+	uint64_t t0 = init_now();
+
+	vTaskDelay(pdMS_TO_TICKS(10));
+	CHECK(init_now() > t0);
+}
@@ -0,0 +1,163 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "test.h"
+#include "lzs.h"
+#include "uart.h"
+#include "task.h"
+
+#define BAUD 921600
+#define IDLE_MS 5
+#define LINES 200
+#define CAP 16384
+
+static lzs_enc_t enc;
+static lzs_dec_t dec;
+static uint8_t out[LZS_BOUND(LZS_BLOCK)];
+static char text[CAP];
+static uint8_t rx[CAP];
+static uint8_t got[CAP];
+
+static size_t make_text(void)
+{
+	size_t n = 0;
+
+	for (int i = 0; i < LINES; i++)
+		n += (size_t)snprintf(text + n, sizeof(text) - n,
+				      "main.c:%d INFO: adc ch%d = %d mV\r\n",
+				      120 + i % 3, i % 4, 1500 + i % 10);
+	return n;
+}
+
+static uint16_t fletcher16(const uint8_t *p, size_t n)
+{
+	uint32_t a = 0, b = 0;
+
+	while (n--) {
+		a = (a + *p++) % 255;
+		b = (b + a) % 255;
+	}
+	return (uint16_t)(b << 8 | a);
+}
+
+TEST(lzs_roundtrip)
+{
+	size_t n = make_text(), packed = 0, len, c;
+	const uint8_t *p;
+	uint32_t blk = 0;
+
+	lzs_enc_reset(&enc);
+	/* Uneven blocks, some without history */
+	for (size_t off = 0; off < n; off += len, blk++) {
+		size_t want = 1 + (blk * 97) % LZS_BLOCK;
+
+		if (want > n - off)
+			want = n - off;
+		len = lzs_enc_put(&enc, text + off, want);
+		CHECK_EQ(len, want);
+		c = lzs_enc_flush(&enc, out, blk % 5 == 0);
+		CHECK(c <= LZS_BOUND(len));
+		if (blk % 5 == 0)
+			lzs_dec_reset(&dec);
+		CHECK_EQ(lzs_dec_block(&dec, out, c, &p), (int)len);
+		CHECK(memcmp(p, text + off, len) == 0);
+		packed += c;
+	}
+	CHECK(packed * 3 < n);
+	CHECK_EQ(lzs_enc_flush(&enc, out, 0), 0);
+}
+
+TEST(lzs_corrupt)
+{
+	/* Match further back than the history, literals past the end */
+	static const uint8_t far[] = { 0x10, 'a', 0x05, 0x00 };
+	static const uint8_t cut[] = { 0x50, 'a', 'b' };
+	const uint8_t *p;
+
+	lzs_dec_reset(&dec);
+	CHECK_EQ(lzs_dec_block(&dec, far, sizeof(far), &p), -1);
+	lzs_dec_reset(&dec);
+	CHECK_EQ(lzs_dec_block(&dec, cut, sizeof(cut), &p), -1);
+	srand(1);
+	for (int i = 0; i < 1000; i++) {
+		for (size_t j = 0; j < sizeof(out); j++)
+			out[j] = (uint8_t)rand();
+		lzs_dec_reset(&dec);
+		CHECK(lzs_dec_block(&dec, out, sizeof(out), &p) <= LZS_BLOCK);
+	}
+}
+
+TEST(lzs_stream)
+{
+	uart_config_t cfg = {
+		.baud = BAUD,
+		.tx_buf_size = 1024,
+		.rx_buf_size = 4096,
+		.use_dma = 1,
+		.irq_prio = 1,
+	};
+	size_t n = make_text(), nrx = 0, ngot = 0;
+	const char *tail = "putc tail\r\n";
+	lzs_stats_t st;
+	TickType_t t0;
+	const uint8_t *p;
+	int frames = 0;
+
+	setenv("SIM_UART1", "loop", 1);
+	CHECK_EQ(uart_init(UART_PORT1, &cfg), 0);
+	CHECK_EQ(lzs_start(UART_PORT1, BAUD, IDLE_MS,
+			   uxTaskPriorityGet(NULL) - 1),
+		 0);
+
+	CHECK_EQ(lzs_write(text, n / 2, portMAX_DELAY), n / 2);
+	CHECK_EQ(lzs_write(text + n / 2, n - n / 2, portMAX_DELAY),
+		 n - n / 2);
+	vTaskDelay(pdMS_TO_TICKS(4 * IDLE_MS));
+	for (const char *c = tail; *c; c++)
+		CHECK_EQ(lzs_putc(*c), *c);
+
+	t0 = xTaskGetTickCount();
+	while (xTaskGetTickCount() - t0 < pdMS_TO_TICKS(200) && nrx < CAP)
+		nrx += uart_read_some(UART_PORT1, rx + nrx, CAP - nrx,
+				      pdMS_TO_TICKS(20));
+
+	/* Whole frames, in order, the first one without history */
+	for (p = rx; p + 3 <= rx + nrx;) {
+		uint32_t len = p[1] | (uint32_t)p[2] << 8;
+		const uint8_t *body = p + 3, *o;
+		int k;
+
+		CHECK_EQ(p[0], LZS_SYNC);
+		CHECK(body + len + 2 <= rx + nrx);
+		CHECK_EQ(fletcher16(body, len),
+			 body[len] | (uint16_t)body[len + 1] << 8);
+		CHECK_EQ(body[1], (uint8_t)frames);
+		if (frames == 0)
+			CHECK(body[0] & LZS_FLAG_RESET);
+		if (body[0] & LZS_FLAG_RESET)
+			lzs_dec_reset(&dec);
+		k = lzs_dec_block(&dec, body + 4, len - 4, &o);
+		CHECK_EQ(k, body[2] | body[3] << 8);
+		CHECK(ngot + (size_t)k <= sizeof(got));
+		memcpy(got + ngot, o, (size_t)k);
+		ngot += (size_t)k;
+		frames++;
+		p = body + len + 2;
+	}
+
+	CHECK_EQ(ngot, n + strlen(tail));
+	CHECK(memcmp(got, text, n) == 0);
+	CHECK(memcmp(got + n, tail, strlen(tail)) == 0);
+	lzs_get_stats(&st);
+	CHECK_EQ(st.frames, (uint32_t)frames);
+	CHECK_EQ(st.in_bytes, ngot);
+	CHECK_EQ(st.out_bytes, nrx);
+	CHECK_EQ(st.dropped + st.in_dropped, 0);
+	/* Several times less on the wire than was written */
+	CHECK(st.out_bytes * 3 < st.in_bytes);
+}
+
+TEST(lzs_bench)
+{
+	CHECK_EQ(lzs_bench(), 0);
+}
@@ -0,0 +1,158 @@
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include "test.h"
+#include "ring.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define STRESS_ITEMS 400000u
+#define PRODUCERS 4
+#define RING_LEN 64
+
+static ring_spsc_t spsc;
+static void *spsc_slots[RING_LEN];
+static ring_mpsc_t mpsc;
+static ring_cell_t mpsc_cells[RING_LEN];
+
+/*
+ * Producers in the stress cases are plain host threads: they race
+ * the consumer for real, on every core of the host. Full and empty
+ * rings yield, a single core host would spin out its time slices.
+ */
+static void block_signals(void)
+{
+	sigset_t all;
+
+	/* Kernel signals belong to the scheduler threads */
+	sigfillset(&all);
+	pthread_sigmask(SIG_BLOCK, &all, NULL);
+}
+
+static void *spsc_producer(__attribute__((unused)) void *arg)
+{
+	block_signals();
+	for (uintptr_t i = 1; i <= STRESS_ITEMS; i++)
+		while (ring_spsc_push(&spsc, (void *)i, NULL) != RING_OK)
+			sched_yield();
+	return NULL;
+}
+
+static void *mpsc_producer(void *arg)
+{
+	uintptr_t id = (uintptr_t)arg;
+
+	block_signals();
+	for (uintptr_t i = 0; i < STRESS_ITEMS / PRODUCERS; i++)
+		while (ring_mpsc_push(&mpsc, (void *)(id << 24 | i), NULL) !=
+		       RING_OK)
+			sched_yield();
+	return NULL;
+}
+
+TEST(ring_spsc_stress)
+{
+	uintptr_t expect = 1;
+	uint32_t bad = 0;
+	pthread_t th;
+	void *item;
+
+	ring_spsc_init(&spsc, spsc_slots, RING_LEN);
+	CHECK_EQ(pthread_create(&th, NULL, spsc_producer, NULL), 0);
+	while (expect <= STRESS_ITEMS) {
+		if (ring_spsc_pop(&spsc, &item) != RING_OK) {
+			sched_yield();
+			continue;
+		}
+		/* Keep draining on a mismatch, the producer has to finish */
+		if ((uintptr_t)item != expect)
+			bad++;
+		expect++;
+	}
+	pthread_join(th, NULL);
+	CHECK_EQ(bad, 0);
+	CHECK_EQ(ring_spsc_count(&spsc), 0);
+}
+
+TEST(ring_mpsc_stress)
+{
+	uintptr_t next[PRODUCERS] = { 0 };
+	pthread_t th[PRODUCERS];
+	uint32_t got = 0, bad = 0;
+	void *item;
+
+	ring_mpsc_init(&mpsc, mpsc_cells, RING_LEN);
+	for (uintptr_t id = 0; id < PRODUCERS; id++)
+		CHECK_EQ(pthread_create(&th[id], NULL, mpsc_producer,
+					(void *)id),
+			 0);
+	while (got < STRESS_ITEMS) {
+		uintptr_t v, id;
+
+		if (ring_mpsc_pop(&mpsc, &item) != RING_OK) {
+			sched_yield();
+			continue;
+		}
+		v = (uintptr_t)item;
+		id = v >> 24;
+		/* Each producer's items arrive whole and in order */
+		if (id >= PRODUCERS || (v & 0xFFFFFF) != next[id])
+			bad++;
+		else
+			next[id]++;
+		got++;
+	}
+	for (uint32_t id = 0; id < PRODUCERS; id++)
+		pthread_join(th[id], NULL);
+	CHECK_EQ(bad, 0);
+	CHECK_EQ(got, STRESS_ITEMS);
+	CHECK(ring_mpsc_pop(&mpsc, &item) == RING_ERR_EMPTY);
+}
+
+TEST(ring_full)
+{
+	void *item;
+
+	ring_spsc_init(&spsc, spsc_slots, 4);
+	for (uintptr_t i = 0; i < 4; i++)
+		CHECK_EQ(ring_spsc_push(&spsc, (void *)i, NULL), RING_OK);
+	CHECK_EQ(ring_spsc_push(&spsc, NULL, NULL), RING_ERR_FULL);
+	CHECK_EQ(ring_spsc_pop(&spsc, &item), RING_OK);
+	CHECK(item == NULL);
+
+	ring_mpsc_init(&mpsc, mpsc_cells, 4);
+	for (uintptr_t i = 0; i < 4; i++)
+		CHECK_EQ(ring_mpsc_push(&mpsc, (void *)i, NULL), RING_OK);
+	CHECK_EQ(ring_mpsc_push(&mpsc, NULL, NULL), RING_ERR_FULL);
+}
+
+static void wake_producer(__attribute__((unused)) void *arg)
+{
+	for (uintptr_t i = 1; i <= 100; i++) {
+		while (ring_spsc_push(&spsc, (void *)i, NULL) != RING_OK)
+			vTaskDelay(1);
+		if (i % 10 == 0)
+			vTaskDelay(2);
+	}
+	vTaskDelete(NULL);
+}
+
+TEST(ring_wake)
+{
+	TickType_t t0;
+	void *item;
+
+	ring_spsc_init(&spsc, spsc_slots, 8);
+	CHECK(xTaskCreate(wake_producer, "ring_p", 256, NULL,
+			  uxTaskPriorityGet(NULL), NULL) == pdPASS);
+	for (uintptr_t i = 1; i <= 100; i++) {
+		CHECK_EQ(ring_spsc_receive(&spsc, &item, pdMS_TO_TICKS(100)),
+			 RING_OK);
+		CHECK_EQ((uintptr_t)item, i);
+	}
+
+	t0 = xTaskGetTickCount();
+	CHECK_EQ(ring_spsc_receive(&spsc, &item, 5), RING_ERR_EMPTY);
+	CHECK(xTaskGetTickCount() - t0 >= 5);
+	CHECK(spsc.waiter == NULL);
+}
@@ -0,0 +1,239 @@
+#include <stdlib.h>
+#include <string.h>
+#include "test.h"
+#include "telem.h"
+#include "uart.h"
+#include "task.h"
+
+#define BAUD 921600
+#define PERIOD_MS 5
+#define BATCH 8
+#define CAPTURE_MS 300
+#define CAP 16384
+
+static uint8_t rx[CAP];
+
+/* Every sample of test_seq moves the other channels too */
+static uint32_t test_count = 0xFFFFFF00u;
+static int32_t test_level = -12345;
+static telem_hist_t test_hist;
+static uint32_t seq_calls;
+
+static int32_t test_seq(void)
+{
+	seq_calls++;
+	test_count += 5;
+	telem_hist_add(&test_hist, seq_calls);
+	return 1000 - 7 * (int32_t)seq_calls;
+}
+
+TELEM_GAUGE_FN(test_seq, 1);
+TELEM_COUNTER(test_count, 2);
+TELEM_GAUGE(test_level, 3);
+TELEM_HIST(test_hist, 4);
+
+typedef struct {
+	char name[TELEM_NAME_MAX + 1];
+	uint8_t kind;
+	uint8_t div;
+	uint8_t based;
+	uint32_t val[TELEM_HIST_BINS];
+	uint32_t nsamples;
+	uint32_t bad;
+} chan_t;
+
+static chan_t chans[TELEM_CHAN_MAX];
+static uint32_t nchans;
+
+static uint32_t varint(const uint8_t **p)
+{
+	uint32_t v = 0;
+
+	for (uint32_t shift = 0;; shift += 7) {
+		uint8_t b = *(*p)++;
+
+		v |= (uint32_t)(b & 0x7F) << shift;
+		if (!(b & 0x80))
+			return v;
+	}
+}
+
+static uint16_t fletcher16(const uint8_t *p, size_t n)
+{
+	uint32_t a = 0, b = 0;
+
+	while (n--) {
+		a = (a + *p++) % 255;
+		b = (b + a) % 255;
+	}
+	return (uint16_t)(b << 8 | a);
+}
+
+static chan_t *chan_find(const char *name)
+{
+	for (uint32_t i = 0; i < nchans; i++)
+		if (strcmp(chans[i].name, name) == 0)
+			return &chans[i];
+	return NULL;
+}
+
+/** @brief Check one decoded sample against what the channel can hold */
+static void chan_check(chan_t *c, uint32_t prev0)
+{
+	int32_t v = (int32_t)c->val[0];
+
+	if (strcmp(c->name, "test_seq") == 0) {
+		/* Consecutive calls, none skipped */
+		if (c->nsamples && v != (int32_t)prev0 - 7)
+			c->bad++;
+	} else if (strcmp(c->name, "test_count") == 0) {
+		/* Across the wrap: steps of 5 from the start value */
+		if ((c->val[0] - 0xFFFFFF00u) % 5 ||
+		    (c->nsamples && c->val[0] - prev0 >= 0x80000000u))
+			c->bad++;
+	} else if (strcmp(c->name, "test_level") == 0) {
+		if (v != -12345)
+			c->bad++;
+	}
+	c->nsamples++;
+}
+
+static void decode_samples(const uint8_t *p, uint32_t tick0, uint8_t nticks,
+			   int key)
+{
+	if (key)
+		for (uint32_t i = 0; i < nchans; i++)
+			chans[i].based = 0;
+
+	for (uint32_t t = tick0; t < tick0 + nticks; t++) {
+		for (uint32_t i = 0; i < nchans; i++) {
+			chan_t *c = &chans[i];
+			uint32_t prev0 = c->val[0], n, d;
+
+			if (t % c->div)
+				continue;
+			n = c->kind == TELEM_KIND_HIST ? TELEM_HIST_BINS : 1;
+			for (uint32_t j = 0; j < n; j++) {
+				d = varint(&p);
+				if (c->kind == TELEM_KIND_GAUGE)
+					d = (d >> 1) ^ -(d & 1);
+				c->val[j] = c->based ? c->val[j] + d : d;
+			}
+			c->based = 1;
+			chan_check(c, prev0);
+		}
+	}
+}
+
+TEST(telem_stream)
+{
+	uart_config_t cfg = {
+		.baud = BAUD,
+		.tx_buf_size = 1024,
+		.rx_buf_size = 4096,
+		.use_dma = 1,
+		.irq_prio = 1,
+	};
+	uint32_t got = 0, frames[3] = { 0 }, hist_total = 0;
+	telem_stats_t st;
+	TickType_t t0;
+	const uint8_t *p;
+	chan_t *c;
+	int synced = 0;
+
+	/* Open with a receive side big enough to read back the stream */
+	setenv("SIM_UART1", "loop", 1);
+	CHECK_EQ(uart_init(UART_PORT1, &cfg), 0);
+	CHECK_EQ(telem_start(UART_PORT1, BAUD, PERIOD_MS, BATCH,
+			     uxTaskPriorityGet(NULL) + 1),
+		 0);
+
+	t0 = xTaskGetTickCount();
+	while (xTaskGetTickCount() - t0 < pdMS_TO_TICKS(CAPTURE_MS) &&
+	       got < CAP)
+		got += uart_read_some(UART_PORT1, rx + got, CAP - got,
+				      pdMS_TO_TICKS(10));
+
+	for (p = rx; p + 5 <= rx + got;) {
+		uint32_t len = p[1] | (uint32_t)p[2] << 8, tick0;
+		const uint8_t *body = p + 3, *q;
+		uint8_t type, nticks;
+
+		/* The stream starts on a frame and loses nothing */
+		CHECK_EQ(p[0], TELEM_SYNC);
+		if (body + len + 2 > rx + got)
+			break;
+		CHECK_EQ(fletcher16(body, len),
+			 body[len] | (uint16_t)body[len + 1] << 8);
+		type = body[0];
+		q = body + 2;
+		tick0 = varint(&q);
+		nticks = *q++;
+		CHECK(type <= TELEM_FRAME_DELTA);
+		frames[type]++;
+
+		if (type == TELEM_FRAME_SCHEMA) {
+			CHECK_EQ(varint(&q), PERIOD_MS);
+			nchans = *q++;
+			CHECK_EQ(nchans, 4);
+			for (uint32_t i = 0; i < nchans; i++) {
+				chans[i].kind = *q++;
+				chans[i].div = *q++;
+				memcpy(chans[i].name, q + 1, *q);
+				chans[i].name[*q] = 0;
+				q += 1 + *q;
+			}
+			synced = 1;
+		} else {
+			/* Schema first, then a key frame */
+			CHECK(synced && frames[TELEM_FRAME_KEY] > 0);
+			CHECK(nticks >= 1 && nticks <= BATCH);
+			decode_samples(q, tick0, nticks,
+				       type == TELEM_FRAME_KEY);
+		}
+		p = body + len + 2;
+	}
+
+	CHECK_EQ(frames[TELEM_FRAME_SCHEMA], 1);
+	CHECK(frames[TELEM_FRAME_KEY] >= 1);
+	CHECK(frames[TELEM_FRAME_DELTA] >= 2);
+
+	c = chan_find("test_seq");
+	CHECK(c && c->kind == TELEM_KIND_GAUGE && c->div == 1);
+	CHECK(c->nsamples >= 2 * BATCH);
+	CHECK_EQ(c->bad, 0);
+	c = chan_find("test_count");
+	CHECK(c && c->kind == TELEM_KIND_COUNTER && c->div == 2);
+	CHECK(c->nsamples >= BATCH);
+	CHECK_EQ(c->bad, 0);
+	c = chan_find("test_level");
+	CHECK(c && c->nsamples > 0);
+	CHECK_EQ(c->bad, 0);
+	c = chan_find("test_hist");
+	CHECK(c && c->kind == TELEM_KIND_HIST && c->nsamples > 0);
+	for (uint32_t j = 0; j < TELEM_HIST_BINS; j++)
+		hist_total += c->val[j];
+	/* Sampled after some test_seq call of the same period at the latest */
+	CHECK(hist_total > 0 && hist_total <= seq_calls);
+
+	telem_get_stats(&st);
+	CHECK_EQ(st.dropped, 0);
+	CHECK(st.frames >= frames[0] + frames[1] + frames[2]);
+	CHECK(st.samples > 0 && st.tick_cycles_max >= st.tick_cycles_avg);
+}
+
+TEST(telem_hist_bins)
+{
+	telem_hist_t h = { 0 };
+
+	telem_hist_add(&h, 0);
+	telem_hist_add(&h, 1);
+	telem_hist_add(&h, 3);
+	telem_hist_add(&h, 4);
+	telem_hist_add(&h, 0xFFFFFFFF);
+	CHECK_EQ(h.bins[0], 1);
+	CHECK_EQ(h.bins[1], 1);
+	CHECK_EQ(h.bins[2], 1);
+	CHECK_EQ(h.bins[3], 1);
+	CHECK_EQ(h.bins[TELEM_HIST_BINS - 1], 1);
+}
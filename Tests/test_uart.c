@@ -0,0 +1,80 @@
+#include <stdlib.h>
+#include <string.h>
+#include "test.h"
+#include "uart.h"
+#include "task.h"
+
+#define LEN 512
+#define CHUNK 64
+
+static uint8_t tx[LEN];
+static uint8_t rx[LEN];
+
+/** @brief Milliseconds to move n bytes at baud, 10 bits per byte */
+static uint32_t wire_ms(uint32_t n, uint32_t baud)
+{
+	return n * 10 * 1000 / baud;
+}
+
+TEST(uart_loopback)
+{
+	const uart_config_t cfg = UART_CONFIG_DEFAULT;
+	uart_stats_t st;
+	TickType_t t0;
+
+	setenv("SIM_UART2", "loop", 1);
+	CHECK_EQ(uart_init(UART_PORT2, &cfg), 0);
+	for (uint32_t i = 0; i < LEN; i++)
+		tx[i] = (uint8_t)(i * 13 + 5);
+
+	t0 = xTaskGetTickCount();
+	for (uint32_t off = 0; off < LEN; off += CHUNK) {
+		CHECK_EQ(uart_write(UART_PORT2, tx + off, CHUNK,
+				    UART_WAIT_FOREVER),
+			 CHUNK);
+		CHECK_EQ(uart_read(UART_PORT2, rx + off, CHUNK,
+				   pdMS_TO_TICKS(100)),
+			 CHUNK);
+	}
+	CHECK(memcmp(tx, rx, LEN) == 0);
+	/* Paced by the baud rate, not by the host */
+	CHECK(xTaskGetTickCount() - t0 >=
+	      pdMS_TO_TICKS(wire_ms(LEN, cfg.baud) * 3 / 4));
+
+	uart_get_stats(UART_PORT2, &st);
+	CHECK_EQ(st.tx_bytes, LEN);
+	CHECK_EQ(st.rx_bytes, LEN);
+	CHECK_EQ(st.rx_dropped, 0);
+}
+
+TEST(uart_flush)
+{
+	const uart_config_t cfg = UART_CONFIG_DEFAULT;
+	TickType_t t0;
+
+	setenv("SIM_UART3", "null", 1);
+	CHECK_EQ(uart_init(UART_PORT3, &cfg), 0);
+	memset(tx, 0x55, 200);
+
+	t0 = xTaskGetTickCount();
+	CHECK_EQ(uart_write(UART_PORT3, tx, 200, UART_WAIT_FOREVER), 200);
+	CHECK_EQ(uart_flush(UART_PORT3, pdMS_TO_TICKS(200)), pdTRUE);
+	CHECK(xTaskGetTickCount() - t0 >=
+	      pdMS_TO_TICKS(wire_ms(200 - 16, cfg.baud)));
+}
+
+TEST(uart_read_timeout)
+{
+	uint8_t b;
+
+	/* Port 2 is looped back and idle: nothing to read */
+	CHECK_EQ(uart_read_some(UART_PORT2, &b, 1, pdMS_TO_TICKS(5)), 0);
+}
+
+TEST(uart_dma_only_on_port1)
+{
+	uart_config_t cfg = UART_CONFIG_DEFAULT;
+
+	cfg.use_dma = 1;
+	CHECK_EQ(uart_init(UART_PORT4, &cfg), -1);
+}
@@ -0,0 +1,48 @@
+#!/usr/bin/env python3
+"""Generate twiddle tables of Lib/dsp (placed in flash as const data).
+
+Usage: dsp_twiddle_gen.py [size] > Lib/dsp/src/dsp_twiddle.c
+"""
+import math
+import sys
+
+
+def q15(v):
+    return max(-32768, min(32767, int(round(v * 32768.0))))
+
+
+def q31(v):
+    return max(-2**31, min(2**31 - 1, int(round(v * 2.0**31))))
+
+
+def main():
+    size = int(sys.argv[1]) if len(sys.argv) > 1 else 1024
+    out = sys.stdout
+    out.write("/* Generated by Tools/dsp_twiddle_gen.py, do not edit */\n")
+    out.write('#include "dsp_tables.h"\n\n')
+    out.write("#if DSP_FFT_MAX != %d\n" % size)
+    out.write('#error "regenerate twiddle tables for DSP_FFT_MAX"\n')
+    out.write("#endif\n\n")
+
+    out.write("/* exp(-2*pi*i*k/DSP_FFT_MAX), interleaved re/im */\n")
+    out.write("const float dsp_twiddle_f32[2 * DSP_FFT_MAX] = {\n")
+    for k in range(size):
+        a = -2.0 * math.pi * k / size
+        out.write("\t%.9ef, %.9ef,\n" % (math.cos(a), math.sin(a)))
+    out.write("};\n\n")
+
+    out.write("const int16_t dsp_twiddle_q15[2 * DSP_FFT_MAX] = {\n")
+    for k in range(size):
+        a = -2.0 * math.pi * k / size
+        out.write("\t%d, %d,\n" % (q15(math.cos(a)), q15(math.sin(a))))
+    out.write("};\n\n")
+
+    out.write("const int32_t dsp_twiddle_q31[2 * DSP_FFT_MAX] = {\n")
+    for k in range(size):
+        a = -2.0 * math.pi * k / size
+        out.write("\t%d, %d,\n" % (q31(math.cos(a)), q31(math.sin(a))))
+    out.write("};\n")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,150 @@
+#!/usr/bin/env python3
+"""Upload a firmware image over UART to Lib/fwup.
+
+Usage:
+    fwup.py --port /dev/ttyUSB0 --a exmp.bin --b exmp_slot_b.bin
+
+The device writes the slot it is not running from, so both slot
+builds are given and the one for the free slot is sent. An upload
+cut short continues where it stopped on the next run with the same
+image. Needs pyserial. The new image starts on the next reset; it
+has to confirm itself or the boot image goes back to the old one.
+"""
+import argparse
+import struct
+import sys
+import time
+import zlib
+
+SYNC = 0xA6
+START, DATA, END, REPLY = 0, 1, 2, 0x80
+CHUNK = 512
+WINDOW = 2
+REPLY_LEN = 14
+STATUS = {0: "ok", -1: "bad parameter", -2: "flash error", -3: "bad CRC",
+          -4: "out of order", -5: "no session", -6: "timeout"}
+
+
+def frame(typ, off, payload=b""):
+    body = struct.pack("<BHI", typ, len(payload), off) + payload
+    return bytes([SYNC]) + body + struct.pack("<I", zlib.crc32(body))
+
+
+class Link:
+    def __init__(self, ser):
+        self.ser = ser
+        self.bad = 0
+
+    def send(self, typ, off, payload=b""):
+        self.ser.write(frame(typ, off, payload))
+
+    def reply(self, timeout):
+        """Next good reply as (type, next offset, status, slot)."""
+        end = time.monotonic() + timeout
+        buf = b""
+        while time.monotonic() < end:
+            buf += self.ser.read(REPLY_LEN - len(buf) if buf else 1)
+            pos = buf.find(bytes([SYNC]))
+            if pos < 0:
+                buf = b""
+                continue
+            buf = buf[pos:]
+            if len(buf) < REPLY_LEN:
+                continue
+            body, crc = buf[1:REPLY_LEN - 4], buf[REPLY_LEN - 4:]
+            if zlib.crc32(body) != struct.unpack("<I", crc)[0]:
+                self.bad += 1
+                buf = buf[1:]
+                continue
+            typ, _, off, st, slot = struct.unpack("<BHIbB", body)
+            return typ & ~REPLY, off, st, slot
+        return None
+
+
+def request(link, typ, off, payload, timeout, tries=3):
+    for _ in range(tries):
+        link.ser.reset_input_buffer()
+        link.send(typ, off, payload)
+        r = link.reply(timeout)
+        if r and r[0] == typ:
+            return r
+    sys.exit("no reply to frame type %d" % typ)
+
+
+def upload(link, img, off):
+    """Send img from off keeping WINDOW chunks in flight."""
+    acked = off
+    sent = []
+    resends = 0
+    while acked < len(img):
+        while len(sent) < WINDOW and off < len(img):
+            n = min(CHUNK, len(img) - off)
+            link.send(DATA, off, img[off:off + n])
+            sent.append(off + n)
+            off += n
+        r = link.reply(1.0)
+        if r and r[0] == DATA and r[2] == 0:
+            acked = r[1]
+            sent = [e for e in sent if e > acked]
+            continue
+        if r and r[0] == DATA and r[2] not in (-3, -4):
+            sys.exit("device refused data: %s" % STATUS.get(r[2], r[2]))
+        # Go back: replies of the frames still in flight are dropped
+        if r:
+            acked = r[1]
+        time.sleep(0.05)
+        link.ser.reset_input_buffer()
+        resends += len(sent)
+        sent = []
+        off = acked
+        print("\r%d / %d bytes" % (acked, len(img)), end="", file=sys.stderr)
+    print(file=sys.stderr)
+    return resends
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("--port", required=True)
+    ap.add_argument("--baud", type=int, default=921600)
+    ap.add_argument("--a", required=True, help="image linked for slot A")
+    ap.add_argument("--b", required=True, help="image linked for slot B")
+    args = ap.parse_args()
+
+    import serial
+
+    with serial.Serial(args.port, args.baud, timeout=0.05) as ser:
+        link = Link(ser)
+        # An empty image is refused, the reply tells the free slot
+        slot = request(link, START, 0, struct.pack("<II", 0, 0), 1.0)[3]
+        with open(args.b if slot else args.a, "rb") as f:
+            img = f.read()
+        crc = zlib.crc32(img)
+        print("slot %s, %d bytes, crc %08x" % ("AB"[slot], len(img), crc),
+              file=sys.stderr)
+
+        # The device erases the rest of the slot before it replies
+        t0 = time.monotonic()
+        _, off, st, _ = request(link, START, 0,
+                                struct.pack("<II", len(img), crc), 30.0)
+        if st == -5:
+            sys.exit("start refused: running image not confirmed yet")
+        if st:
+            sys.exit("start refused: %s" % STATUS.get(st, st))
+        if off:
+            print("resuming at %d" % off, file=sys.stderr)
+        t1 = time.monotonic()
+        resends = upload(link, img, off)
+        _, _, st, _ = request(link, END, 0, b"", 10.0)
+        t2 = time.monotonic()
+        if st:
+            sys.exit("commit failed: %s" % STATUS.get(st, st))
+        print("erase %.1f s, data %.1f s (%.1f KiB/s), %d chunks resent, "
+              "%d bad replies" %
+              (t1 - t0, t2 - t1, (len(img) - off) / 1024 / (t2 - t1),
+               resends, link.bad), file=sys.stderr)
+        print("done, reset the board to start the new image",
+              file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,176 @@
+#!/usr/bin/env python3
+"""Decompress a Lib/lzs frame stream back to the raw UART output.
+
+Usage:
+    lzs_cat.py capture.bin -o raw.bin
+    lzs_cat.py --port /dev/ttyUSB0 --baud 921600 --seconds 10 -o raw.bin
+    lzs_cat.py capture.bin | telem2csv.py -o telem.csv
+
+The output is what the log and the telemetry would have sent without
+the compression, in the order it was written: log text with the
+Lib/telem frames in between, which telem2csv.py picks out by itself.
+--port reads live and needs pyserial. Corrupt frames are skipped by
+resyncing on the next sync byte; after a seq gap output resumes at the
+next reset frame. Frame, loss and ratio figures are printed to stderr.
+"""
+import argparse
+import sys
+import time
+
+SYNC = 0xA7
+FLAG_RESET = 0x01
+WINDOW = 2048
+MIN_MATCH = 4
+RUN = 15
+
+
+def fletcher16(data):
+    a = b = 0
+    for c in data:
+        a = (a + c) % 255
+        b = (b + a) % 255
+    return b << 8 | a
+
+
+def frames(data, stats):
+    """Yield frame bodies with a good checksum, resyncing on errors."""
+    pos = 0
+    while True:
+        pos = data.find(bytes([SYNC]), pos)
+        if pos < 0 or pos + 3 > len(data):
+            return
+        n = data[pos + 1] | data[pos + 2] << 8
+        end = pos + 3 + n + 2
+        if n < 4 or end > len(data):
+            pos += 1
+            continue
+        body = data[pos + 3:pos + 3 + n]
+        if fletcher16(body) != (data[end - 2] | data[end - 1] << 8):
+            stats["bad"] += 1
+            pos += 1
+            continue
+        stats["wire"] += end - pos
+        yield body
+        pos = end
+
+
+def length(data, pos, n):
+    while True:
+        c = data[pos]
+        pos += 1
+        n += c
+        if c != 255:
+            return n, pos
+
+
+def decode(data, hist):
+    """Decode one block onto hist, return the new bytes."""
+    start = len(hist)
+    pos = 0
+    while pos < len(data):
+        token = data[pos]
+        pos += 1
+        nlit = token >> 4
+        if nlit == RUN:
+            nlit, pos = length(data, pos, nlit)
+        if pos + nlit > len(data):
+            raise ValueError("literals past the end")
+        hist += data[pos:pos + nlit]
+        pos += nlit
+        if pos == len(data):
+            break
+        off = data[pos] | data[pos + 1] << 8
+        pos += 2
+        m = token & RUN
+        if m == RUN:
+            m, pos = length(data, pos, m)
+        m += MIN_MATCH
+        if off == 0 or off > WINDOW or off > len(hist):
+            raise ValueError("match offset out of the window")
+        for _ in range(m):
+            hist.append(hist[-off])
+    return bytes(hist[start:])
+
+
+class Decoder:
+    def __init__(self, out):
+        self.out = out
+        self.hist = None
+        self.seq = None
+        self.stats = {"frames": 0, "bad": 0, "lost": 0, "skipped": 0,
+                      "wire": 0, "raw": 0}
+
+    def feed(self, body):
+        flags, seq = body[0], body[1]
+        raw_len = body[2] | body[3] << 8
+        self.stats["frames"] += 1
+        if self.seq is not None and seq != (self.seq + 1) & 0xFF:
+            self.stats["lost"] += (seq - self.seq - 1) & 0xFF
+            self.hist = None
+        self.seq = seq
+
+        if flags & FLAG_RESET:
+            self.hist = bytearray()
+        if self.hist is None:
+            self.stats["skipped"] += 1
+            return
+        try:
+            raw = decode(body[4:], self.hist)
+        except (IndexError, ValueError):
+            raw = None
+        if raw is None or len(raw) != raw_len:
+            self.stats["bad"] += 1
+            self.hist = None
+            return
+        del self.hist[:-WINDOW]
+        self.stats["raw"] += len(raw)
+        self.out.write(raw)
+
+    def summary(self, out):
+        s = self.stats
+        out.write("frames %d, lost %d, corrupt %d, skipped %d\n" %
+                  (s["frames"], s["lost"], s["bad"], s["skipped"]))
+        if s["wire"]:
+            out.write("%d bytes from %d on the wire, ratio %.2f\n" %
+                      (s["raw"], s["wire"], s["raw"] / s["wire"]))
+
+
+def capture(port, baud, seconds):
+    import serial
+
+    data = bytearray()
+    end = time.monotonic() + seconds
+    with serial.Serial(port, baud, timeout=0.1) as ser:
+        while time.monotonic() < end:
+            data += ser.read(4096)
+    return bytes(data)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("input", nargs="?", help="captured stream, - for stdin")
+    ap.add_argument("-o", "--output", default="-", help="raw output file")
+    ap.add_argument("--port", help="read live from a serial port")
+    ap.add_argument("--baud", type=int, default=921600)
+    ap.add_argument("--seconds", type=float, default=10.0)
+    args = ap.parse_args()
+
+    if args.port:
+        data = capture(args.port, args.baud, args.seconds)
+    elif args.input and args.input != "-":
+        with open(args.input, "rb") as f:
+            data = f.read()
+    else:
+        data = sys.stdin.buffer.read()
+
+    f = sys.stdout.buffer if args.output == "-" else open(args.output, "wb")
+    dec = Decoder(f)
+    for body in frames(data, dec.stats):
+        dec.feed(body)
+    if f is not sys.stdout.buffer:
+        f.close()
+    dec.summary(sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
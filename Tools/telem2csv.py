@@ -0,0 +1,200 @@
+#!/usr/bin/env python3
+"""Convert a Lib/telem frame stream to CSV time series.
+
+Usage:
+    telem2csv.py capture.bin -o telem.csv
+    telem2csv.py --port /dev/ttyUSB0 --baud 921600 --seconds 10 -o telem.csv
+
+The capture is the raw UART stream; --port reads it live and needs
+pyserial. Output rows are time_ms,channel,value, histogram bins as
+channel[bin]. Decoding starts at the first schema frame, corrupt
+frames are skipped by resyncing on the next sync byte and a lost
+frame mutes the stream until the next key frame. Frame and error
+counts are printed to stderr.
+"""
+import argparse
+import csv
+import sys
+import time
+
+SYNC = 0xA5
+SCHEMA, KEY, DELTA = 0, 1, 2
+COUNTER, GAUGE, HIST = 0, 1, 2
+HIST_BINS = 16
+KINDS = {COUNTER: "counter", GAUGE: "gauge", HIST: "hist"}
+
+
+def fletcher16(data):
+    a = b = 0
+    for c in data:
+        a = (a + c) % 255
+        b = (b + a) % 255
+    return b << 8 | a
+
+
+def varint(data, pos):
+    v = shift = 0
+    while True:
+        c = data[pos]
+        pos += 1
+        v |= (c & 0x7F) << shift
+        if not c & 0x80:
+            return v, pos
+        shift += 7
+
+
+def frames(data, stats):
+    """Yield frame bodies with a good checksum, resyncing on errors."""
+    pos = 0
+    while True:
+        pos = data.find(bytes([SYNC]), pos)
+        if pos < 0 or pos + 3 > len(data):
+            return
+        n = data[pos + 1] | data[pos + 2] << 8
+        end = pos + 3 + n + 2
+        if n < 4 or end > len(data):
+            pos += 1
+            continue
+        body = data[pos + 3:pos + 3 + n]
+        if fletcher16(body) != (data[end - 2] | data[end - 1] << 8):
+            stats["bad"] += 1
+            pos += 1
+            continue
+        yield body
+        pos = end
+
+
+class Channel:
+    def __init__(self, name, kind, div):
+        self.name = name
+        self.kind = kind
+        self.div = div
+        self.based = False
+        self.val = [0] * (HIST_BINS if kind == HIST else 1)
+
+
+class Decoder:
+    def __init__(self, out):
+        self.out = out
+        self.chans = None
+        self.period_ms = 1
+        self.seq = None
+        self.muted = True
+        self.stats = {"frames": 0, "bad": 0, "lost": 0, "samples": 0}
+
+    def schema(self, body, pos):
+        self.period_ms, pos = varint(body, pos)
+        count = body[pos]
+        pos += 1
+        chans = []
+        for _ in range(count):
+            kind, div, n = body[pos], body[pos + 1], body[pos + 2]
+            name = body[pos + 3:pos + 3 + n].decode("ascii", "replace")
+            chans.append(Channel(name, kind, div))
+            pos += 3 + n
+        # A repeated schema keeps the decoding state
+        if self.chans is None or [(c.name, c.kind, c.div)
+                                  for c in self.chans] != \
+                [(c.name, c.kind, c.div) for c in chans]:
+            self.chans = chans
+            self.muted = True
+
+    def samples(self, body, pos, tick0, nticks):
+        for tick in range(tick0, tick0 + nticks):
+            ms = tick * self.period_ms
+            for c in self.chans:
+                if tick % c.div:
+                    continue
+                for i in range(len(c.val)):
+                    d, pos = varint(body, pos)
+                    if c.kind == GAUGE:
+                        d = (d >> 1) ^ -(d & 1)
+                    v = c.val[i] + d if c.based else d
+                    if c.kind == GAUGE:
+                        v = (v + 0x80000000 & 0xFFFFFFFF) - 0x80000000
+                    else:
+                        v &= 0xFFFFFFFF
+                    c.val[i] = v
+                c.based = True
+                self.stats["samples"] += 1
+                if c.kind == HIST:
+                    for i, v in enumerate(c.val):
+                        self.out.writerow([ms, "%s[%d]" % (c.name, i), v])
+                else:
+                    self.out.writerow([ms, c.name, c.val[0]])
+
+    def feed(self, body):
+        typ, seq = body[0], body[1]
+        tick0, pos = varint(body, 2)
+        nticks = body[pos]
+        pos += 1
+        self.stats["frames"] += 1
+        if self.seq is not None and seq != (self.seq + 1) & 0xFF:
+            self.stats["lost"] += (seq - self.seq - 1) & 0xFF
+            self.muted = True
+        self.seq = seq
+
+        if typ == SCHEMA:
+            self.schema(body, pos)
+            return
+        if self.chans is None:
+            return
+        if typ == KEY:
+            self.muted = False
+            for c in self.chans:
+                c.based = False
+        if not self.muted:
+            self.samples(body, pos, tick0, nticks)
+
+    def summary(self, out):
+        s = self.stats
+        out.write("frames %d, samples %d, lost %d, corrupt %d\n" %
+                  (s["frames"], s["samples"], s["lost"], s["bad"]))
+        for c in self.chans or []:
+            out.write("  %-16s %-7s every %d ms\n" %
+                      (c.name, KINDS.get(c.kind, "?"),
+                       c.div * self.period_ms))
+
+
+def capture(port, baud, seconds):
+    import serial
+
+    data = bytearray()
+    end = time.monotonic() + seconds
+    with serial.Serial(port, baud, timeout=0.1) as ser:
+        while time.monotonic() < end:
+            data += ser.read(4096)
+    return bytes(data)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("input", nargs="?", help="captured stream, - for stdin")
+    ap.add_argument("-o", "--output", default="-", help="CSV file")
+    ap.add_argument("--port", help="read live from a serial port")
+    ap.add_argument("--baud", type=int, default=921600)
+    ap.add_argument("--seconds", type=float, default=10.0)
+    args = ap.parse_args()
+
+    if args.port:
+        data = capture(args.port, args.baud, args.seconds)
+    elif args.input and args.input != "-":
+        with open(args.input, "rb") as f:
+            data = f.read()
+    else:
+        data = sys.stdin.buffer.read()
+
+    f = sys.stdout if args.output == "-" else open(args.output, "w",
+                                                    newline="")
+    out = csv.writer(f)
+    out.writerow(["time_ms", "channel", "value"])
+    dec = Decoder(out)
+    for body in frames(data, dec.stats):
+        dec.feed(body)
+    if f is not sys.stdout:
+        f.close()
+    dec.summary(sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,320 @@
+#!/usr/bin/env python3
+"""Convert a Lib/trace event stream to Chrome/Perfetto trace JSON.
+
+Usage:
+    trace2json.py capture.bin -o trace.json
+    trace2json.py --port /dev/ttyUSB0 --baud 921600 --seconds 10 -o trace.json
+
+The capture is the raw UART stream (e.g. saved by any terminal
+program); --port reads it live and needs pyserial. Open the result
+in https://ui.perfetto.dev or chrome://tracing. A per-task summary
+of run time and ready-to-run latency is printed to stderr.
+"""
+import argparse
+import json
+import struct
+import sys
+import time
+
+REC = struct.Struct("<IBBH")
+PAYLOAD = 0x80
+
+TASK_IN = 0x01
+TASK_OUT = 0x02
+TASK_READY = 0x03
+TASK_DELETE = 0x04
+TASK_DELAY = 0x05
+PRIO_INHERIT = 0x06
+PRIO_DISINHERIT = 0x07
+QUEUE_CREATE = 0x10
+QUEUE_SEND = 0x11
+QUEUE_RECV = 0x12
+QUEUE_BLOCK_SEND = 0x13
+QUEUE_BLOCK_RECV = 0x14
+QUEUE_SEND_ISR = 0x15
+QUEUE_RECV_ISR = 0x16
+NOTIFY_BLOCK = 0x17
+NOTIFY_ISR = 0x18
+ISR_ENTER = 0x20
+ISR_EXIT = 0x21
+TICK = 0x22
+USER = 0x30
+DROPPED = 0x40
+TASK_NAME = PAYLOAD | 0x01
+QUEUE_NAME = PAYLOAD | 0x02
+CLOCK = PAYLOAD | 0x03
+STATS = PAYLOAD | 0x04
+SYNC = 0xFF
+SYNC_REC = REC.pack(0x31435254, SYNC, 0, 0xA55A)
+
+QUEUE_OPS = {
+    QUEUE_SEND: "send",
+    QUEUE_RECV: "recv",
+    QUEUE_BLOCK_SEND: "block send",
+    QUEUE_BLOCK_RECV: "block recv",
+    QUEUE_SEND_ISR: "send",
+    QUEUE_RECV_ISR: "recv",
+}
+QUEUE_TYPES = {
+    0: "queue",
+    1: "mutex",
+    2: "counting sem",
+    3: "binary sem",
+    4: "recursive mutex",
+    5: "queue set",
+}
+
+PID = 1
+ISR_TID = 0
+
+
+def records(data):
+    """Yield (ts, type, arg, id, payload) from the first sync on."""
+    pos = data.find(SYNC_REC)
+    if pos < 0:
+        sys.exit("no sync record in the stream")
+    end = len(data) - REC.size + 1
+    while pos < end:
+        ts, typ, arg, rid = REC.unpack_from(data, pos)
+        pos += REC.size
+        payload = b""
+        if typ & PAYLOAD and typ != SYNC:
+            n = (arg + REC.size - 1) // REC.size * REC.size
+            payload = data[pos:pos + arg]
+            pos += n
+        yield ts, typ, arg, rid, payload
+
+
+class Converter:
+    def __init__(self, hz):
+        self.hz = hz
+        self.events = []
+        self.tasks = {}
+        self.queues = {}
+        self.running = None
+        self.run_start = 0
+        self.run_args = {}
+        self.ready_at = {}
+        self.stats = {}
+        self.isr_depth = 0
+        self.last_ts = None
+        self.cycles = 0
+        self.base_us = 0.0
+        self.recorder = None
+        self.dropped = 0
+
+    def us(self):
+        return self.base_us + self.cycles * 1e6 / self.hz
+
+    def task_name(self, tid):
+        return self.tasks.get(tid, "task %d" % tid)
+
+    def queue_name(self, qid):
+        return self.queues.get(qid, "queue %d" % qid)
+
+    def task_stats(self, tid):
+        return self.stats.setdefault(
+            tid, {"run": 0, "switches": 0, "lat_max": 0.0, "lat_sum": 0.0}
+        )
+
+    def emit(self, **ev):
+        ev.setdefault("pid", PID)
+        self.events.append(ev)
+
+    def instant(self, tid, name, **args):
+        self.emit(name=name, ph="i", s="t", ts=self.us(), tid=tid,
+                  args=args)
+
+    def current_tid(self):
+        if self.isr_depth:
+            return ISR_TID
+        return self.running if self.running is not None else ISR_TID
+
+    def advance(self, ts):
+        if self.last_ts is not None:
+            # Timestamps are taken before the recorder lock, an interrupt
+            # may record in between: allow small steps back
+            d = (ts - self.last_ts) & 0xFFFFFFFF
+            if d >= 0x80000000:
+                d -= 0x100000000
+            self.cycles += d
+        self.last_ts = ts
+
+    def switch_out(self, tid):
+        if self.running != tid:
+            return
+        start = self.run_start
+        self.emit(name=self.task_name(tid), ph="X", tid=tid,
+                  ts=start, dur=max(self.us() - start, 0.0),
+                  args=self.run_args)
+        self.task_stats(tid)["run"] += self.us() - start
+        self.running = None
+
+    def feed(self, ts, typ, arg, rid, payload):
+        if typ == SYNC:
+            self.last_ts = None
+            return
+        if typ == CLOCK:
+            # Clock change mid-stream: the cycles so far keep the old rate
+            if self.last_ts is not None:
+                self.advance(ts)
+                self.base_us = self.us()
+                self.cycles = 0
+            self.hz = struct.unpack_from("<I", payload)[0]
+            return
+        if typ == TASK_NAME:
+            self.tasks[rid] = payload.decode(errors="replace")
+            self.emit(name="thread_name", ph="M", tid=rid,
+                      args={"name": self.tasks[rid]})
+            self.emit(name="thread_sort_index", ph="M", tid=rid,
+                      args={"sort_index": rid})
+            return
+        if typ == QUEUE_NAME:
+            self.queues[rid] = payload.decode(errors="replace")
+            return
+        if typ == STATS:
+            keys = ("events", "dropped", "rec_cycles_max",
+                    "rec_cycles_avg", "ring_hwm", "sent_bytes")
+            self.recorder = dict(zip(keys, struct.unpack_from("<6I",
+                                                              payload)))
+            self.emit(name="recorder", ph="C", ts=self.us(), tid=ISR_TID,
+                      args={"dropped": self.recorder["dropped"],
+                            "ring_hwm": self.recorder["ring_hwm"]})
+            return
+
+        self.advance(ts)
+        now = self.us()
+
+        if typ == TASK_IN:
+            if self.running is not None:
+                self.switch_out(self.running)
+            st = self.task_stats(rid)
+            st["switches"] += 1
+            args = {"prio": arg}
+            if rid in self.ready_at:
+                lat = now - self.ready_at.pop(rid)
+                st["lat_max"] = max(st["lat_max"], lat)
+                st["lat_sum"] += lat
+                st.setdefault("lat_n", 0)
+                st["lat_n"] += 1
+                args["ready_latency_us"] = round(lat, 3)
+            self.running = rid
+            self.run_start = now
+            self.run_args = args
+        elif typ == TASK_OUT:
+            self.switch_out(rid)
+        elif typ == TASK_READY:
+            if rid != self.running:
+                self.ready_at.setdefault(rid, now)
+        elif typ == TASK_DELETE:
+            self.instant(rid, "deleted")
+        elif typ == TASK_DELAY:
+            self.instant(self.current_tid(), "delay")
+        elif typ in (PRIO_INHERIT, PRIO_DISINHERIT):
+            what = "inherit" if typ == PRIO_INHERIT else "disinherit"
+            self.instant(rid, "prio %s" % what, prio=arg)
+        elif typ == QUEUE_CREATE:
+            self.queues.setdefault(rid, "%s %d" % (
+                QUEUE_TYPES.get(arg, "queue"), rid))
+        elif typ in QUEUE_OPS:
+            qname = self.queue_name(rid)
+            tid = ISR_TID if typ in (QUEUE_SEND_ISR,
+                                     QUEUE_RECV_ISR) else self.current_tid()
+            self.instant(tid, "%s %s" % (QUEUE_OPS[typ], qname), items=arg)
+            self.emit(name=qname, ph="C", ts=now, tid=ISR_TID,
+                      args={"items": arg})
+        elif typ == NOTIFY_BLOCK:
+            self.instant(self.current_tid(), "wait notify")
+        elif typ == NOTIFY_ISR:
+            self.instant(ISR_TID, "notify %s" % self.task_name(rid))
+        elif typ == ISR_ENTER:
+            self.isr_depth += 1
+            self.emit(name="irq %d" % rid, ph="B", ts=now, tid=ISR_TID)
+        elif typ == ISR_EXIT:
+            if self.isr_depth:
+                self.isr_depth -= 1
+                self.emit(name="irq %d" % rid, ph="E", ts=now, tid=ISR_TID)
+        elif typ == TICK:
+            self.instant(ISR_TID, "tick", count=rid)
+        elif typ == USER:
+            self.instant(self.current_tid(), "mark %d" % rid, arg=arg)
+        elif typ == DROPPED:
+            self.dropped += rid
+            self.emit(name="dropped %d" % rid, ph="i", s="g", ts=now,
+                      tid=ISR_TID)
+
+    def finish(self):
+        if self.running is not None:
+            self.switch_out(self.running)
+        self.emit(name="thread_name", ph="M", tid=ISR_TID,
+                  args={"name": "ISR"})
+        self.emit(name="process_name", ph="M", tid=ISR_TID,
+                  args={"name": "K1921VG015"})
+        return {"traceEvents": self.events, "displayTimeUnit": "ns"}
+
+    def summary(self, out):
+        total = self.us() or 1.0
+        out.write("%-16s %8s %8s %12s %12s\n" % (
+            "task", "cpu %", "switches", "lat avg us", "lat max us"))
+        for tid in sorted(self.stats):
+            st = self.stats[tid]
+            n = st.get("lat_n", 0)
+            out.write("%-16s %8.2f %8d %12.2f %12.2f\n" % (
+                self.task_name(tid), 100.0 * st["run"] / total,
+                st["switches"], st["lat_sum"] / n if n else 0.0,
+                st["lat_max"]))
+        if self.recorder:
+            r = self.recorder
+            out.write("recorder: %d events, %d dropped, %d/%d cycles "
+                      "avg/max per record, ring hwm %d\n" % (
+                          r["events"], r["dropped"], r["rec_cycles_avg"],
+                          r["rec_cycles_max"], r["ring_hwm"]))
+        if self.dropped:
+            out.write("stream: %d events lost in the ring\n" % self.dropped)
+
+
+def capture(port, baud, seconds):
+    import serial
+
+    data = bytearray()
+    end = time.monotonic() + seconds
+    with serial.Serial(port, baud, timeout=0.1) as ser:
+        while time.monotonic() < end:
+            data += ser.read(4096)
+    return bytes(data)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("input", nargs="?", help="captured stream, - for stdin")
+    ap.add_argument("-o", "--output", default="-", help="JSON file")
+    ap.add_argument("--port", help="read live from a serial port")
+    ap.add_argument("--baud", type=int, default=921600)
+    ap.add_argument("--seconds", type=float, default=10.0)
+    ap.add_argument("--hz", type=float, default=50e6,
+                    help="mcycle rate if the stream has no clock record")
+    args = ap.parse_args()
+
+    if args.port:
+        data = capture(args.port, args.baud, args.seconds)
+    elif args.input and args.input != "-":
+        with open(args.input, "rb") as f:
+            data = f.read()
+    else:
+        data = sys.stdin.buffer.read()
+
+    conv = Converter(args.hz)
+    for rec in records(data):
+        conv.feed(*rec)
+    trace = conv.finish()
+
+    if args.output == "-":
+        json.dump(trace, sys.stdout)
+    else:
+        with open(args.output, "w") as f:
+            json.dump(trace, f)
+    conv.summary(sys.stderr)
+
+
+if __name__ == "__main__":
+    main()